@@ -0,0 +1,187 @@
+/*
+ * 									DS1307_Boot.c
+ *
+ *  This file contains the warm-restart API implementations of the DS1307 driver.
+ *
+ *  A system reset (software, watchdog) resets the MCU peripherals but neither the SRAM nor the DS1307:
+ *  the I2C pins and peripheral are set up again, the DS1307 is left alone when the cache proves that it
+ *  was initialized and running before the reset.
+ *
+ */
+
+#include "DS1307_Boot.h"
+#include "crc16.h"
+
+#include<stddef.h>
+#include<string.h>
+
+/* -- Cache Identification -- */
+#define DS1307_BOOT_MAGIC		0x44533037U		// "DS07"
+#define DS1307_BOOT_VERSION		1U
+
+/* -- Cached State (.noinit SRAM, CRC-16 over all the bytes before 'Crc') -- */
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t WarmCount;				// Warm boots since the last cold boot
+	uint32_t LastEpoch;				// Last saved timestamp (0: none)
+	uint8_t TimeFormat;				// Time Format of LastEpoch
+	uint8_t Version;
+	uint16_t Crc;
+
+}DS1307_Boot_Cache_t;
+
+// Kept across resets while powered: random content after power-on (rejected by magic and CRC)
+__NOINIT static DS1307_Boot_Cache_t bootCache;
+
+// This boot
+static uint8_t bootResetFlags = 0;
+static uint8_t bootType = DS1307_BOOT_COLD;
+static uint8_t bootInitStatus = DS1307_INIT_OK;
+
+/* --Helper Functions-- */
+static uint8_t DS1307_Boot_CacheValid(void);
+static void DS1307_Boot_Seal(void);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_Init
+ * Description	:	To bring up the DS1307 after any reset (replaces DS1307_Init in the application)
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_BOOT_TYPE
+ * Note		:	Warm path: DS1307_BOOT_WARM_RESETS only (no power-on/brown-out flag) AND a valid cache.
+ *			A cache is valid only after a successful DS1307_Init: the clock is known to be running
+ *			with a valid time, so no I2C transfer is made at all.
+ *			Reads (and clears) the RCC reset flags: RCC_GetResetFlags returns them afterwards.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Boot_Init(void)
+{
+	bootResetFlags = RCC_GetResetFlags();
+
+	/* -Step 1. Warm reset with a valid cache: I2C pins and peripheral only- */
+	if ((bootResetFlags & DS1307_BOOT_WARM_RESETS) && !(bootResetFlags & (RCC_RESET_POR | RCC_RESET_BOR)) &&
+		DS1307_Boot_CacheValid())
+	{
+		DS1307_Attach();
+
+		bootCache.WarmCount++;
+		DS1307_Boot_Seal();
+
+		bootType = DS1307_BOOT_WARM;
+		return bootType;
+	}
+
+	/* -Step 2. Cold boot: initialization (running clock not written)- */
+	memset(&bootCache, 0, sizeof(bootCache));
+
+	bootInitStatus = DS1307_Init();
+	if ((bootInitStatus == DS1307_INIT_ERR_HALTED) || (bootInitStatus == DS1307_INIT_ERR_BUS))
+	{
+		bootType = DS1307_BOOT_FAIL;
+		return bootType;
+	}
+
+	/* -Step 3. Cache rebuilt only for a running clock with a valid time (else: cold again next time)- */
+	if (bootInitStatus == DS1307_INIT_OK)
+	{
+		DS1307_Boot_Seal();
+	}
+
+	bootType = DS1307_BOOT_COLD;
+	return bootType;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_Save
+ * Description	:	To save the last timestamp in the cache
+ *
+ * Parameter 1	:	Seconds since DS1307_EPOCH_YEAR (e.g. from DS1307_Get_Epoch)
+ * Parameter 2	:	Time Format (@TIME_FORMAT)
+ * Return Type	:	none (void)
+ * Note		:	No effect while the cache is invalid (time not valid at boot, DS1307_Boot_Invalidate).
+ *			SRAM only (no I2C): cheap enough for every timestamp.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Boot_Save(uint32_t Epoch, uint8_t TimeFormat)
+{
+	if (!DS1307_Boot_CacheValid())
+	{
+		return;
+	}
+
+	bootCache.LastEpoch = Epoch;
+	bootCache.TimeFormat = TimeFormat;
+	DS1307_Boot_Seal();
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_GetInfo
+ * Description	:	To get the warm-restart information
+ *
+ * Parameter 1	:	Pointer to information (filled)
+ * Return Type	:	none (void)
+ * Note		:	WarmCount, LastEpoch and TimeFormat are 0 while the cache is invalid.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Boot_GetInfo(DS1307_Boot_Info_t *pInfo)
+{
+	memset(pInfo, 0, sizeof(*pInfo));
+
+	pInfo->ResetFlags = bootResetFlags;
+	pInfo->BootType = bootType;
+	pInfo->InitStatus = bootInitStatus;
+
+	if (DS1307_Boot_CacheValid())
+	{
+		pInfo->TimeFormat = bootCache.TimeFormat;
+		pInfo->WarmCount = bootCache.WarmCount;
+		pInfo->LastEpoch = bootCache.LastEpoch;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_Invalidate
+ * Description	:	To force the next boot to be cold
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	MUST be called before anything that stops the DS1307 clock (CH set) on purpose.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Boot_Invalidate(void)
+{
+	bootCache.Magic = 0;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_CacheValid
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t (1: valid, 0: invalid)
+ * Note		: Magic, version and CRC-16 of the cache
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Boot_CacheValid(void)
+{
+	return (bootCache.Magic == DS1307_BOOT_MAGIC) && (bootCache.Version == DS1307_BOOT_VERSION) &&
+		(bootCache.Crc == CRC16_Compute(&bootCache, offsetof(DS1307_Boot_Cache_t, Crc), CRC16_INIT));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Boot_Seal
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: To set the magic and version, and recompute the CRC-16 of the cache
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Boot_Seal(void)
+{
+	bootCache.Magic = DS1307_BOOT_MAGIC;
+	bootCache.Version = DS1307_BOOT_VERSION;
+	bootCache.Crc = CRC16_Compute(&bootCache, offsetof(DS1307_Boot_Cache_t, Crc), CRC16_INIT);
+}
@@ -0,0 +1,57 @@
+/*
+ * 									DS1307_Boot.h
+ *
+ * This file contains the warm-restart APIs of the DS1307 driver.
+ *
+ * 	> Cold boot (power-on, brown-out, NRST pin): DS1307_Init (non-destructive, time validity reported)
+ * 	> Warm boot (software or watchdog reset, no power loss) with a valid cache: I2C set up only,
+ * 	  no DS1307 register access (running clock untouched, no I2C transfer before the first timestamp)
+ * 	> The cache lives in .noinit SRAM (not zeroed by the startup), checked with magic, version and CRC-16
+ *
+ */
+
+#ifndef DS1307_BOOT_H_
+#define DS1307_BOOT_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+#include "stm32f407xx_rcc_drivers.h"
+
+
+/* -- Resets that keep the SRAM and the DS1307 running (@RCC_RESET_FLAG) -- */
+#define DS1307_BOOT_WARM_RESETS		(RCC_RESET_SOFTWARE | RCC_RESET_IWDG | RCC_RESET_WWDG)
+
+/* -- Boot Type (@DS1307_BOOT_TYPE) -- */
+#define DS1307_BOOT_COLD		0				// DS1307_Init, cache rebuilt if DS1307_INIT_OK (see InitStatus)
+#define DS1307_BOOT_WARM		1				// Valid cache after a warm reset: I2C set up only
+#define DS1307_BOOT_FAIL		2				// Cold boot, DS1307_Init failed (clock halted): cache invalid
+
+/* -- Warm-restart Information -- */
+typedef struct
+{
+	uint8_t ResetFlags;				// Cause(s) of the last reset (@RCC_RESET_FLAG)
+	uint8_t BootType;				// @DS1307_BOOT_TYPE
+	uint8_t InitStatus;				// @DS1307_INIT_STATUS of this boot (DS1307_INIT_OK when warm)
+	uint8_t TimeFormat;				// Time Format of LastEpoch (@TIME_FORMAT)
+	uint32_t WarmCount;				// Warm boots since the last cold boot
+	uint32_t LastEpoch;				// Last timestamp saved with DS1307_Boot_Save (0: none)
+
+}DS1307_Boot_Info_t;
+
+
+/* -- APIs Supported by DS1307_Boot -- */
+
+// To bring up the DS1307 after any reset: cold or warm path (returns @DS1307_BOOT_TYPE)
+uint8_t DS1307_Boot_Init(void);
+
+// To save the last timestamp in the cache (kept across warm resets)
+void DS1307_Boot_Save(uint32_t Epoch, uint8_t TimeFormat);
+
+// To get the warm-restart information
+void DS1307_Boot_GetInfo(DS1307_Boot_Info_t *pInfo);
+
+// To force the next boot to be cold (e.g. before halting the DS1307 clock on purpose)
+void DS1307_Boot_Invalidate(void);
+
+
+#endif /* DS1307_BOOT_H_ */
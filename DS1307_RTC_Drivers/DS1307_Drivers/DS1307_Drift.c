@@ -0,0 +1,124 @@
+/*
+ * 									DS1307_Drift.c
+ *
+ *  This file contains the frequency-capture API implementations of the DS1307 driver.
+ *
+ */
+
+#include "DS1307_Drift.h"
+
+#include<string.h>
+
+/* --Helper Functions-- */
+static void DS1307_Drift_PinConfig(uint8_t AltFunc);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Drift_Measure
+ * Description	:	To measure the MCU clock against the DS1307 32.768 kHz output
+ *
+ * Parameter 1	:	Measurement window in seconds [1 to DS1307_DRIFT_MAX_SECONDS]
+ * Parameter 2	:	Pointer to the result
+ * Return Type	:	uint8_t @DS1307_DRIFT_STATUS
+ * Note		:	Every 8th rising edge is captured (4096 captures per second): the modulo-65536 deltas
+ *			are summed over exactly 'Seconds' crystal seconds, which gives the timer clock.
+ *			Resolution is 1 timer tick per window (84 MHz, 1 s: 0.012 ppm), the DS1307 crystal
+ *			itself is the limit (typically +/-20 ppm at 25 degC). Ticks summed in 64 bits: 84 MHz
+ *			over 60 s is ~5.0e9, past 32 bits after ~51 s.
+ *
+ *			DS1307_Init MUST be called first. The clock MUST NOT change during the measurement.
+ *			On return SQW/OUT is held high (square wave off), PB8 is a plain input and its EXTI
+ *			line is masked: call DS1307_LowPower_Init again to get the 1 Hz wake-up source back.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Drift_Measure(uint8_t Seconds, DS1307_Drift_t *pDrift)
+{
+	uint32_t captures;
+	uint64_t ticks = 0;
+	uint16_t previous;
+	uint16_t current;
+	uint8_t status = DS1307_DRIFT_OK;
+	int32_t diff;
+
+	if ((Seconds == 0) || (Seconds > DS1307_DRIFT_MAX_SECONDS))
+	{
+		return DS1307_DRIFT_ERR_PARAM;
+	}
+
+	memset(pDrift, 0, sizeof(*pDrift));
+	pDrift->NominalHz = TIM_Clock_Value();
+
+	// Every capture interval MUST fit in 16 bits (at most 268 MHz, never reached on this MCU)
+	if ((pDrift->NominalHz / DS1307_DRIFT_CAPTURES_PER_S) >= 0xFFFFU)
+	{
+		return DS1307_DRIFT_ERR_CLOCK;
+	}
+
+	/* -Step 1. DS1307: 32.768 kHz on SQW/OUT, routed to the capture timer (EXTI line masked: no IRQ per edge)- */
+	EXTI->IMR &= ~(1U << DS1307_SQW_PIN);
+	DS1307_Set_SQW(DS1307_SQW_32KHZ);
+	DS1307_Drift_PinConfig(DS1307_DRIFT_TIM_AF);
+
+	/* -Step 2. Free-running timer, capture on every 8th rising edge, light filter (glitches on the pull-up edge)- */
+	TIM_IC_Init(DS1307_DRIFT_TIM, DS1307_DRIFT_TIM_CHANNEL, TIM_ICEDGE_RISING, TIM_ICPSC_DIV8, 2);
+
+	/* -Step 3. First capture: reference- */
+	if (TIM_IC_WaitCapture(DS1307_DRIFT_TIM, DS1307_DRIFT_TIM_CHANNEL, &previous) == TIM_ERR_TIMEOUT)
+	{
+		status = DS1307_DRIFT_ERR_SIGNAL;
+	}
+
+	/* -Step 4. Sum the intervals over the window (uint16_t difference: wrap-around safe)- */
+	for (captures = (uint32_t)Seconds * DS1307_DRIFT_CAPTURES_PER_S; (captures > 0) && (status == DS1307_DRIFT_OK); captures--)
+	{
+		if (TIM_IC_WaitCapture(DS1307_DRIFT_TIM, DS1307_DRIFT_TIM_CHANNEL, &current) != TIM_OK)
+		{
+			// Timeout ('current' not written) or lost capture: window abandoned
+			status = DS1307_DRIFT_ERR_SIGNAL;
+			break;
+		}
+
+		ticks += (uint16_t)(current - previous);
+		previous = current;
+	}
+
+	/* -Step 5. Release the timer, pin back to input, SQW/OUT static high- */
+	TIM_IC_DeInit(DS1307_DRIFT_TIM, DS1307_DRIFT_TIM_CHANNEL);
+	DS1307_Drift_PinConfig(0);
+	DS1307_Set_SQW_Level(DS1307_OUT_HIGH);
+	EXTI->PR = (1U << DS1307_SQW_PIN);
+
+	if (status != DS1307_DRIFT_OK)
+	{
+		return status;
+	}
+
+	/* -Step 6. Frequency and error: ppm = diff * 1e6 / nominal (64-bit, diff can exceed 4000 ppm on HSI)- */
+	pDrift->MeasuredHz = (uint32_t)(ticks / Seconds);
+	diff = (int32_t)(pDrift->MeasuredHz - pDrift->NominalHz);
+	pDrift->ErrorPPM = (int32_t)(((int64_t)diff * 1000000) / (int64_t)pDrift->NominalHz);
+
+	return DS1307_DRIFT_OK;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Drift_PinConfig
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Alternate function (0: plain input)
+ * Return Type	:	none (void)
+ * Note		: SQW pin as timer input (Alternate Functionality) with pull-up (SQW/OUT is open drain)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Drift_PinConfig(uint8_t AltFunc)
+{
+	GPIO_Handle_t SQW_Pin;
+
+	memset(&SQW_Pin, 0, sizeof(SQW_Pin));
+	SQW_Pin.pGPIOx = DS1307_SQW_GPIO_PORT;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinNumber = DS1307_SQW_PIN;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinMode = (AltFunc) ? GPIO_MODE_ALTFUNC : GPIO_MODE_IN;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinAltFuncMode = AltFunc;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+	GPIO_Init(&SQW_Pin);
+}
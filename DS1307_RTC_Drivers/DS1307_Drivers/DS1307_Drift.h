@@ -0,0 +1,54 @@
+/*
+ * 									DS1307_Drift.h
+ *
+ * This file contains the frequency-capture APIs of the DS1307 driver.
+ *
+ * 	> DS1307 32.768 kHz square wave (SQW/OUT, crystal reference) -> TIM4 CH3 input capture (PB8)
+ * 	> The timer counts the MCU clock (HSI or HSE, through the PLL): its drift in ppm against the crystal
+ * 	> No extra hardware: SQW/OUT is the same pin used as the 1 Hz wake-up source (DS1307_LowPower)
+ *
+ */
+
+#ifndef DS1307_DRIFT_H_
+#define DS1307_DRIFT_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+#include "stm32f407xx_tim_drivers.h"
+
+
+/* -- Capture Timer (DS1307_SQW_PIN: PB8 = TIM4_CH3, AF2) -- */
+#define DS1307_DRIFT_TIM		TIM4
+#define DS1307_DRIFT_TIM_CHANNEL	TIM_CHANNEL_3
+#define DS1307_DRIFT_TIM_AF		2
+
+/* -- Captures per second: 32768 Hz / 8 (TIM_ICPSC_DIV8) -- */
+#define DS1307_DRIFT_SQW_HZ		32768U
+#define DS1307_DRIFT_CAPTURES_PER_S	(DS1307_DRIFT_SQW_HZ / 8U)
+
+/* -- Return Status (@DS1307_DRIFT_STATUS) -- */
+#define DS1307_DRIFT_OK			0
+#define DS1307_DRIFT_ERR_PARAM		1			// Seconds out of range
+#define DS1307_DRIFT_ERR_CLOCK		2			// Timer clock too fast for 16-bit captures
+#define DS1307_DRIFT_ERR_SIGNAL		3			// No square wave (timeout) or lost captures
+
+/* -- Measurement Window Limit -- */
+#define DS1307_DRIFT_MAX_SECONDS	60
+
+/* -- Measurement Result -- */
+typedef struct
+{
+	uint32_t NominalHz;				// Timer clock expected from the RCC configuration
+	uint32_t MeasuredHz;				// Timer clock measured against the DS1307 crystal
+	int32_t ErrorPPM;				// (Measured - Nominal) / Nominal, in ppm (+: MCU clock fast)
+
+}DS1307_Drift_t;
+
+
+/* -- APIs Supported by DS1307_Drift -- */
+
+// To measure the MCU clock against the DS1307 32.768 kHz output (returns @DS1307_DRIFT_STATUS)
+uint8_t DS1307_Drift_Measure(uint8_t Seconds, DS1307_Drift_t *pDrift);
+
+
+#endif /* DS1307_DRIFT_H_ */
@@ -0,0 +1,267 @@
+/*
+ * 									DS1307_Format.c
+ *
+ *  This file contains DS1307 time/date formatting API implementations.
+ *
+ */
+
+#include "DS1307_Format.h"
+
+/* -- "00" to "99": two characters per value, index = 2 * value -- */
+static const char DigitPairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/* -- Day names, index = day - 1 (SUNDAY = 1) -- */
+static const char* const DayNames[7] =
+{
+	"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"
+};
+
+/* --Helper Functions-- */
+static char* Put_2Digits(char *pBuff, uint8_t value);
+static char* Put_Date(char *pBuff, const RTC_Date_h *pRTCDate, char separator);
+static char* Put_Time(char *pBuff, const RTC_Time_h *pRTCTime, uint8_t outFormat);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Format_Time
+ * Description	:	To convert time information into string
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Time_h)
+ * Parameter 2	:	Output Format (@DS1307_FORMAT)
+ * Parameter 3	:	Buffer, at least DS1307_TIME_STR_LEN characters (char *)
+ * Return Type	:	number of characters written, excluding '\0' (uint8_t)
+ * Note		:	"hh:mm:ss" (24-Hour) or "hh:mm:ss AM" / "hh:mm:ss PM" (12-Hour)
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Format_Time(const RTC_Time_h *pRTCTime, uint8_t outFormat, char *pBuff)
+{
+	char *pEnd = Put_Time(pBuff, pRTCTime, outFormat);
+
+	*pEnd = '\0';
+
+	return (uint8_t) (pEnd - pBuff);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Format_Date
+ * Description	:	To convert date information into string
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Buffer, at least DS1307_DATE_STR_LEN characters (char *)
+ * Return Type	:	number of characters written, excluding '\0' (uint8_t)
+ * Note		:	"dd-mm-yy"
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Format_Date(const RTC_Date_h *pRTCDate, char *pBuff)
+{
+	char *pEnd = Put_Date(pBuff, pRTCDate, '-');
+
+	*pEnd = '\0';
+
+	return (uint8_t) (pEnd - pBuff);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Format_ISO8601
+ * Description	:	To convert date and time information into an ISO-8601 string
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Parameter 3	:	Buffer, at least DS1307_ISO8601_STR_LEN characters (char *)
+ * Return Type	:	number of characters written, excluding '\0' (uint8_t)
+ * Note		:	"20yy-mm-ddThh:mm:ss", always 24-Hour (12-Hour time is converted).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Format_ISO8601(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime, char *pBuff)
+{
+	char *p = pBuff;
+
+	// a. Date: 20yy-mm-dd
+	p = Put_2Digits(p, DS1307_CENTURY);
+	p = Put_2Digits(p, pRTCDate->year);
+	*p++ = '-';
+	p = Put_2Digits(p, pRTCDate->month);
+	*p++ = '-';
+	p = Put_2Digits(p, pRTCDate->date);
+
+	// b. Separator
+	*p++ = 'T';
+
+	// c. Time: hh:mm:ss
+	p = Put_Time(p, pRTCTime, DS1307_FORMAT_24H);
+
+	*p = '\0';
+
+	return (uint8_t) (p - pBuff);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Format_Timestamp
+ * Description	:	To convert date and time information into a single string
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Parameter 3	:	Output Format (@DS1307_FORMAT)
+ * Parameter 4	:	Buffer, at least DS1307_TIMESTAMP_STR_LEN characters (char *)
+ * Return Type	:	number of characters written, excluding '\0' (uint8_t)
+ * Note		:	"dd-mm-yy hh:mm:ss" or "dd-mm-yy hh:mm:ss AM", written in a single pass.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Format_Timestamp(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime, uint8_t outFormat, char *pBuff)
+{
+	char *p = Put_Date(pBuff, pRTCDate, '-');
+
+	*p++ = ' ';
+
+	p = Put_Time(p, pRTCTime, outFormat);
+
+	*p = '\0';
+
+	return (uint8_t) (p - pBuff);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_DayName
+ * Description	:	To get the name of the day of the week
+ *
+ * Parameter 1	:	day (SUNDAY to SATURDAY) (uint8_t)
+ * Return Type	:	day of week (const char *)
+ * Note		:	Returns "???" for values out of range (instead of reading outside of the table).
+ * ------------------------------------------------------------------------------------------------------ */
+const char* DS1307_DayName(uint8_t day)
+{
+	if ((day < SUNDAY) || (day > SATURDAY))
+	{
+		return "???";
+	}
+
+	return DayNames[day - SUNDAY];
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Put_2Digits
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Buffer (char *)
+ * Parameter 2	:	value [0 to 99] (uint8_t)
+ * Return Type	:	Buffer position after the two characters (char *)
+ * Note		:	Values above 99 are written as "??" (never skipped, never truncated silently).
+ * ------------------------------------------------------------------------------------------------------ */
+static char* Put_2Digits(char *pBuff, uint8_t value)
+{
+	if (value > 99)
+	{
+		pBuff[0] = '?';
+		pBuff[1] = '?';
+	}
+	else
+	{
+		pBuff[0] = DigitPairs[2 * value];
+		pBuff[1] = DigitPairs[2 * value + 1];
+	}
+
+	return pBuff + 2;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Put_Date
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Buffer (char *)
+ * Parameter 2	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 3	:	separator (char)
+ * Return Type	:	Buffer position after the date (char *)
+ * Note		:	"dd-mm-yy", no '\0'
+ * ------------------------------------------------------------------------------------------------------ */
+static char* Put_Date(char *pBuff, const RTC_Date_h *pRTCDate, char separator)
+{
+	pBuff = Put_2Digits(pBuff, pRTCDate->date);
+	*pBuff++ = separator;
+	pBuff = Put_2Digits(pBuff, pRTCDate->month);
+	*pBuff++ = separator;
+	pBuff = Put_2Digits(pBuff, pRTCDate->year);
+
+	return pBuff;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Put_Time
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Buffer (char *)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Parameter 3	:	Output Format (@DS1307_FORMAT)
+ * Return Type	:	Buffer position after the time (char *)
+ * Note		:	"hh:mm:ss" or "hh:mm:ss AM", no '\0'
+ *			12-Hour: 12 AM is midnight (00 in 24-Hour), 12 PM is noon (12 in 24-Hour)
+ * ------------------------------------------------------------------------------------------------------ */
+static char* Put_Time(char *pBuff, const RTC_Time_h *pRTCTime, uint8_t outFormat)
+{
+	uint8_t hours = pRTCTime->hours;
+	uint8_t isPM = (pRTCTime->timeFormat == TIME_FORMAT_12H_PM);
+
+	/* -Step 1. Convert Hours into the requested Output Format- */
+	if (outFormat == DS1307_FORMAT_AS_IS)
+	{
+		outFormat = (pRTCTime->timeFormat == TIME_FORMAT_24H) ? DS1307_FORMAT_24H : DS1307_FORMAT_12H;
+	}
+
+	if ((outFormat == DS1307_FORMAT_24H) && (pRTCTime->timeFormat != TIME_FORMAT_24H))
+	{
+		// 12-Hour -> 24-Hour: 12 AM -> 0, 1 PM to 11 PM -> 13 to 23
+		if (hours == 12)
+		{
+			hours = 0;
+		}
+
+		if (isPM)
+		{
+			hours += 12;
+		}
+	}
+	else if ((outFormat == DS1307_FORMAT_12H) && (pRTCTime->timeFormat == TIME_FORMAT_24H))
+	{
+		// 24-Hour -> 12-Hour: 0 -> 12 AM, 12 -> 12 PM, 13 to 23 -> 1 PM to 11 PM
+		isPM = (hours >= 12);
+
+		if (hours > 12)
+		{
+			hours -= 12;
+		}
+		else if (hours == 0)
+		{
+			hours = 12;
+		}
+	}
+
+	/* -Step 2. hh:mm:ss- */
+	pBuff = Put_2Digits(pBuff, hours);
+	*pBuff++ = ':';
+	pBuff = Put_2Digits(pBuff, pRTCTime->minutes);
+	*pBuff++ = ':';
+	pBuff = Put_2Digits(pBuff, pRTCTime->seconds);
+
+	/* -Step 3. AM/PM (12-Hour only)- */
+	if (outFormat == DS1307_FORMAT_12H)
+	{
+		*pBuff++ = ' ';
+		*pBuff++ = isPM ? 'P' : 'A';
+		*pBuff++ = 'M';
+	}
+
+	return pBuff;
+}
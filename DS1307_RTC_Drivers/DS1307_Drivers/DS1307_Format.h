@@ -0,0 +1,52 @@
+/*
+ * 									DS1307_Format.h
+ *
+ * This file contains the time/date formatting APIs for the DS1307 driver.
+ *
+ * 	> Caller provided buffers (no static buffers, no heap): reentrant and ISR-safe
+ * 	> Const look-up tables (Flash) for digits and day names
+ * 	> Every API returns the number of characters written (excluding '\0')
+ *
+ */
+
+#ifndef DS1307_FORMAT_H_
+#define DS1307_FORMAT_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+
+
+/* -- Output Formats (@DS1307_FORMAT) -- */
+#define DS1307_FORMAT_AS_IS		0				// Keep the Time Format of the RTC_Time_h
+#define DS1307_FORMAT_12H		1				// hh:mm:ss AM/PM
+#define DS1307_FORMAT_24H		2				// hh:mm:ss
+
+/* -- Minimum Buffer Sizes (including '\0') -- */
+#define DS1307_TIME_STR_LEN		12				// "hh:mm:ss AM"
+#define DS1307_DATE_STR_LEN		9				// "dd-mm-yy"
+#define DS1307_ISO8601_STR_LEN		20				// "20yy-mm-ddThh:mm:ss"
+#define DS1307_TIMESTAMP_STR_LEN	21				// "dd-mm-yy hh:mm:ss AM"
+
+/* -- Century of the 2-digit DS1307 Year Register -- */
+#define DS1307_CENTURY			20
+
+
+/* -- APIs Supported by DS1307_Format -- */
+
+// To convert time into "hh:mm:ss" (24-Hour) or "hh:mm:ss AM"/"hh:mm:ss PM" (12-Hour)
+uint8_t DS1307_Format_Time(const RTC_Time_h *pRTCTime, uint8_t outFormat, char *pBuff);
+
+// To convert date into "dd-mm-yy"
+uint8_t DS1307_Format_Date(const RTC_Date_h *pRTCDate, char *pBuff);
+
+// To convert date and time into ISO-8601 "20yy-mm-ddThh:mm:ss" (always 24-Hour)
+uint8_t DS1307_Format_ISO8601(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime, char *pBuff);
+
+// To convert date and time into "dd-mm-yy hh:mm:ss[ AM]" in a single pass
+uint8_t DS1307_Format_Timestamp(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime, uint8_t outFormat, char *pBuff);
+
+// To get the name of the day of the week (SUNDAY to SATURDAY), "???" if out of range
+const char* DS1307_DayName(uint8_t day);
+
+
+#endif /* DS1307_FORMAT_H_ */
@@ -0,0 +1,193 @@
+/*
+ * 									DS1307_LowPower.c
+ *
+ *  This file contains the sleep-until-next-second API implementations of the DS1307 driver.
+ *
+ */
+
+#include "DS1307_LowPower.h"
+#include "stm32f407xx_nvic_drivers.h"
+#include "stm32f407xx_dwt_drivers.h"
+
+#include<string.h>
+
+// Selected low-power mode (@DS1307_LP_MODE) and clock restored after STOP
+static uint8_t lpMode = DS1307_LP_SLEEP;
+static const RCC_ClockConfig_t *pLpRunClock = NULL;
+
+// Set by the SQW EXTI callback, cleared by DS1307_LowPower_WaitForTick
+static volatile uint8_t sqwTick = 0;
+
+// Wake-up statistics
+static DS1307_LP_Stats_t lpStats;
+
+/* --Helper Functions-- */
+static void DS1307_LP_TickCallback(uint8_t PinNumber);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_LowPower_Init
+ * Description	:	To set up the 1 Hz SQW wake-up source and the low-power mode
+ *
+ * Parameter 1	:	@DS1307_LP_MODE
+ * Parameter 2	:	Clock configuration restored after STOP (NULL allowed for DS1307_LP_SLEEP)
+ * Return Type	:	uint8_t (0: success, 1: invalid parameters)
+ * Note		:	DS1307_Init MUST be called first.
+ *			For the lowest wake-up latency in STOP use RCC_Config_PLL_HSI_168MHz (no HSE start-up,
+ *			timestamps keep the DS1307 crystal precision either way).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_LowPower_Init(uint8_t Mode, const RCC_ClockConfig_t *pRunClock)
+{
+	GPIO_Handle_t SQW_Pin;
+
+	if ((Mode > DS1307_LP_STOP_LPDS) || ((Mode != DS1307_LP_SLEEP) && (pRunClock == NULL)))
+	{
+		return 1;
+	}
+
+	lpMode = Mode;
+	pLpRunClock = pRunClock;
+	sqwTick = 0;
+	memset(&lpStats, 0, sizeof(lpStats));
+
+	/* -Step 1. DS1307: 1 Hz square wave on SQW/OUT- */
+	DS1307_Set_SQW(DS1307_SQW_1HZ);
+
+	/* -Step 2. SQW pin: EXTI on falling edge (seconds update), pull-up (SQW/OUT is open drain)- */
+	memset(&SQW_Pin, 0, sizeof(SQW_Pin));
+	SQW_Pin.pGPIOx = DS1307_SQW_GPIO_PORT;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinNumber = DS1307_SQW_PIN;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_IT_FT;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+	SQW_Pin.GPIO_PinConfig.GPIO_PinCallback = DS1307_LP_TickCallback;
+	GPIO_Init(&SQW_Pin);
+
+	NVIC_ClearPendingIRQ(DS1307_SQW_IRQ_NO);
+	GPIO_IRQInterruptConfig(DS1307_SQW_IRQ_NO, ENABLE);
+
+	/* -Step 3. PWR: deep sleep is STOP (not STANDBY), regulator as selected, Flash kept powered- */
+	PWR_PCLK_EN();
+	PWR->CR &= ~((1 << PWR_CR_PDDS) | (1 << PWR_CR_FPDS) | (1 << PWR_CR_LPDS));
+	if (Mode == DS1307_LP_STOP_LPDS)
+	{
+		PWR->CR |= (1 << PWR_CR_LPDS);
+	}
+
+	/* -Step 4. Cycle counter for the wake-to-ready time- */
+	DWT_CycleCounterInit();
+
+	return 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_LowPower_WaitForTick
+ * Description	:	To sleep until the next SQW tick (next second)
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	Interrupts are masked (PRIMASK) around WFI: a tick arriving between the flag check
+ *			and WFI is not lost (a pending interrupt still ends WFI). After every wake-up, the run
+ *			clock is restored BEFORE the pending ISRs run, then they are unmasked.
+ *
+ *			Wake-to-ready = WFI return to clocks restored (incl. clock listeners, e.g. I2C re-timing).
+ *			In STOP it mostly runs on HSI, so it is converted to microseconds at 16 MHz (upper bound).
+ *			The hardware wake-up (regulator, Flash) before WFI returns is not visible to the DWT.
+ *
+ *			Run clock not restored after STOP (e.g. HSE failed, PLL not locked): counted with its
+ *			@RCC_STATUS in the statistics, the core then runs on RCC_Config_HSI_16MHz (slow, but the
+ *			cached clock values and the peripherals re-timing stay consistent).
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_LowPower_WaitForTick(void)
+{
+	uint32_t wakeStart;
+	uint32_t wakeCycles;
+	uint32_t wakeHclk;
+	uint8_t clockStatus;
+
+	/* -Step 1. Sleep depth (SLEEPDEEP: STOP) and the clock the core wakes up on- */
+	if (lpMode == DS1307_LP_SLEEP)
+	{
+		*SCB_SCR &= ~(1U << SCB_SCR_SLEEPDEEP);
+		wakeHclk = RCC_Hclk_Value();
+	}
+	else
+	{
+		*SCB_SCR |= (1U << SCB_SCR_SLEEPDEEP);
+		wakeHclk = RCC_HSI_VALUE;
+	}
+
+	/* -Step 2. Sleep until the SQW tick- */
+	__asm volatile ("cpsid i" ::: "memory");
+
+	while (!sqwTick)
+	{
+		__asm volatile ("dsb\n\twfi" ::: "memory");
+
+		wakeStart = DWT_GetCycles();
+
+		/* -Step 3. STOP: core restarts on HSI, PLL/HSE are off: restore the run clock- */
+		if (lpMode != DS1307_LP_SLEEP)
+		{
+			RCC_UpdateClockCache();
+			clockStatus = RCC_ClockConfig(pLpRunClock);
+			if (clockStatus != RCC_OK)
+			{
+				lpStats.ClockErrors++;
+				lpStats.LastClockError = clockStatus;
+				(void)RCC_ClockConfig(&RCC_Config_HSI_16MHz);
+			}
+		}
+
+		/* -Step 4. Wake-up statistics- */
+		wakeCycles = DWT_GetCycles() - wakeStart;
+		lpStats.WakeCount++;
+		lpStats.LastWakeCycles = wakeCycles;
+		lpStats.LastWakeUs = (uint32_t)(((uint64_t)wakeCycles * 1000000ULL) / wakeHclk);	// HCLK below 1 MHz too
+		if (lpStats.LastWakeUs > lpStats.MaxWakeUs)
+		{
+			lpStats.MaxWakeUs = lpStats.LastWakeUs;
+		}
+
+		/* -Step 5. Let the pending ISR(s) run (SQW callback sets sqwTick)- */
+		__asm volatile ("cpsie i\n\tisb" ::: "memory");
+		__asm volatile ("cpsid i" ::: "memory");
+	}
+
+	sqwTick = 0;
+	lpStats.TickCount++;
+
+	*SCB_SCR &= ~(1U << SCB_SCR_SLEEPDEEP);
+	__asm volatile ("cpsie i" ::: "memory");
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_LowPower_GetStats
+ * Description	:	To get the wake-up statistics
+ *
+ * Parameter 1	:	Pointer to statistics (copied)
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_LowPower_GetStats(DS1307_LP_Stats_t *pStats)
+{
+	*pStats = lpStats;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_LP_TickCallback
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	EXTI line (pin number)
+ * Return Type	:	none (void)
+ * Note		: SQW falling edge (EXTI callback, registered through GPIO_Init)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_LP_TickCallback(uint8_t PinNumber)
+{
+	(void)PinNumber;
+
+	sqwTick = 1;
+}
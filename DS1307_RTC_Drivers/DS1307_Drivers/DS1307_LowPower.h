@@ -0,0 +1,51 @@
+/*
+ * 									DS1307_LowPower.h
+ *
+ * This file contains the sleep-until-next-second APIs of the DS1307 driver.
+ *
+ * 	> DS1307 1 Hz square wave (SQW/OUT) -> EXTI falling edge wakes the MCU (no busy polling)
+ * 	> SLEEP (WFI, clocks running) or STOP (clocks stopped, run clock restored on wake-up)
+ * 	> Wake-to-ready time measured with the DWT cycle counter
+ *
+ */
+
+#ifndef DS1307_LOWPOWER_H_
+#define DS1307_LOWPOWER_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+#include "stm32f407xx_rcc_drivers.h"
+
+
+/* -- Low-power Modes (@DS1307_LP_MODE) -- */
+#define DS1307_LP_SLEEP			0				// Core stopped, clocks running: wake-up in a few cycles
+#define DS1307_LP_STOP			1				// All clocks stopped, main regulator ON: fast wake-up
+#define DS1307_LP_STOP_LPDS		2				// All clocks stopped, low-power regulator: lowest current
+
+/* -- Wake-up Statistics -- */
+typedef struct
+{
+	uint32_t TickCount;				// SQW ticks (seconds) waited for
+	uint32_t WakeCount;				// Wake-ups (SQW ticks and any other interrupt)
+	uint32_t LastWakeCycles;			// DWT cycles from wake-up (WFI return) to ready
+	uint32_t LastWakeUs;				// The same in microseconds
+	uint32_t MaxWakeUs;				// Worst wake-to-ready time since DS1307_LowPower_Init
+	uint32_t ClockErrors;				// Run clock not restored after STOP (HSI 16 MHz used instead)
+	uint8_t  LastClockError;			// @RCC_STATUS of the last failure
+
+}DS1307_LP_Stats_t;
+
+
+/* -- APIs Supported by DS1307_LowPower -- */
+
+// To set up the 1 Hz SQW wake-up source and the low-power mode (returns 0 on success)
+uint8_t DS1307_LowPower_Init(uint8_t Mode, const RCC_ClockConfig_t *pRunClock);
+
+// To sleep until the next SQW tick (next second), clocks restored on return
+void DS1307_LowPower_WaitForTick(void);
+
+// To get the wake-up statistics
+void DS1307_LowPower_GetStats(DS1307_LP_Stats_t *pStats);
+
+
+#endif /* DS1307_LOWPOWER_H_ */
@@ -6,6 +6,8 @@
  */
 
 #include "DS1307_RTC.h"
+#include "bcd_codec.h"
+#include "stm32f407xx_rcc_drivers.h"
 
 #include<stdint.h>
 #include<string.h>
@@ -13,23 +15,81 @@
 // I2C Global Handle Variable
 I2C_Handle_t DS1307_I2CHandle;
 
+// Days before each month (non-leap year), index = month - 1
+static const uint16_t DaysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
 /* --Helper Functions-- */
 static void DS1307_I2C_PinConfig(void);
 static void DS1307_I2C_Config(void);
-static void DS1307_Write(uint8_t value, uint8_t RegAddress);
-static uint8_t DS1307_Read(uint8_t RegAddress);
-static uint8_t Binary_to_BCD(uint8_t value);
-static uint8_t BCD_to_Binary(uint8_t value);
+static uint8_t DS1307_Write(uint8_t value, uint8_t RegAddress);
+static uint8_t DS1307_Read(uint8_t RegAddress, uint8_t *pValue);
+static uint8_t DS1307_Encode_Hours(uint8_t hours, uint8_t timeFormat);
+__RAMFUNC static uint8_t DS1307_Decode_Hours(uint8_t value, uint8_t *pTimeFormat);
+static uint8_t DS1307_Check_Timekeeper(const uint8_t *pRegs);
+static uint8_t DS1307_Read_Timekeeper(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime);
+static void DS1307_ClockChanged(void);
 
 /* ------------------------------------------------------------------------------------------------------
  * Name		:	DS1307_Init
  * Description	:	To initialize the DS1307 RTC
  *
  * Parameter 1	:	none (void)
- * Return Type	:	uint8_t ()
- * Note		:	if returns 0, meaning CH is SET (Clock halt is removed, clock is enabled).
+ * Return Type	:	uint8_t @DS1307_INIT_STATUS
+ * Note		:	Non-destructive: a running clock is never written (no lost seconds). Common case
+ *			(clock running): one I2C transfer, the burst read of the time-keeper registers.
+ *			DS1307_INIT_RESTARTED and DS1307_INIT_TIME_INVALID: the clock runs, the time MUST be set.
  * ------------------------------------------------------------------------------------------------------ */
 uint8_t DS1307_Init(void)
+{
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+
+	/* -Step 1 to 3. Initialize I2C Pins and Peripheral, enable I2C Peripheral- */
+	DS1307_Attach();
+
+	/* -Step 4. Seconds to Year in one transfer (no answer: stuck bus or no DS1307)- */
+	if (DS1307_Read_Burst(DS1307_SECONDS_ADDR, regs, BCD_TIMEKEEPER_LEN) != 0)
+	{
+		return DS1307_INIT_ERR_BUS;
+	}
+
+	/* -Step 5. CH cleared: the oscillator is running, nothing to write- */
+	if (!(regs[DS1307_SECONDS_ADDR] & (1 << DS1307_SECONDS_CH)))
+	{
+		return DS1307_Check_Timekeeper(regs) ? DS1307_INIT_OK : DS1307_INIT_TIME_INVALID;
+	}
+
+	/* -Step 6. CH set (first power-up, battery lost): restart the oscillator, seconds kept- */
+	if (DS1307_Write(regs[DS1307_SECONDS_ADDR] & ~(1 << DS1307_SECONDS_CH), DS1307_SECONDS_ADDR) != 0)
+	{
+		return DS1307_INIT_ERR_BUS;
+	}
+
+	/* -Step 7. Ensure CH bit is Cleared (Clock is Enabled)- */
+	if (DS1307_Read(DS1307_SECONDS_ADDR, &regs[DS1307_SECONDS_ADDR]) != 0)
+	{
+		return DS1307_INIT_ERR_BUS;
+	}
+
+	if (regs[DS1307_SECONDS_ADDR] & (1 << DS1307_SECONDS_CH))
+	{
+		return DS1307_INIT_ERR_HALTED;
+	}
+
+	return DS1307_INIT_RESTARTED;
+}
+
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Attach
+ * Description	:	To set up the I2C pins and peripheral used by the DS1307
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	No DS1307 register is accessed: the time keeping is not disturbed.
+ *			Used alone when the DS1307 is known to be running (warm reset, see DS1307_Boot.h).
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Attach(void)
 {
 	/* -Step 1. Initialize I2C Pins- */
 	DS1307_I2C_PinConfig();
@@ -39,24 +99,9 @@ uint8_t DS1307_Init(void)
 
 	/* -Step 3. Enable I2C Peripheral- */
 	I2C_PeripheralControl(DS1307_I2C_Peripheral, ENABLE);
-
-	/* -Step 4. Enable Time-keeper Registers of DS1307 (Disabled by default)- */
-	/*
-	 * Address: 0x00 [Seconds Register]
-	 * Bit[7] : CH (Clock halt)
-	 * Write 0 to Enable clock
-	 * */
-	DS1307_Write(0x00, DS1307_SECONDS_ADDR);
-
-	/* -Step 5. Ensure CH bit is Cleared (Clock is Enabled)- */
-	uint8_t CH_State = DS1307_Read(DS1307_SECONDS_ADDR);
-
-	/* -Step 6. Return CH State (>> 7 because 7th Bit in Time-Keeper Register)- */
-	return ((CH_State >> 7) & 0x1);
 }
 
 
-
 /* ------------------------------------------------------------------------------------------------------
  * Name		:	DS1307_Set_Current_Time
  * Description	:	To set the current time
@@ -72,7 +117,7 @@ void DS1307_Set_Current_Time(RTC_Time_h *pRTCTimehandle)
 	uint8_t seconds;
 
 	// a. Convert User inputed value into BCD format
-	seconds = Binary_to_BCD(pRTCTimehandle->seconds);
+	seconds = BCD_Encode(pRTCTimehandle->seconds);
 
 	// b. Make sure 7th bit is Cleared (CH) [if 1, Clock is Halted]
 	seconds &= ~(1 << 7);
@@ -85,70 +130,19 @@ void DS1307_Set_Current_Time(RTC_Time_h *pRTCTimehandle)
 	uint8_t minutes;
 
 	// a. Convert User inputed value into BCD format
-	minutes = Binary_to_BCD(pRTCTimehandle->minutes);
+	minutes = BCD_Encode(pRTCTimehandle->minutes);
 
 	// b. Write into DS1307 Seconds Register
 	DS1307_Write(minutes, DS1307_MINUTES_ADDR);
 
 	/* -Step 3. Program Hours- */
 
-	/* [NOTE]
-	 * Bit[6] is defined as 12-Hour(HIGH) or 24-Hours(LOW)
-	 *
-	 * when Bit[6] is HIGH i.e. 12-Hours Mode, Bit[5] is defined as AM/PM bit
-	 * When Bit[5] is HIGH -> PM
-	 *
-	 * In 24-Hour Mode, Bit[5] is the second 10-Hour bit (20 to 23 Hours).
-	 * The Hours value must be re-entered whenever the 12/24-Hour Mode is changed
-	 *
-	 * */
-
 	uint8_t hours;
 
-	// a. Convert User inputed value into BCD format
-	hours = Binary_to_BCD(pRTCTimehandle->hours);
+	// a. Convert User inputed value and Time Format into Hours Register format
+	hours = DS1307_Encode_Hours(pRTCTimehandle->hours, pRTCTimehandle->timeFormat);
 
-	// b. Perform Checks according to [NOTE]
-	if (pRTCTimehandle->timeFormat == TIME_FORMAT_24H)
-	{
-		/* -Format is 24 Hours- */
-
-		// a. Clear Bit[6]: Bit[6] is defined as 24-Hours when LOW
-		hours &= ~(1 << 6);
-
-	}
-	else
-	{
-		/* -Format is 12 Hours- */
-
-		// a. SET Bit[6]: Bit[6] is defined as 12-Hour when HIGH
-		hours |= (1 << 6);
-
-		// b. Check for AM or PM
-		if (pRTCTimehandle->timeFormat == TIME_FORMAT_12H_PM)
-		{
-			// PM
-
-			// SET Bit[5]: When HIGH -> PM
-			hours |= (1 << 5);
-
-		}
-		else if (pRTCTimehandle->timeFormat == TIME_FORMAT_12H_AM)
-		{
-			// AM
-
-			// Clear Bit[5]: When LOW -> AM
-			hours &= ~(1 << 5);
-
-		}
-		else
-		{
-			// Nothing
-		}
-
-	}
-
-	// c. Write into DS1307 Hours Register
+	// b. Write into DS1307 Hours Register
 	DS1307_Write(hours, DS1307_HOURS_ADDR);
 
 }
@@ -170,7 +164,7 @@ void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle)
 	uint8_t date;
 
 	// a. Convert User inputed value into BCD format
-	date = Binary_to_BCD(pRTCDatehandle->date);
+	date = BCD_Encode(pRTCDatehandle->date);
 
 	// b. Write into DS1307 Date Register
 	DS1307_Write(date, DS1307_DATE_ADDR);
@@ -180,7 +174,7 @@ void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle)
 	uint8_t day;
 
 	// a. Convert User inputed value into BCD format
-	day = Binary_to_BCD(pRTCDatehandle->day);
+	day = BCD_Encode(pRTCDatehandle->day);
 
 	// b. Write into DS1307 Date Register
 	DS1307_Write(day, DS1307_DAY_ADDR);
@@ -190,7 +184,7 @@ void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle)
 	uint8_t month;
 
 	// a. Convert User inputed value into BCD format
-	month = Binary_to_BCD(pRTCDatehandle->month);
+	month = BCD_Encode(pRTCDatehandle->month);
 
 	// b. Write into DS1307 Date Register
 	DS1307_Write(month, DS1307_MONTH_ADDR);
@@ -200,7 +194,7 @@ void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle)
 	uint8_t year;
 
 	// a. Convert User inputed value into BCD format
-	year = Binary_to_BCD(pRTCDatehandle->year);
+	year = BCD_Encode(pRTCDatehandle->year);
 
 	// b. Write into DS1307 Date Register
 	DS1307_Write(year, DS1307_YEAR_ADDR);
@@ -210,219 +204,447 @@ void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle)
 
 /* ------------------------------------------------------------------------------------------------------
  * Name		:	DS1307_Get_Current_Time
+ * Description	:	To get the current time
+ *
+ * Parameter 1	:	Handle pointer variable
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus, 3: clock halted (CH) or registers out of range)
+ * Note		:	One burst read of the time-keeper registers (see DS1307_Read_Timekeeper).
+ *			Time and date of the same instant: DS1307_Get_Current_DateTime.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Get_Current_Time(RTC_Time_h *pRTCTimehandle)
+{
+	return DS1307_Read_Timekeeper(NULL, pRTCTimehandle);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Get_Current_Date
  * Description	:	To get the current date
  *
  * Parameter 1	:	Handle pointer variable
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus, 3: clock halted (CH) or registers out of range)
+ * Note		:	One burst read of the time-keeper registers (see DS1307_Read_Timekeeper).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Get_Current_Date(RTC_Date_h *pRTCDatehandle)
+{
+	return DS1307_Read_Timekeeper(pRTCDatehandle, NULL);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Get_Current_DateTime
+ * Description	:	To get the current date and time
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus, 3: clock halted (CH) or registers out of range)
+ * Note		:	Both from the same burst read: no roll-over (e.g. 23:59:59 -> 00:00:00) between the time
+ *			and the date, unlike DS1307_Get_Current_Date followed by DS1307_Get_Current_Time.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Get_Current_DateTime(RTC_Date_h *pRTCDatehandle, RTC_Time_h *pRTCTimehandle)
+{
+	return DS1307_Read_Timekeeper(pRTCDatehandle, pRTCTimehandle);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Set_SQW
+ * Description	:	To enable the square-wave output on SQW/OUT
+ *
+ * Parameter 1	:	@DS1307_SQW (1 Hz, 4.096 kHz, 8.192 kHz, 32.768 kHz)
  * Return Type	:	none (void)
- * Note		:	Read from DS1307 Registers [Registers: seconds, minutes, and Hours]
+ * Note		:	Control Register (0x07): SQWE = 1, RS1:RS0 = rate.
+ *			SQW/OUT is open drain: a pull-up is required on the MCU pin.
  * ------------------------------------------------------------------------------------------------------ */
-void DS1307_Get_Current_Time(RTC_Time_h *pRTCTimehandle)
+void DS1307_Set_SQW(uint8_t SQWRate)
 {
-	/* -Step 1. Get Seconds- */
-	uint8_t seconds;
+	DS1307_Write((1 << DS1307_CONTROL_SQWE) | (SQWRate & 0x03), DS1307_CONTROL_ADDR);
+}
 
-	// a. Read from Seconds Register
-	seconds = DS1307_Read(DS1307_SECONDS_ADDR);
 
-	// b. Make sure 7th bit is Cleared (CH) [if 1, Clock is Halted] [NOT required in data]
-	seconds &= ~(1 << 7);
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Set_SQW_Level
+ * Description	:	To disable the square wave and drive SQW/OUT to a static level
+ *
+ * Parameter 1	:	@DS1307_OUT (DS1307_OUT_LOW or DS1307_OUT_HIGH)
+ * Return Type	:	none (void)
+ * Note		:	Control Register (0x07): SQWE = 0, OUT = level.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Set_SQW_Level(uint8_t Level)
+{
+	DS1307_Write(((Level & 0x01) << DS1307_CONTROL_OUT), DS1307_CONTROL_ADDR);
+}
+
 
-	// c. Convert BCD (values from register) to Binary
-	seconds = BCD_to_Binary(seconds);
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Get_Control
+ * Description	:	To read the Control Register (0x07)
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t (OUT, SQWE and RS1:RS0 bits, see DS1307_CONTROL_xxx)
+ * Note		:	0x00 when the DS1307 does not answer.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Get_Control(void)
+{
+	uint8_t control;
 
-	// d. Copy into seconds member element
-	pRTCTimehandle->seconds = seconds;
+	DS1307_Read(DS1307_CONTROL_ADDR, &control);
 
-	/* -Step 2. Get Minutes- */
-	uint8_t minutes;
+	return control;
+}
 
-	// a. Read from Minutes Register
-	minutes = DS1307_Read(DS1307_MINUTES_ADDR);
 
-	// b. Convert BCD (values from register) to Binary
-	minutes = BCD_to_Binary(minutes);
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Read_Burst
+ * Description	:	To read consecutive registers in one I2C transfer
+ *
+ * Parameter 1	:	First Register Address [0x00 to DS1307_LAST_ADDR]
+ * Parameter 2	:	Pointer to the destination buffer
+ * Parameter 3	:	Number of registers
+ * Return Type	:	uint8_t (0: success, 1: out of range, 2: no answer on the bus (@I2C_STATUS error))
+ * Note		:	The DS1307 latches the time-keeper registers at the START of a read, so a burst from
+ *			0x00 is a consistent snapshot (no seconds/minutes roll-over between two registers).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Read_Burst(uint8_t RegAddress, uint8_t *pBuffer, uint8_t Len)
+{
+	if ((Len == 0) || (((uint16_t)RegAddress + Len) > (DS1307_LAST_ADDR + 1)))
+	{
+		return 1;
+	}
 
-	// c. Copy into minutes member element
-	pRTCTimehandle->minutes = minutes;
+	// Send desired address to read, then read 'Len' registers (address pointer auto-increments)
+	if ((I2C_MasterSendData(&DS1307_I2CHandle, &RegAddress, 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI) != I2C_OK) ||
+	    (I2C_MasterReceiveData(&DS1307_I2CHandle, pBuffer, Len, DS1307_I2C_ADDR, I2C_REPEATED_START_DI) != I2C_OK))
+	{
+		return 2;
+	}
 
-	/* -Step 3. Get Hours- */
-	uint8_t hours;
+	return 0;
+}
 
-	// a. Read from Hours Register
-	hours = DS1307_Read(DS1307_HOURS_ADDR);
 
-	// b. Checks for Bit[5]: AM/PM and Bit[6]: Time Format
-	if (hours & (1 << 6))
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Write_Burst
+ * Description	:	To write consecutive registers in one I2C transfer
+ *
+ * Parameter 1	:	First Register Address [0x00 to DS1307_LAST_ADDR]
+ * Parameter 2	:	Pointer to the source buffer
+ * Parameter 3	:	Number of registers
+ * Return Type	:	uint8_t (0: success, 1: out of range, 2: no answer on the bus (@I2C_STATUS error))
+ * Note		:	Writing 0x00 to 0x06 in one transfer sets the whole date and time at once.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Write_Burst(uint8_t RegAddress, const uint8_t *pBuffer, uint8_t Len)
+{
+	uint8_t TxData[DS1307_LAST_ADDR + 2];
+
+	if ((Len == 0) || (((uint16_t)RegAddress + Len) > (DS1307_LAST_ADDR + 1)))
 	{
-		// Bit[6] is SET -> 12-Hour Format
+		return 1;
+	}
 
-		// Check for AM or PM
-		if (hours & (1 << 5))
-		{
-			// Bit[5] is HIGH -> PM
-			pRTCTimehandle->timeFormat = TIME_FORMAT_12H_PM;
-		}
-		else
-		{
-			// Bit[5] is LOW -> AM
-			pRTCTimehandle->timeFormat = TIME_FORMAT_12H_AM;
-		}
+	TxData[0] = RegAddress;		// Send First [Device Requirement (Data sheet)]
+	memcpy(&TxData[1], pBuffer, Len);
 
+	if (I2C_MasterSendData(&DS1307_I2CHandle, TxData, Len + 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI) != I2C_OK)
+	{
+		return 2;
 	}
-	else
+
+	return 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Read_RAM
+ * Description	:	To read the battery-backed RAM
+ *
+ * Parameter 1	:	RAM Offset [0 to DS1307_RAM_SIZE - 1]
+ * Parameter 2	:	Pointer to the destination buffer
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	uint8_t (0: success, 1: out of range)
+ * Note		:	RAM content is kept on VBAT, its power-on value (new battery) is undefined.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Read_RAM(uint8_t Offset, uint8_t *pBuffer, uint8_t Len)
+{
+	if (((uint16_t)Offset + Len) > DS1307_RAM_SIZE)
 	{
-		// Bit[6] is Cleared -> 24-Hour Format
-		pRTCTimehandle->timeFormat = TIME_FORMAT_24H;
+		return 1;
 	}
 
-	// c. Discard Bit[5] and Bit[6] [NOT required in data]
-	hours &= ~(1 << 5);
-	hours &= ~(1 << 6);
+	return DS1307_Read_Burst(DS1307_RAM_ADDR + Offset, pBuffer, Len);
+}
 
-	// d. Convert BCD (values from register) to Binary
-	hours = BCD_to_Binary(hours);
 
-	// d. Copy into Hours member element
-	pRTCTimehandle->hours = hours;
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Write_RAM
+ * Description	:	To write the battery-backed RAM
+ *
+ * Parameter 1	:	RAM Offset [0 to DS1307_RAM_SIZE - 1]
+ * Parameter 2	:	Pointer to the source buffer
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	uint8_t (0: success, 1: out of range)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Write_RAM(uint8_t Offset, const uint8_t *pBuffer, uint8_t Len)
+{
+	if (((uint16_t)Offset + Len) > DS1307_RAM_SIZE)
+	{
+		return 1;
+	}
 
+	return DS1307_Write_Burst(DS1307_RAM_ADDR + Offset, pBuffer, Len);
 }
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	DS1307_Get_Current_Date
- * Description	:	To get the current date
+ * Name		:	DS1307_Get_Epoch
+ * Description	:	To get date and time as seconds since DS1307_EPOCH_YEAR
  *
- * Parameter 1	:	Handle pointer variable
- * Return Type	:	none (void)
- * Note		:	Read from DS1307 Registers [Registers: Date, Day, Month, and year]
+ * Parameter 1	:	Pointer to store the Time Format of the RTC (@TIME_FORMAT), NULL allowed
+ * Return Type	:	uint32_t (seconds since 2000-01-01 00:00:00)
+ * Note		:	DS1307_Read_Epoch without the status: 0 (and 24-Hour Format) when the DS1307 does not
+ *			answer.
  * ------------------------------------------------------------------------------------------------------ */
-void DS1307_Get_Current_Date(RTC_Date_h *pRTCDatehandle)
+uint32_t DS1307_Get_Epoch(uint8_t *pTimeFormat)
 {
-	/* -Step 1. Get Date- */
-	uint8_t date;
+	uint32_t epoch;
 
-	// a. Read from Date Register
-	date = DS1307_Read(DS1307_DATE_ADDR);
+	DS1307_Read_Epoch(&epoch, pTimeFormat);
 
-	// b. Convert BCD (values from register) to Binary
-	date = BCD_to_Binary(date);
+	return epoch;
+}
 
-	// c. Copy into Date member element
-	pRTCDatehandle->date = date;
 
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Read_Epoch
+ * Description	:	To get date and time as seconds since DS1307_EPOCH_YEAR, with the read status
+ *
+ * Parameter 1	:	Pointer to store the seconds since 2000-01-01 00:00:00
+ * Parameter 2	:	Pointer to store the Time Format of the RTC (@TIME_FORMAT), NULL allowed
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus, 3: clock halted (CH) or registers out of range)
+ * Note		:	One burst read of the seven time-keeper registers (see DS1307_Read_Timekeeper).
+ *			Status 2: epoch 0 and 24-Hour Format stored. Status 3: the registers are decoded anyway.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Read_Epoch(uint32_t *pEpoch, uint8_t *pTimeFormat)
+{
+	uint8_t status;
+	RTC_Time_h time;
+	RTC_Date_h date;
 
-	/* -Step 2. Get Day- */
-	uint8_t day;
+	/* -Step 1. Seconds to Year in one transfer, decoded- */
+	status = DS1307_Read_Timekeeper(&date, &time);
+	if (status == 2)
+	{
+		*pEpoch = 0;
+		if (pTimeFormat != NULL)
+		{
+			*pTimeFormat = TIME_FORMAT_24H;
+		}
+		return status;
+	}
 
-	// a. Read from Day Register
-	day = DS1307_Read(DS1307_DAY_ADDR);
+	/* -Step 2. Seconds since DS1307_EPOCH_YEAR- */
+	if (pTimeFormat != NULL)
+	{
+		*pTimeFormat = time.timeFormat;
+	}
 
-	// b. Convert BCD (values from register) to Binary
-	day = BCD_to_Binary(day);
+	*pEpoch = DS1307_DateTime_To_Epoch(&date, &time);
 
-	// c. Copy into Day member element
-	pRTCDatehandle->day = day;
+	return status;
+}
 
 
-	/* -Step 3. Get Month- */
-	uint8_t month;
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Set_Epoch
+ * Description	:	To set date and time from seconds since DS1307_EPOCH_YEAR
+ *
+ * Parameter 1	:	Seconds since 2000-01-01 00:00:00 [0 to DS1307_EPOCH_MAX]
+ * Parameter 2	:	Time Format written to the RTC (@TIME_FORMAT: 24H, or any 12H value for 12-Hour)
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus)
+ * Note		:	One burst write of the seven time-keeper registers, CH stays cleared (clock running).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Set_Epoch(uint32_t Epoch, uint8_t TimeFormat)
+{
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+	RTC_Time_h time;
+	RTC_Date_h date;
 
-	// a. Read from Month Register
-	month = DS1307_Read(DS1307_MONTH_ADDR);
+	DS1307_Epoch_To_DateTime(Epoch, &date, &time, TimeFormat);
 
-	// b. Convert BCD (values from register) to Binary
-	month = BCD_to_Binary(month);
+	regs[DS1307_SECONDS_ADDR] = time.seconds;
+	regs[DS1307_MINUTES_ADDR] = time.minutes;
+	regs[DS1307_HOURS_ADDR] = 0;
+	regs[DS1307_DAY_ADDR] = date.day;
+	regs[DS1307_DATE_ADDR] = date.date;
+	regs[DS1307_MONTH_ADDR] = date.month;
+	regs[DS1307_YEAR_ADDR] = date.year;
 
-	// c. Copy into Month member element
-	pRTCDatehandle->month = month;
+	BCD_EncodeTimekeeper(regs);
+	regs[DS1307_HOURS_ADDR] = DS1307_Encode_Hours(time.hours, time.timeFormat);
 
+	return DS1307_Write_Burst(DS1307_SECONDS_ADDR, regs, BCD_TIMEKEEPER_LEN);
+}
 
-	/* -Step 4. Get Year- */
-	uint8_t year;
 
-	// a. Read from Month Register
-	year = DS1307_Read(DS1307_YEAR_ADDR);
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_DateTime_To_Epoch
+ * Description	:	To convert date and time into seconds since DS1307_EPOCH_YEAR
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h), year 0 to 99
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h), any Time Format
+ * Return Type	:	uint32_t (seconds since 2000-01-01 00:00:00)
+ * Note		:	Pure function (no I2C access). 2000 to 2099: every 4th year is a leap year.
+ *			The day of the week is not used. Runs from SRAM (__RAMFUNC). Month index taken unsigned:
+ *			a month of 0 (blank or garbage register) stays inside the table.
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC uint32_t DS1307_DateTime_To_Epoch(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime)
+{
+	uint32_t days;
+	uint32_t hours = pRTCTime->hours;
 
-	// b. Convert BCD (values from register) to Binary
-	year = BCD_to_Binary(year);
+	/* -Step 1. Days: whole years (one leap day per started 4-year block), months, date- */
+	days = (365U * pRTCDate->year) + ((pRTCDate->year + 3U) / 4U);
+	days += DaysBeforeMonth[(uint8_t)(pRTCDate->month - 1) % 12];
+	if (((pRTCDate->year % 4) == 0) && (pRTCDate->month > 2))
+	{
+		days++;
+	}
+	days += pRTCDate->date - 1U;
 
-	// c. Copy into Year member element
-	pRTCDatehandle->year = year;
+	/* -Step 2. Hours in 24-Hour Format (12 AM is 0, 12 PM is 12)- */
+	if (pRTCTime->timeFormat != TIME_FORMAT_24H)
+	{
+		hours = (hours % 12U) + ((pRTCTime->timeFormat == TIME_FORMAT_12H_PM) ? 12U : 0U);
+	}
 
+	return (((days * 24U) + hours) * 60U + pRTCTime->minutes) * 60U + pRTCTime->seconds;
 }
 
 
-/* --Helper Functions-- */
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	DS1307_I2C_PinConfig
- * Description	:	Helper Functions
+ * Name		:	DS1307_Days_In_Month
+ * Description	:	To get the number of days of a month
  *
- * Parameter 1	:	none (void)
- * Return Type	:	none (void)
- * Note		: To initialize GPIO to behave as I2C Pins (Alternate Functionality)
+ * Parameter 1	:	Month [1 to 12]
+ * Parameter 2	:	Year [0 to 99] (2000 to 2099)
+ * Return Type	:	uint8_t (28 to 31, 0 for a month out of range)
+ * Note		:	Pure function (no I2C access), same calendar table as the epoch conversions: every 4th
+ *			year is a leap year.
  * ------------------------------------------------------------------------------------------------------ */
-static void DS1307_I2C_PinConfig(void)
+uint8_t DS1307_Days_In_Month(uint8_t month, uint8_t year)
 {
-	// GPIO Handle Variables
-	GPIO_Handle_t I2C_SDA;
-	GPIO_Handle_t I2C_SCL;
+	uint16_t next;
 
-	/* -Initialize the handle variable to ZERO, in order to prevent registers to have random values- */
-	memset(&I2C_SDA,0,sizeof(I2C_SDA));
-	memset(&I2C_SCL,0,sizeof(I2C_SCL));
+	if ((month < 1) || (month > 12))
+	{
+		return 0;
+	}
 
+	next = (month == 12) ? 365U : DaysBeforeMonth[month];
 
-	/* -Initialize I2C SDA Line- */
+	return (uint8_t)(next - DaysBeforeMonth[month - 1] + (((month == 2) && ((year % 4) == 0)) ? 1U : 0U));
+}
 
-	// Select Port
-	I2C_SDA.pGPIOx = DS1307_I2C_GPIO_PORT;
 
-	// Pin Configuration: PIN MODE
-	I2C_SDA.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFUNC;
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Epoch_To_DateTime
+ * Description	:	To convert seconds since DS1307_EPOCH_YEAR into date and time
+ *
+ * Parameter 1	:	Seconds since 2000-01-01 00:00:00 [0 to DS1307_EPOCH_MAX]
+ * Parameter 2	:	Handle pointer variable (RTC_Date_h), day of the week included
+ * Parameter 3	:	Handle pointer variable (RTC_Time_h)
+ * Parameter 4	:	Output Time Format (@TIME_FORMAT: 24H, or any 12H value for 12-Hour, AM/PM computed)
+ * Return Type	:	none (void)
+ * Note		:	Pure function (no I2C access). 2000-01-01 was a SATURDAY.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Epoch_To_DateTime(uint32_t Epoch, RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime, uint8_t TimeFormat)
+{
+	uint32_t days = Epoch / 86400U;
+	uint32_t secs = Epoch % 86400U;
+	uint32_t block;
+	uint16_t yearDays;
+	uint8_t month;
+	uint8_t leap;
 
-	// Pin Configuration: Alternate Functionality
-	I2C_SDA.GPIO_PinConfig.GPIO_PinAltFuncMode = 4;	// Alternate Functionality Mode: 4
+	/* -Step 1. Time of the day- */
+	pRTCTime->hours = (uint8_t)(secs / 3600U);
+	pRTCTime->minutes = (uint8_t)((secs / 60U) % 60U);
+	pRTCTime->seconds = (uint8_t)(secs % 60U);
+	pRTCTime->timeFormat = TIME_FORMAT_24H;
 
-	// Pin Configuration: PIN NUMBER
-	I2C_SDA.GPIO_PinConfig.GPIO_PinNumber = DS1307_I2C_SCL_PIN; // Defined in DS1307_RTC.h
+	if (TimeFormat != TIME_FORMAT_24H)
+	{
+		pRTCTime->timeFormat = (pRTCTime->hours >= 12) ? TIME_FORMAT_12H_PM : TIME_FORMAT_12H_AM;
+		pRTCTime->hours = (pRTCTime->hours % 12) ? (pRTCTime->hours % 12) : 12;
+	}
 
-	// Pin Configuration: Output Type
-	I2C_SDA.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_OD;	// Open Drain
+	/* -Step 2. Day of the week (SUNDAY = 1)- */
+	pRTCDate->day = (uint8_t)(((days + 6U) % 7U) + 1U);
 
-	// Pin Configuration: Internal Pull-up/down
-	I2C_SDA.GPIO_PinConfig.GPIO_PinPuPdControl = DS1307_I2C_PUPD; // Defined in DS1307_RTC.h
+	/* -Step 3. Year: 4-year blocks of 1461 days (leap year first), then years in the block- */
+	block = days / 1461U;
+	days %= 1461U;
+	pRTCDate->year = (uint8_t)(block * 4U);
 
-	// Pin Configuration: Pin Speed
-	I2C_SDA.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_VERY_HIGH;
+	if (days >= 366U)
+	{
+		days -= 366U;
+		pRTCDate->year += (uint8_t)(1U + (days / 365U));
+		days %= 365U;
+	}
 
-	/* -Configure GPIO as I2Cx_SDA- */
-	GPIO_Init(&I2C_SDA);
+	/* -Step 4. Month and date- */
+	leap = ((pRTCDate->year % 4) == 0);
 
-	/* -Initialize I2C SCL Line- */
+	for (month = 12; month > 1; month--)
+	{
+		yearDays = DaysBeforeMonth[month - 1] + ((leap && (month > 2)) ? 1 : 0);
+		if (days >= yearDays)
+		{
+			break;
+		}
+	}
 
-	// Select Port
-	I2C_SCL.pGPIOx = DS1307_I2C_GPIO_PORT;
+	pRTCDate->month = month;
+	pRTCDate->date = (uint8_t)(days - DaysBeforeMonth[month - 1] - ((leap && (month > 2)) ? 1 : 0) + 1U);
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_I2C_PinConfig
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: To initialize GPIO to behave as I2C Pins (Alternate Functionality)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_I2C_PinConfig(void)
+{
+	// GPIO Pin Configuration (same for SDA and SCL)
+	GPIO_PinConfig_t I2C_Pins;
+
+	/* -Initialize the configuration variable to ZERO, in order to prevent registers to have random values- */
+	memset(&I2C_Pins,0,sizeof(I2C_Pins));
 
 	// Pin Configuration: PIN MODE
-	I2C_SCL.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFUNC;
+	I2C_Pins.GPIO_PinMode = GPIO_MODE_ALTFUNC;
 
 	// Pin Configuration: Alternate Functionality
-	I2C_SCL.GPIO_PinConfig.GPIO_PinAltFuncMode = 4;	// Alternate Functionality Mode: 4
-
-	// Pin Configuration: PIN NUMBER
-	I2C_SCL.GPIO_PinConfig.GPIO_PinNumber = DS1307_I2C_SDA_PIN; // Defined in DS1307_RTC.h
+	I2C_Pins.GPIO_PinAltFuncMode = 4;	// Alternate Functionality Mode: 4
 
 	// Pin Configuration: Output Type
-	I2C_SCL.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_OD;	// Open Drain
+	I2C_Pins.GPIO_PinOPType = GPIO_OP_TYPE_OD;	// Open Drain
 
 	// Pin Configuration: Internal Pull-up/down
-	I2C_SCL.GPIO_PinConfig.GPIO_PinPuPdControl = DS1307_I2C_PUPD; // Defined in DS1307_RTC.h
+	I2C_Pins.GPIO_PinPuPdControl = DS1307_I2C_PUPD; // Defined in DS1307_RTC.h
 
 	// Pin Configuration: Pin Speed
-	I2C_SCL.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_VERY_HIGH;
+	I2C_Pins.GPIO_PinSpeed = GPIO_SPEED_VERY_HIGH;
 
-	/* -Configure GPIO as I2Cx_SCl- */
-	GPIO_Init(&I2C_SCL);
+	/* -Configure both GPIOs as I2Cx_SDA and I2Cx_SCL at once (one store per GPIO register)- */
+	GPIO_InitMask(DS1307_I2C_GPIO_PORT, GPIO_PIN_MASK(DS1307_I2C_SDA_PIN) | GPIO_PIN_MASK(DS1307_I2C_SCL_PIN), &I2C_Pins);
 
 }
 
@@ -448,20 +670,147 @@ static void DS1307_I2C_Config(void)
 	/* -- Initialize the I2C Peripheral -- */
 	I2C_Init(&DS1307_I2CHandle);
 
+	/* -- Re-time SCL (100 kHz) whenever the APB1 clock changes -- */
+	RCC_RegisterClockListener(DS1307_ClockChanged);
 
 }
 
 
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Check_Timekeeper
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Time-keeper registers, Seconds to Year (BCD_TIMEKEEPER_LEN bytes, raw)
+ * Return Type	:	uint8_t (1: valid date and time, 0: out of range)
+ * Note		: Pure function (no I2C access). BCD digits, field ranges and days per month (leap years).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Check_Timekeeper(const uint8_t *pRegs)
+{
+	// Minimum and maximum (binary) of each field, hours checked apart (format dependent)
+	static const uint8_t fieldMin[BCD_TIMEKEEPER_LEN] = {0, 0, 0, 1, 1, 1, 0};
+	static const uint8_t fieldMax[BCD_TIMEKEEPER_LEN] = {59, 59, 23, 7, 31, 12, 99};
+	uint8_t value;
+	uint8_t timeFormat;
+
+	for (uint8_t i = 0; i < BCD_TIMEKEEPER_LEN; i++)
+	{
+		// a. Control bits out (CH, 12/24, AM/PM)
+		value = pRegs[i];
+		if (i == DS1307_SECONDS_ADDR)
+		{
+			value &= 0x7F;
+		}
+		else if (i == DS1307_HOURS_ADDR)
+		{
+			value &= (value & (1 << 6)) ? 0x1F : 0x3F;
+		}
+
+		// b. Both digits 0 to 9
+		if (((value & 0x0F) > 9) || ((value >> 4) > 9))
+		{
+			return 0;
+		}
+
+		// c. Field range
+		value = BCD_Decode(value);
+		if ((value < fieldMin[i]) || (value > fieldMax[i]))
+		{
+			return 0;
+		}
+	}
+
+	// d. Date within the month (e.g. no 31 February)
+	if (BCD_Decode(pRegs[DS1307_DATE_ADDR]) > DS1307_Days_In_Month(BCD_Decode(pRegs[DS1307_MONTH_ADDR]),
+		BCD_Decode(pRegs[DS1307_YEAR_ADDR])))
+	{
+		return 0;
+	}
+
+	// e. 12-Hour Format: 1 to 12
+	value = DS1307_Decode_Hours(pRegs[DS1307_HOURS_ADDR], &timeFormat);
+
+	return (timeFormat == TIME_FORMAT_24H) || ((value >= 1) && (value <= 12));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Read_Timekeeper
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h), NULL: date not stored
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h), NULL: time not stored
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus, 3: clock halted (CH) or registers out of range)
+ * Note		: One burst read of Seconds to Year (consistent snapshot), decoded with BCD_DecodeTimekeeper.
+ *		  Status 2: nothing stored. Status 3: the registers are decoded anyway.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Read_Timekeeper(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime)
+{
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+	uint8_t hoursReg;
+	uint8_t status = 0;
+
+	/* -Step 1. Seconds to Year in one transfer- */
+	if (DS1307_Read_Burst(DS1307_SECONDS_ADDR, regs, BCD_TIMEKEEPER_LEN) != 0)
+	{
+		return 2;
+	}
+
+	if ((regs[DS1307_SECONDS_ADDR] & (1 << DS1307_SECONDS_CH)) || !DS1307_Check_Timekeeper(regs))
+	{
+		status = 3;
+	}
+
+	/* -Step 2. Hours keep their control bits (own decoder), CH is masked, the rest is decoded at once- */
+	hoursReg = regs[DS1307_HOURS_ADDR];
+	regs[DS1307_SECONDS_ADDR] &= 0x7F;
+	regs[DS1307_HOURS_ADDR] = 0;
+	BCD_DecodeTimekeeper(regs);
+
+	/* -Step 3. Copy into the member elements- */
+	if (pRTCTime != NULL)
+	{
+		pRTCTime->seconds = regs[DS1307_SECONDS_ADDR];
+		pRTCTime->minutes = regs[DS1307_MINUTES_ADDR];
+		pRTCTime->hours = DS1307_Decode_Hours(hoursReg, &pRTCTime->timeFormat);
+	}
+
+	if (pRTCDate != NULL)
+	{
+		pRTCDate->day = regs[DS1307_DAY_ADDR];
+		pRTCDate->date = regs[DS1307_DATE_ADDR];
+		pRTCDate->month = regs[DS1307_MONTH_ADDR];
+		pRTCDate->year = regs[DS1307_YEAR_ADDR];
+	}
+
+	return status;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_ClockChanged
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: RCC clock-change listener: recomputes FREQ/CCR/TRISE of the DS1307 I2C peripheral, so SCL
+ *		  stays at or below 100 kHz at every operating point (deferred if a transfer is running).
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_ClockChanged(void)
+{
+	I2C_UpdateTiming(&DS1307_I2CHandle);
+}
+
+
 /* ------------------------------------------------------------------------------------------------------
  * Name		:	DS1307_Write
  * Description	:	Helper Functions
  *
  * Parameter 1	:	Value to be written (uint8_t)
  * Parameter 2	:	Register Address (where to write) (uint8_t)
- * Return Type	:	none (void)
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus (@I2C_STATUS error))
  * Note		: To write into DS1307 Registers
  * ------------------------------------------------------------------------------------------------------ */
-static void DS1307_Write(uint8_t value, uint8_t RegAddress)
+static uint8_t DS1307_Write(uint8_t value, uint8_t RegAddress)
 {
 	uint8_t TxData[2];
 
@@ -469,7 +818,12 @@ static void DS1307_Write(uint8_t value, uint8_t RegAddress)
 	TxData[1] = value;
 
 	// I2C Send Data
-	I2C_MasterSendData(&DS1307_I2CHandle, TxData,2,DS1307_I2C_ADDR,I2C_REPEATED_START_DI);
+	if (I2C_MasterSendData(&DS1307_I2CHandle, TxData,2,DS1307_I2C_ADDR,I2C_REPEATED_START_DI) != I2C_OK)
+	{
+		return 2;
+	}
+
+	return 0;
 
 }
 
@@ -480,12 +834,13 @@ static void DS1307_Write(uint8_t value, uint8_t RegAddress)
  * Description	:	Helper Functions
  *
  * Parameter 1	:	Register Address (where to read) (uint8_t)
- * Return Type	:	register value (uint8_t)
- * Note		: To read from DS1307 Registers
+ * Parameter 2	:	Pointer to store the register value (uint8_t *)
+ * Return Type	:	uint8_t (0: success, 2: no answer on the bus (@I2C_STATUS error))
+ * Note		: To read from DS1307 Registers (0x00 stored when the DS1307 does not answer)
  * ------------------------------------------------------------------------------------------------------ */
-static uint8_t DS1307_Read(uint8_t RegAddress)
+static uint8_t DS1307_Read(uint8_t RegAddress, uint8_t *pValue)
 {
-	uint8_t RxData;
+	*pValue = 0;
 	/*
 	 * Slave (DS1307) will start transmitting data from the memory location pointed by its current address pointer.
 	 * > Before reading data, initialize the address pointer to desired address (from where to read)
@@ -495,77 +850,107 @@ static uint8_t DS1307_Read(uint8_t RegAddress)
 	 * */
 
 	// Send desired address to read
-	I2C_MasterSendData(&DS1307_I2CHandle, &RegAddress, 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI);
+	if (I2C_MasterSendData(&DS1307_I2CHandle, &RegAddress, 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI) != I2C_OK)
+	{
+		return 2;
+	}
 
 	// I2C Read
-	I2C_MasterReceiveData(&DS1307_I2CHandle, &RxData, 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI);
+	if (I2C_MasterReceiveData(&DS1307_I2CHandle, pValue, 1, DS1307_I2C_ADDR, I2C_REPEATED_START_DI) != I2C_OK)
+	{
+		*pValue = 0;
+		return 2;
+	}
 
-	return RxData;
+	return 0;
 
 }
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	Binary_to_BCD
+ * Name		:	DS1307_Encode_Hours
  * Description	:	Helper Functions
  *
- * Parameter 1	:	value (uint8_t)
- * Return Type	:	BCD equivalent of provided binary value.(uint8_t)
- * Note		:	Converts Binary values the user provides into BCD for writing into DS1307 Registers.
+ * Parameter 1	:	hours (binary) (uint8_t)
+ * Parameter 2	:	Time Format (@TIME_FORMAT) (uint8_t)
+ * Return Type	:	Hours Register value (uint8_t)
+ * Note		:	Pure function (no I2C access), 1 to 12 in 12-Hour Format and 0 to 23 in 24-Hour Format.
  * ------------------------------------------------------------------------------------------------------ */
-static uint8_t Binary_to_BCD(uint8_t value)
+static uint8_t DS1307_Encode_Hours(uint8_t hours, uint8_t timeFormat)
 {
-	/*
-	 * BCD[x] | BCD[y] = value
+	/* [NOTE]
+	 * Bit[6] is defined as 12-Hour(HIGH) or 24-Hours(LOW)
+	 *
+	 * when Bit[6] is HIGH i.e. 12-Hours Mode, Bit[5] is defined as AM/PM bit
+	 * When Bit[5] is HIGH -> PM
+	 *
+	 * In 24-Hour Mode, Bit[5] is the second 10-Hour bit (20 to 23 Hours).
+	 * The Hours value must be re-entered whenever the 12/24-Hour Mode is changed
 	 *
 	 * */
-	uint8_t x;
-	uint8_t y;
-	uint8_t BCD;
 
-	if (value >= 10)
-	{
-		// a. Split the digits: example 10 -> [1][0]
-		x = value / 10;		// Integer division
-		y = value % 10;
+	// a. Convert User inputed value into BCD format
+	uint8_t value = BCD_Encode(hours);
 
-		// b.
-		BCD = (uint8_t) ((x << 4) | (y));
+	// b. Perform Checks according to [NOTE]
+	if (timeFormat == TIME_FORMAT_24H)
+	{
+		// Clear Bit[6]: Bit[6] is defined as 24-Hours when LOW
+		value &= ~(1 << 6);
 	}
 	else
 	{
-		// BCD is equals to value
-		BCD = value;
+		// SET Bit[6]: Bit[6] is defined as 12-Hour when HIGH
+		value |= (1 << 6);
+
+		if (timeFormat == TIME_FORMAT_12H_PM)
+		{
+			// SET Bit[5]: When HIGH -> PM
+			value |= (1 << 5);
+		}
+		else
+		{
+			// Clear Bit[5]: When LOW -> AM
+			value &= ~(1 << 5);
+		}
 	}
 
-	return BCD;
+	return value;
 
 }
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	BCD_to_Binary
+ * Name		:	DS1307_Decode_Hours
  * Description	:	Helper Functions
  *
- * Parameter 1	:	value (uint8_t)
- * Return Type	:	Binary equivalent of provided BCD value.(uint8_t)
- * Note		:	Converts BCD values (returned by I2C Read operation) from DS1307 Registers into Binary format.
+ * Parameter 1	:	Hours Register value (uint8_t)
+ * Parameter 2	:	Pointer to store Time Format (@TIME_FORMAT) (uint8_t *)
+ * Return Type	:	hours (binary) (uint8_t)
+ * Note		:	Pure function (no I2C access). Inverse of DS1307_Encode_Hours.
+ *			Decode path of every read: runs from SRAM (__RAMFUNC).
  * ------------------------------------------------------------------------------------------------------ */
-static uint8_t BCD_to_Binary(uint8_t value)
+__RAMFUNC static uint8_t DS1307_Decode_Hours(uint8_t value, uint8_t *pTimeFormat)
 {
-	/*
-	 * Binary = (BCD[x] to decimal) + (BCD[y] to decimal)
-	 *
-	 * */
-	uint8_t x;
-	uint8_t y;
-	uint8_t Binary;
+	// a. Checks for Bit[6]: Time Format and Bit[5]: AM/PM
+	if (value & (1 << 6))
+	{
+		// Bit[6] is SET -> 12-Hour Format, Bit[5] HIGH -> PM, LOW -> AM
+		*pTimeFormat = (value & (1 << 5)) ? TIME_FORMAT_12H_PM : TIME_FORMAT_12H_AM;
 
-	x = (uint8_t) ((value >> 4) * 10);
-	y = (value & (uint8_t) 0x0F);			// Mask Bits[7:4] (they are x) and extract bits[3:0] -> y
+		// Discard Bit[5] and Bit[6] [NOT required in data]
+		value &= 0x1F;
+	}
+	else
+	{
+		// Bit[6] is Cleared -> 24-Hour Format
+		*pTimeFormat = TIME_FORMAT_24H;
 
-	Binary = x + y;
+		// Bit[5] is the second 10-Hour bit (20 to 23 Hours): keep it, discard Bit[7:6] only
+		value &= 0x3F;
+	}
 
-	return Binary;
+	// b. Convert BCD (values from register) to Binary
+	return BCD_Decode(value);
 
 }
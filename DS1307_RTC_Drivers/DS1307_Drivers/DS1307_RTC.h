@@ -21,6 +21,9 @@
 #define DS1307_I2C_SCL_PIN		GPIO_Pin_6			// DS1307 SCL is connected to PB6
 #define DS1307_I2C_PUPD			GPIO_PIN_PU			// Internal Pull-Up
 #define DS1307_I2C_SPEED		I2C_SCL_SPEED_SM		// I2C is in Standard Mode (DO NOT CHANGE)
+#define DS1307_SQW_GPIO_PORT		GPIOB				// DS1307 SQW/OUT is connected to GPIO port B
+#define DS1307_SQW_PIN			GPIO_Pin_8			// DS1307 SQW/OUT is connected to PB8 (open drain)
+#define DS1307_SQW_IRQ_NO		IRQ_NO_EXTI5_9			// EXTI IRQ of DS1307_SQW_PIN
 
 
 /* -- Registers Addresses -- */
@@ -34,6 +37,40 @@
 #define DS1307_MONTH_ADDR		0x05
 #define DS1307_YEAR_ADDR		0x06
 
+// Control Register
+#define DS1307_CONTROL_ADDR		0x07
+
+/* -- Seconds Register Bit Positions -- */
+#define DS1307_SECONDS_CH		7				// Clock Halt: oscillator stopped
+
+/* -- Control Register Bit Positions -- */
+#define DS1307_CONTROL_RS0		0				// Rate Select [RS1:RS0]
+#define DS1307_CONTROL_RS1		1
+#define DS1307_CONTROL_SQWE		4				// Square-Wave Enable
+#define DS1307_CONTROL_OUT		7				// Output level when SQWE = 0
+
+// Battery-backed RAM (NVRAM): 56 bytes, offsets 0 to 55
+#define DS1307_RAM_ADDR			0x08
+#define DS1307_RAM_SIZE			56
+#define DS1307_LAST_ADDR		0x3F
+
+/* -- DS1307_Init Status (@DS1307_INIT_STATUS) -- */
+#define DS1307_INIT_OK			0				// Clock was running and time is valid: nothing written
+#define DS1307_INIT_RESTARTED		1				// Oscillator was stopped (CH set): restarted, time NOT valid
+#define DS1307_INIT_TIME_INVALID	2				// Clock running, time-keeper registers out of range
+#define DS1307_INIT_ERR_HALTED		3				// CH still set after the restart (no DS1307 on the bus?)
+#define DS1307_INIT_ERR_BUS		4				// No answer on the I2C bus (I2C_ERR_TIMEOUT, I2C_ERR_NACK)
+
+/* -- Square-Wave Rates (@DS1307_SQW) -- */
+#define DS1307_SQW_1HZ			0				// 1 Hz, falling edge on the seconds update
+#define DS1307_SQW_4KHZ			1				// 4.096 kHz
+#define DS1307_SQW_8KHZ			2				// 8.192 kHz
+#define DS1307_SQW_32KHZ		3				// 32.768 kHz
+
+/* -- SQW/OUT Output Levels (@DS1307_OUT), square wave disabled -- */
+#define DS1307_OUT_LOW			0
+#define DS1307_OUT_HIGH			1				// Released (open drain): pulled up
+
 /* -- Time Format -- */
 #define TIME_FORMAT_12H_AM		0
 #define TIME_FORMAT_12H_PM		1
@@ -48,6 +85,10 @@
 #define FRIDAY				6
 #define SATURDAY			7
 
+/* -- Epoch: seconds since 2000-01-01 00:00:00 (DS1307 years 00 to 99 are 2000 to 2099) -- */
+#define DS1307_EPOCH_YEAR		2000
+#define DS1307_EPOCH_MAX		3155759999U			// 2099-12-31 23:59:59
+
 /* -- Device Address (I2C) -- */
 #define DS1307_I2C_ADDR			0x68
 
@@ -75,16 +116,49 @@ typedef struct
 
 /* -- APIs Supported by DS1307_RTC driver -- */
 
-// To enable DS1307
+// To set up the DS1307 without disturbing a running clock (returns @DS1307_INIT_STATUS)
 uint8_t DS1307_Init(void);
 
+// To set up the I2C pins and peripheral only (DS1307 already running, e.g. after a warm reset)
+void DS1307_Attach(void);
+
 // To initialize: Current Time and Date Information
 void DS1307_Set_Current_Time(RTC_Time_h *pRTCTimehandle);
 void DS1307_Set_Current_Date(RTC_Date_h *pRTCDatehandle);
 
-// To get: the Current Time and Date Information
-void DS1307_Get_Current_Time(RTC_Time_h *pRTCTimehandle);
-void DS1307_Get_Current_Date(RTC_Date_h *pRTCDatehandle);
+// To get: the Current Time and Date Information (one burst read each, 0: success, 2: bus error, 3: halted/invalid)
+uint8_t DS1307_Get_Current_Time(RTC_Time_h *pRTCTimehandle);
+uint8_t DS1307_Get_Current_Date(RTC_Date_h *pRTCDatehandle);
+uint8_t DS1307_Get_Current_DateTime(RTC_Date_h *pRTCDatehandle, RTC_Time_h *pRTCTimehandle);	// Same instant
+
+// To enable the square-wave output on SQW/OUT
+void DS1307_Set_SQW(uint8_t SQWRate);
+
+// To disable the square wave and drive SQW/OUT to a static level
+void DS1307_Set_SQW_Level(uint8_t Level);
+
+// To read the Control Register (0x07)
+uint8_t DS1307_Get_Control(void);
+
+// To read/write consecutive registers in one I2C transfer (returns 0 on success, 1: out of range, 2: bus error)
+uint8_t DS1307_Read_Burst(uint8_t RegAddress, uint8_t *pBuffer, uint8_t Len);
+uint8_t DS1307_Write_Burst(uint8_t RegAddress, const uint8_t *pBuffer, uint8_t Len);
+
+// To read/write the battery-backed RAM (Offset 0 to DS1307_RAM_SIZE - 1, returns 0 on success)
+uint8_t DS1307_Read_RAM(uint8_t Offset, uint8_t *pBuffer, uint8_t Len);
+uint8_t DS1307_Write_RAM(uint8_t Offset, const uint8_t *pBuffer, uint8_t Len);
+
+// To get/set date and time as seconds since DS1307_EPOCH_YEAR (one burst transfer, consistent snapshot)
+uint32_t DS1307_Get_Epoch(uint8_t *pTimeFormat);
+uint8_t DS1307_Read_Epoch(uint32_t *pEpoch, uint8_t *pTimeFormat);	// 0: success, 2: bus error, 3: halted/invalid
+uint8_t DS1307_Set_Epoch(uint32_t Epoch, uint8_t TimeFormat);			// 0: success, 2: bus error
+
+// To convert between date/time and seconds since DS1307_EPOCH_YEAR (no I2C access)
+__RAMFUNC uint32_t DS1307_DateTime_To_Epoch(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime);
+void DS1307_Epoch_To_DateTime(uint32_t Epoch, RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime, uint8_t TimeFormat);
+
+// To get the number of days of a month, leap years included (0 for a month out of range)
+uint8_t DS1307_Days_In_Month(uint8_t month, uint8_t year);
 
 
 #endif /* DS1307_RTC_H_ */
@@ -0,0 +1,359 @@
+/*
+ * 									DS1307_Stream.c
+ *
+ *  This file contains the serial streaming API implementations of the DS1307 driver.
+ *
+ */
+
+#include "DS1307_Stream.h"
+#include "DS1307_Format.h"
+#include "stm32f407xx_gpio_drivers.h"
+#include "stm32f407xx_nvic_drivers.h"
+#include "dlog.h"
+#include "mem_pool.h"
+
+#include<string.h>
+
+// Serial port buffers: mem_pool blocks (SRAM, DMA accessible), pTxBuffer != NULL while the stream runs
+_Static_assert((DS1307_STREAM_TX_SIZE <= MEMPOOL_CLASS3_SIZE) && (DS1307_STREAM_RX_SIZE <= MEMPOOL_CLASS3_SIZE),
+	"DS1307_Stream buffers must fit a block of the memory pool");
+
+static USART_Handle_t streamUSART;
+
+// Selected mode (@DS1307_STREAM_MODE) and statistics
+static uint8_t streamMode = DS1307_STREAM_TEXT;
+static DS1307_Stream_Stats_t streamStats;
+
+/* --Helper Functions-- */
+static void DS1307_Stream_PinConfig(void);
+static void DS1307_Stream_LogSink(const uint8_t *pRecord, uint32_t Len);
+static uint8_t DS1307_Stream_Queue(const void *pData, uint32_t Len);
+static uint8_t DS1307_Stream_FreeBuffers(void);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Init
+ * Description	:	To set up the serial port (DS1307_STREAM_USART) and its DMA streams
+ *
+ * Parameter 1	:	@DS1307_STREAM_MODE
+ * Return Type	:	uint8_t @DS1307_STREAM_STATUS
+ * Note		:	DS1307_Init and MemPool_Init MUST be called first, DLog_Init too for DS1307_STREAM_BINARY.
+ *			8N1 at DS1307_STREAM_BAUD, re-timed by the USART driver after clock changes.
+ *			A running stream is stopped first (DS1307_Stream_DeInit): mode change.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Stream_Init(uint8_t Mode)
+{
+	uint8_t usartIRQ = 0;
+	uint8_t txIRQ = 0;
+	uint8_t rxIRQ = 0;
+
+	if (Mode > DS1307_STREAM_BINARY)
+	{
+		return DS1307_STREAM_ERR_CONFIG;
+	}
+
+	(void)DS1307_Stream_DeInit();
+
+	streamMode = Mode;
+	memset(&streamStats, 0, sizeof(streamStats));
+
+	/* -Step 1. TX/RX buffers from the memory pool- */
+	memset(&streamUSART, 0, sizeof(streamUSART));
+	streamUSART.pTxBuffer = MemPool_Alloc(DS1307_STREAM_TX_SIZE);
+	streamUSART.pRxBuffer = MemPool_Alloc(DS1307_STREAM_RX_SIZE);
+
+	if ((streamUSART.pTxBuffer == NULL) || (streamUSART.pRxBuffer == NULL))
+	{
+		(void)DS1307_Stream_FreeBuffers();
+		return DS1307_STREAM_ERR_MEMORY;
+	}
+
+	/* -Step 2. TX/RX pins in alternate function- */
+	DS1307_Stream_PinConfig();
+
+	/* -Step 3. USART with DMA TX buffer and circular DMA RX- */
+	streamUSART.pUSARTx = DS1307_STREAM_USART;
+	streamUSART.USART_Config.USART_Baud = DS1307_STREAM_BAUD;
+	streamUSART.USART_Config.USART_StopBits = USART_STOPBITS_1;
+	streamUSART.USART_Config.USART_Parity = USART_PARITY_NONE;
+	streamUSART.TxSize = DS1307_STREAM_TX_SIZE;
+	streamUSART.RxSize = DS1307_STREAM_RX_SIZE;
+
+	if (USART_Init(&streamUSART) != USART_OK)
+	{
+		(void)DS1307_Stream_FreeBuffers();
+		return DS1307_STREAM_ERR_CONFIG;
+	}
+
+	/* -Step 4. USART and DMA stream interrupts (handlers at the end of this file)- */
+	USART_GetIRQNumbers(&streamUSART, &usartIRQ, &txIRQ, &rxIRQ);
+	NVIC_SetPriority(usartIRQ, DS1307_STREAM_IRQ_PRIORITY);
+	NVIC_SetPriority(txIRQ, DS1307_STREAM_IRQ_PRIORITY);
+	NVIC_SetPriority(rxIRQ, DS1307_STREAM_IRQ_PRIORITY);
+	NVIC_EnableIRQ(usartIRQ);
+	NVIC_EnableIRQ(txIRQ);
+	NVIC_EnableIRQ(rxIRQ);
+
+	return DS1307_STREAM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_DeInit
+ * Description	:	To stop the serial port and give its buffers back to the memory pool
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_STREAM_STATUS (DS1307_STREAM_ERR_OVERFLOW: a guard word was overwritten)
+ * Note		:	Bytes not on the line yet are lost: DS1307_Stream_Flush first. Nothing done when the
+ *			stream is not running. The other DS1307_Stream APIs drop/return nothing until the next Init.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Stream_DeInit(void)
+{
+	uint8_t usartIRQ = 0;
+	uint8_t txIRQ = 0;
+	uint8_t rxIRQ = 0;
+
+	if (streamUSART.pTxBuffer == NULL)
+	{
+		return DS1307_STREAM_OK;
+	}
+
+	/* -Step 1. Interrupts off, USART and DMA streams stopped (nothing writes to the buffers any more)- */
+	USART_GetIRQNumbers(&streamUSART, &usartIRQ, &txIRQ, &rxIRQ);
+	NVIC_DisableIRQ(usartIRQ);
+	NVIC_DisableIRQ(txIRQ);
+	NVIC_DisableIRQ(rxIRQ);
+	USART_DeInit(&streamUSART);
+
+	/* -Step 2. Buffers back to the pool (guard words checked)- */
+	return DS1307_Stream_FreeBuffers();
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Timestamp
+ * Description	:	To read the DS1307 and queue one timestamp
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_STREAM_STATUS
+ * Note		:	One burst read (date and time consistent). Text: ISO-8601 line copied to the TX
+ *			buffer. Binary: DLOG record with the epoch (seconds since 2000-01-01), sent by
+ *			DS1307_Stream_Service. Returns without waiting for the line in both modes.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Stream_Timestamp(void)
+{
+	char isoBuff[DS1307_ISO8601_STR_LEN + 1];
+	RTC_Date_h date;
+	RTC_Time_h time;
+	uint32_t epoch;
+	uint8_t len;
+
+	epoch = DS1307_Get_Epoch(NULL);
+
+	if (streamMode == DS1307_STREAM_BINARY)
+	{
+		DLOG("DS1307 epoch %lu", epoch);
+		streamStats.Timestamps++;
+		return DS1307_STREAM_OK;
+	}
+
+	DS1307_Epoch_To_DateTime(epoch, &date, &time, TIME_FORMAT_24H);
+	len = DS1307_Format_ISO8601(&date, &time, isoBuff);
+	isoBuff[len++] = '\n';
+
+	if (DS1307_Stream_Queue(isoBuff, len) != DS1307_STREAM_OK)
+	{
+		return DS1307_STREAM_ERR_FULL;
+	}
+	streamStats.Timestamps++;
+
+	return DS1307_STREAM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Service
+ * Description	:	To queue the pending log records (binary mode)
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	Records queued or dropped (uint32_t)
+ * Note		:	Thread context only (single USART_Write producer). Text mode or stream stopped: nothing
+ *			to do (the records stay in the log).
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t DS1307_Stream_Service(void)
+{
+	if ((streamMode != DS1307_STREAM_BINARY) || (streamUSART.pTxBuffer == NULL))
+	{
+		return 0;
+	}
+
+	return DLog_Drain(DS1307_Stream_LogSink);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Flush
+ * Description	:	To wait until the queued bytes are on the line
+ *
+ * Parameter 1	:	Timeout (polling iterations)
+ * Return Type	:	uint8_t (0: done, 1: timeout)
+ * Note		:	Binary mode: the log records are queued first (DS1307_Stream_Service). STOP mode
+ *			halts the USART clock: a transfer running at that time would resume only after wake-up.
+ *			Stream stopped: done.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Stream_Flush(uint32_t Timeout)
+{
+	if (streamUSART.pTxBuffer == NULL)
+	{
+		return 0;
+	}
+
+	(void)DS1307_Stream_Service();
+
+	return USART_Flush(&streamUSART, Timeout);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Read
+ * Description	:	To read the bytes received from the host
+ *
+ * Parameter 1	:	Pointer to the application buffer
+ * Parameter 2	:	Size of the application buffer
+ * Return Type	:	Bytes copied (uint32_t)
+ * Note		:	Bytes older than DS1307_STREAM_RX_SIZE are overwritten: call at least that often.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t DS1307_Stream_Read(uint8_t *pBuffer, uint32_t MaxLen)
+{
+	return USART_Read(&streamUSART, pBuffer, MaxLen);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_GetStats
+ * Description	:	To get the statistics
+ *
+ * Parameter 1	:	Pointer to the statistics
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Stream_GetStats(DS1307_Stream_Stats_t *pStats)
+{
+	*pStats = streamStats;
+	pStats->TxPending = USART_TxPending(&streamUSART);
+	pStats->RxErrors = streamUSART.RxErrors;
+}
+
+
+/* -- Interrupt Handlers of DS1307_STREAM_USART (USART2) and its DMA streams (DMA1 Stream6 TX, Stream5 RX) -- */
+void USART2_IRQHandler(void)
+{
+	USART_IRQHandling(&streamUSART);
+}
+
+void DMA1_Stream6_IRQHandler(void)
+{
+	USART_DMA_TX_IRQHandling(&streamUSART);
+}
+
+void DMA1_Stream5_IRQHandler(void)
+{
+	USART_DMA_RX_IRQHandling(&streamUSART);
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_PinConfig
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: TX push-pull, RX pull-up (idle line high when the host is not connected)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Stream_PinConfig(void)
+{
+	GPIO_Handle_t USART_Pins;
+
+	memset(&USART_Pins, 0, sizeof(USART_Pins));
+	USART_Pins.pGPIOx = DS1307_STREAM_GPIO_PORT;
+	USART_Pins.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFUNC;
+	USART_Pins.GPIO_PinConfig.GPIO_PinAltFuncMode = DS1307_STREAM_AF;
+	USART_Pins.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+	USART_Pins.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_HIGH;
+	USART_Pins.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+
+	USART_Pins.GPIO_PinConfig.GPIO_PinNumber = DS1307_STREAM_TX_PIN;
+	GPIO_Init(&USART_Pins);
+
+	USART_Pins.GPIO_PinConfig.GPIO_PinNumber = DS1307_STREAM_RX_PIN;
+	GPIO_Init(&USART_Pins);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_LogSink
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Record
+ * Parameter 2	:	Record length (bytes)
+ * Return Type	:	none (void)
+ * Note		: DLog_Drain sink: whole records only (a partial record costs the host a resync)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Stream_LogSink(const uint8_t *pRecord, uint32_t Len)
+{
+	if (DS1307_Stream_Queue(pRecord, Len) == DS1307_STREAM_OK)
+	{
+		streamStats.Records++;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_Queue
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Data
+ * Parameter 2	:	Length (bytes)
+ * Return Type	:	uint8_t @DS1307_STREAM_STATUS
+ * Note		: All or nothing: dropped whole (and counted) when the TX buffer has not enough space
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Stream_Queue(const void *pData, uint32_t Len)
+{
+	if ((streamUSART.TxSize - USART_TxPending(&streamUSART)) < Len)
+	{
+		streamStats.Dropped++;
+		return DS1307_STREAM_ERR_FULL;
+	}
+
+	(void)USART_Write(&streamUSART, pData, Len);
+
+	return DS1307_STREAM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Stream_FreeBuffers
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_STREAM_STATUS (DS1307_STREAM_ERR_OVERFLOW: a guard word was overwritten)
+ * Note		: USART and DMA MUST be stopped. The handle is cleared: TxSize 0, every report is dropped.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Stream_FreeBuffers(void)
+{
+	uint8_t status = DS1307_STREAM_OK;
+
+	if ((streamUSART.pTxBuffer != NULL) && (MemPool_Free(streamUSART.pTxBuffer) == MEMPOOL_ERR_OVERFLOW))
+	{
+		status = DS1307_STREAM_ERR_OVERFLOW;
+	}
+	if ((streamUSART.pRxBuffer != NULL) && (MemPool_Free(streamUSART.pRxBuffer) == MEMPOOL_ERR_OVERFLOW))
+	{
+		status = DS1307_STREAM_ERR_OVERFLOW;
+	}
+
+	memset(&streamUSART, 0, sizeof(streamUSART));
+
+	return status;
+}
@@ -0,0 +1,87 @@
+/*
+ * 									DS1307_Stream.h
+ *
+ * This file contains the serial streaming APIs of the DS1307 driver (time reporting over UART).
+ *
+ * 	> DS1307 timestamps (and, in binary mode, the deferred log records) sent on a USART by DMA:
+ * 	  a report is one copy into the TX buffer, the RTC polling never waits for the line
+ * 	> Text mode: one ISO-8601 line per timestamp ("20yy-mm-ddThh:mm:ss\n"), readable on any terminal
+ * 	> Binary mode: timestamps are DLOG records, sent with the other log records (Tools/dlog_decode.py)
+ * 	> Host side: Tools/uart_monitor.py (serial port or pty), checks that the timestamps never go back
+ * 	> Output full: the report is dropped whole (counted), never sent in part
+ * 	> TX/RX buffers are blocks of the memory pool (mem_pool.h, MemPool_Init first): taken by
+ * 	  DS1307_Stream_Init, given back by DS1307_Stream_DeInit, DMA overruns caught by the guard words
+ *
+ */
+
+#ifndef DS1307_STREAM_H_
+#define DS1307_STREAM_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+#include "stm32f407xx_usart_drivers.h"
+
+
+/* -- Serial Port (USART2: PA2 TX, PA3 RX, AF7 - ST-LINK virtual COM port on some boards) -- */
+#define DS1307_STREAM_USART		USART2
+#define DS1307_STREAM_GPIO_PORT		GPIOA
+#define DS1307_STREAM_TX_PIN		GPIO_Pin_2
+#define DS1307_STREAM_RX_PIN		GPIO_Pin_3
+#define DS1307_STREAM_AF		7
+#define DS1307_STREAM_BAUD		USART_BAUD_115200
+
+/* -- Buffers (mem_pool blocks: SRAM, DMA accessible): TX power of 2 -- */
+#define DS1307_STREAM_TX_SIZE		1024
+#define DS1307_STREAM_RX_SIZE		64
+
+/* -- Interrupt Priority (USART and DMA streams: low, only buffer bookkeeping) -- */
+#define DS1307_STREAM_IRQ_PRIORITY	12
+
+/* -- Stream Modes (@DS1307_STREAM_MODE) -- */
+#define DS1307_STREAM_TEXT		0				// ISO-8601 lines
+#define DS1307_STREAM_BINARY		1				// DLOG records (timestamps and log)
+
+/* -- Return Status (@DS1307_STREAM_STATUS) -- */
+#define DS1307_STREAM_OK		0
+#define DS1307_STREAM_ERR_CONFIG	1			// Mode or USART configuration (@USART_STATUS)
+#define DS1307_STREAM_ERR_FULL		2			// Report dropped (TX buffer or log full)
+#define DS1307_STREAM_ERR_MEMORY	3			// No pool block for the TX/RX buffers
+#define DS1307_STREAM_ERR_OVERFLOW	4			// Guard word of a buffer overwritten (DS1307_Stream_DeInit)
+
+/* -- Statistics -- */
+typedef struct
+{
+	uint32_t Timestamps;				// Timestamps queued (text) or logged (binary)
+	uint32_t Records;				// Log records sent (binary, DS1307_Stream_Service)
+	uint32_t Dropped;				// Reports/records dropped (output full)
+	uint32_t TxPending;				// Bytes queued, not on the line yet
+	uint32_t RxErrors;				// Overrun, framing, noise errors (USART)
+
+}DS1307_Stream_Stats_t;
+
+
+/* -- APIs Supported by DS1307_Stream -- */
+
+// To set up the serial port and its DMA streams (returns @DS1307_STREAM_STATUS)
+uint8_t DS1307_Stream_Init(uint8_t Mode);
+
+// To stop the serial port and give its buffers back to the pool (returns @DS1307_STREAM_STATUS)
+uint8_t DS1307_Stream_DeInit(void);
+
+// To read the DS1307 and queue one timestamp, no waiting (returns @DS1307_STREAM_STATUS)
+uint8_t DS1307_Stream_Timestamp(void);
+
+// To queue the pending log records (binary mode, from the main loop; returns the records queued)
+uint32_t DS1307_Stream_Service(void);
+
+// To wait until the queued bytes are on the line, e.g. before STOP mode (returns 0: done, 1: timeout)
+uint8_t DS1307_Stream_Flush(uint32_t Timeout);
+
+// To read the bytes received from the host (e.g. commands, returns the bytes copied)
+uint32_t DS1307_Stream_Read(uint8_t *pBuffer, uint32_t MaxLen);
+
+// To get the statistics
+void DS1307_Stream_GetStats(DS1307_Stream_Stats_t *pStats);
+
+
+#endif /* DS1307_STREAM_H_ */
@@ -0,0 +1,383 @@
+/*
+ * 									DS1307_Trim.c
+ *
+ *  This file contains the crystal drift tracking and software trimming API implementations of the DS1307 driver.
+ *
+ *  Fit (coordinates relative to the LAST sync: it is always the sample (0, 0)):
+ *  	x = reference time - last sync reference time [s]
+ *  	y = RTC time without the nudges - reference time [s] (error accumulated since the RTC was set)
+ *  	drift = (n.Sxy - Sx.Sy) / (n.Sxx - Sx^2)
+ *  On every sync the new sample is added and all sums are shifted to the new origin, so x and y stay
+ *  small and the 64-bit sums cannot overflow (DS1307_TRIM_MAX_GAP, DS1307_TRIM_MAX_SAMPLES).
+ *
+ */
+
+#include "DS1307_Trim.h"
+#include "crc16.h"
+
+#include<stddef.h>
+#include<string.h>
+
+/* -- NVRAM Record Identification -- */
+#define DS1307_TRIM_MAGIC		0x1307U
+#define DS1307_TRIM_VERSION		1U
+
+/* -- Drift Tracking State (NVRAM record, CRC-16 over all the bytes before 'Crc') -- */
+typedef struct
+{
+	int64_t Sx;					// Weighted sums of the fit
+	int64_t Sy;
+	int64_t Sxx;
+	int64_t Sxy;
+	uint32_t SyncEpoch;				// Reference time of the last sync (fit origin)
+	int32_t Nudged;					// Seconds removed from the RTC since the last sync
+	int32_t DriftPPB;				// Last fitted drift (kept when the fit restarts)
+	uint16_t Magic;
+	uint8_t Version;
+	uint8_t Count;					// Sample weight
+	uint16_t Reserved;
+	uint16_t Crc;
+
+}DS1307_Trim_State_t;
+
+// Stored up to 'Crc': the tail padding of the 8-byte aligned structure is not written to NVRAM
+_Static_assert((offsetof(DS1307_Trim_State_t, Crc) + sizeof(uint16_t)) == DS1307_TRIM_RAM_LEN, "DS1307_TRIM_RAM_LEN does not match the NVRAM record");
+_Static_assert(DS1307_TRIM_RAM_END <= DS1307_RAM_SIZE, "DS1307 Trim state does not fit in NVRAM");
+
+// Working copy of the NVRAM record
+static DS1307_Trim_State_t trimState;
+
+/* --Helper Functions-- */
+static void DS1307_Trim_Save(void);
+static void DS1307_Trim_Restart(void);
+static void DS1307_Trim_AddSample(int64_t x, int64_t y);
+static int32_t DS1307_Trim_Ratio(int64_t Num, int64_t Den, int64_t Scale);
+static int64_t DS1307_Trim_PendingMs(uint32_t RtcEpoch);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Init
+ * Description	:	To load the drift state from NVRAM
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_TRIM_STATUS (DS1307_TRIM_OK or DS1307_TRIM_NEW)
+ * Note		:	DS1307_Init MUST be called first. An invalid record (new battery, other layout) is
+ *			replaced by an empty fit: the drift is known again after two syncs.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Trim_Init(void)
+{
+	DS1307_Read_RAM(DS1307_TRIM_RAM_OFFSET, (uint8_t *)&trimState, DS1307_TRIM_RAM_LEN);
+
+	if ((trimState.Magic == DS1307_TRIM_MAGIC) && (trimState.Version == DS1307_TRIM_VERSION) &&
+		(trimState.Crc == CRC16_Compute(&trimState, offsetof(DS1307_Trim_State_t, Crc), CRC16_INIT)))
+	{
+		return DS1307_TRIM_OK;
+	}
+
+	DS1307_Trim_Reset();
+
+	return DS1307_TRIM_NEW;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Sync
+ * Description	:	To record a sync with a reference time
+ *
+ * Parameter 1	:	Reference time (seconds since DS1307_EPOCH_YEAR), e.g. from the network
+ * Return Type	:	none (void)
+ * Note		:	Steps: RTC read, sample added, drift fitted, RTC set to the reference (its Time
+ *			Format is kept), state saved in NVRAM.
+ *			The first sync, a sync going back in time, after DS1307_TRIM_MAX_GAP or with an error
+ *			above DS1307_TRIM_MAX_PPM (+1 s resolution) restarts the fit (the last drift is kept and
+ *			applied until two new samples are available).
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Trim_Sync(uint32_t RefEpoch)
+{
+	uint8_t timeFormat;
+	uint32_t rtcEpoch = DS1307_Get_Epoch(&timeFormat);
+	int64_t x = (int64_t)RefEpoch - trimState.SyncEpoch;
+	int64_t y = ((int64_t)rtcEpoch + trimState.Nudged) - RefEpoch;
+
+	/* -Step 1. Add the sample (or restart) and fit- */
+	if ((trimState.Count == 0) || (x <= 0) || (x > (int64_t)DS1307_TRIM_MAX_GAP) ||
+		((((y > 0) ? y : -y) - 1) * 1000000 > (x * DS1307_TRIM_MAX_PPM)))
+	{
+		DS1307_Trim_Restart();
+	}
+	else
+	{
+		DS1307_Trim_AddSample(x, y);
+	}
+
+	/* -Step 2. RTC set to the reference: new fit origin, no nudge yet- */
+	DS1307_Set_Epoch(RefEpoch, timeFormat);
+	trimState.SyncEpoch = RefEpoch;
+	trimState.Nudged = 0;
+
+	DS1307_Trim_Save();
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Now
+ * Description	:	To get the corrected time
+ *
+ * Parameter 1	:	Pointer to store the milliseconds [0 to 999] (NULL allowed)
+ * Return Type	:	uint32_t (corrected seconds since DS1307_EPOCH_YEAR)
+ * Note		:	One burst read of the RTC. The pending correction (drift since the last sync not yet
+ *			nudged into the registers) is applied in software, with millisecond resolution.
+ *			The milliseconds are those of the correction: the RTC itself counts whole seconds.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t DS1307_Trim_Now(uint16_t *pMs)
+{
+	uint32_t rtcEpoch = DS1307_Get_Epoch(NULL);
+	int64_t nowMs = ((int64_t)rtcEpoch * 1000) - DS1307_Trim_PendingMs(rtcEpoch);
+
+	if (nowMs < 0)
+	{
+		nowMs = 0;
+	}
+
+	if (pMs != NULL)
+	{
+		*pMs = (uint16_t)(nowMs % 1000);
+	}
+
+	return (uint32_t)(nowMs / 1000);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Service
+ * Description	:	To nudge the time-keeper registers when the pending correction reaches 1 s
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @DS1307_TRIM_STATUS (DS1307_TRIM_OK or DS1307_TRIM_NUDGED)
+ * Note		:	Call it periodically (e.g. every minute): at 35 ppm (3 s/day) it nudges every ~8 hours.
+ *			Whole seconds only, written right after a seconds roll-over (polled, blocks up to 1 s)
+ *			so the sub-second phase of the DS1307 is kept. The state is saved after every nudge.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS1307_Trim_Service(void)
+{
+	uint8_t timeFormat;
+	uint8_t seconds;
+	uint8_t previous;
+	uint16_t polls;
+	uint32_t rtcEpoch = DS1307_Get_Epoch(NULL);
+	int64_t pendingMs = DS1307_Trim_PendingMs(rtcEpoch);
+	int32_t nudge;
+
+	if ((pendingMs < DS1307_TRIM_NUDGE_MS) && (pendingMs > -DS1307_TRIM_NUDGE_MS))
+	{
+		return DS1307_TRIM_OK;
+	}
+
+	nudge = (int32_t)(pendingMs / 1000);
+
+	/* -Step 1. Wait for the seconds roll-over (1 register per poll, ~0.4 ms at 100 kHz)- */
+	DS1307_Read_Burst(DS1307_SECONDS_ADDR, &previous, 1);
+	for (polls = 0; polls < 4000; polls++)
+	{
+		DS1307_Read_Burst(DS1307_SECONDS_ADDR, &seconds, 1);
+		if (seconds != previous)
+		{
+			break;
+		}
+	}
+
+	if (seconds == previous)
+	{
+		// Clock halted (CH) or bus stuck: nothing to correct
+		return DS1307_TRIM_OK;
+	}
+
+	/* -Step 2. Burst write of the corrected time, in the Time Format of the RTC- */
+	rtcEpoch = DS1307_Get_Epoch(&timeFormat);
+	if ((((int64_t)rtcEpoch - nudge) < 0) || (((int64_t)rtcEpoch - nudge) > DS1307_EPOCH_MAX))
+	{
+		return DS1307_TRIM_OK;
+	}
+
+	DS1307_Set_Epoch((uint32_t)((int64_t)rtcEpoch - nudge), timeFormat);
+	trimState.Nudged += nudge;
+
+	DS1307_Trim_Save();
+
+	return DS1307_TRIM_NUDGED;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_GetInfo
+ * Description	:	To get the drift tracking information
+ *
+ * Parameter 1	:	Pointer to the information (filled)
+ * Return Type	:	none (void)
+ * Note		:	Reads the RTC (pending correction).
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Trim_GetInfo(DS1307_Trim_Info_t *pInfo)
+{
+	pInfo->DriftPPB = trimState.DriftPPB;
+	pInfo->PendingMs = (int32_t)DS1307_Trim_PendingMs(DS1307_Get_Epoch(NULL));
+	pInfo->NudgedSeconds = trimState.Nudged;
+	pInfo->LastSync = trimState.SyncEpoch;
+	pInfo->Samples = trimState.Count;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Reset
+ * Description	:	To forget the fit and clear the NVRAM state
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	For a new crystal or a new board: the drift is also cleared.
+ * ------------------------------------------------------------------------------------------------------ */
+void DS1307_Trim_Reset(void)
+{
+	memset(&trimState, 0, sizeof(trimState));
+
+	DS1307_Trim_Save();
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Save
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: To write the state (magic, version, CRC) into the DS1307 NVRAM, one burst write
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Trim_Save(void)
+{
+	trimState.Magic = DS1307_TRIM_MAGIC;
+	trimState.Version = DS1307_TRIM_VERSION;
+	trimState.Reserved = 0;
+	trimState.Crc = CRC16_Compute(&trimState, offsetof(DS1307_Trim_State_t, Crc), CRC16_INIT);
+
+	DS1307_Write_RAM(DS1307_TRIM_RAM_OFFSET, (const uint8_t *)&trimState, DS1307_TRIM_RAM_LEN);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Restart
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: To restart the fit with a single sample at the origin (the sync being recorded)
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Trim_Restart(void)
+{
+	trimState.Sx = 0;
+	trimState.Sy = 0;
+	trimState.Sxx = 0;
+	trimState.Sxy = 0;
+	trimState.Count = 1;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_AddSample
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	x: seconds since the last sync (> 0)
+ * Parameter 2	:	y: error accumulated since the last sync [s]
+ * Return Type	:	none (void)
+ * Note		: To add a sample, move the origin onto it and fit the drift
+ *			Shift by (x, y): Sxx' = Sxx - 2x.Sx + n.x^2, Sxy' = Sxy - x.Sy - y.Sx + n.x.y,
+ *			Sx' = Sx - n.x, Sy' = Sy - n.y (sums taken after the sample is added).
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS1307_Trim_AddSample(int64_t x, int64_t y)
+{
+	int64_t n;
+
+	/* -Step 1. Weight limit: halve the sums (older samples count less)- */
+	if (trimState.Count >= DS1307_TRIM_MAX_SAMPLES)
+	{
+		trimState.Sx /= 2;
+		trimState.Sy /= 2;
+		trimState.Sxx /= 2;
+		trimState.Sxy /= 2;
+		trimState.Count /= 2;
+	}
+
+	/* -Step 2. Add the sample- */
+	trimState.Count++;
+	trimState.Sx += x;
+	trimState.Sy += y;
+	trimState.Sxx += x * x;
+	trimState.Sxy += x * y;
+
+	/* -Step 3. Fit: drift [ppb] = (n.Sxy - Sx.Sy) * 1e9 / (n.Sxx - Sx^2)- */
+	n = trimState.Count;
+	trimState.DriftPPB = DS1307_Trim_Ratio((n * trimState.Sxy) - (trimState.Sx * trimState.Sy),
+		(n * trimState.Sxx) - (trimState.Sx * trimState.Sx), 1000000000);
+
+	/* -Step 4. New origin: the sample just added- */
+	trimState.Sxx += (n * x * x) - (2 * x * trimState.Sx);
+	trimState.Sxy += (n * x * y) - (x * trimState.Sy) - (y * trimState.Sx);
+	trimState.Sx -= n * x;
+	trimState.Sy -= n * y;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_Ratio
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Numerator
+ * Parameter 2	:	Denominator (>= 0)
+ * Parameter 3	:	Scale (> 0)
+ * Return Type	:	Num * Scale / Den, saturated to int32_t (0 if Den is 0)
+ * Note		: Fixed point without 128-bit products: Num and Den are halved together until
+ *			Num * Scale fits in 64 bits (the ratio keeps ~30 significant bits)
+ * ------------------------------------------------------------------------------------------------------ */
+static int32_t DS1307_Trim_Ratio(int64_t Num, int64_t Den, int64_t Scale)
+{
+	int64_t result;
+
+	while (((Num > 0) ? Num : -Num) > (INT64_MAX / Scale))
+	{
+		Num /= 2;
+		Den /= 2;
+	}
+
+	if (Den <= 0)
+	{
+		return 0;
+	}
+
+	result = (Num * Scale) / Den;
+
+	if (result > INT32_MAX)
+	{
+		return INT32_MAX;
+	}
+
+	return (result < INT32_MIN) ? INT32_MIN : (int32_t)result;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Trim_PendingMs
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	RTC time (seconds since DS1307_EPOCH_YEAR)
+ * Return Type	:	Correction not yet in the registers [ms] (+: RTC ahead)
+ * Note		: drift x time since the last sync - nudges since the last sync
+ * ------------------------------------------------------------------------------------------------------ */
+static int64_t DS1307_Trim_PendingMs(uint32_t RtcEpoch)
+{
+	int64_t elapsed = (int64_t)RtcEpoch - trimState.SyncEpoch;
+
+	if ((trimState.Count == 0) || (elapsed < 0))
+	{
+		return 0;
+	}
+
+	return ((elapsed * trimState.DriftPPB) / 1000000) - ((int64_t)trimState.Nudged * 1000);
+}
@@ -0,0 +1,72 @@
+/*
+ * 									DS1307_Trim.h
+ *
+ * This file contains the crystal drift tracking and software trimming APIs of the DS1307 driver.
+ *
+ * 	> Every sync records (RTC time, reference time): the drift (ppb) is fitted incrementally
+ * 	  (fixed-point weighted least squares, older samples halved: follows crystal aging)
+ * 	> Corrected time = RTC time - pending correction (drift since the last sync, minus nudges)
+ * 	> When the pending correction reaches 1 s, the time-keeper registers are nudged (burst write)
+ * 	> The fit survives power cycles in the DS1307 battery-backed RAM (magic, version, CRC-16)
+ *
+ * The DS1307 has no calibration register: this is the only way to trim it without extra hardware.
+ *
+ */
+
+#ifndef DS1307_TRIM_H_
+#define DS1307_TRIM_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+
+
+/* -- NVRAM Placement (DS1307_Read_RAM / DS1307_Write_RAM offsets): 0 to 51 reserved, 52 to 55 free -- */
+#define DS1307_TRIM_RAM_OFFSET		0
+#define DS1307_TRIM_RAM_LEN		52				// NVRAM record up to its CRC (checked in DS1307_Trim.c)
+#define DS1307_TRIM_RAM_END		(DS1307_TRIM_RAM_OFFSET + DS1307_TRIM_RAM_LEN)	// First byte left to the application
+
+/* -- Fit Parameters -- */
+#define DS1307_TRIM_MAX_SAMPLES		16				// Sample weight limit: all sums halved when reached
+#define DS1307_TRIM_MAX_GAP		(48UL * 86400UL)		// Syncs further apart restart the fit (64-bit sums)
+#define DS1307_TRIM_NUDGE_MS		1000				// Pending correction that triggers a nudge
+#define DS1307_TRIM_MAX_PPM		500				// Larger errors are not drift (RTC set by hand): fit restarted
+
+/* -- Return Status (@DS1307_TRIM_STATUS) -- */
+#define DS1307_TRIM_OK			0
+#define DS1307_TRIM_NEW			1				// No valid state in NVRAM: fit started from scratch
+#define DS1307_TRIM_NUDGED		2				// DS1307_Trim_Service: time-keeper registers corrected
+
+/* -- Drift Tracking Information -- */
+typedef struct
+{
+	int32_t DriftPPB;				// Fitted drift (+: DS1307 fast), parts per billion
+	int32_t PendingMs;				// Correction not yet applied to the time-keeper registers
+	int32_t NudgedSeconds;				// Nudges since the last sync (+: RTC set back)
+	uint32_t LastSync;				// Reference time of the last sync (seconds since DS1307_EPOCH_YEAR)
+	uint8_t Samples;				// Current sample weight [0 to DS1307_TRIM_MAX_SAMPLES]
+
+}DS1307_Trim_Info_t;
+
+
+/* -- APIs Supported by DS1307_Trim -- */
+
+// To load the drift state from NVRAM (returns @DS1307_TRIM_STATUS)
+uint8_t DS1307_Trim_Init(void);
+
+// To record a sync with a reference time: updates the fit and sets the RTC to the reference
+void DS1307_Trim_Sync(uint32_t RefEpoch);
+
+// To get the corrected time (seconds since DS1307_EPOCH_YEAR and milliseconds)
+uint32_t DS1307_Trim_Now(uint16_t *pMs);
+
+// To nudge the time-keeper registers when the pending correction reaches 1 s (returns @DS1307_TRIM_STATUS)
+uint8_t DS1307_Trim_Service(void);
+
+// To get the drift tracking information
+void DS1307_Trim_GetInfo(DS1307_Trim_Info_t *pInfo);
+
+// To forget the fit (new crystal, new board) and clear the NVRAM state
+void DS1307_Trim_Reset(void);
+
+
+#endif /* DS1307_TRIM_H_ */
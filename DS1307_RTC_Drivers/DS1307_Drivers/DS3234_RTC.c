@@ -0,0 +1,443 @@
+/*
+ * 									DS3234_RTC.c
+ *
+ *  This file contains DS3234 (SPI RTC) driver API implementations.
+ *
+ */
+
+#include "DS3234_RTC.h"
+#include "stm32f407xx_nvic_drivers.h"
+#include "bcd_codec.h"
+
+#include<string.h>
+
+// Global Variable
+SPI_Handle_t DS3234_SPIHandle;
+
+/* --Helper Functions-- */
+static void DS3234_SPI_PinConfig(void);
+static uint8_t DS3234_RAM_Transfer(uint16_t Offset, const uint8_t *pTx, uint8_t *pRx, uint16_t Len);
+static uint8_t DS3234_Encode_Hours(uint8_t hours, uint8_t timeFormat);
+static uint8_t DS3234_Decode_Hours(uint8_t value, uint8_t *pTimeFormat);
+
+// DS3234 backend of the common RTC interface (APIs already in @RTC_STATUS form)
+const RTC_Ops_t DS3234_RTC_Ops =
+{
+	.pName		= "DS3234 (SPI)",
+	.NVRAMSize	= DS3234_SRAM_SIZE,
+	.Init		= DS3234_Init,
+	.GetDateTime	= DS3234_Get_DateTime,
+	.SetDateTime	= DS3234_Set_DateTime,
+	.ReadNVRAM	= DS3234_Read_RAM,
+	.WriteNVRAM	= DS3234_Write_RAM,
+	.SetSQW		= DS3234_Set_SQW,
+};
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Init
+ * Description	:	To initialize the DS3234 RTC
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	Non-destructive: time-keeper registers never written. The oscillator is enabled on
+ *			battery (EOSC cleared) only when it was disabled. RTC_ERR_TIME_INVALID: OSF set (power
+ *			lost or oscillator stopped), cleared by DS3234_Set_DateTime. SPI has no acknowledge:
+ *			registers read as all ones mean no DS3234 (MISO pulled up, nothing driving it).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Init(void)
+{
+	uint8_t txIRQ = 0;
+	uint8_t rxIRQ = 0;
+	uint8_t regs[2];
+
+	/* -Step 1. SPI pins and peripheral (mode 1, DMA streams)- */
+	DS3234_SPI_PinConfig();
+
+	memset(&DS3234_SPIHandle, 0, sizeof(DS3234_SPIHandle));
+	DS3234_SPIHandle.pSPIx = DS3234_SPI_Peripheral;
+	DS3234_SPIHandle.SPI_Config.SPI_MaxHz = DS3234_SPI_MAX_HZ;
+	DS3234_SPIHandle.SPI_Config.SPI_CPOL = SPI_CPOL_LOW;
+	DS3234_SPIHandle.SPI_Config.SPI_CPHA = SPI_CPHA_SECOND;
+	DS3234_SPIHandle.SPI_Config.SPI_DMA = ENABLE;
+	DS3234_SPIHandle.pCSPort = DS3234_SPI_GPIO_PORT;
+	DS3234_SPIHandle.CSPin = DS3234_SPI_CS_PIN;
+
+	if (SPI_Init(&DS3234_SPIHandle) != SPI_OK)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	/* -Step 2. DMA stream interrupts (handlers at the end of this file)- */
+	SPI_GetIRQNumbers(&DS3234_SPIHandle, &txIRQ, &rxIRQ);
+	NVIC_SetPriority(txIRQ, DS3234_DMA_IRQ_PRIORITY);
+	NVIC_SetPriority(rxIRQ, DS3234_DMA_IRQ_PRIORITY);
+	NVIC_EnableIRQ(txIRQ);
+	NVIC_EnableIRQ(rxIRQ);
+
+	/* -Step 3. Control and Status in one transfer- */
+	if ((DS3234_Read_Burst(DS3234_CONTROL_ADDR, regs, 2) != RTC_OK) || ((regs[0] & regs[1]) == 0xFF))
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	/* -Step 4. Oscillator kept running on battery- */
+	if (regs[0] & (1 << DS3234_CONTROL_EOSC))
+	{
+		regs[0] &= ~(1 << DS3234_CONTROL_EOSC);
+		DS3234_Write_Burst(DS3234_CONTROL_ADDR, &regs[0], 1);
+	}
+
+	return (regs[1] & (1 << DS3234_STATUS_OSF)) ? RTC_ERR_TIME_INVALID : RTC_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Read_Burst / DS3234_Write_Burst
+ * Description	:	To read/write consecutive registers in one SPI transfer
+ *
+ * Parameter 1	:	First register address [0x00 to 0x19]
+ * Parameter 2	:	Buffer
+ * Parameter 3	:	Number of registers
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	Polled: a few bytes at 4 MHz take less time than a DMA set-up. The address byte
+ *			selects read (bit 7 cleared) or write (bit 7 set), the address then increments.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Read_Burst(uint8_t RegAddress, uint8_t *pBuffer, uint8_t Len)
+{
+	uint8_t status;
+
+	if ((RegAddress + Len) > (DS3234_SRAM_DATA_ADDR + 1))
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	SPI_ChipSelect(&DS3234_SPIHandle, ENABLE);
+	status = SPI_Transfer(&DS3234_SPIHandle, &RegAddress, NULL, 1);
+	if (status == SPI_OK)
+	{
+		status = SPI_Transfer(&DS3234_SPIHandle, NULL, pBuffer, Len);
+	}
+	SPI_ChipSelect(&DS3234_SPIHandle, DISABLE);
+
+	return (status == SPI_OK) ? RTC_OK : RTC_ERR_DEVICE;
+}
+
+uint8_t DS3234_Write_Burst(uint8_t RegAddress, const uint8_t *pBuffer, uint8_t Len)
+{
+	uint8_t address = RegAddress | DS3234_WRITE;
+	uint8_t status;
+
+	if ((RegAddress + Len) > (DS3234_SRAM_DATA_ADDR + 1))
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	SPI_ChipSelect(&DS3234_SPIHandle, ENABLE);
+	status = SPI_Transfer(&DS3234_SPIHandle, &address, NULL, 1);
+	if (status == SPI_OK)
+	{
+		status = SPI_Transfer(&DS3234_SPIHandle, pBuffer, NULL, Len);
+	}
+	SPI_ChipSelect(&DS3234_SPIHandle, DISABLE);
+
+	return (status == SPI_OK) ? RTC_OK : RTC_ERR_DEVICE;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Get_DateTime
+ * Description	:	To get date and time
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	One burst read of the seven time-keeper registers (the DS3234 latches them at the
+ *			start of the transfer: consistent snapshot), decoded with BCD_DecodeTimekeeper.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Get_DateTime(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime)
+{
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+	uint8_t hoursReg;
+
+	if (DS3234_Read_Burst(DS3234_SECONDS_ADDR, regs, BCD_TIMEKEEPER_LEN) != RTC_OK)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	/* -Step 1. Hours keep their control bits (own decoder), Century masked, the rest decoded at once- */
+	hoursReg = regs[DS3234_HOURS_ADDR];
+	regs[DS3234_HOURS_ADDR] = 0;
+	regs[DS3234_MONTH_ADDR] &= ~(1 << DS3234_MONTH_CENTURY);
+	BCD_DecodeTimekeeper(regs);
+
+	pRTCTime->seconds = regs[DS1307_SECONDS_ADDR];
+	pRTCTime->minutes = regs[DS1307_MINUTES_ADDR];
+	pRTCTime->hours = DS3234_Decode_Hours(hoursReg, &pRTCTime->timeFormat);
+	pRTCDate->day = regs[DS1307_DAY_ADDR];
+	pRTCDate->date = regs[DS1307_DATE_ADDR];
+	pRTCDate->month = regs[DS1307_MONTH_ADDR];
+	pRTCDate->year = regs[DS1307_YEAR_ADDR];
+
+	return RTC_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Set_DateTime
+ * Description	:	To set date and time
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h), day of the week not used (derived from the date)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h), Time Format written to the RTC
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	One burst write of the seven time-keeper registers (countdown chain reset by the
+ *			seconds write), then OSF cleared: the time is valid from now on.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Set_DateTime(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime)
+{
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+	uint8_t status;
+	RTC_Date_h date;
+	RTC_Time_h time;
+
+	if (RTC_CheckDateTime(pRTCDate, pRTCTime) != RTC_OK)
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	/* -Step 1. Normalized through the epoch: day of the week computed, same as the DS1307 backend- */
+	DS1307_Epoch_To_DateTime(DS1307_DateTime_To_Epoch(pRTCDate, pRTCTime), &date, &time, pRTCTime->timeFormat);
+
+	/* -Step 2. Seconds to Year in one transfer- */
+	regs[DS1307_SECONDS_ADDR] = time.seconds;
+	regs[DS1307_MINUTES_ADDR] = time.minutes;
+	regs[DS1307_HOURS_ADDR] = 0;
+	regs[DS1307_DAY_ADDR] = date.day;
+	regs[DS1307_DATE_ADDR] = date.date;
+	regs[DS1307_MONTH_ADDR] = date.month;
+	regs[DS1307_YEAR_ADDR] = date.year;
+	BCD_EncodeTimekeeper(regs);
+	regs[DS3234_HOURS_ADDR] = DS3234_Encode_Hours(time.hours, time.timeFormat);
+
+	if (DS3234_Write_Burst(DS3234_SECONDS_ADDR, regs, BCD_TIMEKEEPER_LEN) != RTC_OK)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	/* -Step 3. OSF cleared (other status bits kept)- */
+	status = DS3234_Read_Burst(DS3234_STATUS_ADDR, &regs[0], 1);
+	if (status == RTC_OK)
+	{
+		regs[0] &= ~(1 << DS3234_STATUS_OSF);
+		status = DS3234_Write_Burst(DS3234_STATUS_ADDR, &regs[0], 1);
+	}
+
+	return status;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Read_RAM / DS3234_Write_RAM
+ * Description	:	To read/write the battery-backed SRAM
+ *
+ * Parameter 1	:	Offset [0 to DS3234_SRAM_SIZE - 1]
+ * Parameter 2	:	Buffer (DMA from DS3234_DMA_MIN_LEN bytes: SRAM, CCMRAM falls back to polled)
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	SRAM address written once, then one burst on the data register.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Read_RAM(uint16_t Offset, uint8_t *pBuffer, uint16_t Len)
+{
+	return DS3234_RAM_Transfer(Offset, NULL, pBuffer, Len);
+}
+
+uint8_t DS3234_Write_RAM(uint16_t Offset, const uint8_t *pBuffer, uint16_t Len)
+{
+	return DS3234_RAM_Transfer(Offset, pBuffer, NULL, Len);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Set_SQW
+ * Description	:	To select the INT/SQW output
+ *
+ * Parameter 1	:	@RTC_SQW (RTC_SQW_32KHZ: RTC_ERR_UNSUPPORTED, see the 32kHz pin)
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		:	Control Register read-modify-write: INTCN and RS2:RS1 only (EOSC, alarms kept).
+ *			RTC_SQW_OFF: INTCN set, INT/SQW released (open drain) while no alarm is enabled.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DS3234_Set_SQW(uint8_t Rate)
+{
+	uint8_t control;
+
+	if (Rate >= RTC_SQW_32KHZ)
+	{
+		return RTC_ERR_UNSUPPORTED;
+	}
+
+	if (DS3234_Read_Burst(DS3234_CONTROL_ADDR, &control, 1) != RTC_OK)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	control &= ~((1 << DS3234_CONTROL_INTCN) | (3 << DS3234_CONTROL_RS));
+	if (Rate == RTC_SQW_OFF)
+	{
+		control |= (1 << DS3234_CONTROL_INTCN);
+	}
+	else
+	{
+		// RTC_SQW_1HZ to RTC_SQW_8KHZ are RS2:RS1 = 0 to 3
+		control |= (uint8_t)((Rate - RTC_SQW_1HZ) << DS3234_CONTROL_RS);
+	}
+
+	return DS3234_Write_Burst(DS3234_CONTROL_ADDR, &control, 1);
+}
+
+
+/* -- DMA Stream Interrupt Handlers of DS3234_SPI_Peripheral (SPI2: DMA1 Stream 4 TX, Stream 3 RX) -- */
+void DMA1_Stream3_IRQHandler(void)
+{
+	SPI_DMA_IRQHandling(&DS3234_SPIHandle);
+}
+
+void DMA1_Stream4_IRQHandler(void)
+{
+	SPI_DMA_IRQHandling(&DS3234_SPIHandle);
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_SPI_PinConfig
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: SCK/MISO/MOSI in Alternate Functionality, CS output driven high (released) first
+ * ------------------------------------------------------------------------------------------------------ */
+static void DS3234_SPI_PinConfig(void)
+{
+	GPIO_Handle_t SPI_Pins;
+
+	memset(&SPI_Pins, 0, sizeof(SPI_Pins));
+	SPI_Pins.pGPIOx = DS3234_SPI_GPIO_PORT;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFUNC;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinAltFuncMode = DS3234_SPI_AF;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinOPType = GPIO_OP_TYPE_PP;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinSpeed = GPIO_SPEED_HIGH;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
+
+	SPI_Pins.GPIO_PinConfig.GPIO_PinNumber = DS3234_SPI_SCK_PIN;
+	GPIO_Init(&SPI_Pins);
+	SPI_Pins.GPIO_PinConfig.GPIO_PinNumber = DS3234_SPI_MOSI_PIN;
+	GPIO_Init(&SPI_Pins);
+
+	// MISO pulled up: reads all ones without a DS3234 (detected by DS3234_Init)
+	SPI_Pins.GPIO_PinConfig.GPIO_PinNumber = DS3234_SPI_MISO_PIN;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PIN_PU;
+	GPIO_Init(&SPI_Pins);
+
+	GPIO_SetPins(DS3234_SPI_GPIO_PORT, (1 << DS3234_SPI_CS_PIN));
+	SPI_Pins.GPIO_PinConfig.GPIO_PinNumber = DS3234_SPI_CS_PIN;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUT;
+	SPI_Pins.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_NO_PUPD;
+	GPIO_Init(&SPI_Pins);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_RAM_Transfer
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	SRAM offset
+ * Parameter 2	:	Bytes to write (NULL: read)
+ * Parameter 3	:	Bytes read (NULL: write)
+ * Parameter 4	:	Number of bytes
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		: Address register (18h), then one chip-select cycle on the data register (19h): the
+ *			SRAM address increments on every byte. Blocks by DMA, waited for (no per-byte polling),
+ *			aborted on timeout; a DMA transfer error is reported (RTC_ERR_DEVICE).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS3234_RAM_Transfer(uint16_t Offset, const uint8_t *pTx, uint8_t *pRx, uint16_t Len)
+{
+	uint8_t address = (uint8_t)Offset;
+	uint8_t command = DS3234_SRAM_DATA_ADDR | ((pTx != NULL) ? DS3234_WRITE : 0);
+	uint8_t status;
+
+	if ((Offset + Len) > DS3234_SRAM_SIZE)
+	{
+		return RTC_ERR_PARAM;
+	}
+	if (Len == 0)
+	{
+		return RTC_OK;
+	}
+
+	/* -Step 1. SRAM address- */
+	if (DS3234_Write_Burst(DS3234_SRAM_ADDR_ADDR, &address, 1) != RTC_OK)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	/* -Step 2. Data register, then the block (DMA, polled for short blocks or CCMRAM buffers)- */
+	SPI_ChipSelect(&DS3234_SPIHandle, ENABLE);
+	status = SPI_Transfer(&DS3234_SPIHandle, &command, NULL, 1);
+	if (status == SPI_OK)
+	{
+		if ((Len >= DS3234_DMA_MIN_LEN) && (SPI_TransferDMA(&DS3234_SPIHandle, pTx, pRx, Len) == SPI_OK))
+		{
+			// Not done in time: DMA stopped before the caller's buffer is released
+			status = SPI_WaitDone(&DS3234_SPIHandle, SPI_TIMEOUT * Len);
+			if (status == SPI_ERR_BUSY)
+			{
+				SPI_AbortDMA(&DS3234_SPIHandle);
+			}
+		}
+		else
+		{
+			status = SPI_Transfer(&DS3234_SPIHandle, pTx, pRx, Len);
+		}
+	}
+	SPI_ChipSelect(&DS3234_SPIHandle, DISABLE);
+
+	return (status == SPI_OK) ? RTC_OK : RTC_ERR_DEVICE;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS3234_Encode_Hours / DS3234_Decode_Hours
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Hours (binary) / Hours Register
+ * Parameter 2	:	Time Format (@TIME_FORMAT) / Pointer to store it
+ * Return Type	:	Hours Register / Hours (binary)
+ * Note		: Same coding as the DS1307: Bit[6] 12-Hour (HIGH), Bit[5] PM in 12-Hour, 20 hours in 24-Hour
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS3234_Encode_Hours(uint8_t hours, uint8_t timeFormat)
+{
+	uint8_t value = BCD_Encode(hours);
+
+	if (timeFormat != TIME_FORMAT_24H)
+	{
+		value |= (1 << 6);
+		if (timeFormat == TIME_FORMAT_12H_PM)
+		{
+			value |= (1 << 5);
+		}
+	}
+
+	return value;
+}
+
+static uint8_t DS3234_Decode_Hours(uint8_t value, uint8_t *pTimeFormat)
+{
+	if (value & (1 << 6))
+	{
+		*pTimeFormat = (value & (1 << 5)) ? TIME_FORMAT_12H_PM : TIME_FORMAT_12H_AM;
+		return BCD_Decode(value & 0x1F);
+	}
+
+	*pTimeFormat = TIME_FORMAT_24H;
+	return BCD_Decode(value & 0x3F);
+}
@@ -0,0 +1,88 @@
+/*
+ * 									DS3234_RTC.h
+ *
+ * This file contains all the DS3234 (SPI RTC) APIs supported by the driver.
+ *
+ * 	> SPI mode 1 (CPOL 0, CPHA 1) up to 4 MHz: a time-keeper burst read is ~20 us (DS1307 over I2C
+ * 	  at 100 kHz: ~1 ms)
+ * 	> Same time-keeper layout as the DS1307 (BCD, 12/24-Hour bit): same RTC_Date_h/RTC_Time_h
+ * 	> 256 bytes of battery-backed SRAM, transferred by DMA for blocks (DS3234_DMA_MIN_LEN)
+ * 	> Backend of the common RTC interface (RTC_Device.h: DS3234_RTC_Ops), APIs return @RTC_STATUS
+ *
+ */
+
+#ifndef DS3234_RTC_H_
+#define DS3234_RTC_H_
+
+#include <stdint.h>
+#include "RTC_Device.h"
+#include "stm32f407xx_spi_drivers.h"
+
+
+/* -- Application Configurable Items  -- */
+#define DS3234_SPI_Peripheral		SPI2				// DS3234 is connected to SPI2 Peripheral
+#define DS3234_SPI_GPIO_PORT		GPIOB				// SCK, MISO, MOSI and CS on GPIO port B
+#define DS3234_SPI_SCK_PIN		GPIO_Pin_13
+#define DS3234_SPI_MISO_PIN		GPIO_Pin_14
+#define DS3234_SPI_MOSI_PIN		GPIO_Pin_15
+#define DS3234_SPI_CS_PIN		GPIO_Pin_12			// Software chip select (active low)
+#define DS3234_SPI_AF			5
+#define DS3234_SPI_MAX_HZ		4000000U			// DS3234 SCLK limit
+#define DS3234_DMA_IRQ_PRIORITY		12				// SPI2 DMA streams (DMA1 Stream 4 TX, Stream 3 RX)
+#define DS3234_DMA_MIN_LEN		16				// SRAM blocks from this size by DMA (polled below)
+
+
+/* -- Registers Addresses (read; write: address | DS3234_WRITE) -- */
+#define DS3234_WRITE			0x80
+
+// Time-keeper Register (same order and coding as the DS1307)
+#define DS3234_SECONDS_ADDR		0x00
+#define DS3234_HOURS_ADDR		0x02
+#define DS3234_MONTH_ADDR		0x05
+
+// Control and Status Registers
+#define DS3234_CONTROL_ADDR		0x0E
+#define DS3234_STATUS_ADDR		0x0F
+
+// SRAM: address register, then data register (SRAM address incremented on every data byte)
+#define DS3234_SRAM_ADDR_ADDR		0x18
+#define DS3234_SRAM_DATA_ADDR		0x19
+#define DS3234_SRAM_SIZE		256
+
+/* -- Control Register Bit Positions -- */
+#define DS3234_CONTROL_INTCN		2				// 1: INT/SQW is the alarm interrupt (square wave off)
+#define DS3234_CONTROL_RS		3				// Rate Select [RS2:RS1]
+#define DS3234_CONTROL_EOSC		7				// 1: oscillator stopped on battery (active low enable)
+
+/* -- Status Register Bit Positions -- */
+#define DS3234_STATUS_OSF		7				// Oscillator Stop Flag: time NOT valid
+
+/* -- Month Register Bit Positions -- */
+#define DS3234_MONTH_CENTURY		7				// Toggled when the year wraps 99 -> 00 (not used: 2000-2099)
+
+/* -- Bus Handle (DMA stream IRQs routed to it by DS3234_RTC.c) -- */
+extern SPI_Handle_t DS3234_SPIHandle;
+
+
+/* -- APIs Supported by DS3234_RTC driver -- */
+
+// To set up the SPI pins, peripheral and DMA, without disturbing a running clock (returns @RTC_STATUS)
+uint8_t DS3234_Init(void);
+
+// To read/write consecutive registers in one SPI transfer (returns @RTC_STATUS)
+uint8_t DS3234_Read_Burst(uint8_t RegAddress, uint8_t *pBuffer, uint8_t Len);
+uint8_t DS3234_Write_Burst(uint8_t RegAddress, const uint8_t *pBuffer, uint8_t Len);
+
+// To get/set date and time in one burst transfer (set also clears OSF; returns @RTC_STATUS)
+uint8_t DS3234_Get_DateTime(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime);
+uint8_t DS3234_Set_DateTime(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime);
+
+// To read/write the battery-backed SRAM (Offset + Len <= DS3234_SRAM_SIZE, returns @RTC_STATUS)
+uint8_t DS3234_Read_RAM(uint16_t Offset, uint8_t *pBuffer, uint16_t Len);
+uint8_t DS3234_Write_RAM(uint16_t Offset, const uint8_t *pBuffer, uint16_t Len);
+
+// To select the INT/SQW output (@RTC_SQW, returns @RTC_STATUS)
+uint8_t DS3234_Set_SQW(uint8_t Rate);
+
+
+#endif /* DS3234_RTC_H_ */
@@ -0,0 +1,175 @@
+/*
+ * 									RTC_DS1307.c
+ *
+ *  This file contains the DS1307 (I2C) backend of the common RTC interface (RTC_Device.h).
+ *
+ */
+
+#include "RTC_Device.h"
+#include "DS1307_Trim.h"
+
+/* -- NVRAM left to the application: after the drift tracking record (DS1307_Trim) -- */
+#define DS1307_OPS_NVRAM_BASE		DS1307_TRIM_RAM_END
+#define DS1307_OPS_NVRAM_SIZE		(DS1307_RAM_SIZE - DS1307_OPS_NVRAM_BASE)
+
+/* --Helper Functions-- */
+static uint8_t DS1307_Ops_Init(void);
+static uint8_t DS1307_Ops_GetDateTime(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime);
+static uint8_t DS1307_Ops_SetDateTime(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime);
+static uint8_t DS1307_Ops_ReadNVRAM(uint16_t Offset, uint8_t *pBuffer, uint16_t Len);
+static uint8_t DS1307_Ops_WriteNVRAM(uint16_t Offset, const uint8_t *pBuffer, uint16_t Len);
+static uint8_t DS1307_Ops_SetSQW(uint8_t Rate);
+
+// DS1307 backend: thin wrappers of the DS1307 driver APIs
+const RTC_Ops_t DS1307_RTC_Ops =
+{
+	.pName		= "DS1307 (I2C)",
+	.NVRAMSize	= DS1307_OPS_NVRAM_SIZE,
+	.Init		= DS1307_Ops_Init,
+	.GetDateTime	= DS1307_Ops_GetDateTime,
+	.SetDateTime	= DS1307_Ops_SetDateTime,
+	.ReadNVRAM	= DS1307_Ops_ReadNVRAM,
+	.WriteNVRAM	= DS1307_Ops_WriteNVRAM,
+	.SetSQW		= DS1307_Ops_SetSQW,
+};
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Ops_Init
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		: DS1307_Init (non-destructive), @DS1307_INIT_STATUS mapped to @RTC_STATUS
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Ops_Init(void)
+{
+	switch (DS1307_Init())
+	{
+		case DS1307_INIT_OK:
+			return RTC_OK;
+
+		case DS1307_INIT_RESTARTED:
+		case DS1307_INIT_TIME_INVALID:
+			return RTC_ERR_TIME_INVALID;
+
+		default:
+			return RTC_ERR_DEVICE;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Ops_GetDateTime / DS1307_Ops_SetDateTime
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Parameter 2	:	Handle pointer variable (RTC_Time_h)
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		: One burst transfer each way (epoch APIs): date and time never torn at a rollover.
+ *			Time Format kept as stored in the DS1307 (get) or as given (set). RTC_ERR_DEVICE on a bus
+ *			error, get: RTC_ERR_TIME_INVALID for a halted clock or registers out of range (31 Feb...).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Ops_GetDateTime(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime)
+{
+	uint8_t timeFormat;
+	uint32_t epoch;
+	uint8_t status = DS1307_Read_Epoch(&epoch, &timeFormat);
+
+	if (status == 2)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	DS1307_Epoch_To_DateTime(epoch, pRTCDate, pRTCTime, timeFormat);
+
+	return (status == 0) ? RTC_OK : RTC_ERR_TIME_INVALID;
+}
+
+static uint8_t DS1307_Ops_SetDateTime(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime)
+{
+	if (RTC_CheckDateTime(pRTCDate, pRTCTime) != RTC_OK)
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	if (DS1307_Set_Epoch(DS1307_DateTime_To_Epoch(pRTCDate, pRTCTime), pRTCTime->timeFormat) != 0)
+	{
+		return RTC_ERR_DEVICE;
+	}
+
+	return RTC_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Ops_ReadNVRAM / DS1307_Ops_WriteNVRAM
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Offset [0 to DS1307_OPS_NVRAM_SIZE - 1]
+ * Parameter 2	:	Buffer
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	uint8_t @RTC_STATUS
+ * Note		: One burst transfer (DS1307 RAM APIs). Offset 0 is DS1307 RAM byte DS1307_OPS_NVRAM_BASE:
+ *			the drift tracking record before it is never reachable through the RTC interface.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Ops_ReadNVRAM(uint16_t Offset, uint8_t *pBuffer, uint16_t Len)
+{
+	if ((Offset + Len) > DS1307_OPS_NVRAM_SIZE)
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	return (DS1307_Read_RAM((uint8_t)(DS1307_OPS_NVRAM_BASE + Offset), pBuffer, (uint8_t)Len) == 0) ? RTC_OK : RTC_ERR_DEVICE;
+}
+
+static uint8_t DS1307_Ops_WriteNVRAM(uint16_t Offset, const uint8_t *pBuffer, uint16_t Len)
+{
+	if ((Offset + Len) > DS1307_OPS_NVRAM_SIZE)
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	return (DS1307_Write_RAM((uint8_t)(DS1307_OPS_NVRAM_BASE + Offset), pBuffer, (uint8_t)Len) == 0) ? RTC_OK : RTC_ERR_DEVICE;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DS1307_Ops_SetSQW
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	@RTC_SQW
+ * Return Type	:	uint8_t @RTC_STATUS (RTC_SQW_1KHZ: RTC_ERR_UNSUPPORTED)
+ * Note		: RTC_SQW_OFF releases SQW/OUT (DS1307_OUT_HIGH)
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DS1307_Ops_SetSQW(uint8_t Rate)
+{
+	switch (Rate)
+	{
+		case RTC_SQW_OFF:
+			DS1307_Set_SQW_Level(DS1307_OUT_HIGH);
+			break;
+
+		case RTC_SQW_1HZ:
+			DS1307_Set_SQW(DS1307_SQW_1HZ);
+			break;
+
+		case RTC_SQW_4KHZ:
+			DS1307_Set_SQW(DS1307_SQW_4KHZ);
+			break;
+
+		case RTC_SQW_8KHZ:
+			DS1307_Set_SQW(DS1307_SQW_8KHZ);
+			break;
+
+		case RTC_SQW_32KHZ:
+			DS1307_Set_SQW(DS1307_SQW_32KHZ);
+			break;
+
+		default:
+			return RTC_ERR_UNSUPPORTED;
+	}
+
+	return RTC_OK;
+}
@@ -0,0 +1,117 @@
+/*
+ * 									RTC_Device.h
+ *
+ * This file contains the common RTC interface: one API whatever the RTC chip and its bus.
+ *
+ * 	> Ops table (RTC_Ops_t) per backend: init, get/set date and time, battery-backed NVRAM, SQW output
+ * 	> Backends: DS1307 over I2C (100 kHz, RTC_DS1307.c) and DS3234 over SPI (4 MHz, DS3234_RTC.c)
+ * 	> Same date/time structures (RTC_Date_h, RTC_Time_h) and time formats as the DS1307 driver
+ * 	> The application holds a 'const RTC_Ops_t *' (RTC_DEFAULT_OPS): moving to the SPI RTC is a
+ * 	  build switch (USE_DS3234_RTC, build configuration Debug_DS3234), not a code change
+ *
+ */
+
+#ifndef RTC_DEVICE_H_
+#define RTC_DEVICE_H_
+
+#include <stdint.h>
+#include "DS1307_RTC.h"
+
+
+/* -- Return Status (@RTC_STATUS) -- */
+#define RTC_OK				0
+#define RTC_ERR_TIME_INVALID		1			// Clock running, time lost (oscillator stopped): set it
+#define RTC_ERR_DEVICE			2			// No answer from the RTC (bus error, not fitted)
+#define RTC_ERR_PARAM			3			// Value or NVRAM range out of bounds
+#define RTC_ERR_UNSUPPORTED		4			// Feature not available on this RTC (e.g. SQW rate)
+
+/* -- Square-Wave Output (@RTC_SQW): not every rate exists on every RTC (RTC_ERR_UNSUPPORTED) -- */
+#define RTC_SQW_OFF			0				// Output released (high with the pull-up)
+#define RTC_SQW_1HZ			1				// DS1307, DS3234
+#define RTC_SQW_1KHZ			2				// 1.024 kHz: DS3234
+#define RTC_SQW_4KHZ			3				// 4.096 kHz: DS1307, DS3234
+#define RTC_SQW_8KHZ			4				// 8.192 kHz: DS1307, DS3234
+#define RTC_SQW_32KHZ			5				// 32.768 kHz: DS1307 (DS3234: dedicated 32kHz pin)
+
+/* -- Operations of an RTC Backend -- */
+typedef struct
+{
+	const char	*pName;					// Chip and bus, e.g. "DS1307 (I2C)"
+	uint16_t	NVRAMSize;				// Battery-backed RAM left to the application [bytes]
+
+	uint8_t (*Init)(void);					// Bus and chip, never stops a running clock (@RTC_STATUS)
+	uint8_t (*GetDateTime)(RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime);		// One consistent snapshot
+	uint8_t (*SetDateTime)(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime);	// Day of the week derived
+	uint8_t (*ReadNVRAM)(uint16_t Offset, uint8_t *pBuffer, uint16_t Len);
+	uint8_t (*WriteNVRAM)(uint16_t Offset, const uint8_t *pBuffer, uint16_t Len);
+	uint8_t (*SetSQW)(uint8_t Rate);			// @RTC_SQW
+
+}RTC_Ops_t;
+
+/* -- Backends -- */
+extern const RTC_Ops_t DS1307_RTC_Ops;
+extern const RTC_Ops_t DS3234_RTC_Ops;
+
+/* -- Application Backend (build switch) -- */
+#ifdef USE_DS3234_RTC
+#define RTC_DEFAULT_OPS			(&DS3234_RTC_Ops)
+#else
+#define RTC_DEFAULT_OPS			(&DS1307_RTC_Ops)
+#endif
+
+
+/* -- APIs Supported by the common RTC interface (dispatch through the ops table) -- */
+
+// To set up the bus and the RTC (returns @RTC_STATUS)
+static inline uint8_t RTC_Init(const RTC_Ops_t *pRTC)
+{
+	return pRTC->Init();
+}
+
+// To get/set date and time (returns @RTC_STATUS)
+static inline uint8_t RTC_GetDateTime(const RTC_Ops_t *pRTC, RTC_Date_h *pRTCDate, RTC_Time_h *pRTCTime)
+{
+	return pRTC->GetDateTime(pRTCDate, pRTCTime);
+}
+
+static inline uint8_t RTC_SetDateTime(const RTC_Ops_t *pRTC, const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime)
+{
+	return pRTC->SetDateTime(pRTCDate, pRTCTime);
+}
+
+// To check a date/time before it is written (used by the backends, returns @RTC_STATUS)
+// Date checked against the days of its month (leap years 2000 to 2099): no 31 April, no 29 February 2023
+static inline uint8_t RTC_CheckDateTime(const RTC_Date_h *pRTCDate, const RTC_Time_h *pRTCTime)
+{
+	uint8_t hourMin = (pRTCTime->timeFormat == TIME_FORMAT_24H) ? 0 : 1;
+	uint8_t hourMax = (pRTCTime->timeFormat == TIME_FORMAT_24H) ? 23 : 12;
+
+	if ((pRTCDate->year > 99) || (pRTCDate->month < 1) || (pRTCDate->month > 12) || (pRTCDate->date < 1)
+		|| (pRTCDate->date > DS1307_Days_In_Month(pRTCDate->month, pRTCDate->year)) || (pRTCTime->timeFormat > TIME_FORMAT_24H) || (pRTCTime->hours < hourMin)
+		|| (pRTCTime->hours > hourMax) || (pRTCTime->minutes > 59) || (pRTCTime->seconds > 59))
+	{
+		return RTC_ERR_PARAM;
+	}
+
+	return RTC_OK;
+}
+
+// To read/write the battery-backed RAM (Offset + Len <= NVRAMSize, returns @RTC_STATUS)
+static inline uint8_t RTC_ReadNVRAM(const RTC_Ops_t *pRTC, uint16_t Offset, uint8_t *pBuffer, uint16_t Len)
+{
+	return pRTC->ReadNVRAM(Offset, pBuffer, Len);
+}
+
+static inline uint8_t RTC_WriteNVRAM(const RTC_Ops_t *pRTC, uint16_t Offset, const uint8_t *pBuffer, uint16_t Len)
+{
+	return pRTC->WriteNVRAM(Offset, pBuffer, Len);
+}
+
+// To select the square-wave output (returns @RTC_STATUS)
+static inline uint8_t RTC_SetSQW(const RTC_Ops_t *pRTC, uint8_t Rate)
+{
+	return pRTC->SetSQW(Rate);
+}
+
+
+#endif /* RTC_DEVICE_H_ */
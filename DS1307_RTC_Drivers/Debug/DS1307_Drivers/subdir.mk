@@ -5,13 +5,37 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../DS1307_Drivers/DS1307_RTC.c 
+../DS1307_Drivers/DS1307_Boot.c \
+../DS1307_Drivers/DS1307_Drift.c \
+../DS1307_Drivers/DS1307_Format.c \
+../DS1307_Drivers/DS1307_LowPower.c \
+../DS1307_Drivers/DS1307_RTC.c \
+../DS1307_Drivers/DS1307_Stream.c \
+../DS1307_Drivers/DS1307_Trim.c \
+../DS1307_Drivers/DS3234_RTC.c \
+../DS1307_Drivers/RTC_DS1307.c 
 
 OBJS += \
-./DS1307_Drivers/DS1307_RTC.o 
+./DS1307_Drivers/DS1307_Boot.o \
+./DS1307_Drivers/DS1307_Drift.o \
+./DS1307_Drivers/DS1307_Format.o \
+./DS1307_Drivers/DS1307_LowPower.o \
+./DS1307_Drivers/DS1307_RTC.o \
+./DS1307_Drivers/DS1307_Stream.o \
+./DS1307_Drivers/DS1307_Trim.o \
+./DS1307_Drivers/DS3234_RTC.o \
+./DS1307_Drivers/RTC_DS1307.o 
 
 C_DEPS += \
-./DS1307_Drivers/DS1307_RTC.d 
+./DS1307_Drivers/DS1307_Boot.d \
+./DS1307_Drivers/DS1307_Drift.d \
+./DS1307_Drivers/DS1307_Format.d \
+./DS1307_Drivers/DS1307_LowPower.d \
+./DS1307_Drivers/DS1307_RTC.d \
+./DS1307_Drivers/DS1307_Stream.d \
+./DS1307_Drivers/DS1307_Trim.d \
+./DS1307_Drivers/DS3234_RTC.d \
+./DS1307_Drivers/RTC_DS1307.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -21,7 +45,7 @@ DS1307_Drivers/%.o DS1307_Drivers/%.su: ../DS1307_Drivers/%.c DS1307_Drivers/sub
 clean: clean-DS1307_Drivers
 
 clean-DS1307_Drivers:
-	-$(RM) ./DS1307_Drivers/DS1307_RTC.d ./DS1307_Drivers/DS1307_RTC.o ./DS1307_Drivers/DS1307_RTC.su
+	-$(RM) ./DS1307_Drivers/DS1307_Boot.d ./DS1307_Drivers/DS1307_Boot.o ./DS1307_Drivers/DS1307_Boot.su ./DS1307_Drivers/DS1307_Drift.d ./DS1307_Drivers/DS1307_Drift.o ./DS1307_Drivers/DS1307_Drift.su ./DS1307_Drivers/DS1307_Format.d ./DS1307_Drivers/DS1307_Format.o ./DS1307_Drivers/DS1307_Format.su ./DS1307_Drivers/DS1307_LowPower.d ./DS1307_Drivers/DS1307_LowPower.o ./DS1307_Drivers/DS1307_LowPower.su ./DS1307_Drivers/DS1307_RTC.d ./DS1307_Drivers/DS1307_RTC.o ./DS1307_Drivers/DS1307_RTC.su ./DS1307_Drivers/DS1307_Stream.d ./DS1307_Drivers/DS1307_Stream.o ./DS1307_Drivers/DS1307_Stream.su ./DS1307_Drivers/DS1307_Trim.d ./DS1307_Drivers/DS1307_Trim.o ./DS1307_Drivers/DS1307_Trim.su ./DS1307_Drivers/DS3234_RTC.d ./DS1307_Drivers/DS3234_RTC.o ./DS1307_Drivers/DS3234_RTC.su ./DS1307_Drivers/RTC_DS1307.d ./DS1307_Drivers/RTC_DS1307.o ./DS1307_Drivers/RTC_DS1307.su
 
 .PHONY: clean-DS1307_Drivers
 
@@ -5,19 +5,52 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Device_Drivers/Src/bcd_codec.c \
+../Device_Drivers/Src/dlog.c \
+../Device_Drivers/Src/mem_pool.c \
+../Device_Drivers/Src/stm32f407xx_dma_drivers.c \
+../Device_Drivers/Src/stm32f407xx_flash_drivers.c \
 ../Device_Drivers/Src/stm32f407xx_gpio_drivers.c \
 ../Device_Drivers/Src/stm32f407xx_i2c_drivers.c \
-../Device_Drivers/Src/stm32f407xx_rcc_drivers.c 
+../Device_Drivers/Src/stm32f407xx_itm_drivers.c \
+../Device_Drivers/Src/stm32f407xx_rcc_drivers.c \
+../Device_Drivers/Src/stm32f407xx_spi_drivers.c \
+../Device_Drivers/Src/stm32f407xx_systick_drivers.c \
+../Device_Drivers/Src/stm32f407xx_tim_drivers.c \
+../Device_Drivers/Src/stm32f407xx_usart_drivers.c \
+../Device_Drivers/Src/timer_wheel.c 
 
 OBJS += \
+./Device_Drivers/Src/bcd_codec.o \
+./Device_Drivers/Src/dlog.o \
+./Device_Drivers/Src/mem_pool.o \
+./Device_Drivers/Src/stm32f407xx_dma_drivers.o \
+./Device_Drivers/Src/stm32f407xx_flash_drivers.o \
 ./Device_Drivers/Src/stm32f407xx_gpio_drivers.o \
 ./Device_Drivers/Src/stm32f407xx_i2c_drivers.o \
-./Device_Drivers/Src/stm32f407xx_rcc_drivers.o 
+./Device_Drivers/Src/stm32f407xx_itm_drivers.o \
+./Device_Drivers/Src/stm32f407xx_rcc_drivers.o \
+./Device_Drivers/Src/stm32f407xx_spi_drivers.o \
+./Device_Drivers/Src/stm32f407xx_systick_drivers.o \
+./Device_Drivers/Src/stm32f407xx_tim_drivers.o \
+./Device_Drivers/Src/stm32f407xx_usart_drivers.o \
+./Device_Drivers/Src/timer_wheel.o 
 
 C_DEPS += \
+./Device_Drivers/Src/bcd_codec.d \
+./Device_Drivers/Src/dlog.d \
+./Device_Drivers/Src/mem_pool.d \
+./Device_Drivers/Src/stm32f407xx_dma_drivers.d \
+./Device_Drivers/Src/stm32f407xx_flash_drivers.d \
 ./Device_Drivers/Src/stm32f407xx_gpio_drivers.d \
 ./Device_Drivers/Src/stm32f407xx_i2c_drivers.d \
-./Device_Drivers/Src/stm32f407xx_rcc_drivers.d 
+./Device_Drivers/Src/stm32f407xx_itm_drivers.d \
+./Device_Drivers/Src/stm32f407xx_rcc_drivers.d \
+./Device_Drivers/Src/stm32f407xx_spi_drivers.d \
+./Device_Drivers/Src/stm32f407xx_systick_drivers.d \
+./Device_Drivers/Src/stm32f407xx_tim_drivers.d \
+./Device_Drivers/Src/stm32f407xx_usart_drivers.d \
+./Device_Drivers/Src/timer_wheel.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -27,7 +60,7 @@ Device_Drivers/Src/%.o Device_Drivers/Src/%.su: ../Device_Drivers/Src/%.c Device
 clean: clean-Device_Drivers-2f-Src
 
 clean-Device_Drivers-2f-Src:
-	-$(RM) ./Device_Drivers/Src/stm32f407xx_gpio_drivers.d ./Device_Drivers/Src/stm32f407xx_gpio_drivers.o ./Device_Drivers/Src/stm32f407xx_gpio_drivers.su ./Device_Drivers/Src/stm32f407xx_i2c_drivers.d ./Device_Drivers/Src/stm32f407xx_i2c_drivers.o ./Device_Drivers/Src/stm32f407xx_i2c_drivers.su ./Device_Drivers/Src/stm32f407xx_rcc_drivers.d ./Device_Drivers/Src/stm32f407xx_rcc_drivers.o ./Device_Drivers/Src/stm32f407xx_rcc_drivers.su
+	-$(RM) ./Device_Drivers/Src/bcd_codec.d ./Device_Drivers/Src/bcd_codec.o ./Device_Drivers/Src/bcd_codec.su ./Device_Drivers/Src/dlog.d ./Device_Drivers/Src/dlog.o ./Device_Drivers/Src/dlog.su ./Device_Drivers/Src/mem_pool.d ./Device_Drivers/Src/mem_pool.o ./Device_Drivers/Src/mem_pool.su ./Device_Drivers/Src/stm32f407xx_dma_drivers.d ./Device_Drivers/Src/stm32f407xx_dma_drivers.o ./Device_Drivers/Src/stm32f407xx_dma_drivers.su ./Device_Drivers/Src/stm32f407xx_flash_drivers.d ./Device_Drivers/Src/stm32f407xx_flash_drivers.o ./Device_Drivers/Src/stm32f407xx_flash_drivers.su ./Device_Drivers/Src/stm32f407xx_gpio_drivers.d ./Device_Drivers/Src/stm32f407xx_gpio_drivers.o ./Device_Drivers/Src/stm32f407xx_gpio_drivers.su ./Device_Drivers/Src/stm32f407xx_i2c_drivers.d ./Device_Drivers/Src/stm32f407xx_i2c_drivers.o ./Device_Drivers/Src/stm32f407xx_i2c_drivers.su ./Device_Drivers/Src/stm32f407xx_itm_drivers.d ./Device_Drivers/Src/stm32f407xx_itm_drivers.o ./Device_Drivers/Src/stm32f407xx_itm_drivers.su ./Device_Drivers/Src/stm32f407xx_rcc_drivers.d ./Device_Drivers/Src/stm32f407xx_rcc_drivers.o ./Device_Drivers/Src/stm32f407xx_rcc_drivers.su ./Device_Drivers/Src/stm32f407xx_spi_drivers.d ./Device_Drivers/Src/stm32f407xx_spi_drivers.o ./Device_Drivers/Src/stm32f407xx_spi_drivers.su ./Device_Drivers/Src/stm32f407xx_systick_drivers.d ./Device_Drivers/Src/stm32f407xx_systick_drivers.o ./Device_Drivers/Src/stm32f407xx_systick_drivers.su ./Device_Drivers/Src/stm32f407xx_tim_drivers.d ./Device_Drivers/Src/stm32f407xx_tim_drivers.o ./Device_Drivers/Src/stm32f407xx_tim_drivers.su ./Device_Drivers/Src/stm32f407xx_usart_drivers.d ./Device_Drivers/Src/stm32f407xx_usart_drivers.o ./Device_Drivers/Src/stm32f407xx_usart_drivers.su ./Device_Drivers/Src/timer_wheel.d ./Device_Drivers/Src/timer_wheel.o ./Device_Drivers/Src/timer_wheel.su
 
 .PHONY: clean-Device_Drivers-2f-Src
 
@@ -6,15 +6,18 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Src/01_DS1307_RTC_Basic.c \
-../Src/sysmem.c 
+../Src/sysmem.c \
+../Src/system_stm32f407xx.c 
 
 OBJS += \
 ./Src/01_DS1307_RTC_Basic.o \
-./Src/sysmem.o 
+./Src/sysmem.o \
+./Src/system_stm32f407xx.o 
 
 C_DEPS += \
 ./Src/01_DS1307_RTC_Basic.d \
-./Src/sysmem.d 
+./Src/sysmem.d \
+./Src/system_stm32f407xx.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -24,7 +27,7 @@ Src/%.o Src/%.su: ../Src/%.c Src/subdir.mk
 clean: clean-Src
 
 clean-Src:
-	-$(RM) ./Src/01_DS1307_RTC_Basic.d ./Src/01_DS1307_RTC_Basic.o ./Src/01_DS1307_RTC_Basic.su ./Src/sysmem.d ./Src/sysmem.o ./Src/sysmem.su
+	-$(RM) ./Src/01_DS1307_RTC_Basic.d ./Src/01_DS1307_RTC_Basic.o ./Src/01_DS1307_RTC_Basic.su ./Src/sysmem.d ./Src/sysmem.o ./Src/sysmem.su ./Src/system_stm32f407xx.d ./Src/system_stm32f407xx.o ./Src/system_stm32f407xx.su
 
 .PHONY: clean-Src
 
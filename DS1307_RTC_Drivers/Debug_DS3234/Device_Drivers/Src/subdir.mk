@@ -0,0 +1,66 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+# Toolchain: GNU Tools for STM32 (10.3-2021.10)
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Device_Drivers/Src/bcd_codec.c \
+../Device_Drivers/Src/dlog.c \
+../Device_Drivers/Src/mem_pool.c \
+../Device_Drivers/Src/stm32f407xx_dma_drivers.c \
+../Device_Drivers/Src/stm32f407xx_flash_drivers.c \
+../Device_Drivers/Src/stm32f407xx_gpio_drivers.c \
+../Device_Drivers/Src/stm32f407xx_i2c_drivers.c \
+../Device_Drivers/Src/stm32f407xx_itm_drivers.c \
+../Device_Drivers/Src/stm32f407xx_rcc_drivers.c \
+../Device_Drivers/Src/stm32f407xx_spi_drivers.c \
+../Device_Drivers/Src/stm32f407xx_systick_drivers.c \
+../Device_Drivers/Src/stm32f407xx_tim_drivers.c \
+../Device_Drivers/Src/stm32f407xx_usart_drivers.c \
+../Device_Drivers/Src/timer_wheel.c 
+
+OBJS += \
+./Device_Drivers/Src/bcd_codec.o \
+./Device_Drivers/Src/dlog.o \
+./Device_Drivers/Src/mem_pool.o \
+./Device_Drivers/Src/stm32f407xx_dma_drivers.o \
+./Device_Drivers/Src/stm32f407xx_flash_drivers.o \
+./Device_Drivers/Src/stm32f407xx_gpio_drivers.o \
+./Device_Drivers/Src/stm32f407xx_i2c_drivers.o \
+./Device_Drivers/Src/stm32f407xx_itm_drivers.o \
+./Device_Drivers/Src/stm32f407xx_rcc_drivers.o \
+./Device_Drivers/Src/stm32f407xx_spi_drivers.o \
+./Device_Drivers/Src/stm32f407xx_systick_drivers.o \
+./Device_Drivers/Src/stm32f407xx_tim_drivers.o \
+./Device_Drivers/Src/stm32f407xx_usart_drivers.o \
+./Device_Drivers/Src/timer_wheel.o 
+
+C_DEPS += \
+./Device_Drivers/Src/bcd_codec.d \
+./Device_Drivers/Src/dlog.d \
+./Device_Drivers/Src/mem_pool.d \
+./Device_Drivers/Src/stm32f407xx_dma_drivers.d \
+./Device_Drivers/Src/stm32f407xx_flash_drivers.d \
+./Device_Drivers/Src/stm32f407xx_gpio_drivers.d \
+./Device_Drivers/Src/stm32f407xx_i2c_drivers.d \
+./Device_Drivers/Src/stm32f407xx_itm_drivers.d \
+./Device_Drivers/Src/stm32f407xx_rcc_drivers.d \
+./Device_Drivers/Src/stm32f407xx_spi_drivers.d \
+./Device_Drivers/Src/stm32f407xx_systick_drivers.d \
+./Device_Drivers/Src/stm32f407xx_tim_drivers.d \
+./Device_Drivers/Src/stm32f407xx_usart_drivers.d \
+./Device_Drivers/Src/timer_wheel.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Device_Drivers/Src/%.o Device_Drivers/Src/%.su: ../Device_Drivers/Src/%.c Device_Drivers/Src/subdir.mk
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -g3 -DDEBUG -DSTM32 -DSTM32F407G_DISC1 -DSTM32F4 -DSTM32F407VGTx -DUSE_DS3234_RTC -c -I"D:/Resources/GIT/g_DS1307_RTC_Drivers/DS1307_RTC/DS1307_RTC_Drivers/DS1307_Drivers" -I../Inc -I"D:/Resources/GIT/g_DS1307_RTC_Drivers/DS1307_RTC/DS1307_RTC_Drivers/Device_Drivers/Inc" -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
+
+clean: clean-Device_Drivers-2f-Src
+
+clean-Device_Drivers-2f-Src:
+	-$(RM) ./Device_Drivers/Src/bcd_codec.d ./Device_Drivers/Src/bcd_codec.o ./Device_Drivers/Src/bcd_codec.su ./Device_Drivers/Src/dlog.d ./Device_Drivers/Src/dlog.o ./Device_Drivers/Src/dlog.su ./Device_Drivers/Src/mem_pool.d ./Device_Drivers/Src/mem_pool.o ./Device_Drivers/Src/mem_pool.su ./Device_Drivers/Src/stm32f407xx_dma_drivers.d ./Device_Drivers/Src/stm32f407xx_dma_drivers.o ./Device_Drivers/Src/stm32f407xx_dma_drivers.su ./Device_Drivers/Src/stm32f407xx_flash_drivers.d ./Device_Drivers/Src/stm32f407xx_flash_drivers.o ./Device_Drivers/Src/stm32f407xx_flash_drivers.su ./Device_Drivers/Src/stm32f407xx_gpio_drivers.d ./Device_Drivers/Src/stm32f407xx_gpio_drivers.o ./Device_Drivers/Src/stm32f407xx_gpio_drivers.su ./Device_Drivers/Src/stm32f407xx_i2c_drivers.d ./Device_Drivers/Src/stm32f407xx_i2c_drivers.o ./Device_Drivers/Src/stm32f407xx_i2c_drivers.su ./Device_Drivers/Src/stm32f407xx_itm_drivers.d ./Device_Drivers/Src/stm32f407xx_itm_drivers.o ./Device_Drivers/Src/stm32f407xx_itm_drivers.su ./Device_Drivers/Src/stm32f407xx_rcc_drivers.d ./Device_Drivers/Src/stm32f407xx_rcc_drivers.o ./Device_Drivers/Src/stm32f407xx_rcc_drivers.su ./Device_Drivers/Src/stm32f407xx_spi_drivers.d ./Device_Drivers/Src/stm32f407xx_spi_drivers.o ./Device_Drivers/Src/stm32f407xx_spi_drivers.su ./Device_Drivers/Src/stm32f407xx_systick_drivers.d ./Device_Drivers/Src/stm32f407xx_systick_drivers.o ./Device_Drivers/Src/stm32f407xx_systick_drivers.su ./Device_Drivers/Src/stm32f407xx_tim_drivers.d ./Device_Drivers/Src/stm32f407xx_tim_drivers.o ./Device_Drivers/Src/stm32f407xx_tim_drivers.su ./Device_Drivers/Src/stm32f407xx_usart_drivers.d ./Device_Drivers/Src/stm32f407xx_usart_drivers.o ./Device_Drivers/Src/stm32f407xx_usart_drivers.su ./Device_Drivers/Src/timer_wheel.d ./Device_Drivers/Src/timer_wheel.o ./Device_Drivers/Src/timer_wheel.su
+
+.PHONY: clean-Device_Drivers-2f-Src
+
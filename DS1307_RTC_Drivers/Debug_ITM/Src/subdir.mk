@@ -0,0 +1,36 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+# Toolchain: GNU Tools for STM32 (10.3-2021.10)
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Src/01_DS1307_RTC_Basic.c \
+../Src/syscalls.c \
+../Src/sysmem.c \
+../Src/system_stm32f407xx.c 
+
+OBJS += \
+./Src/01_DS1307_RTC_Basic.o \
+./Src/syscalls.o \
+./Src/sysmem.o \
+./Src/system_stm32f407xx.o 
+
+C_DEPS += \
+./Src/01_DS1307_RTC_Basic.d \
+./Src/syscalls.d \
+./Src/sysmem.d \
+./Src/system_stm32f407xx.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Src/%.o Src/%.su: ../Src/%.c Src/subdir.mk
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -g3 -DDEBUG -DSTM32 -DSTM32F407G_DISC1 -DSTM32F4 -DSTM32F407VGTx -DUSE_ITM_TRACE -c -I"D:/Resources/GIT/g_DS1307_RTC_Drivers/DS1307_RTC/DS1307_RTC_Drivers/DS1307_Drivers" -I../Inc -I"D:/Resources/GIT/g_DS1307_RTC_Drivers/DS1307_RTC/DS1307_RTC_Drivers/Device_Drivers/Inc" -O0 -ffunction-sections -fdata-sections -Wall -fstack-usage -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
+
+clean: clean-Src
+
+clean-Src:
+	-$(RM) ./Src/01_DS1307_RTC_Basic.d ./Src/01_DS1307_RTC_Basic.o ./Src/01_DS1307_RTC_Basic.su ./Src/syscalls.d ./Src/syscalls.o ./Src/syscalls.su ./Src/sysmem.d ./Src/sysmem.o ./Src/sysmem.su ./Src/system_stm32f407xx.d ./Src/system_stm32f407xx.o ./Src/system_stm32f407xx.su
+
+.PHONY: clean-Src
+
@@ -0,0 +1,138 @@
+/*
+ * 									bcd_codec.h
+ *
+ * This file contains the BCD (Binary Coded Decimal) codec shared by the drivers.
+ *
+ * All conversions are free of division and branches:
+ * 	> Encode	: 100-entry const look-up table (Flash), one load per byte
+ * 	> Decode	: shift/add, BCD[x][y] -> 16x + y - 6x = 10x + y
+ * 	> Packed	: four bytes per 32-bit word (SWAR: SIMD Within A Register)
+ *
+ */
+
+#ifndef INC_BCD_CODEC_H_
+#define INC_BCD_CODEC_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/* -- Number of Time-keeper Registers (DS1307: Seconds to Year) -- */
+#define BCD_TIMEKEEPER_LEN		7
+
+/* -- Encode Look-up Table [0 to 99] (Defined in bcd_codec.c) -- */
+extern const uint8_t BCD_EncodeLUT[100];
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_Encode
+ * Description	:	To convert a binary value into BCD
+ *
+ * Parameter 1	:	value [0 to 99] (uint8_t)
+ * Return Type	:	BCD equivalent of provided binary value (uint8_t)
+ * Note		:	Table index clamped: 100 and above give 0x99 (never read past the table; compiled
+ *			as a conditional move, no branch).
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint8_t BCD_Encode(uint8_t value)
+{
+	return BCD_EncodeLUT[(value < 100) ? value : 99];
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_Decode
+ * Description	:	To convert a BCD value into binary
+ *
+ * Parameter 1	:	BCD value [0x00 to 0x99] (uint8_t)
+ * Return Type	:	Binary equivalent of provided BCD value (uint8_t)
+ * Note		:	bcd - 6x, where 6x = 4x + 2x = ((bcd >> 4) << 2) + ((bcd >> 4) << 1)
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint8_t BCD_Decode(uint8_t bcd)
+{
+	return (uint8_t) (bcd - ((bcd >> 2) & 0x3C) - ((bcd >> 3) & 0x1E));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_DecodePacked
+ * Description	:	To convert four BCD bytes (one 32-bit word) into binary at once
+ *
+ * Parameter 1	:	four BCD values [0x00 to 0x99] (uint32_t)
+ * Return Type	:	four binary values (uint32_t)
+ * Note		:	Same formula as BCD_Decode on each byte lane, no lane can borrow from its neighbour
+ *			(6x <= lane value). Control bits (CH, 12/24, AM/PM) MUST be masked by the caller.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t BCD_DecodePacked(uint32_t bcd)
+{
+	uint32_t tens = (bcd >> 4) & 0x0F0F0F0FU;
+
+	return bcd - (tens << 2) - (tens << 1);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_EncodePacked
+ * Description	:	To convert four binary bytes (one 32-bit word) into BCD at once
+ *
+ * Parameter 1	:	four binary values [0 to 99] (uint32_t)
+ * Return Type	:	four BCD values (uint32_t)
+ * Note		:	tens = (value * 103) >> 10 is exact for 0 to 178 but needs 14 bits, so the bytes are
+ *			processed as two words with 16-bit lanes (even and odd bytes). BCD = value + 6 * tens.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t BCD_EncodePacked(uint32_t value)
+{
+	uint32_t even = value & 0x00FF00FFU;
+	uint32_t odd  = (value >> 8) & 0x00FF00FFU;
+
+	uint32_t tensEven = ((even * 103U) >> 10) & 0x000F000FU;
+	uint32_t tensOdd  = ((odd * 103U) >> 10) & 0x000F000FU;
+
+	even += (tensEven << 2) + (tensEven << 1);
+	odd  += (tensOdd << 2) + (tensOdd << 1);
+
+	return even | (odd << 8);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_DecodeTimekeeper
+ * Description	:	To convert all seven Time-keeper bytes from BCD into binary (in place)
+ *
+ * Parameter 1	:	Time-keeper bytes [Seconds, Minutes, Hours, Day, Date, Month, Year] (uint8_t *)
+ * Return Type	:	none (void)
+ * Note		:	Two 32-bit words (bytes 0-3 and 4-6). Control bits MUST be masked by the caller.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void BCD_DecodeTimekeeper(uint8_t *pRegs)
+{
+	uint32_t word[2] = {0, 0};
+
+	memcpy(word, pRegs, BCD_TIMEKEEPER_LEN);
+
+	word[0] = BCD_DecodePacked(word[0]);
+	word[1] = BCD_DecodePacked(word[1]);
+
+	memcpy(pRegs, word, BCD_TIMEKEEPER_LEN);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	BCD_EncodeTimekeeper
+ * Description	:	To convert all seven Time-keeper bytes from binary into BCD (in place)
+ *
+ * Parameter 1	:	Time-keeper bytes [Seconds, Minutes, Hours, Day, Date, Month, Year] (uint8_t *)
+ * Return Type	:	none (void)
+ * Note		:	Two 32-bit words (bytes 0-3 and 4-6). Every byte MUST be below 100.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void BCD_EncodeTimekeeper(uint8_t *pRegs)
+{
+	uint32_t word[2] = {0, 0};
+
+	memcpy(word, pRegs, BCD_TIMEKEEPER_LEN);
+
+	word[0] = BCD_EncodePacked(word[0]);
+	word[1] = BCD_EncodePacked(word[1]);
+
+	memcpy(pRegs, word, BCD_TIMEKEEPER_LEN);
+}
+
+
+#endif /* INC_BCD_CODEC_H_ */
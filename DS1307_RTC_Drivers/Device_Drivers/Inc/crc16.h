@@ -0,0 +1,48 @@
+/*
+ * 									crc16.h
+ *
+ * This file contains the CRC-16 (CCITT) used to validate data kept across resets and power cycles.
+ *
+ * 	> Polynomial 0x1021, initial value 0xFFFF, no reflection (CRC-16/CCITT-FALSE)
+ * 	> Bitwise: no table, small records only (a few tens of bytes)
+ *
+ */
+
+#ifndef INC_CRC16_H_
+#define INC_CRC16_H_
+
+#include <stdint.h>
+
+/* -- Initial Value -- */
+#define CRC16_INIT			0xFFFFU
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	CRC16_Compute
+ * Description	:	To compute the CRC-16/CCITT-FALSE of a buffer
+ *
+ * Parameter 1	:	Pointer to the data (const void *)
+ * Parameter 2	:	Number of bytes (uint32_t)
+ * Parameter 3	:	Initial value (CRC16_INIT, or a previous result to continue)
+ * Return Type	:	CRC (uint16_t)
+ * Note		:	"123456789" -> 0x29B1
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint16_t CRC16_Compute(const void *pData, uint32_t Len, uint16_t Crc)
+{
+	const uint8_t *pByte = (const uint8_t *)pData;
+
+	while (Len--)
+	{
+		Crc ^= (uint16_t)(*pByte++ << 8);
+
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			Crc = (Crc & 0x8000U) ? (uint16_t)((Crc << 1) ^ 0x1021U) : (uint16_t)(Crc << 1);
+		}
+	}
+
+	return Crc;
+}
+
+
+#endif /* INC_CRC16_H_ */
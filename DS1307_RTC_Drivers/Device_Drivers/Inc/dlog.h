@@ -0,0 +1,97 @@
+/*
+ * 									dlog.h
+ *
+ * This file contains the deferred (binary) logging APIs shared by the drivers and the application.
+ *
+ * 	> A log site stores a compact record: format string ID, DWT timestamp and the raw arguments.
+ * 	  No formatting on the target (no printf, no heap): a few tens of cycles per record
+ * 	> Format strings live in the .dlog_fmt INFO section: kept in the ELF, NOT loaded in Flash.
+ * 	  The ID is the offset of the string in that section
+ * 	> Lock-free ring buffer (LDREX/STREX): log sites callable from thread and ISRs, full ring drops
+ * 	  the record (counted), one consumer (DLog_Drain) sends the records to a transport (e.g. ITM)
+ * 	> Tools/dlog_decode.py formats the records on the host with the strings read from the ELF
+ *
+ * 	Record (little-endian words):
+ * 		[0] header: ID [31:16], DLOG_MARK [15:12], type [11:8] (@DLOG_TYPE), payload bytes [7:0]
+ * 		[1] DWT_CYCCNT at the log site
+ * 		[2] payload, padded to a whole word
+ *
+ */
+
+#ifndef INC_DLOG_H_
+#define INC_DLOG_H_
+
+#include <stdint.h>
+
+
+/* -- Application Configurable Items -- */
+#define DLOG_RING_WORDS			256				// Ring size (power of 2, 1 KB)
+#define DLOG_MAX_ARGS			4				// DLOG: 32-bit arguments per record
+#define DLOG_MAX_BYTES			16				// DLOG_BYTES: payload bytes per record
+
+/* -- Record Types (@DLOG_TYPE): how the host consumes the payload for each conversion -- */
+#define DLOG_TYPE_WORDS			0				// 4 bytes per conversion (%d %u %x %c ...)
+#define DLOG_TYPE_BYTES			1				// %hhx: 1 byte, %hx: 2 bytes, others: 4 bytes
+
+/* -- Record Layout -- */
+#define DLOG_MARK			0xAU			// Committed record (never 0: free ring words are 0)
+#define DLOG_HEADER_WORDS		2				// Header and timestamp
+#define DLOG_MAX_RECORD_WORDS		(DLOG_HEADER_WORDS + ((DLOG_MAX_BYTES + 3) / 4))
+
+/* -- Statistics -- */
+typedef struct
+{
+	uint32_t Records;				// Records written
+	uint32_t Dropped;				// Records dropped (ring full, or payload too long)
+	uint32_t MaxUsedWords;				// High-water mark of the ring (sizing DLOG_RING_WORDS)
+
+}DLog_Stats_t;
+
+/* -- Record Sink: one whole record per call (DLog_Drain) -- */
+typedef void (*DLog_Sink_t)(const uint8_t *pRecord, uint32_t Len);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Log site macros: the format string is placed in .dlog_fmt, only its ID reaches the target code.
+ *
+ *	DLOG("Epoch %lu, format %u", epoch, timeFormat);		arguments converted to uint32_t
+ *	DLOG_BYTES("Regs %02hhx %02hhx %02hhx", regs, 3);		raw bytes (len <= DLOG_MAX_BYTES)
+ *
+ * No %s (strings are not copied), %f is not supported. Format strings MUST be literals.
+ * ------------------------------------------------------------------------------------------------------ */
+#define DLOG_FMT_SECTION		__attribute__((section(".dlog_fmt"), used, aligned(1)))
+#define DLOG_ID(pFmt)			((uint16_t)(uintptr_t)(pFmt))
+
+#define DLOG(Fmt, ...)										\
+	do {											\
+		DLOG_FMT_SECTION static const char dlogFmt[] = Fmt;				\
+		const uint32_t dlogArgs[] = {0, ##__VA_ARGS__};					\
+		_Static_assert(sizeof(dlogArgs) <= ((DLOG_MAX_ARGS + 1) * sizeof(uint32_t)),	\
+			"DLOG: too many arguments");						\
+		DLog_Write(DLOG_ID(dlogFmt), DLOG_TYPE_WORDS, &dlogArgs[1],			\
+			sizeof(dlogArgs) - sizeof(uint32_t));					\
+	} while (0)
+
+#define DLOG_BYTES(Fmt, pData, Len)								\
+	do {											\
+		DLOG_FMT_SECTION static const char dlogFmt[] = Fmt;				\
+		DLog_Write(DLOG_ID(dlogFmt), DLOG_TYPE_BYTES, (pData), (Len));			\
+	} while (0)
+
+
+/* -- APIs Supported by the deferred log -- */
+
+// To empty the ring and clear the statistics (before any log site runs)
+void DLog_Init(void);
+
+// To store one record (used by DLOG/DLOG_BYTES; returns 0: stored, 1: dropped)
+uint8_t DLog_Write(uint16_t FmtId, uint8_t Type, const void *pPayload, uint32_t Len);
+
+// To pass the committed records to a sink, oldest first (one consumer only; returns the records sent)
+uint32_t DLog_Drain(DLog_Sink_t Sink);
+
+// To get the statistics
+void DLog_GetStats(DLog_Stats_t *pStats);
+
+
+#endif /* INC_DLOG_H_ */
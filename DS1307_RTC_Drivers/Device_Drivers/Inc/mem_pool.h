@@ -0,0 +1,75 @@
+/*
+ * 									mem_pool.h
+ *
+ * This file contains the fixed-size block allocator APIs shared by the drivers.
+ *
+ * 	> MEMPOOL_CLASSES block classes (sizes and counts below), static storage: no _sbrk, no fragmentation
+ * 	> O(1) allocation and release: one free list per class, constant time in the real-time loop
+ * 	> Callable from any context (thread or ISR): short PRIMASK critical sections
+ * 	> Statistics per class (in use, high-water mark, failures) and overflow detection (guard word
+ * 	  after every block, checked on release and by MemPool_Check), double/invalid release detection
+ *
+ */
+
+#ifndef INC_MEM_POOL_H_
+#define INC_MEM_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/* -- Application Configurable Items: Block Classes (ascending sizes, bytes, multiple of 4, count > 0) -- */
+#define MEMPOOL_CLASS0_SIZE		16				// Small requests/descriptors
+#define MEMPOOL_CLASS0_COUNT		8
+#define MEMPOOL_CLASS1_SIZE		64				// DS1307_Stream RX buffer (DS1307_STREAM_RX_SIZE)
+#define MEMPOOL_CLASS1_COUNT		2
+#define MEMPOOL_CLASS2_SIZE		128				// Log records, short transfer buffers
+#define MEMPOOL_CLASS2_COUNT		2
+#define MEMPOOL_CLASS3_SIZE		1024				// DS1307_Stream TX buffer (DS1307_STREAM_TX_SIZE)
+#define MEMPOOL_CLASS3_COUNT		1
+
+#define MEMPOOL_CLASSES			4
+
+/* -- Return Status (@MEMPOOL_STATUS) -- */
+#define MEMPOOL_OK			0
+#define MEMPOOL_ERR_INVALID		1			// Not a block of the pool (or NULL): nothing done
+#define MEMPOOL_ERR_DOUBLE_FREE		2			// Block already free: nothing done
+#define MEMPOOL_ERR_OVERFLOW		3			// Guard (or tag) word overwritten, see MemPool_Free
+
+/* -- Statistics of one Block Class -- */
+typedef struct
+{
+	uint16_t BlockSize;				// Usable bytes per block
+	uint16_t BlockCount;
+	uint16_t Used;					// Blocks in use
+	uint16_t MaxUsed;				// High-water mark of Used
+	uint32_t Allocs;				// Successful allocations from this class
+	uint32_t Fails;					// Requests this class could not serve (empty: next class tried)
+	uint32_t Overflows;				// Overwritten guard/tag words found by MemPool_Free
+	uint32_t DoubleFrees;
+
+}MemPool_Stats_t;
+
+
+/* -- APIs Supported by the memory pool -- */
+
+// To build the free lists (all blocks free, statistics cleared)
+void MemPool_Init(void);
+
+// To get a block of at least 'Size' bytes: smallest class that fits, larger if empty (NULL: none left)
+void* MemPool_Alloc(uint32_t Size);
+
+// To give a block back (returns @MEMPOOL_STATUS)
+uint8_t MemPool_Free(void *pBlock);
+
+// To get the usable size of an allocated block (0 if not a block of the pool)
+uint32_t MemPool_BlockSize(const void *pBlock);
+
+// To check the guard word of every block in use (returns the number of overwritten guards)
+uint32_t MemPool_Check(void);
+
+// To get the statistics of a block class (0 to MEMPOOL_CLASSES - 1)
+void MemPool_GetStats(uint8_t Class, MemPool_Stats_t *pStats);
+
+
+#endif /* INC_MEM_POOL_H_ */
@@ -54,11 +54,99 @@
 // Number of Priority Bit Implemented
 #define PRI_BITS_IMPLEMENTED		4
 
+// ARM Cortex Mx NVIC Register arrays (indexed access, see stm32f407xx_nvic_drivers.h)
+#define NVIC_ISER					((volatile uint32_t *)0xE000E100)	// [IRQNumber / 32]
+#define NVIC_ICER					((volatile uint32_t *)0xE000E180)	// [IRQNumber / 32]
+#define NVIC_ISPR					((volatile uint32_t *)0xE000E200)	// [IRQNumber / 32]
+#define NVIC_ICPR					((volatile uint32_t *)0xE000E280)	// [IRQNumber / 32]
+#define NVIC_IPR					((volatile uint8_t *)0xE000E400)	// [IRQNumber] (byte accessible)
+
+// ARM Cortex Mx SCB AIRCR (Application Interrupt and Reset Control) Register Address
+#define SCB_AIRCR					((volatile uint32_t *)0xE000ED0C)
+#define SCB_AIRCR_VECTKEY			0x05FAU				// Write key [31:16]
+#define SCB_AIRCR_PRIGROUP			8				// PRIGROUP [10:8]
+
+// ARM Cortex Mx SCB SCR (System Control) Register Address
+#define SCB_SCR						((volatile uint32_t *)0xE000ED10)
+#define SCB_SCR_SLEEPONEXIT			1
+#define SCB_SCR_SLEEPDEEP			2				// WFI/WFE enter STOP (with PWR_CR) instead of SLEEP
+
+// ARM Cortex Mx SCB CPACR (Coprocessor Access Control) Register Address
+#define SCB_CPACR					((volatile uint32_t *)0xE000ED88)
+#define SCB_CPACR_CP10				20				// CP10 [21:20], CP11 [23:22]: FPU access
+
+// ARM Cortex Mx DEMCR (Debug Exception and Monitor Control) Register Address
+#define SCB_DEMCR					((volatile uint32_t *)0xE000EDFC)
+#define SCB_DEMCR_TRCENA			24				// Enables DWT and ITM
+
+// ARM Cortex Mx DWT (Data Watchpoint and Trace) Registers Addresses
+#define DWT_CTRL					((volatile uint32_t *)0xE0001000)
+#define DWT_CYCCNT					((volatile uint32_t *)0xE0001004)
+#define DWT_CTRL_CYCCNTENA			0
+
+// ARM Cortex Mx ITM (Instrumentation Trace Macrocell) Registers Addresses
+#define ITM_STIM(Port)				((volatile uint32_t *)(0xE0000000 + (4 * (Port))))	// Stimulus Ports 0 to 31
+#define ITM_TER						((volatile uint32_t *)0xE0000E00)	// Trace Enable (one bit per port)
+#define ITM_TPR						((volatile uint32_t *)0xE0000E40)	// Trace Privilege
+#define ITM_TCR						((volatile uint32_t *)0xE0000E80)	// Trace Control
+#define ITM_LAR						((volatile uint32_t *)0xE0000FB0)	// Lock Access
+#define ITM_LAR_KEY					0xC5ACCE55U
+#define ITM_STIM_FIFOREADY			0				// Read of a stimulus port: 1 = can accept a write
+#define ITM_TCR_ITMENA				0
+#define ITM_TCR_SYNCENA				2
+#define ITM_TCR_SWOENA				4				// Timestamp counter clocked by the SWO prescaler
+#define ITM_TCR_BUSY				23
+#define ITM_TCR_TRACEBUSID			16				// [22:16]
+
+// ARM Cortex Mx TPIU (Trace Port Interface Unit) Registers Addresses: clocked by HCLK
+#define TPIU_ACPR					((volatile uint32_t *)0xE0040010)	// SWO prescaler: HCLK / (ACPR + 1)
+#define TPIU_SPPR					((volatile uint32_t *)0xE00400F0)	// Selected Pin Protocol
+#define TPIU_FFCR					((volatile uint32_t *)0xE0040304)	// Formatter and Flush Control
+#define TPIU_SPPR_NRZ				2				// SWO asynchronous, NRZ (UART like)
+#define TPIU_FFCR_TRIGIN			8
+
+// STM32F407 DBGMCU Control Register Address
+#define DBGMCU_CR					((volatile uint32_t *)0xE0042004)
+#define DBGMCU_CR_TRACE_IOEN			5				// Trace pin (PB3 TRACESWO) enabled
+#define DBGMCU_CR_TRACE_MODE			6				// [7:6]: 00 asynchronous (SWO)
+
+// ARM Cortex Mx SysTick Registers Addresses
+#define SYST_CSR					((volatile uint32_t *)0xE000E010)	// Control and Status
+#define SYST_RVR					((volatile uint32_t *)0xE000E014)	// Reload Value
+#define SYST_CVR					((volatile uint32_t *)0xE000E018)	// Current Value
+#define SYST_CSR_ENABLE				0
+#define SYST_CSR_TICKINT			1				// SysTick exception on reaching 0
+#define SYST_CSR_CLKSOURCE			2				// 1: processor clock (HCLK), 0: HCLK / 8
+#define SYST_CSR_COUNTFLAG			16
+#define SYST_RVR_MAX				0x00FFFFFFU			// 24-bit counter
+
+// ARM Cortex Mx SCB SHPRx (System Handler Priority) Registers, byte accessible
+#define SCB_SHPR					((volatile uint8_t *)0xE000ED18)	// [Exception number - 4]
+#define SYSTICK_EXCEPTION_NO			15
+
+// ARM Cortex Mx SCB SHCSR (System Handler Control and State) Register Address
+#define SCB_SHCSR					((volatile uint32_t *)0xE000ED24)
+#define SCB_SHCSR_MEMFAULTENA			16				// MemManage fault enabled (else HardFault)
+
+// ARM Cortex Mx MPU (Memory Protection Unit) Registers Addresses: 8 regions
+#define MPU_TYPE					((volatile uint32_t *)0xE000ED90)
+#define MPU_CTRL					((volatile uint32_t *)0xE000ED94)
+#define MPU_RNR						((volatile uint32_t *)0xE000ED98)	// Region Number
+#define MPU_RBAR					((volatile uint32_t *)0xE000ED9C)	// Region Base Address
+#define MPU_RASR					((volatile uint32_t *)0xE000EDA0)	// Region Attribute and Size
+#define MPU_CTRL_ENABLE				0
+#define MPU_CTRL_PRIVDEFENA			2				// Default memory map for privileged code
+#define MPU_RASR_ENABLE				0
+#define MPU_RASR_SIZE				1				// [5:1]: region size = 2^(SIZE + 1) bytes
+#define MPU_RASR_AP				24				// [26:24]: 000 no access
+#define MPU_RASR_XN				28				// Execute never
+
 /* -- Base Addresses of Memories -- */
 #define FLASH_BASEADDR				0x08000000U
 #define SRAM1_BASEADDR				0x20000000U				// 112 KB
 #define SRAM2_BASEADDR				0x20001C00U				// 16 KB
 #define SRAM					SRAM1_BASEADDR
+#define CCMRAM_BASEADDR				0x10000000U				// 64 KB, D-bus only (no DMA, no code)
 #define ROM_BASEADDR				0x1FFF0000U  		 		// System Memory
 
 
@@ -81,8 +169,16 @@
 #define GPIOI_BASEADDR				((AHB1PERIPH_BASEADDR) + (0x2000))
 
 #define RCC_BASEADDR				((AHB1PERIPH_BASEADDR) + (0x3800))
+#define FLASH_R_BASEADDR			((AHB1PERIPH_BASEADDR) + (0x3C00))	// Flash interface registers
+#define DMA1_BASEADDR				((AHB1PERIPH_BASEADDR) + (0x6000))
+#define DMA2_BASEADDR				((AHB1PERIPH_BASEADDR) + (0x6400))
 
 /* -- Base Addresses of peripherals on APB1 Bus -- */
+#define TIM2_BASEADDR				((APB1PERIPH_BASEADDR) + (0x0000))
+#define TIM3_BASEADDR				((APB1PERIPH_BASEADDR) + (0x0400))
+#define TIM4_BASEADDR				((APB1PERIPH_BASEADDR) + (0x0800))
+#define TIM5_BASEADDR				((APB1PERIPH_BASEADDR) + (0x0C00))
+
 #define I2C1_BASEADDR				((APB1PERIPH_BASEADDR) + (0x5400)) 	// APB1PERIPH_BASE + Offset
 #define I2C2_BASEADDR				((APB1PERIPH_BASEADDR) + (0x5800))
 #define I2C3_BASEADDR				((APB1PERIPH_BASEADDR) + (0x5C00))
@@ -95,6 +191,8 @@
 #define UART4_BASEADDR				((APB1PERIPH_BASEADDR) + (0x4C00))
 #define UART5_BASEADDR				((APB1PERIPH_BASEADDR) + (0x5000))
 
+#define PWR_BASEADDR				((APB1PERIPH_BASEADDR) + (0x7000))
+
 /* -- Base Addresses of peripherals on APB2 Bus -- */
 #define EXTI_BASEADDR				((APB2PERIPH_BASEADDR) + (0x3C00)) 	// APB2PERIPH_BASE + Offset
 #define SPI1_BASEADDR				((APB2PERIPH_BASEADDR) + (0x3000))
@@ -159,6 +257,27 @@ typedef struct
 
 }RCC_RegDef_t;
 
+// Structure for PWR peripheral Registers (Power controller)
+typedef struct
+{
+	volatile uint32_t CR;		   /* - Power control register								 - Offset :0x00 */
+	volatile uint32_t CSR;		   /* - Power control/status register							 - Offset :0x04 */
+
+}PWR_RegDef_t;
+
+// Structure for Flash interface Registers
+typedef struct
+{
+	volatile uint32_t ACR;		   /* - Flash access control register							 - Offset :0x00 */
+	volatile uint32_t KEYR;		   /* - Flash key register								 - Offset :0x04 */
+	volatile uint32_t OPTKEYR;	   /* - Flash option key register							 - Offset :0x08 */
+	volatile uint32_t SR;		   /* - Flash status register								 - Offset :0x0C */
+	volatile uint32_t CR;		   /* - Flash control register								 - Offset :0x10 */
+	volatile uint32_t OPTCR;	   /* - Flash option control register							 - Offset :0x14 */
+	volatile uint32_t OPTCR1;	   /* - Flash option control register 1						 	 - Offset :0x18 */
+
+}FLASH_RegDef_t;
+
 // Structure for EXTI peripheral Registers (External interrupt)
 typedef struct
 {
@@ -228,6 +347,50 @@ typedef struct
 
 }USART_RegDef_t;
 
+// Registers Structure for General-purpose Timers (TIM2 to TIM5)
+typedef struct
+{
+	volatile uint32_t CR1;		/* - Control Register 1 								- Offset :0x00 */
+	volatile uint32_t CR2;		/* - Control Register 2 								- Offset :0x04 */
+	volatile uint32_t SMCR;		/* - Slave Mode Control Register 							- Offset :0x08 */
+	volatile uint32_t DIER;		/* - DMA/Interrupt Enable Register 							- Offset :0x0C */
+	volatile uint32_t SR;		/* - Status Register 									- Offset :0x10 */
+	volatile uint32_t EGR;		/* - Event Generation Register 								- Offset :0x14 */
+	volatile uint32_t CCMR[2];	/* - Capture/Compare Mode Registers 1 and 2 						- Offset :0x18-0x1C */
+	volatile uint32_t CCER;		/* - Capture/Compare Enable Register 							- Offset :0x20 */
+	volatile uint32_t CNT;		/* - Counter 										- Offset :0x24 */
+	volatile uint32_t PSC;		/* - Prescaler 										- Offset :0x28 */
+	volatile uint32_t ARR;		/* - Auto-Reload Register 								- Offset :0x2C */
+	volatile uint32_t RESERVED1;	/* - RESERVED 										- Offset :0x30 */
+	volatile uint32_t CCR[4];	/* - Capture/Compare Registers 1 to 4 							- Offset :0x34-0x40 */
+	volatile uint32_t RESERVED2;	/* - RESERVED 										- Offset :0x44 */
+	volatile uint32_t DCR;		/* - DMA Control Register 								- Offset :0x48 */
+	volatile uint32_t DMAR;		/* - DMA address for full transfer 							- Offset :0x4C */
+	volatile uint32_t OR;		/* - Option Register (TIM2, TIM5) 							- Offset :0x50 */
+
+}TIM_RegDef_t;
+
+// Registers Structure for one DMA Stream (8 per DMA controller)
+typedef struct
+{
+	volatile uint32_t CR;		/* - Stream Configuration Register 							- Offset :0x00 */
+	volatile uint32_t NDTR;		/* - Stream Number of Data Register (items left) 					- Offset :0x04 */
+	volatile uint32_t PAR;		/* - Stream Peripheral Address Register 						- Offset :0x08 */
+	volatile uint32_t M0AR;		/* - Stream Memory 0 Address Register 							- Offset :0x0C */
+	volatile uint32_t M1AR;		/* - Stream Memory 1 Address Register (double buffer) 					- Offset :0x10 */
+	volatile uint32_t FCR;		/* - Stream FIFO Control Register 							- Offset :0x14 */
+
+}DMA_Stream_RegDef_t;
+
+// Registers Structure for DMA Controllers (DMA1, DMA2)
+typedef struct
+{
+	volatile uint32_t ISR[2];	/* - Interrupt Status, [0] - LOW (streams 0-3) [1] - HIGH (streams 4-7)		- Offset :0x00-0x04 */
+	volatile uint32_t IFCR[2];	/* - Interrupt Flag Clear, [0] - LOW [1] - HIGH (write 1 to clear)			- Offset :0x08-0x0C */
+	DMA_Stream_RegDef_t S[8];	/* - Streams 0 to 7 									- Offset :0x10-0xCC */
+
+}DMA_RegDef_t;
+
 /* -- Peripheral Definitions (Peripheral Base Address type-casted to x_RegDef_t) -- */
 
 // For GPIO
@@ -244,9 +407,15 @@ typedef struct
 // For RCC
 #define RCC					((RCC_RegDef_t *)RCC_BASEADDR)
 
+// For Flash interface
+#define FLASH					((FLASH_RegDef_t *)FLASH_R_BASEADDR)
+
 // For EXTI
 #define EXTI					((EXTI_RegDef_t *)EXTI_BASEADDR)
 
+// For PWR
+#define PWR					((PWR_RegDef_t *)PWR_BASEADDR)
+
 // For SYSCFG
 #define SYSCFG					((SYSCFG_RegDef_t *)SYSCFG_BASEADDR)
 
@@ -261,6 +430,16 @@ typedef struct
 #define I2C2					((I2C_RegDef_t *)I2C2_BASEADDR)
 #define I2C3					((I2C_RegDef_t *)I2C3_BASEADDR)
 
+// For TIM
+#define TIM2					((TIM_RegDef_t *)TIM2_BASEADDR)
+#define TIM3					((TIM_RegDef_t *)TIM3_BASEADDR)
+#define TIM4					((TIM_RegDef_t *)TIM4_BASEADDR)
+#define TIM5					((TIM_RegDef_t *)TIM5_BASEADDR)
+
+// For DMA
+#define DMA1					((DMA_RegDef_t *)DMA1_BASEADDR)
+#define DMA2					((DMA_RegDef_t *)DMA2_BASEADDR)
+
 // For USART
 #define USART1					((USART_RegDef_t *)USART1_BASEADDR)
 #define USART2					((USART_RegDef_t *)USART2_BASEADDR)
@@ -289,6 +468,12 @@ typedef struct
 #define I2C2_PCLK_EN()			(RCC -> APB1ENR |= (1 << 22))		// SET 22nd Bit to enable
 #define I2C3_PCLK_EN()			(RCC -> APB1ENR |= (1 << 23))		// SET 23rd Bit to enable
 
+// Clock Enable MACROS for TIMx Peripherals
+#define TIM2_PCLK_EN()			(RCC -> APB1ENR |= (1 << 0))		// SET 0th Bit to enable
+#define TIM3_PCLK_EN()			(RCC -> APB1ENR |= (1 << 1))		// SET 1st Bit to enable
+#define TIM4_PCLK_EN()			(RCC -> APB1ENR |= (1 << 2))		// SET 2nd Bit to enable
+#define TIM5_PCLK_EN()			(RCC -> APB1ENR |= (1 << 3))		// SET 3rd Bit to enable
+
 // Clock Enable MACROS for SPIx Peripherals
 #define SPI1_PCLK_EN()			(RCC -> APB2ENR |= (1 << 12))		// SET 12th Bit to enable
 #define SPI2_PCLK_EN()			(RCC -> APB1ENR |= (1 << 14))		// SET 14th Bit to enable
@@ -296,6 +481,10 @@ typedef struct
 #define SPI4_PCLK_EN()			(RCC -> APB2ENR |= (1 << 13))		// SET 13th Bit to enable
 
 
+// Clock Enable MACROS for DMA Controllers
+#define DMA1_PCLK_EN()			(RCC -> AHB1ENR |= (1 << 21))		// SET 21st Bit to enable
+#define DMA2_PCLK_EN()			(RCC -> AHB1ENR |= (1 << 22))		// SET 22nd Bit to enable
+
 // Clock Enable MACROS for USARTx Peripherals
 #define USART1_PCLK_EN()		(RCC -> APB2ENR |= (1 << 4))		// SET 4th Bit to enable
 #define USART2_PCLK_EN()		(RCC -> APB1ENR |= (1 << 17))		// SET 17th Bit to enable
@@ -307,6 +496,9 @@ typedef struct
 // Clock Enable MACROS for SYSCFG Peripheral
 #define SYSCFG_EN()			(RCC -> APB2ENR |= (1 << 14))		// SET 14th Bit to enable
 
+// Clock Enable MACROS for PWR Peripheral
+#define PWR_PCLK_EN()			(RCC -> APB1ENR |= (1 << 28))		// SET 28th Bit to enable
+
 // Clock Disable MACROS for GPIOx Peripherals
 #define GPIOA_PCLK_DI()			(RCC -> AHB1ENR &= ~(1 << 0))		// CLEAR 0th Bit to disable
 #define GPIOB_PCLK_DI()			(RCC -> AHB1ENR &= ~(1 << 1))		// CLEAR 1st Bit to disable
@@ -323,12 +515,22 @@ typedef struct
 #define I2C2_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 22))		// CLEAR 22nd Bit to disable
 #define I2C3_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 23))		// CLEAR 23rd Bit to disable
 
+// Clock Disable MACROS for TIMx Peripherals
+#define TIM2_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 0))		// CLEAR 0th Bit to disable
+#define TIM3_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 1))		// CLEAR 1st Bit to disable
+#define TIM4_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 2))		// CLEAR 2nd Bit to disable
+#define TIM5_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 3))		// CLEAR 3rd Bit to disable
+
 // Clock Disable MACROS for SPIx Peripherals
 #define SPI1_PCLK_DI()			(RCC -> APB2ENR &= ~(1 << 12))		// CLEAR 12th Bit to disable
 #define SPI2_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 14))		// CLEAR 14th Bit to disable
 #define SPI3_PCLK_DI()			(RCC -> APB1ENR &= ~(1 << 15))		// CLEAR 15th Bit to disable
 #define SPI4_PCLK_DI()			(RCC -> APB2ENR &= ~(1 << 13))		// CLEAR 13th Bit to disable
 
+// Clock Disable MACROS for DMA Controllers
+#define DMA1_PCLK_DI()			(RCC -> AHB1ENR &= ~(1 << 21))		// CLEAR 21st Bit to disable
+#define DMA2_PCLK_DI()			(RCC -> AHB1ENR &= ~(1 << 22))		// CLEAR 22nd Bit to disable
+
 // Clock Disable MACROS for USARTx Peripherals
 #define USART1_PCLK_DI()		(RCC -> APB2ENR &= ~(1 << 4))		// CLEAR 4th Bit to disable
 #define USART2_PCLK_DI()		(RCC -> APB1ENR &= ~(1 << 17))		// CLEAR 17th Bit to disable
@@ -417,6 +619,109 @@ typedef struct
 #define IRQ_NO_UART5	   		53
 #define IRQ_NO_USART6	    		71
 
+// For DMA Streams (DMA1 Stream n: 11 + n except Stream 7, DMA2 Stream n: 56 + n up to Stream 4)
+#define IRQ_NO_DMA1_STREAM0		11
+#define IRQ_NO_DMA1_STREAM1		12
+#define IRQ_NO_DMA1_STREAM2		13
+#define IRQ_NO_DMA1_STREAM3		14
+#define IRQ_NO_DMA1_STREAM4		15
+#define IRQ_NO_DMA1_STREAM5		16
+#define IRQ_NO_DMA1_STREAM6		17
+#define IRQ_NO_DMA1_STREAM7		47
+#define IRQ_NO_DMA2_STREAM0		56
+#define IRQ_NO_DMA2_STREAM1		57
+#define IRQ_NO_DMA2_STREAM2		58
+#define IRQ_NO_DMA2_STREAM3		59
+#define IRQ_NO_DMA2_STREAM4		60
+#define IRQ_NO_DMA2_STREAM5		68
+#define IRQ_NO_DMA2_STREAM6		69
+#define IRQ_NO_DMA2_STREAM7		70
+
+/* -- Bit Position Definitions of RCC Peripheral -- */
+
+// For RCC_CR
+#define RCC_CR_HSION			0
+#define RCC_CR_HSIRDY			1
+#define RCC_CR_HSEON			16
+#define RCC_CR_HSERDY			17
+#define RCC_CR_HSEBYP			18
+#define RCC_CR_PLLON			24
+#define RCC_CR_PLLRDY			25
+
+// For RCC_PLLCFGR
+#define RCC_PLLCFGR_PLLM		0			// [5:0]
+#define RCC_PLLCFGR_PLLN		6			// [14:6]
+#define RCC_PLLCFGR_PLLP		16			// [17:16]
+#define RCC_PLLCFGR_PLLSRC		22
+#define RCC_PLLCFGR_PLLQ		24			// [27:24]
+
+// For RCC_CFGR
+#define RCC_CFGR_SW			0			// [1:0]
+#define RCC_CFGR_SWS			2			// [3:2]
+#define RCC_CFGR_HPRE			4			// [7:4]
+#define RCC_CFGR_PPRE1			10			// [12:10]
+#define RCC_CFGR_PPRE2			13			// [15:13]
+
+// For RCC_CSR
+#define RCC_CSR_LSION			0
+#define RCC_CSR_LSIRDY			1
+#define RCC_CSR_RMVF			24			// Write 1: clear the reset flags
+#define RCC_CSR_BORRSTF			25
+#define RCC_CSR_PINRSTF			26
+#define RCC_CSR_PORRSTF			27
+#define RCC_CSR_SFTRSTF			28
+#define RCC_CSR_IWDGRSTF		29
+#define RCC_CSR_WWDGRSTF		30
+#define RCC_CSR_LPWRRSTF		31
+
+
+/* -- Bit Position Definitions of PWR Peripheral -- */
+
+// For PWR_CR
+#define PWR_CR_LPDS			0			// Low-power regulator in STOP
+#define PWR_CR_PDDS			1			// 0: STOP, 1: STANDBY on deep sleep
+#define PWR_CR_CWUF			2
+#define PWR_CR_CSBF			3
+#define PWR_CR_FPDS			9			// Flash power-down in STOP
+#define PWR_CR_VOS			14
+
+
+/* -- Bit Position Definitions of Flash interface -- */
+
+// For FLASH_ACR
+#define FLASH_ACR_LATENCY		0			// [2:0]
+#define FLASH_ACR_PRFTEN		8
+#define FLASH_ACR_ICEN			9
+#define FLASH_ACR_DCEN			10
+#define FLASH_ACR_ICRST			11
+#define FLASH_ACR_DCRST			12
+
+
+/* -- Bit Position Definitions of TIM Peripheral (General-purpose) -- */
+
+// For TIM_CR1
+#define TIM_CR1_CEN			0
+#define TIM_CR1_URS			2
+
+// For TIM_SR (channel x: bit + x - 1)
+#define TIM_SR_UIF			0
+#define TIM_SR_CC1IF			1
+#define TIM_SR_CC1OF			9
+
+// For TIM_EGR
+#define TIM_EGR_UG			0
+
+// For TIM_CCMRx (input capture, channel 1/3 at 0, channel 2/4 at 8)
+#define TIM_CCMR_CCS			0			// [1:0] 01: ICx mapped on TIx
+#define TIM_CCMR_ICPSC			2			// [3:2] capture every 1, 2, 4, 8 events
+#define TIM_CCMR_ICF			4			// [7:4] input filter
+
+// For TIM_CCER (channel x: bit + 4 * (x - 1))
+#define TIM_CCER_CC1E			0
+#define TIM_CCER_CC1P			1
+#define TIM_CCER_CC1NP			3
+
+
 /* -- Bit Position Definitions of SPI Peripheral -- */
 
 // For SPI_CR1 Register
@@ -570,6 +875,37 @@ typedef struct
 #define USART_CR3_ONEBIT		11
 
 
+/* -- Bit Position Definitions of DMA Controllers -- */
+
+// For DMA_SxCR
+#define DMA_SxCR_EN			0
+#define DMA_SxCR_DMEIE			1
+#define DMA_SxCR_TEIE			2
+#define DMA_SxCR_HTIE			3
+#define DMA_SxCR_TCIE			4
+#define DMA_SxCR_PFCTRL			5
+#define DMA_SxCR_DIR			6	// DIR[7:6]
+#define DMA_SxCR_CIRC			8
+#define DMA_SxCR_PINC			9
+#define DMA_SxCR_MINC			10
+#define DMA_SxCR_PSIZE			11	// PSIZE[12:11]
+#define DMA_SxCR_MSIZE			13	// MSIZE[14:13]
+#define DMA_SxCR_PL			16	// PL[17:16]
+#define DMA_SxCR_DBM			18
+#define DMA_SxCR_CT			19
+#define DMA_SxCR_CHSEL			25	// CHSEL[27:25]
+
+// For DMA_SxFCR
+#define DMA_SxFCR_DMDIS			2	// 1: FIFO mode, 0: direct mode
+
+// For DMA_ISR/IFCR (stream flags at bit 0, 6, 16, 22 of the LOW/HIGH register)
+#define DMA_ISR_FEIF			0
+#define DMA_ISR_DMEIF			2
+#define DMA_ISR_TEIF			3
+#define DMA_ISR_HTIF			4
+#define DMA_ISR_TCIF			5
+
+
 /* -- General MACROS -- */
 #define ENABLE				1
 #define DISABLE				0
@@ -581,5 +917,20 @@ typedef struct
 #define FLAG_RESET			RESET
 
 
+/* -- Memory Placement MACROS (sections copied/zeroed by Reset_Handler, see STM32F407VGTX_FLASH.ld) -- */
+
+// Function executed from SRAM (no Flash wait states). Calls between Flash and SRAM are out of BL range:
+// the linker inserts a long-branch veneer (a direct call for Tools/stack_report.py)
+#define __RAMFUNC			__attribute__((section(".RamFunc"), noinline))
+
+// Initialized data in CCMRAM (zero wait state, CPU only: NOT for DMA buffers)
+#define __CCMRAM			__attribute__((section(".ccmram")))
+
+// Zero-initialized data in CCMRAM (CPU only: NOT for DMA buffers)
+#define __CCMRAM_BSS			__attribute__((section(".ccmbss")))
+
+// Data in SRAM neither copied nor zeroed at reset (no boot cost, content kept across resets while powered)
+#define __NOINIT			__attribute__((section(".noinit")))
+
 
 #endif /* INC_STM32F407XX_H_ */
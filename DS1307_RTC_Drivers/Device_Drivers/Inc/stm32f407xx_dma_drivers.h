@@ -0,0 +1,87 @@
+/*
+ * 									stm32f407xx_dma_drivers.h
+ *
+ * This file contains all the DMA (DMA1, DMA2 streams) APIs supported by the driver.
+ *
+ * 	> Peripheral <-> memory transfers of bytes, peripheral address fixed, memory address incremented
+ * 	  (or fixed: one dummy byte sent or received many times)
+ * 	> Direct mode (no FIFO), normal or circular
+ * 	> Stream flags normalized to the stream 0 layout (@DMA_FLAG), whatever the stream number
+ * 	> Memory MUST be SRAM (or Flash for memory-to-peripheral): CCMRAM is not on the DMA bus
+ *
+ */
+
+#ifndef INC_STM32F407XX_DMA_DRIVERS_H_
+#define INC_STM32F407XX_DMA_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- CONFIGURATION Structure for a DMA Stream -- */
+typedef struct
+{
+	uint8_t DMA_Channel;				// Request channel [0 to 7] (reference manual, DMA request mapping)
+	uint8_t DMA_Direction;				// Possible values: @DMA_DIR
+	uint8_t DMA_Mode;				// Possible values: @DMA_MODE
+	uint8_t DMA_Priority;				// Possible values: @DMA_PRIORITY
+	uint8_t DMA_Interrupts;				// Possible values: @DMA_IT (OR-ed, 0: polled)
+
+}DMA_Config_t;
+
+/* -- Transfer Direction (@DMA_DIR) -- */
+#define DMA_DIR_PERIPH_TO_MEM		0
+#define DMA_DIR_MEM_TO_PERIPH		1
+
+/* -- Mode (@DMA_MODE) -- */
+#define DMA_MODE_NORMAL			0				// Stops after NDTR items (stream disabled)
+#define DMA_MODE_CIRCULAR		1				// Restarts from the buffer start (NDTR reloaded)
+
+/* -- Priority (@DMA_PRIORITY) -- */
+#define DMA_PRIORITY_LOW		0
+#define DMA_PRIORITY_MEDIUM		1
+#define DMA_PRIORITY_HIGH		2
+#define DMA_PRIORITY_VERY_HIGH		3
+
+/* -- Interrupts (@DMA_IT) -- */
+#define DMA_IT_TE			(1 << DMA_SxCR_TEIE)		// Transfer error
+#define DMA_IT_HT			(1 << DMA_SxCR_HTIE)		// Half transfer
+#define DMA_IT_TC			(1 << DMA_SxCR_TCIE)		// Transfer complete
+
+/* -- Stream Flags (@DMA_FLAG) -- */
+#define DMA_FLAG_FE			(1 << DMA_ISR_FEIF)
+#define DMA_FLAG_DME			(1 << DMA_ISR_DMEIF)
+#define DMA_FLAG_TE			(1 << DMA_ISR_TEIF)
+#define DMA_FLAG_HT			(1 << DMA_ISR_HTIF)
+#define DMA_FLAG_TC			(1 << DMA_ISR_TCIF)
+#define DMA_FLAG_ALL			(DMA_FLAG_FE | DMA_FLAG_DME | DMA_FLAG_TE | DMA_FLAG_HT | DMA_FLAG_TC)
+
+/* -- Polling Limit for a Stream to Stop -- */
+#define DMA_TIMEOUT			0x0000FFFFU
+
+
+/* -- APIs Supported by this driver -- */
+
+// Peripheral Clock Setup
+void DMA_PeriClockControl(DMA_RegDef_t *pDMAx, uint8_t EnorDi);
+
+// To configure a stream (stopped) for a peripheral data register
+void DMA_StreamInit(DMA_RegDef_t *pDMAx, uint8_t Stream, const DMA_Config_t *pDMAConfig, volatile void *pPeriphData);
+
+// To fix or increment the memory address (stream stopped; e.g. dummy bytes for SPI, incremented by default)
+void DMA_SetMemoryIncrement(DMA_RegDef_t *pDMAx, uint8_t Stream, uint8_t EnorDi);
+
+// To start a transfer of 'Count' bytes (1 to 65535) from/to memory
+void DMA_StreamStart(DMA_RegDef_t *pDMAx, uint8_t Stream, const volatile void *pMemory, uint16_t Count);
+
+// To stop a stream (waits until the current item is done)
+void DMA_StreamStop(DMA_RegDef_t *pDMAx, uint8_t Stream);
+
+// To get the number of items left (NDTR)
+uint16_t DMA_GetRemaining(DMA_RegDef_t *pDMAx, uint8_t Stream);
+
+// To get/clear the flags of a stream (@DMA_FLAG)
+uint8_t DMA_GetFlags(DMA_RegDef_t *pDMAx, uint8_t Stream);
+void DMA_ClearFlags(DMA_RegDef_t *pDMAx, uint8_t Stream, uint8_t Flags);
+
+
+#endif /* INC_STM32F407XX_DMA_DRIVERS_H_ */
@@ -0,0 +1,52 @@
+/*
+ * 									stm32f407xx_dwt_drivers.h
+ *
+ * This file contains the DWT (Data Watchpoint and Trace) cycle counter APIs shared by all drivers.
+ *
+ * 	> CYCCNT counts HCLK cycles (32 bits, wraps after ~25 s at 168 MHz)
+ * 	> All APIs are 'static inline': a measurement costs two loads from CYCCNT
+ *
+ */
+
+#ifndef INC_STM32F407XX_DWT_DRIVERS_H_
+#define INC_STM32F407XX_DWT_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DWT_CycleCounterInit
+ * Description	:	To enable the cycle counter (DWT_CYCCNT)
+ *
+ * Parameter 1	:	none
+ * Return Type	:	none (void)
+ * Note		:	TRCENA (DEMCR) MUST be set first, DWT registers are not writable otherwise.
+ *			Cleared only when stopped: a running counter (started by Reset_Handler) is one
+ *			monotonic timeline for every user (deferred log timestamps, wake-up times).
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void DWT_CycleCounterInit(void)
+{
+	*SCB_DEMCR |= (1U << SCB_DEMCR_TRCENA);
+	if (!(*DWT_CTRL & (1U << DWT_CTRL_CYCCNTENA)))
+	{
+		*DWT_CYCCNT = 0;
+		*DWT_CTRL |= (1U << DWT_CTRL_CYCCNTENA);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DWT_GetCycles
+ * Description	:	To read the cycle counter
+ *
+ * Parameter 1	:	none
+ * Return Type	:	HCLK cycles (uint32_t)
+ * Note		:	Elapsed cycles = DWT_GetCycles() - start (unsigned subtraction handles one wrap).
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t DWT_GetCycles(void)
+{
+	return *DWT_CYCCNT;
+}
+
+
+#endif /* INC_STM32F407XX_DWT_DRIVERS_H_ */
@@ -0,0 +1,46 @@
+/*
+ * 									stm32f407xx_flash_drivers.h
+ *
+ * This file contains all the Flash interface (FLASH_ACR) APIs supported by the driver.
+ *
+ * 	> Wait states (LATENCY) from the target HCLK and the supply voltage range
+ * 	> ART accelerator: instruction cache (ICEN), data cache (DCEN) and prefetch buffer (PRFTEN)
+ *
+ */
+
+#ifndef INC_STM32F407XX_FLASH_DRIVERS_H_
+#define INC_STM32F407XX_FLASH_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- Supply Voltage Ranges (@FLASH_VRANGE): HCLK per wait state -- */
+#define FLASH_VRANGE_1V8_2V1		0			// 20 MHz per WS (prefetch MUST stay disabled)
+#define FLASH_VRANGE_2V1_2V4		1			// 22 MHz per WS
+#define FLASH_VRANGE_2V4_2V7		2			// 24 MHz per WS
+#define FLASH_VRANGE_2V7_3V6		3			// 30 MHz per WS
+
+// STM32F407G-DISC1: VDD = 3 V
+#define FLASH_VRANGE_BOARD		FLASH_VRANGE_2V7_3V6
+
+/* -- Maximum Wait States (LATENCY[2:0]) -- */
+#define FLASH_LATENCY_MAX		7
+
+
+/* -- APIs Supported by this driver -- */
+
+// To get the number of wait states needed for a given HCLK and voltage range
+uint8_t FLASH_Latency_Value(uint32_t Hclk, uint8_t VoltageRange);
+
+// To program the wait states for a given HCLK and voltage range
+void FLASH_SetLatency(uint32_t Hclk, uint8_t VoltageRange);
+
+// To get the wait states currently programmed
+uint8_t FLASH_GetLatency(void);
+
+// To enable or disable the ART accelerator (instruction cache, data cache and prefetch)
+void FLASH_ARTControl(uint8_t EnOrDi);
+
+
+
+#endif /* INC_STM32F407XX_FLASH_DRIVERS_H_ */
@@ -11,6 +11,10 @@
 #include <stm32f407xx.h>
 
 
+/* -- Callback for a GPIO pin interrupt (called from the EXTI IRQ handler with the pin number) -- */
+typedef void (*GPIO_Callback_t)(uint8_t PinNumber);
+
+
 /* -- CONFIGURATION Structure for a GPIO pin -- */
 typedef struct
 {
@@ -21,6 +25,7 @@ typedef struct
 	uint8_t GPIO_PinPuPdControl;			// Possible values: GPIO_Pin_PULL_UP_and_PULL_DOWN_Configuration
 	uint8_t GPIO_PinOPType;				// Possible values: GPIO_Pin_Possible_Output_Type
 	uint8_t GPIO_PinAltFuncMode;
+	GPIO_Callback_t GPIO_PinCallback;		// Interrupt Modes only: registered for the pin(s) by GPIO_Init (NULL: none)
 
 }GPIO_PinConfig_t;
 
@@ -58,6 +63,14 @@ typedef struct
 #define GPIO_Pin_14			14
 #define GPIO_Pin_15			15
 
+// GPIO_Pin_Masks (for multi-pin APIs: GPIO_InitMask, GPIO_SetPins, GPIO_ResetPins)
+#define GPIO_PIN_MASK(x)		((uint16_t) (1U << (x)))
+#define GPIO_PIN_MASK_ALL		((uint16_t) 0xFFFF)
+
+// EXTI Lines served by each EXTI IRQ (for GPIO_IRQDispatch)
+#define GPIO_EXTI_LINES_9_5		((uint16_t) 0x03E0)
+#define GPIO_EXTI_LINES_15_10		((uint16_t) 0xFC00)
+
 
 // GPIO_Pin_Possible_Modes
 #define GPIO_MODE_IN			0				// Input Mode (reset state)
@@ -94,6 +107,7 @@ void GPIO_PeriClockControl(GPIO_RegDef_t *pGPIOx, uint8_t EnorDi);
 
 // Peripheral Initialize and De-initialize APIs
 void GPIO_Init(GPIO_Handle_t *pGPIOHandle);				// To initialize the GPIO peripheral
+void GPIO_InitMask(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, GPIO_PinConfig_t *pPinConfig);	// To initialize several pins at once
 void GPIO_DeInit(GPIO_RegDef_t *pGPIOx);				// To de-initialize the GPIO peripheral
 
 // Data Read and Write APIs
@@ -102,10 +116,14 @@ uint16_t GPIO_ReadFromInputPort(GPIO_RegDef_t *pGPIOx);
 void GPIO_WriteToOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Value);
 void GPIO_WriteToOutputPort(GPIO_RegDef_t *pGPIOx, uint16_t Value);
 void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber);
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask);		// Atomic (BSRR)
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask);		// Atomic (BSRR)
 
 // IRQ Configuration and ISR Handling
 void GPIO_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi);    	// To configure IRQ number of the GPIO
 void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);	// To configure the priority
 void GPIO_IRQHandling(uint8_t PinNumber);				// To process the interrupt
+void GPIO_RegisterCallback(uint8_t PinNumber, GPIO_Callback_t Callback);	// To register the callback of an EXTI Line
+void GPIO_IRQDispatch(uint16_t LineMask);				// To clear and dispatch all pending lines of LineMask
 
 #endif /* INC_STM32F407XX_GPIO_DRIVERS_H_ */
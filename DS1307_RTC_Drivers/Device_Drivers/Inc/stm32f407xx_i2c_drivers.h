@@ -40,6 +40,7 @@ typedef struct
 	uint8_t		DeviceAdddress;			// To store Slave/Device address
 	uint32_t	RxSize;				// To store Rx size
 	uint8_t		RepeatedStart;			// to store Repeated Start value (Sr)
+	uint8_t		TimingUpdatePending;		// SET: Pclk1 changed during a transfer (see I2C_UpdateTiming)
 
 }I2C_Handle_t;
 
@@ -95,6 +96,22 @@ typedef struct
 #define I2C_EVENT_DATA_REQUEST  	8
 #define I2C_EVENT_DATA_RECEIVE  	9
 
+/* -- Polled Transfer Status (@I2C_STATUS) -- */
+#define I2C_OK				0
+#define I2C_ERR_TIMEOUT			1			// Flag not set before the deadline (bus stuck, SCL/SDA held low)
+#define I2C_ERR_NACK			2			// Address or data not acknowledged (no device, device busy)
+
+/* -- Polled Transfer Deadline (every flag wait, SysTick time base) -- */
+#define I2C_TIMEOUT_MS			10			// One byte at 100 kHz is 90 us: margin for clock stretching
+#define I2C_TIMEOUT_POLLS		0x000FFFFFU		// Backstop while the tick cannot advance (SysTick not started,
+								// caller at or above the SysTick priority)
+
+/* -- Timing Update Status (@I2C_TIMING) -- */
+#define I2C_TIMING_OK			0			// FREQ, CCR and TRISE programmed
+#define I2C_TIMING_DEFERRED		1			// Transfer in progress, applied before the next one
+#define I2C_TIMING_ERR_PCLK		2			// Pclk1 out of range (min 2 MHz SM / 4 MHz FM, max 50 MHz)
+#define I2C_TIMING_ERR_DUTY		3			// FM: I2C_FM_DutyCycle not I2C_FM_DutyCycle_2 or _16_9
+
 /* -- General MACROS -- */
 // Repeated Start
 #define I2C_REPEATED_START_EN		ENABLE
@@ -113,9 +130,12 @@ void I2C_PeriClockControl(I2C_RegDef_t *pI2Cx, uint8_t EnorDi);
 void I2C_Init(I2C_Handle_t *pI2CHandle);
 void I2C_DeInit(I2C_RegDef_t *pI2Cx);
 
-// Data Send and Receive
-void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
-void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
+// To recompute FREQ, CCR and TRISE after a Pclk1 change (deferred while a transfer is in progress)
+uint8_t I2C_UpdateTiming(I2C_Handle_t *pI2CHandle);
+
+// Data Send and Receive (polled, bounded by I2C_TIMEOUT_MS per flag: returns @I2C_STATUS)
+uint8_t I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
+uint8_t I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
 
 uint8_t I2C_MasterSendData_IT(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
 uint8_t I2C_MasterReceiveData_IT(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart);
@@ -137,7 +157,7 @@ void I2C_GenerateStopCondition(I2C_RegDef_t *pI2Cx);
 void I2C_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi);     		// To configure IRQ number of the I2C
 void I2C_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority);		// To configure the priority
 
-void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle);				// TO handle interrupt by I2C EVENTS
+__RAMFUNC void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle);				// TO handle interrupt by I2C EVENTS
 void I2C_ER_IRQHandling(I2C_Handle_t *pI2CHandle);				// To handle interrupts by I2C ERRORS
 
 // Other Helper APIs
@@ -0,0 +1,54 @@
+/*
+ * 									stm32f407xx_itm_drivers.h
+ *
+ * This file contains all the ITM (Instrumentation Trace Macrocell) trace output APIs supported by the driver.
+ *
+ * 	> Output on the SWO pin (PB3, asynchronous NRZ) through the debug probe: no CPU halt per call
+ * 	  (unlike semihosting), a few cycles per 4 bytes
+ * 	> Channelled: one stimulus port per stream (stdout, stderr, timestamps), filtered by the host viewer
+ * 	> Non-blocking: when the stimulus FIFO stays full the rest of the write is dropped and counted
+ * 	> SWO prescaler re-computed after every clock change (RCC clock-change listener)
+ * 	> stdout/stderr (printf) routed here by syscalls.c when built with USE_ITM_TRACE
+ *
+ */
+
+#ifndef INC_STM32F407XX_ITM_DRIVERS_H_
+#define INC_STM32F407XX_ITM_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- Stimulus Ports (@ITM_PORT) -- */
+#define ITM_PORT_STDOUT			0				// printf (syscalls.c, file 1)
+#define ITM_PORT_STDERR			1				// syscalls.c, file 2
+#define ITM_PORT_TIME			2				// Timestamp readings
+#define ITM_PORT_DLOG			3				// Deferred log records (dlog.h, binary)
+#define ITM_PORTS			8				// Ports enabled and counted: 0 to ITM_PORTS - 1
+
+/* -- Default SWO Bit Rate (MUST match the host viewer, e.g. SWV settings) -- */
+#define ITM_SWO_HZ			2000000U
+
+/* -- FIFO Polls before Dropping (one 32-bit write is ~20 SWO bits) -- */
+#define ITM_FIFO_RETRIES		64
+
+/* -- Return Status (@ITM_STATUS) -- */
+#define ITM_OK				0
+#define ITM_ERR_RATE			1			// SWO bit rate above HCLK or prescaler out of range
+
+
+/* -- APIs Supported by this driver -- */
+
+// To set up the TPIU (SWO, NRZ) and the ITM, ports 0 to ITM_PORTS - 1 enabled (returns @ITM_STATUS)
+uint8_t ITM_Init(uint32_t SwoHz);
+
+// To write bytes on a stimulus port without blocking (returns the bytes written, the rest is dropped)
+uint32_t ITM_Write(uint8_t Port, const char *pData, uint32_t Len);
+
+// To know if a stimulus port is traced (ITM enabled by ITM_Init or the debugger, port enabled)
+uint8_t ITM_IsEnabled(uint8_t Port);
+
+// To get the bytes dropped on a stimulus port since ITM_Init (FIFO full)
+uint32_t ITM_GetDropCount(uint8_t Port);
+
+
+#endif /* INC_STM32F407XX_ITM_DRIVERS_H_ */
@@ -0,0 +1,246 @@
+/*
+ * 									stm32f407xx_nvic_drivers.h
+ *
+ * This file contains the NVIC (Nested Vectored Interrupt Controller) APIs shared by all drivers.
+ *
+ * 	> All APIs are 'static inline': with a constant IRQ number, register and bit position are
+ * 	  computed at compile time (one store, no range checks, no branches)
+ * 	> ISER/ICER/ISPR/ICPR are write-1 registers: written directly, never read-modify-write
+ * 	> IPR is byte accessible: a priority is replaced (old value cleared) with a single byte store
+ *
+ */
+
+#ifndef INC_STM32F407XX_NVIC_DRIVERS_H_
+#define INC_STM32F407XX_NVIC_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- Priority Grouping (@NVIC_PRIGROUP): preemption bits . sub-priority bits (4 bits implemented) -- */
+#define NVIC_PRIGROUP_4_0			3				// 16 preemption levels, no sub-priority (reset value)
+#define NVIC_PRIGROUP_3_1			4				// 8 preemption levels, 2 sub-priorities
+#define NVIC_PRIGROUP_2_2			5				// 4 preemption levels, 4 sub-priorities
+#define NVIC_PRIGROUP_1_3			6				// 2 preemption levels, 8 sub-priorities
+#define NVIC_PRIGROUP_0_4			7				// no preemption, 16 sub-priorities
+
+/* -- Lowest Priority (highest value) with PRI_BITS_IMPLEMENTED -- */
+#define NVIC_PRIORITY_LOWEST		((1U << PRI_BITS_IMPLEMENTED) - 1)
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_EnableIRQ
+ * Description	:	To enable an IRQ (NVIC_ISERx)
+ *
+ * Parameter 1	:	IRQ number
+ * Return Type	:	none (void)
+ * Note		:	Writing 0 has no effect, so only the bit of the IRQ is written.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_EnableIRQ(uint8_t IRQNumber)
+{
+	NVIC_ISER[IRQNumber >> 5] = (1U << (IRQNumber & 0x1F));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_DisableIRQ
+ * Description	:	To disable an IRQ (NVIC_ICERx)
+ *
+ * Parameter 1	:	IRQ number
+ * Return Type	:	none (void)
+ * Note		:	Writing 0 has no effect, so only the bit of the IRQ is written.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_DisableIRQ(uint8_t IRQNumber)
+{
+	NVIC_ICER[IRQNumber >> 5] = (1U << (IRQNumber & 0x1F));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_SetPendingIRQ / NVIC_ClearPendingIRQ
+ * Description	:	To set or clear the pending state of an IRQ (NVIC_ISPRx / NVIC_ICPRx)
+ *
+ * Parameter 1	:	IRQ number
+ * Return Type	:	none (void)
+ * Note		:
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_SetPendingIRQ(uint8_t IRQNumber)
+{
+	NVIC_ISPR[IRQNumber >> 5] = (1U << (IRQNumber & 0x1F));
+}
+
+static inline void NVIC_ClearPendingIRQ(uint8_t IRQNumber)
+{
+	NVIC_ICPR[IRQNumber >> 5] = (1U << (IRQNumber & 0x1F));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_SetPriority
+ * Description	:	To set the priority of an IRQ (NVIC_IPRx)
+ *
+ * Parameter 1	:	IRQ number
+ * Parameter 2	:	Priority [0 (highest) to NVIC_PRIORITY_LOWEST]
+ * Return Type	:	none (void)
+ * Note		:	Byte store: the previous priority is replaced (not ORed), the other three IRQs sharing
+ *			the 32-bit IPR register are untouched. Only the upper PRI_BITS_IMPLEMENTED bits exist.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_SetPriority(uint8_t IRQNumber, uint32_t IRQPriority)
+{
+	NVIC_IPR[IRQNumber] = (uint8_t) ((IRQPriority << (8 - PRI_BITS_IMPLEMENTED)) & 0xFF);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_GetPriority
+ * Description	:	To get the priority of an IRQ (NVIC_IPRx)
+ *
+ * Parameter 1	:	IRQ number
+ * Return Type	:	Priority [0 to NVIC_PRIORITY_LOWEST] (uint32_t)
+ * Note		:
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t NVIC_GetPriority(uint8_t IRQNumber)
+{
+	return (uint32_t) NVIC_IPR[IRQNumber] >> (8 - PRI_BITS_IMPLEMENTED);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_SetPriorityGrouping
+ * Description	:	To split the priority bits into preemption priority and sub-priority (SCB_AIRCR.PRIGROUP)
+ *
+ * Parameter 1	:	Priority Grouping (@NVIC_PRIGROUP)
+ * Return Type	:	none (void)
+ * Note		:	AIRCR is only written with the VECTKEY in [31:16], other bits are preserved.
+ *			Configure once, before setting any priority.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_SetPriorityGrouping(uint8_t PriGroup)
+{
+	uint32_t aircr = *SCB_AIRCR;
+
+	// Clear VECTKEYSTAT (reads back as 0xFA05) and PRIGROUP, then write key and new grouping
+	aircr &= ~((0xFFFFU << 16) | (0x7U << SCB_AIRCR_PRIGROUP));
+	aircr |= (SCB_AIRCR_VECTKEY << 16) | ((uint32_t) (PriGroup & 0x7) << SCB_AIRCR_PRIGROUP);
+
+	*SCB_AIRCR = aircr;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_GetPriorityGrouping
+ * Description	:	To get the Priority Grouping (SCB_AIRCR.PRIGROUP)
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	Priority Grouping (@NVIC_PRIGROUP) (uint8_t)
+ * Note		:
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint8_t NVIC_GetPriorityGrouping(void)
+{
+	return (uint8_t) ((*SCB_AIRCR >> SCB_AIRCR_PRIGROUP) & 0x7);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_EncodePriority
+ * Description	:	To build a priority value from preemption priority and sub-priority
+ *
+ * Parameter 1	:	Priority Grouping (@NVIC_PRIGROUP)
+ * Parameter 2	:	Preemption priority
+ * Parameter 3	:	Sub-priority
+ * Return Type	:	Priority for NVIC_SetPriority (uint32_t)
+ * Note		:	Values too large for their field are truncated.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t NVIC_EncodePriority(uint8_t PriGroup, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	// Sub-priority bits among the implemented ones: PRIGROUP - (7 - PRI_BITS_IMPLEMENTED), none below that
+	uint32_t subBits = ((PriGroup & 0x7) > (7 - PRI_BITS_IMPLEMENTED)) ? ((PriGroup & 0x7) - (7 - PRI_BITS_IMPLEMENTED)) : 0;
+	uint32_t preemptBits = PRI_BITS_IMPLEMENTED - subBits;
+
+	return ((PreemptPriority & ((1U << preemptBits) - 1)) << subBits) | (SubPriority & ((1U << subBits) - 1));
+}
+
+
+/* -- Critical Sections (BASEPRI) --
+ * Mask only the interrupts with a priority value >= given priority (lower urgency), higher priority
+ * interrupts (e.g. time-stamping edges) keep running. Nesting is supported:
+ *
+ * 	uint32_t state = NVIC_EnterCritical(5);
+ * 	...
+ * 	NVIC_ExitCritical(state);
+ */
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_EnterCritical
+ * Description	:	To mask all interrupts with a priority lower than or equal to the given one
+ *
+ * Parameter 1	:	Priority [1 to NVIC_PRIORITY_LOWEST] (0 has no effect: BASEPRI = 0 disables masking)
+ * Return Type	:	Previous BASEPRI, to be given to NVIC_ExitCritical (uint32_t)
+ * Note		:	BASEPRI_MAX only raises the masking level, so a nested call never lowers it.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t NVIC_EnterCritical(uint32_t Priority)
+{
+	uint32_t previous;
+	uint32_t basepri = (Priority << (8 - PRI_BITS_IMPLEMENTED)) & 0xFF;
+
+	__asm volatile ("mrs %0, basepri" : "=r" (previous));
+	__asm volatile ("msr basepri_max, %0" : : "r" (basepri) : "memory");
+
+	return previous;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_ExitCritical
+ * Description	:	To restore the masking level saved by NVIC_EnterCritical
+ *
+ * Parameter 1	:	Value returned by NVIC_EnterCritical (uint32_t)
+ * Return Type	:	none (void)
+ * Note		:
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_ExitCritical(uint32_t State)
+{
+	__asm volatile ("msr basepri, %0" : : "r" (State) : "memory");
+}
+
+
+/* -- Critical Sections (PRIMASK) --
+ * Mask every configurable-priority interrupt (state shared with any ISR, short sections only).
+ * Nesting is supported, and the saved PRIMASK is restored (not cleared):
+ *
+ * 	uint32_t primask = NVIC_EnterCriticalAll();
+ * 	...
+ * 	NVIC_ExitCriticalAll(primask);
+ */
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_EnterCriticalAll
+ * Description	:	To mask all interrupts (PRIMASK), HardFault and NMI excepted
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	Previous PRIMASK, to be given to NVIC_ExitCriticalAll (uint32_t)
+ * Note		:	Read and mask back to back: callable from thread and ISR, nested sections included.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline uint32_t NVIC_EnterCriticalAll(void)
+{
+	uint32_t primask;
+
+	__asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+
+	return primask;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	NVIC_ExitCriticalAll
+ * Description	:	To restore the PRIMASK saved by NVIC_EnterCriticalAll
+ *
+ * Parameter 1	:	Value returned by NVIC_EnterCriticalAll (uint32_t)
+ * Return Type	:	none (void)
+ * Note		:	Interrupts stay masked when the section was entered with PRIMASK already set.
+ * ------------------------------------------------------------------------------------------------------ */
+static inline void NVIC_ExitCriticalAll(uint32_t State)
+{
+	__asm volatile ("msr primask, %0" :: "r" (State) : "memory");
+}
+
+
+#endif /* INC_STM32F407XX_NVIC_DRIVERS_H_ */
@@ -3,15 +3,137 @@
  *
  * This file contains all the RCC-related APIs supported by the driver.
  *
+ * 	> System clock from HSI, HSE or PLL (up to 168 MHz)
+ * 	> SYSCLK, HCLK, PCLK1 and PCLK2 are cached after every clock change: getters are O(1)
+ * 	> Clock-change listeners: drivers re-time their peripherals (e.g. I2C) after every change
+ *
  */
 
-#include <stm32f407xx.h>
-
 #ifndef INC_STM32F407XX_RCC_DRIVERS_H_
 #define INC_STM32F407XX_RCC_DRIVERS_H_
 
+#include <stm32f407xx.h>
+
+
+/* -- Oscillator Frequencies -- */
+#define RCC_HSI_VALUE			16000000U		// Internal RC oscillator
+#define RCC_HSE_VALUE			8000000U		// STM32F407G-DISC1 crystal (X2)
+
+/* -- Maximum Frequencies (Voltage Scale 1, VDD 2.7 V to 3.6 V) -- */
+#define RCC_SYSCLK_MAX			168000000U
+#define RCC_PCLK1_MAX			42000000U
+#define RCC_PCLK2_MAX			84000000U
+
+/* -- System Clock Sources (@RCC_SYSCLK) -- */
+#define RCC_SYSCLK_HSI			0
+#define RCC_SYSCLK_HSE			1
+#define RCC_SYSCLK_PLL			2
+
+/* -- PLL Sources (@RCC_PLLSRC) -- */
+#define RCC_PLLSRC_HSI			0
+#define RCC_PLLSRC_HSE			1
+
+/* -- AHB Prescaler (@RCC_AHB_DIV) : RCC_CFGR HPRE encoding -- */
+#define RCC_AHB_DIV1			0
+#define RCC_AHB_DIV2			8
+#define RCC_AHB_DIV4			9
+#define RCC_AHB_DIV8			10
+#define RCC_AHB_DIV16			11
+#define RCC_AHB_DIV64			12
+#define RCC_AHB_DIV128			13
+#define RCC_AHB_DIV256			14
+#define RCC_AHB_DIV512			15
+
+/* -- APB1/APB2 Prescaler (@RCC_APB_DIV) : RCC_CFGR PPREx encoding -- */
+#define RCC_APB_DIV1			0
+#define RCC_APB_DIV2			4
+#define RCC_APB_DIV4			5
+#define RCC_APB_DIV8			6
+#define RCC_APB_DIV16			7
+
+/* -- Return Status (@RCC_STATUS) -- */
+#define RCC_OK				0
+#define RCC_ERR_CONFIG			1			// Out of range PLL factors or bus frequencies
+#define RCC_ERR_HSE			2			// HSE not ready (timeout)
+#define RCC_ERR_PLL			3			// PLL not locked (timeout)
+#define RCC_ERR_SWITCH			4			// System clock switch not completed (timeout)
+
+/* -- Reset Flags (@RCC_RESET_FLAG) : RCC_CSR[31:25] >> 24, several can be set at once -- */
+#define RCC_RESET_BOR			(1 << 1)		// Brown-out (also set on power-on)
+#define RCC_RESET_PIN			(1 << 2)		// NRST pin (also set by every internal reset)
+#define RCC_RESET_POR			(1 << 3)		// Power-on / power-down
+#define RCC_RESET_SOFTWARE		(1 << 4)		// SYSRESETREQ (NVIC_SystemReset)
+#define RCC_RESET_IWDG			(1 << 5)		// Independent watchdog
+#define RCC_RESET_WWDG			(1 << 6)		// Window watchdog
+#define RCC_RESET_LPWR			(1 << 7)		// Illegal STOP/STANDBY entry (option bytes)
+
+/* -- Polling Limit for Ready Flags -- */
+#define RCC_TIMEOUT			0x0000FFFFU
+
+/* -- Maximum number of Clock-change Listeners -- */
+#define RCC_MAX_CLOCK_LISTENERS		6
+
+/* -- Clock-change Listener: called after the clock cache is updated (new values via the getters) -- */
+typedef void (*RCC_ClockListener_t)(void);
+
+/* -- Clock Configuration Structure -- */
+typedef struct
+{
+	uint8_t RCC_SysClkSource;			// @RCC_SYSCLK
+	uint8_t RCC_PLLSource;				// @RCC_PLLSRC
+	uint8_t RCC_PLLM;				// [2 to 63]	: VCO input  = PLL source / M	(1 to 2 MHz)
+	uint16_t RCC_PLLN;				// [50 to 432]	: VCO output = VCO input * N	(100 to 432 MHz)
+	uint8_t RCC_PLLP;				// [2, 4, 6, 8]	: PLLCLK     = VCO output / P
+	uint8_t RCC_PLLQ;				// [2 to 15]	: 48 MHz clock = VCO output / Q (USB, SDIO, RNG)
+	uint8_t RCC_AHBPrescaler;			// @RCC_AHB_DIV
+	uint8_t RCC_APB1Prescaler;			// @RCC_APB_DIV
+	uint8_t RCC_APB2Prescaler;			// @RCC_APB_DIV
+}RCC_ClockConfig_t;
+
+/* -- Ready-made Configurations (defined in stm32f407xx_rcc_drivers.c) -- */
+
+// Reset state: HSI 16 MHz, all buses 16 MHz
+extern const RCC_ClockConfig_t RCC_Config_HSI_16MHz;
+
+// HSE 8 MHz -> PLL (M 8, N 336, P 2, Q 7): SYSCLK/HCLK 168 MHz, PCLK1 42 MHz, PCLK2 84 MHz, 48 MHz clock
+extern const RCC_ClockConfig_t RCC_Config_PLL_168MHz;
+
+// HSI 16 MHz -> PLL (M 16, N 336, P 2, Q 7): same bus clocks, no HSE start-up (fast wake-up from STOP)
+extern const RCC_ClockConfig_t RCC_Config_PLL_HSI_168MHz;
+
+
+/* -- APIs Supported by this driver -- */
+
+/* - Clock Configuration - */
+
+// To switch the System Clock (oscillator, PLL, bus prescalers and Flash latency)
+uint8_t RCC_ClockConfig(const RCC_ClockConfig_t *pClockConfig);
+
+// To change only the AHB prescaler (dynamic scaling: HCLK, PCLK1 and PCLK2 follow, SYSCLK/PLL untouched)
+uint8_t RCC_SetHclkPrescaler(uint8_t AHBPrescaler);
+
+// To refresh the cached clock values from the RCC registers
+void RCC_UpdateClockCache(void);
+
+// To register a function called after every clock change
+uint8_t RCC_RegisterClockListener(RCC_ClockListener_t Listener);
+
+/* - Reset Cause - */
+
+// To get the cause(s) of the last reset (@RCC_RESET_FLAG), flags are cleared in RCC_CSR on the first call
+uint8_t RCC_GetResetFlags(void);
+
 /* - To get System Clock Frequency - */
 
+// To get PLL output Frequency (PLLCLK, computed from RCC_PLLCFGR)
+uint32_t RCC_PLLClk_Value(void);
+
+// To get System Clock Frequency (SYSCLK)
+uint32_t RCC_SysClk_Value(void);
+
+// To get AHB Clock Frequency (HCLK)
+uint32_t RCC_Hclk_Value(void);
+
 // To get Peripheral Clock APB1 Frequency (pCLK1)
 uint32_t RCC_Pclk1_Value(void);
 
@@ -0,0 +1,130 @@
+/*
+ * 									stm32f407xx_spi_drivers.h
+ *
+ * This file contains all the SPI (master, 8-bit, MSB first) APIs supported by the driver.
+ *
+ * 	> SCLK given as an upper limit (device maximum): highest PCLK / 2^n not above it,
+ * 	  re-computed after every clock change (RCC clock-change listener)
+ * 	> Polled full-duplex transfers for short register accesses (a few bytes at MHz rates)
+ * 	> DMA full-duplex transfers for blocks: RX and TX streams started together, completion
+ * 	  signalled by the RX stream (last byte received, bus idle)
+ * 	> Chip select driven by the driver on a GPIO pin (software NSS), active low or high
+ * 	> DMA streams chosen from the peripheral (reference manual request mapping, see spiDmaMap)
+ *
+ * 	The application sets up the pins (SCK/MISO/MOSI alternate function, CS output) and, for DMA
+ * 	transfers, routes the IRQs of both streams (SPI_GetIRQNumbers) to SPI_DMA_IRQHandling.
+ *
+ */
+
+#ifndef INC_STM32F407XX_SPI_DRIVERS_H_
+#define INC_STM32F407XX_SPI_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- CONFIGURATION Structure for a SPI Peripheral -- */
+typedef struct
+{
+	uint32_t	SPI_MaxHz;				// SCLK upper limit [Hz] (device datasheet)
+	uint8_t		SPI_CPOL;				// Possible values: @SPI_CPOL
+	uint8_t		SPI_CPHA;				// Possible values: @SPI_CPHA
+	uint8_t		SPI_DMA;				// ENABLE: DMA streams set up by SPI_Init (SPI_TransferDMA)
+
+}SPI_Config_t;
+
+/* -- Handle Structure for SPIx Peripheral --  */
+typedef struct
+{
+	// Base address of the SPIx Peripheral (SPI1, SPI2, SPI3, SPI4)
+	SPI_RegDef_t	*pSPIx;
+
+	// To hold different SPI configuration
+	SPI_Config_t	SPI_Config;
+
+	// Chip select pin (GPIO output set up by the application), NULL: not driven by the driver
+	GPIO_RegDef_t	*pCSPort;
+	uint8_t		CSPin;
+	uint8_t		CSActiveHigh;			// 0: active low (most devices), 1: active high (e.g. DS1305 CE)
+
+	// Filled by SPI_Init
+	DMA_RegDef_t	*pDMAx;				// DMA controller of both streams
+	uint8_t		TxStream;
+	uint8_t		RxStream;
+	uint32_t	SclkHz;				// SCLK obtained for the current PCLK
+	volatile uint8_t State;				// @SPI_STATE
+	volatile uint8_t LastError;			// @SPI_STATUS of the last DMA transfer (SPI_ERR_DMA: TE)
+	volatile uint8_t ClockPending;			// PCLK changed during a DMA transfer: re-timed when it ends
+
+}SPI_Handle_t;
+
+/* -- SPI Configuration Macros -- */
+
+// @SPI_CPOL
+#define SPI_CPOL_LOW			0				// SCLK idle low
+#define SPI_CPOL_HIGH			1				// SCLK idle high
+
+// @SPI_CPHA
+#define SPI_CPHA_FIRST			0				// Data captured on the first edge
+#define SPI_CPHA_SECOND			1				// Data captured on the second edge
+
+/* -- Transfer State (@SPI_STATE) -- */
+#define SPI_READY			0
+#define SPI_BUSY_DMA			1
+
+/* -- Return Status (@SPI_STATUS) -- */
+#define SPI_OK				0
+#define SPI_ERR_CONFIG			1			// Peripheral, SCLK limit or buffer (CCMRAM) not supported
+#define SPI_ERR_BUSY			2			// DMA transfer running
+#define SPI_ERR_TIMEOUT			3			// Flag not set in time (clock off, bus stuck)
+#define SPI_ERR_DMA			4			// DMA transfer error (TE): transfer aborted, data incomplete
+
+/* -- Possible SPI Application Events (Application callback) -- */
+#define SPI_EVENT_DMA_DONE		0			// DMA transfer complete (last byte received)
+#define SPI_ERROR_DMA			1			// DMA transfer error (transfer aborted)
+
+/* -- Byte sent when no TX buffer is given (read-only transfers) -- */
+#define SPI_DUMMY_BYTE			0xFF
+
+/* -- Polling Limit per Byte and Number of SPI Peripherals (clock listener) -- */
+#define SPI_TIMEOUT			0x0000FFFFU
+#define SPI_MAX_HANDLES			4
+
+
+/* -- APIs Supported by this driver -- */
+
+// Peripheral Clock Setup
+void SPI_PeriClockControl(SPI_RegDef_t *pSPIx, uint8_t EnorDi);
+
+// Peripheral Initialize (master, with DMA streams if selected) and De-initialize APIs (returns @SPI_STATUS)
+uint8_t SPI_Init(SPI_Handle_t *pSPIHandle);
+void SPI_DeInit(SPI_Handle_t *pSPIHandle);
+
+// To recompute the SCLK prescaler after a PCLK change (done by the clock listener, deferred while busy)
+uint8_t SPI_UpdateClock(SPI_Handle_t *pSPIHandle);
+
+// To assert (ENABLE) or release (DISABLE) the chip select
+void SPI_ChipSelect(SPI_Handle_t *pSPIHandle, uint8_t EnorDi);
+
+// To send and receive 'Len' bytes, polled (pTx NULL: SPI_DUMMY_BYTE sent, pRx NULL: discarded)
+uint8_t SPI_Transfer(SPI_Handle_t *pSPIHandle, const uint8_t *pTx, uint8_t *pRx, uint32_t Len);
+
+// To start the same transfer by DMA (1 to 65535 bytes, returns at once; done: SPI_EVENT_DMA_DONE)
+uint8_t SPI_TransferDMA(SPI_Handle_t *pSPIHandle, const uint8_t *pTx, uint8_t *pRx, uint16_t Len);
+
+// To wait for the end of a DMA transfer (returns @SPI_STATUS: SPI_ERR_DMA on a transfer error)
+uint8_t SPI_WaitDone(SPI_Handle_t *pSPIHandle, uint32_t Timeout);
+
+// To stop a DMA transfer (both streams, SPI DMA requests): buffers released, handle ready
+void SPI_AbortDMA(SPI_Handle_t *pSPIHandle);
+
+// To get the IRQ numbers of the DMA streams (TX, RX)
+void SPI_GetIRQNumbers(SPI_Handle_t *pSPIHandle, uint8_t *pTxIRQ, uint8_t *pRxIRQ);
+
+// ISR Handling (both DMA streams)
+void SPI_DMA_IRQHandling(SPI_Handle_t *pSPIHandle);
+
+// Application Callbacks [To be implemented in the application]
+void SPI_ApplicationEventCallback(SPI_Handle_t *pSPIHandle, uint8_t ApplicationEvent);
+
+
+#endif /* INC_STM32F407XX_SPI_DRIVERS_H_ */
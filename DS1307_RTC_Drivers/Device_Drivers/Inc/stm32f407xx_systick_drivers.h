@@ -0,0 +1,54 @@
+/*
+ * 									stm32f407xx_systick_drivers.h
+ *
+ * This file contains all the SysTick (system timer) APIs supported by the driver.
+ *
+ * 	> Tick counter at a configurable rate (1 kHz: millisecond time base), from HCLK
+ * 	> Reload re-computed after every clock change (RCC clock-change listener)
+ * 	> One tick hook, called from SysTick_Handler (e.g. TimerWheel_Tick)
+ *
+ */
+
+#ifndef INC_STM32F407XX_SYSTICK_DRIVERS_H_
+#define INC_STM32F407XX_SYSTICK_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- Default Tick Rate: 1 tick = 1 ms -- */
+#define SYSTICK_TICK_HZ			1000U
+
+/* -- Return Status (@SYSTICK_STATUS) -- */
+#define SYSTICK_OK			0
+#define SYSTICK_ERR_RATE		1			// Reload value out of the 24-bit range for this HCLK
+
+/* -- Tick Hook: called from SysTick_Handler (interrupt context) after the counter is incremented -- */
+typedef void (*SysTick_Hook_t)(void);
+
+
+/* -- APIs Supported by this driver -- */
+
+// To start the tick counter (rate in Hz, exception priority [0 to NVIC_PRIORITY_LOWEST])
+uint8_t SysTick_Init(uint32_t TickHz, uint8_t Priority);
+
+// To stop the tick counter (SysTick exception disabled)
+void SysTick_DeInit(void);
+
+// To get the number of ticks since SysTick_Init (wraps around after 2^32 ticks)
+uint32_t SysTick_GetTicks(void);
+
+// To get the number of ticks elapsed since a SysTick_GetTicks value (wrap-around safe)
+uint32_t SysTick_Elapsed(uint32_t StartTicks);
+
+// To convert milliseconds into ticks (rounded up)
+uint32_t SysTick_MsToTicks(uint32_t Ms);
+
+// To wait (blocking) for at least 'Ms' milliseconds
+void SysTick_Delay(uint32_t Ms);
+
+// To install the tick hook (NULL to remove)
+void SysTick_SetTickHook(SysTick_Hook_t Hook);
+
+
+
+#endif /* INC_STM32F407XX_SYSTICK_DRIVERS_H_ */
@@ -0,0 +1,62 @@
+/*
+ * 									stm32f407xx_tim_drivers.h
+ *
+ * This file contains all the General-purpose Timer (TIM2 to TIM5) APIs supported by the driver.
+ *
+ * 	> Free-running counter (ARR 0xFFFF) with input capture on one channel
+ * 	> Polled capture: no interrupt per edge, the caller accumulates the tick deltas
+ * 	> Timer kernel clock from the cached RCC values (x2 when the APB1 prescaler is not 1)
+ *
+ */
+
+#ifndef INC_STM32F407XX_TIM_DRIVERS_H_
+#define INC_STM32F407XX_TIM_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- Channels (@TIM_CHANNEL) -- */
+#define TIM_CHANNEL_1			1
+#define TIM_CHANNEL_2			2
+#define TIM_CHANNEL_3			3
+#define TIM_CHANNEL_4			4
+
+/* -- Input Capture Prescaler (@TIM_ICPSC): capture every N edges -- */
+#define TIM_ICPSC_DIV1			0
+#define TIM_ICPSC_DIV2			1
+#define TIM_ICPSC_DIV4			2
+#define TIM_ICPSC_DIV8			3
+
+/* -- Input Capture Edge (@TIM_ICEDGE) -- */
+#define TIM_ICEDGE_RISING		0
+#define TIM_ICEDGE_FALLING		1
+
+/* -- Return Status (@TIM_STATUS) -- */
+#define TIM_OK				0
+#define TIM_ERR_TIMEOUT			1			// No capture within the polling limit
+#define TIM_ERR_OVERCAPTURE		2			// A capture was lost (read too late)
+
+/* -- Polling Limit for a Capture -- */
+#define TIM_TIMEOUT			0x000FFFFFU
+
+
+/* -- APIs Supported by this driver -- */
+
+// Peripheral Clock Setup
+void TIM_PeriClockControl(TIM_RegDef_t *pTIMx, uint8_t EnorDi);
+
+// To get the counter clock of a TIM2 to TIM5 timer (prescaler 0)
+uint32_t TIM_Clock_Value(void);
+
+// To start the free-running counter with input capture on one channel
+void TIM_IC_Init(TIM_RegDef_t *pTIMx, uint8_t Channel, uint8_t Edge, uint8_t ICPrescaler, uint8_t ICFilter);
+
+// To wait for the next capture on a channel (returns @TIM_STATUS)
+uint8_t TIM_IC_WaitCapture(TIM_RegDef_t *pTIMx, uint8_t Channel, uint16_t *pCapture);
+
+// To stop the counter and disable the capture channel
+void TIM_IC_DeInit(TIM_RegDef_t *pTIMx, uint8_t Channel);
+
+
+
+#endif /* INC_STM32F407XX_TIM_DRIVERS_H_ */
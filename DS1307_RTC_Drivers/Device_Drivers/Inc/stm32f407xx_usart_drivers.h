@@ -0,0 +1,131 @@
+/*
+ * 									stm32f407xx_usart_drivers.h
+ *
+ * This file contains all the USART (asynchronous, 8 data bits) APIs supported by the driver.
+ *
+ * 	> TX: circular buffer emptied by DMA, one transfer per contiguous segment (no interrupt per byte).
+ * 	  USART_Write only copies into the buffer and returns: it never waits for the line
+ * 	> RX: DMA in circular mode into a buffer, IDLE line interrupt signals the end of a burst
+ * 	> Baud rate re-computed after every clock change (RCC clock-change listener)
+ * 	> DMA streams chosen from the peripheral (reference manual request mapping, see usartDmaMap)
+ * 	> Buffers are given by the application and MUST be in SRAM (not CCMRAM: no DMA access)
+ *
+ * 	The application routes the IRQs of the peripheral and of its two DMA streams (USART_GetIRQNumbers):
+ * 		USARTx_IRQHandler		-> USART_IRQHandling
+ * 		DMAx_Streamy_IRQHandler (TX)	-> USART_DMA_TX_IRQHandling
+ * 		DMAx_Streamy_IRQHandler (RX)	-> USART_DMA_RX_IRQHandling
+ *
+ */
+
+#ifndef INC_STM32F407XX_USART_DRIVERS_H_
+#define INC_STM32F407XX_USART_DRIVERS_H_
+
+#include <stm32f407xx.h>
+
+
+/* -- CONFIGURATION Structure for a USART Peripheral -- */
+typedef struct
+{
+	uint32_t	USART_Baud;				// Possible values: @USART_BAUD (any rate PCLK / 16 can reach)
+	uint8_t		USART_StopBits;				// Possible values: @USART_STOPBITS
+	uint8_t		USART_Parity;				// Possible values: @USART_PARITY
+
+}USART_Config_t;
+
+/* -- Handle Structure for USARTx Peripheral --  */
+typedef struct
+{
+	// Base address of the USARTx Peripheral (USART1, USART2, USART3, UART4, UART5, USART6)
+	USART_RegDef_t	*pUSARTx;
+
+	// To hold different USART configuration
+	USART_Config_t	USART_Config;
+
+	// Buffers given by the application (SRAM): TX size power of 2, RX NULL for TX only
+	uint8_t		*pTxBuffer;
+	uint32_t	TxSize;
+	uint8_t		*pRxBuffer;
+	uint16_t	RxSize;
+
+	// Filled by USART_Init
+	DMA_RegDef_t	*pDMAx;				// DMA controller of both streams
+	uint8_t		TxStream;
+	uint8_t		RxStream;
+	volatile uint32_t TxHead;			// Free-running indexes: written up to TxHead,
+	volatile uint32_t TxTail;			// sent up to TxTail,
+	volatile uint32_t TxDMALength;			// bytes of the running DMA transfer (0: idle)
+	uint32_t	RxRead;				// Read up to RxRead (index in pRxBuffer)
+	uint32_t	TxDropped;			// Bytes USART_Write could not queue (buffer full)
+	uint32_t	RxErrors;			// Overrun/framing/noise errors
+
+}USART_Handle_t;
+
+/* -- USART Configuration Macros -- */
+
+// @USART_BAUD
+#define USART_BAUD_9600			9600
+#define USART_BAUD_115200		115200
+#define USART_BAUD_921600		921600
+
+// @USART_STOPBITS
+#define USART_STOPBITS_1		0
+#define USART_STOPBITS_2		2
+
+// @USART_PARITY
+#define USART_PARITY_NONE		0
+#define USART_PARITY_EVEN		1
+#define USART_PARITY_ODD		2
+
+/* -- Return Status (@USART_STATUS) -- */
+#define USART_OK			0
+#define USART_ERR_CONFIG		1			// Peripheral, buffer (size, CCMRAM) or parity not supported
+#define USART_ERR_BAUD			2			// Baud rate not reachable with the current PCLK
+
+/* -- Possible USART Application Events (Application callback) -- */
+#define USART_EVENT_TX_DONE		0			// TX buffer empty (last DMA transfer complete)
+#define USART_EVENT_RX_DATA		1			// RX buffer half/fully written (USART_Read)
+#define USART_EVENT_RX_IDLE		2			// Line idle after a burst (USART_Read)
+#define USART_ERROR_RX			3			// Overrun, framing or noise error (counted)
+#define USART_ERROR_DMA			4			// DMA transfer error (stream stopped)
+
+/* -- Number of USART Peripherals (clock listener) -- */
+#define USART_MAX_HANDLES		6
+
+
+/* -- APIs Supported by this driver -- */
+
+// Peripheral Clock Setup
+void USART_PeriClockControl(USART_RegDef_t *pUSARTx, uint8_t EnorDi);
+
+// Peripheral Initialize (with DMA streams) and De-initialize APIs (returns @USART_STATUS)
+uint8_t USART_Init(USART_Handle_t *pUSARTHandle);
+void USART_DeInit(USART_Handle_t *pUSARTHandle);
+
+// To recompute the baud rate register after a PCLK change (done by the clock listener)
+uint8_t USART_UpdateBaud(USART_Handle_t *pUSARTHandle);
+
+// To queue bytes for transmission without waiting (returns the bytes queued, the rest is dropped)
+uint32_t USART_Write(USART_Handle_t *pUSARTHandle, const void *pData, uint32_t Len);
+
+// To get the bytes queued and not sent yet
+uint32_t USART_TxPending(USART_Handle_t *pUSARTHandle);
+
+// To wait until everything queued is on the line (e.g. before STOP mode), returns 0: done, 1: timeout
+uint8_t USART_Flush(USART_Handle_t *pUSARTHandle, uint32_t Timeout);
+
+// To read the bytes received since the last call (returns the bytes copied)
+uint32_t USART_Read(USART_Handle_t *pUSARTHandle, uint8_t *pBuffer, uint32_t MaxLen);
+
+// To get the IRQ numbers to enable (USART, TX DMA stream, RX DMA stream)
+void USART_GetIRQNumbers(USART_Handle_t *pUSARTHandle, uint8_t *pUSARTIRQ, uint8_t *pTxIRQ, uint8_t *pRxIRQ);
+
+// ISR Handling
+void USART_IRQHandling(USART_Handle_t *pUSARTHandle);				// IDLE line and RX errors
+void USART_DMA_TX_IRQHandling(USART_Handle_t *pUSARTHandle);			// TX segment complete: next one
+void USART_DMA_RX_IRQHandling(USART_Handle_t *pUSARTHandle);			// RX half/full buffer
+
+// Application Callbacks [To be implemented in the application]
+void USART_ApplicationEventCallback(USART_Handle_t *pUSARTHandle, uint8_t ApplicationEvent);
+
+
+#endif /* INC_STM32F407XX_USART_DRIVERS_H_ */
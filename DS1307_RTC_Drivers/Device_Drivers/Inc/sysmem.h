@@ -0,0 +1,70 @@
+/*
+ * 									sysmem.h
+ *
+ * This file contains the stack and heap usage APIs (implemented in sysmem.c, next to _sbrk).
+ *
+ * 	> The reserved stack [_sstack, _estack) is painted with SYSMEM_STACK_PAINT by Reset_Handler:
+ * 	  the high-water mark is the lowest word no longer holding the pattern
+ * 	> Heap end from _sbrk (newlib never gives memory back: the heap end is also its high-water mark)
+ * 	> Optional MPU guard region at the bottom of the stack: an overflow faults (MemManage) instead of
+ * 	  silently corrupting the memory below
+ * 	> Use: run the worst case, read SysMem_GetInfo, then shrink _Min_Stack_Size/_Min_Heap_Size
+ * 	  (linker script) keeping a margin, and give the RAM to larger buffers
+ *
+ */
+
+#ifndef INC_SYSMEM_H_
+#define INC_SYSMEM_H_
+
+#include <stdint.h>
+
+
+/* -- Stack Painting (MUST match the pattern written by Reset_Handler) -- */
+#define SYSMEM_STACK_PAINT		0xA5A5A5A5U
+
+/* -- MPU Stack Guard -- */
+// Bytes, power of two, _sstack aligned on it (MPU region). MUST exceed the largest single push: an
+// exception entry stacks 104 bytes (FPU extended frame, -mfloat-abi=hard) and would step over a smaller
+// guard without faulting. Lost for the stack when enabled (_Min_Stack_Size includes it).
+#define SYSMEM_GUARD_SIZE		256
+#define SYSMEM_GUARD_REGION		7				// MPU region (highest number: wins over overlapping regions)
+
+/* -- Return Status (@SYSMEM_STATUS) -- */
+#define SYSMEM_OK			0
+#define SYSMEM_ERR_NO_MPU		1			// MPU not implemented
+#define SYSMEM_ERR_ALIGN		2			// _sstack not aligned on SYSMEM_GUARD_SIZE (_Min_Stack_Size)
+#define SYSMEM_ERR_USED			3			// Guard bytes already used by the stack (not painted any more)
+
+/* -- Memory Usage (bytes) -- */
+typedef struct
+{
+	uint32_t StackSize;				// Reserved stack: _estack - _sstack
+	uint32_t StackUsed;				// High-water mark since reset (guard excluded)
+	uint32_t StackFree;				// Minimum free stack since reset: StackSize - StackUsed
+	uint32_t HeapEnd;				// Current heap end (__sbrk_heap_end, _end before the first _sbrk)
+	uint32_t HeapUsed;				// HeapEnd - _end
+	uint32_t HeapFree;				// _heap_limit - HeapEnd (minimum since reset)
+	uint32_t MinFree;				// StackFree + HeapFree: RAM never used since reset
+
+}SysMem_Info_t;
+
+
+/* -- APIs Supported by sysmem -- */
+
+// To get the stack and heap usage
+void SysMem_GetInfo(SysMem_Info_t *pInfo);
+
+// To get the stack high-water mark (bytes used since reset)
+uint32_t SysMem_StackUsed(void);
+
+// To get the current heap end (address)
+uint32_t SysMem_HeapEnd(void);
+
+// To protect the bottom SYSMEM_GUARD_SIZE bytes of the stack with the MPU (returns @SYSMEM_STATUS)
+uint8_t SysMem_StackGuardEnable(void);
+
+// To remove the MPU stack guard
+void SysMem_StackGuardDisable(void);
+
+
+#endif /* INC_SYSMEM_H_ */
@@ -0,0 +1,84 @@
+/*
+ * 									timer_wheel.h
+ *
+ * This file contains the software timer APIs (hierarchical timer wheel) shared by the drivers.
+ *
+ * 	> O(1) start/stop: a timer is linked into one slot, chosen from its expiry time
+ * 	> 5 levels of 64 slots: 1, 64, 4096 .. ticks per slot, up to 2^30 ticks (12.4 days at 1 kHz)
+ * 	> Per tick: one slot of level 0, the next level is cascaded (re-distributed) every 64 ticks
+ * 	> Static pool of timers: no allocation
+ * 	> Driven by the SysTick tick hook, callbacks run in SysTick interrupt context
+ *
+ */
+
+#ifndef INC_TIMER_WHEEL_H_
+#define INC_TIMER_WHEEL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stm32f407xx.h>
+
+
+/* -- Pool Size (number of timers that can exist at the same time) -- */
+#define TIMER_WHEEL_POOL_SIZE		16
+
+/* -- Wheel Geometry -- */
+#define TIMER_WHEEL_LEVELS		5
+#define TIMER_WHEEL_SLOT_BITS		6
+#define TIMER_WHEEL_SLOTS		(1U << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_MAX_DELAY		((1UL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1)
+
+/* -- Timer States (@TIMER_WHEEL_STATE) -- */
+#define TIMER_WHEEL_FREE		0			// In the pool
+#define TIMER_WHEEL_IDLE		1			// Created, not armed
+#define TIMER_WHEEL_ARMED		2			// Linked into the wheel
+
+/* -- Return Status (@TIMER_WHEEL_STATUS) -- */
+#define TIMER_WHEEL_OK			0
+#define TIMER_WHEEL_ERR_PARAM		1			// NULL/free timer or delay above TIMER_WHEEL_MAX_DELAY
+
+/* -- Timer Callback (SysTick interrupt context: keep it short) -- */
+typedef void (*TimerWheel_Callback_t)(void *pArg);
+
+/* -- Software Timer -- */
+typedef struct TimerWheel_Timer
+{
+	struct TimerWheel_Timer *pNext;			// Slot list (pPrevNext: address of the pointer to this timer)
+	struct TimerWheel_Timer **pPrevNext;
+	uint32_t Expires;				// Expiry time [ticks]
+	uint32_t Period;				// 0: one-shot, otherwise re-armed every 'Period' ticks
+	TimerWheel_Callback_t Callback;
+	void *pArg;
+	uint8_t State;					// @TIMER_WHEEL_STATE
+
+}TimerWheel_Timer_t;
+
+
+/* -- APIs Supported by the timer wheel -- */
+
+// To empty the wheel and the pool, and install the tick on the SysTick hook
+void TimerWheel_Init(void);
+
+// To take a timer from the pool (NULL if the pool is empty)
+TimerWheel_Timer_t* TimerWheel_Create(TimerWheel_Callback_t Callback, void *pArg);
+
+// To give a timer back to the pool (stopped first)
+void TimerWheel_Delete(TimerWheel_Timer_t *pTimer);
+
+// To arm a timer: first expiry after 'DelayTicks', then every 'PeriodTicks' (0: one-shot)
+uint8_t TimerWheel_Start(TimerWheel_Timer_t *pTimer, uint32_t DelayTicks, uint32_t PeriodTicks);
+
+// To disarm a timer (no effect if not armed)
+void TimerWheel_Stop(TimerWheel_Timer_t *pTimer);
+
+// To know if a timer is armed (one-shot timers are disarmed before their callback)
+uint8_t TimerWheel_IsArmed(const TimerWheel_Timer_t *pTimer);
+
+// To advance the wheel by one tick (SysTick hook)
+__RAMFUNC void TimerWheel_Tick(void);
+
+// To get the wheel time [ticks]
+uint32_t TimerWheel_Now(void);
+
+
+#endif /* INC_TIMER_WHEEL_H_ */
@@ -0,0 +1,196 @@
+/*
+ * 									dlog.c
+ *
+ *  This file contains the deferred logging implementations (see dlog.h).
+ *
+ *  Producers (any context) reserve whole records by moving 'dlogHead' with a compare-and-swap
+ *  (LDREX/STREX), write the timestamp and the payload, then the header last: a record is committed
+ *  once its header holds DLOG_MARK. The consumer stops at the first record not committed yet (a
+ *  producer pre-empted between its reservation and its header write) and zeroes the words it frees.
+ *
+ */
+
+#include <dlog.h>
+#include <stm32f407xx_dwt_drivers.h>
+
+#include <string.h>
+
+_Static_assert((DLOG_RING_WORDS & (DLOG_RING_WORDS - 1)) == 0, "DLOG_RING_WORDS must be a power of 2");
+_Static_assert(DLOG_MAX_BYTES <= 255, "Payload length is 8 bits in the header");
+
+#define DLOG_RING_MASK			(DLOG_RING_WORDS - 1)
+
+// Ring (SRAM) and its free-running word indexes: reserved up to 'dlogHead', consumed up to 'dlogTail'
+static uint32_t dlogRing[DLOG_RING_WORDS];
+static volatile uint32_t dlogHead = 0;
+static volatile uint32_t dlogTail = 0;
+
+static DLog_Stats_t dlogStats;
+
+/* --Helper Functions-- */
+static uint8_t DLog_Reserve(uint32_t Words, uint32_t *pIndex);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_Init
+ * Description	:	To empty the ring and clear the statistics
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	MUST NOT run while a log site or DLog_Drain is running (call it first in main).
+ *			Starts the DWT cycle counter if needed (record timestamps).
+ * ------------------------------------------------------------------------------------------------------ */
+void DLog_Init(void)
+{
+	memset(dlogRing, 0, sizeof(dlogRing));
+	memset(&dlogStats, 0, sizeof(dlogStats));
+	dlogHead = 0;
+	dlogTail = 0;
+
+	DWT_CycleCounterInit();
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_Write
+ * Description	:	To store one record
+ * Parameter 1	:	Format string ID (DLOG_ID, offset in .dlog_fmt)
+ * Parameter 2	:	@DLOG_TYPE
+ * Parameter 3	:	Pointer to the payload
+ * Parameter 4	:	Payload bytes (0 to DLOG_MAX_BYTES)
+ * Return Type	:	uint8_t (0: stored, 1: dropped)
+ * Note		:	Lock-free, callable from thread and ISRs (interrupts are never masked).
+ *			Use the DLOG/DLOG_BYTES macros rather than calling it directly.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DLog_Write(uint16_t FmtId, uint8_t Type, const void *pPayload, uint32_t Len)
+{
+	const uint8_t *pBytes = (const uint8_t *)pPayload;
+	uint32_t words;
+	uint32_t index;
+	uint32_t word;
+	uint32_t chunk;
+
+	/* -Step 1. Reserve the whole record (or drop it)- */
+	if (Len > DLOG_MAX_BYTES)
+	{
+		__atomic_fetch_add(&dlogStats.Dropped, 1, __ATOMIC_RELAXED);
+		return 1;
+	}
+
+	words = DLOG_HEADER_WORDS + ((Len + 3) / 4);
+	if (!DLog_Reserve(words, &index))
+	{
+		__atomic_fetch_add(&dlogStats.Dropped, 1, __ATOMIC_RELAXED);
+		return 1;
+	}
+
+	/* -Step 2. Timestamp and payload (words, last one zero padded)- */
+	dlogRing[(index + 1) & DLOG_RING_MASK] = DWT_GetCycles();
+
+	for (uint32_t i = 0; i < Len; i += 4)
+	{
+		word = 0;
+		chunk = ((Len - i) >= 4) ? 4 : (Len - i);
+		memcpy(&word, &pBytes[i], chunk);
+		dlogRing[(index + DLOG_HEADER_WORDS + (i / 4)) & DLOG_RING_MASK] = word;
+	}
+
+	/* -Step 3. Commit: header last, after the record words are visible- */
+	__atomic_store_n(&dlogRing[index & DLOG_RING_MASK], ((uint32_t)FmtId << 16) | (DLOG_MARK << 12) |
+		((uint32_t)(Type & 0xF) << 8) | Len, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&dlogStats.Records, 1, __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_Drain
+ * Description	:	To pass the committed records to a sink, oldest first
+ * Parameter 1	:	Sink (one whole record per call, little-endian words)
+ * Return Type	:	Records sent (uint32_t)
+ * Note		:	One consumer only (thread context, e.g. the main loop). Stops at the first record
+ *			reserved but not committed yet: it is sent on the next call.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t DLog_Drain(DLog_Sink_t Sink)
+{
+	uint32_t record[DLOG_MAX_RECORD_WORDS];
+	uint32_t tail = dlogTail;
+	uint32_t header;
+	uint32_t words;
+	uint32_t sent = 0;
+
+	while (tail != __atomic_load_n(&dlogHead, __ATOMIC_ACQUIRE))
+	{
+		/* -Step 1. Committed record at the tail?- */
+		header = __atomic_load_n(&dlogRing[tail & DLOG_RING_MASK], __ATOMIC_ACQUIRE);
+		if (((header >> 12) & 0xF) != DLOG_MARK)
+		{
+			break;
+		}
+
+		/* -Step 2. Copy it out and free its words (zero: not committed for the next producer)- */
+		words = DLOG_HEADER_WORDS + (((header & 0xFF) + 3) / 4);
+		for (uint32_t i = 0; i < words; i++)
+		{
+			record[i] = dlogRing[(tail + i) & DLOG_RING_MASK];
+			dlogRing[(tail + i) & DLOG_RING_MASK] = 0;
+		}
+
+		tail += words;
+		__atomic_store_n(&dlogTail, tail, __ATOMIC_RELEASE);
+
+		/* -Step 3. Send it- */
+		Sink((const uint8_t *)record, words * sizeof(uint32_t));
+		sent++;
+	}
+
+	return sent;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_GetStats
+ * Description	:	To get the statistics
+ * Parameters	:	Pointer to statistics (copied)
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void DLog_GetStats(DLog_Stats_t *pStats)
+{
+	*pStats = dlogStats;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_Reserve
+ * Description	:	Helper Functions
+ * Parameters	:	Record words, pointer to the first word index (filled)
+ * Return Type	:	uint8_t (1: reserved, 0: ring full)
+ * Note		:	Compare-and-swap loop on 'dlogHead' (LDREX/STREX, retried when pre-empted).
+ *			Also keeps the high-water mark of the ring.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t DLog_Reserve(uint32_t Words, uint32_t *pIndex)
+{
+	uint32_t head = __atomic_load_n(&dlogHead, __ATOMIC_RELAXED);
+	uint32_t used;
+	uint32_t maxUsed;
+
+	do
+	{
+		used = head + Words - __atomic_load_n(&dlogTail, __ATOMIC_ACQUIRE);
+		if (used > DLOG_RING_WORDS)
+		{
+			return 0;
+		}
+	} while (!__atomic_compare_exchange_n(&dlogHead, &head, head + Words, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+	maxUsed = __atomic_load_n(&dlogStats.MaxUsedWords, __ATOMIC_RELAXED);
+	while ((used > maxUsed) &&
+		!__atomic_compare_exchange_n(&dlogStats.MaxUsedWords, &maxUsed, used, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	*pIndex = head;
+
+	return 1;
+}
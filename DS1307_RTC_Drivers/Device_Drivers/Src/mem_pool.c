@@ -0,0 +1,322 @@
+/*
+ * 									mem_pool.c
+ *
+ *  This file contains the fixed-size block allocator implementations (see mem_pool.h).
+ *
+ *  Block layout (words): [tag][payload: BlockSize bytes][guard]. A free block keeps the next free block
+ *  in its first payload word, so the free lists cost no extra memory. The tag tells a block in use from
+ *  a free one (double release), the guard detects writes past the end of the payload.
+ *
+ */
+
+#include <mem_pool.h>
+#include <stm32f407xx_nvic_drivers.h>
+
+#include <string.h>
+
+/* -- Block Tags and Guard -- */
+#define MEMPOOL_TAG_FREE		0x46524545U		// "FREE"
+#define MEMPOOL_TAG_USED		0x55534544U		// "USED"
+#define MEMPOOL_GUARD			0xA5C3E1F0U
+
+// Words per block: tag, payload, guard
+#define MEMPOOL_STRIDE_WORDS(Size)	(((Size) / 4U) + 2U)
+
+_Static_assert(((MEMPOOL_CLASS0_SIZE | MEMPOOL_CLASS1_SIZE | MEMPOOL_CLASS2_SIZE | MEMPOOL_CLASS3_SIZE) & 3) == 0,
+	"Block sizes must be multiples of 4");
+_Static_assert((MEMPOOL_CLASS0_SIZE < MEMPOOL_CLASS1_SIZE) && (MEMPOOL_CLASS1_SIZE < MEMPOOL_CLASS2_SIZE) &&
+	(MEMPOOL_CLASS2_SIZE < MEMPOOL_CLASS3_SIZE), "Block sizes must be ascending");
+_Static_assert(MEMPOOL_CLASS0_SIZE >= sizeof(void *), "Blocks must hold the free list link");
+
+/* -- Block Class -- */
+typedef struct
+{
+	uint32_t *pStorage;				// First block (tag word)
+	uint32_t *pFree;				// First free block, NULL: class empty
+	uint32_t StrideWords;				// Tag + payload + guard
+	MemPool_Stats_t Stats;
+
+}MemPool_Class_t;
+
+// Storage of the blocks (SRAM: reachable by DMA)
+static uint32_t class0Storage[MEMPOOL_CLASS0_COUNT * MEMPOOL_STRIDE_WORDS(MEMPOOL_CLASS0_SIZE)];
+static uint32_t class1Storage[MEMPOOL_CLASS1_COUNT * MEMPOOL_STRIDE_WORDS(MEMPOOL_CLASS1_SIZE)];
+static uint32_t class2Storage[MEMPOOL_CLASS2_COUNT * MEMPOOL_STRIDE_WORDS(MEMPOOL_CLASS2_SIZE)];
+static uint32_t class3Storage[MEMPOOL_CLASS3_COUNT * MEMPOOL_STRIDE_WORDS(MEMPOOL_CLASS3_SIZE)];
+
+// Class configuration (index = class)
+static uint32_t * const classStorage[MEMPOOL_CLASSES] = {class0Storage, class1Storage, class2Storage, class3Storage};
+static const uint16_t classSize[MEMPOOL_CLASSES] = {MEMPOOL_CLASS0_SIZE, MEMPOOL_CLASS1_SIZE,
+	MEMPOOL_CLASS2_SIZE, MEMPOOL_CLASS3_SIZE};
+static const uint16_t classCount[MEMPOOL_CLASSES] = {MEMPOOL_CLASS0_COUNT, MEMPOOL_CLASS1_COUNT,
+	MEMPOOL_CLASS2_COUNT, MEMPOOL_CLASS3_COUNT};
+
+static MemPool_Class_t poolClasses[MEMPOOL_CLASSES];
+
+/* --Helper Functions-- */
+static MemPool_Class_t* MemPool_ClassOf(const void *pBlock);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_Init
+ * Description	:	To build the free lists of all the block classes
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	All blocks previously allocated are lost, statistics are cleared.
+ * ------------------------------------------------------------------------------------------------------ */
+void MemPool_Init(void)
+{
+	MemPool_Class_t *pClass;
+	uint32_t *pBlock;
+	uint32_t primask = NVIC_EnterCriticalAll();
+
+	for (uint8_t c = 0; c < MEMPOOL_CLASSES; c++)
+	{
+		pClass = &poolClasses[c];
+
+		memset(pClass, 0, sizeof(*pClass));
+		pClass->pStorage = classStorage[c];
+		pClass->StrideWords = MEMPOOL_STRIDE_WORDS(classSize[c]);
+		pClass->Stats.BlockSize = classSize[c];
+		pClass->Stats.BlockCount = classCount[c];
+
+		// Free list in address order (last block first in, first block on top)
+		for (uint16_t i = classCount[c]; i > 0; i--)
+		{
+			pBlock = pClass->pStorage + ((i - 1) * pClass->StrideWords);
+			pBlock[0] = MEMPOOL_TAG_FREE;
+			*(uint32_t **)&pBlock[1] = pClass->pFree;
+			pClass->pFree = pBlock;
+		}
+	}
+
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_Alloc
+ * Description	:	To get a block of at least 'Size' bytes
+ * Parameter 1	:	Size [bytes]
+ * Return Type	:	Pointer to the block (4-byte aligned, content undefined), NULL if none left or too big
+ * Note		:	Smallest class that fits; when it is empty, the next larger ones (Fails counted).
+ *			Constant time: at most MEMPOOL_CLASSES free lists looked at, no search in a list.
+ * ------------------------------------------------------------------------------------------------------ */
+void* MemPool_Alloc(uint32_t Size)
+{
+	MemPool_Class_t *pClass;
+	uint32_t *pBlock = NULL;
+	uint32_t primask = NVIC_EnterCriticalAll();
+
+	for (uint8_t c = 0; c < MEMPOOL_CLASSES; c++)
+	{
+		pClass = &poolClasses[c];
+
+		if (Size > pClass->Stats.BlockSize)
+		{
+			continue;
+		}
+
+		pBlock = pClass->pFree;
+		if (pBlock == NULL)
+		{
+			pClass->Stats.Fails++;
+			continue;
+		}
+
+		// a. Off the free list, tagged in use, guard after the payload
+		pClass->pFree = *(uint32_t **)&pBlock[1];
+		pBlock[0] = MEMPOOL_TAG_USED;
+		pBlock[pClass->StrideWords - 1] = MEMPOOL_GUARD;
+
+		// b. Statistics
+		pClass->Stats.Allocs++;
+		if (++pClass->Stats.Used > pClass->Stats.MaxUsed)
+		{
+			pClass->Stats.MaxUsed = pClass->Stats.Used;
+		}
+		break;
+	}
+
+	NVIC_ExitCriticalAll(primask);
+
+	return (pBlock != NULL) ? &pBlock[1] : NULL;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_Free
+ * Description	:	To give a block back to its class
+ * Parameter 1	:	Pointer returned by MemPool_Alloc
+ * Return Type	:	uint8_t @MEMPOOL_STATUS
+ * Note		:	Constant time. Overwritten guard: the block is released, MEMPOOL_ERR_OVERFLOW returned.
+ *			Overwritten tag (overflow of the block before it): NOT released, MEMPOOL_ERR_OVERFLOW.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t MemPool_Free(void *pBlock)
+{
+	MemPool_Class_t *pClass = MemPool_ClassOf(pBlock);
+	uint32_t *pHead;
+	uint32_t primask;
+	uint8_t status = MEMPOOL_OK;
+
+	if (pClass == NULL)
+	{
+		return MEMPOOL_ERR_INVALID;
+	}
+
+	pHead = (uint32_t *)pBlock - 1;
+
+	primask = NVIC_EnterCriticalAll();
+
+	/* -Step 1. Tag: in use, free (double release) or overwritten- */
+	if (pHead[0] != MEMPOOL_TAG_USED)
+	{
+		if (pHead[0] == MEMPOOL_TAG_FREE)
+		{
+			pClass->Stats.DoubleFrees++;
+			status = MEMPOOL_ERR_DOUBLE_FREE;
+		}
+		else
+		{
+			pClass->Stats.Overflows++;
+			status = MEMPOOL_ERR_OVERFLOW;
+		}
+
+		NVIC_ExitCriticalAll(primask);
+		return status;
+	}
+
+	/* -Step 2. Guard after the payload- */
+	if (pHead[pClass->StrideWords - 1] != MEMPOOL_GUARD)
+	{
+		pClass->Stats.Overflows++;
+		status = MEMPOOL_ERR_OVERFLOW;
+	}
+
+	/* -Step 3. Back on top of the free list- */
+	pHead[0] = MEMPOOL_TAG_FREE;
+	*(uint32_t **)&pHead[1] = pClass->pFree;
+	pClass->pFree = pHead;
+	pClass->Stats.Used--;
+
+	NVIC_ExitCriticalAll(primask);
+
+	return status;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_BlockSize
+ * Description	:	To get the usable size of an allocated block
+ * Parameter 1	:	Pointer returned by MemPool_Alloc
+ * Return Type	:	uint32_t (bytes, 0 if not a block of the pool or not allocated)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t MemPool_BlockSize(const void *pBlock)
+{
+	const MemPool_Class_t *pClass = MemPool_ClassOf(pBlock);
+
+	if ((pClass == NULL) || (((const uint32_t *)pBlock)[-1] != MEMPOOL_TAG_USED))
+	{
+		return 0;
+	}
+
+	return pClass->Stats.BlockSize;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_Check
+ * Description	:	To check the guard word of every block in use
+ * Parameters	:	none
+ * Return Type	:	uint32_t (number of blocks with an overwritten guard or tag)
+ * Note		:	Walks all the blocks (not for the real-time loop): background/debug check that finds
+ *			an overflow before the block is released. Statistics are not changed.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t MemPool_Check(void)
+{
+	const MemPool_Class_t *pClass;
+	const uint32_t *pBlock;
+	uint32_t corrupted = 0;
+	uint32_t primask;
+
+	for (uint8_t c = 0; c < MEMPOOL_CLASSES; c++)
+	{
+		pClass = &poolClasses[c];
+
+		// One class at a time: interrupts are masked for one class walk at most
+		primask = NVIC_EnterCriticalAll();
+
+		for (uint16_t i = 0; i < pClass->Stats.BlockCount; i++)
+		{
+			pBlock = pClass->pStorage + (i * pClass->StrideWords);
+
+			if (((pBlock[0] == MEMPOOL_TAG_USED) && (pBlock[pClass->StrideWords - 1] != MEMPOOL_GUARD)) ||
+				((pBlock[0] != MEMPOOL_TAG_USED) && (pBlock[0] != MEMPOOL_TAG_FREE)))
+			{
+				corrupted++;
+			}
+		}
+
+		NVIC_ExitCriticalAll(primask);
+	}
+
+	return corrupted;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_GetStats
+ * Description	:	To get the statistics of a block class
+ * Parameter 1	:	Class (0 to MEMPOOL_CLASSES - 1)
+ * Parameter 2	:	Pointer to statistics (copied, all zero for an invalid class)
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void MemPool_GetStats(uint8_t Class, MemPool_Stats_t *pStats)
+{
+	uint32_t primask;
+
+	if (Class >= MEMPOOL_CLASSES)
+	{
+		memset(pStats, 0, sizeof(*pStats));
+		return;
+	}
+
+	primask = NVIC_EnterCriticalAll();
+	*pStats = poolClasses[Class].Stats;
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	MemPool_ClassOf
+ * Description	:	Helper Functions
+ * Parameters	:	Pointer to a block payload
+ * Return Type	:	Class of the block, NULL if the pointer is not the payload of one of its blocks
+ * Note		:	Constant time: storage range of each class, then the position on a block boundary
+ * ------------------------------------------------------------------------------------------------------ */
+static MemPool_Class_t* MemPool_ClassOf(const void *pBlock)
+{
+	MemPool_Class_t *pClass;
+	const uint32_t *pHead = (const uint32_t *)pBlock - 1;
+	uint32_t offset;
+
+	for (uint8_t c = 0; c < MEMPOOL_CLASSES; c++)
+	{
+		pClass = &poolClasses[c];
+
+		if ((pHead < pClass->pStorage) ||
+			(pHead >= (pClass->pStorage + (pClass->Stats.BlockCount * pClass->StrideWords))))
+		{
+			continue;
+		}
+
+		offset = (uint32_t)((const uint8_t *)pHead - (const uint8_t *)pClass->pStorage);
+
+		return ((offset % (pClass->StrideWords * 4U)) == 0) ? pClass : NULL;
+	}
+
+	return NULL;
+}
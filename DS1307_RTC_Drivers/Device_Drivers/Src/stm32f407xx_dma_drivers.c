@@ -0,0 +1,181 @@
+/*
+ * 									stm32f407xx_dma_drivers.c
+ *
+ *  This file contains DMA driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_dma_drivers.h>
+
+// Position of the stream flags in DMA_ISR/IFCR LOW (streams 0-3) or HIGH (streams 4-7)
+static const uint8_t dmaFlagShift[4] = {0, 6, 16, 22};
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_PeriClockControl
+ * Description	:	To enable or disable the peripheral clock of a DMA controller
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	ENABLE or DISABLE Macro
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void DMA_PeriClockControl(DMA_RegDef_t *pDMAx, uint8_t EnorDi)
+{
+	if (EnorDi == ENABLE)
+	{
+		if (pDMAx == DMA1)
+		{
+			DMA1_PCLK_EN();
+		}
+		else if (pDMAx == DMA2)
+		{
+			DMA2_PCLK_EN();
+		}
+	}
+	else
+	{
+		if (pDMAx == DMA1)
+		{
+			DMA1_PCLK_DI();
+		}
+		else if (pDMAx == DMA2)
+		{
+			DMA2_PCLK_DI();
+		}
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_StreamInit
+ * Description	:	To configure a stream for a peripheral data register
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Parameter 3	:	Pointer to the stream configuration
+ * Parameter 4	:	Address of the peripheral data register (e.g. &USART2->DR)
+ * Return Type	:	none (void)
+ * Note		:	The stream is stopped first and its flags cleared. Byte items, peripheral address
+ *			fixed, memory address incremented, direct mode (no FIFO). Started by DMA_StreamStart.
+ *			The DMA clock MUST be enabled (DMA_PeriClockControl).
+ * ------------------------------------------------------------------------------------------------------ */
+void DMA_StreamInit(DMA_RegDef_t *pDMAx, uint8_t Stream, const DMA_Config_t *pDMAConfig, volatile void *pPeriphData)
+{
+	DMA_Stream_RegDef_t *pStream = &pDMAx->S[Stream];
+	uint32_t cr = 0;
+
+	/* -Step 1. Stream stopped (configuration registers are read-only while EN is set)- */
+	DMA_StreamStop(pDMAx, Stream);
+
+	/* -Step 2. Channel, direction, mode, priority, byte items, memory increment, interrupts- */
+	cr |= ((uint32_t)(pDMAConfig->DMA_Channel & 0x7) << DMA_SxCR_CHSEL);
+	cr |= ((uint32_t)(pDMAConfig->DMA_Direction & 0x3) << DMA_SxCR_DIR);
+	cr |= ((uint32_t)(pDMAConfig->DMA_Priority & 0x3) << DMA_SxCR_PL);
+	cr |= (1U << DMA_SxCR_MINC);
+	if (pDMAConfig->DMA_Mode == DMA_MODE_CIRCULAR)
+	{
+		cr |= (1U << DMA_SxCR_CIRC);
+	}
+	cr |= (pDMAConfig->DMA_Interrupts & (DMA_IT_TE | DMA_IT_HT | DMA_IT_TC));
+
+	pStream->CR = cr;
+	pStream->FCR = 0;				// Direct mode
+	pStream->PAR = (uint32_t)pPeriphData;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_SetMemoryIncrement
+ * Description	:	To fix or increment the memory address of a stream
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Parameter 3	:	ENABLE (incremented, DMA_StreamInit default) or DISABLE (same byte for every item)
+ * Return Type	:	none (void)
+ * Note		:	The stream MUST be stopped (CR is read-only while EN is set).
+ * ------------------------------------------------------------------------------------------------------ */
+void DMA_SetMemoryIncrement(DMA_RegDef_t *pDMAx, uint8_t Stream, uint8_t EnorDi)
+{
+	if (EnorDi == ENABLE)
+	{
+		pDMAx->S[Stream].CR |= (1U << DMA_SxCR_MINC);
+	}
+	else
+	{
+		pDMAx->S[Stream].CR &= ~(1U << DMA_SxCR_MINC);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_StreamStart
+ * Description	:	To start a transfer
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Parameter 3	:	Memory address (SRAM, NOT CCMRAM)
+ * Parameter 4	:	Number of bytes [1 to 65535]
+ * Return Type	:	none (void)
+ * Note		:	The stream MUST be stopped (normal mode: done, see DMA_FLAG_TC). Old flags are cleared
+ *			first: a stale TC would stop the new transfer immediately.
+ * ------------------------------------------------------------------------------------------------------ */
+void DMA_StreamStart(DMA_RegDef_t *pDMAx, uint8_t Stream, const volatile void *pMemory, uint16_t Count)
+{
+	DMA_Stream_RegDef_t *pStream = &pDMAx->S[Stream];
+
+	DMA_ClearFlags(pDMAx, Stream, DMA_FLAG_ALL);
+
+	pStream->M0AR = (uint32_t)pMemory;
+	pStream->NDTR = Count;
+	pStream->CR |= (1U << DMA_SxCR_EN);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_StreamStop
+ * Description	:	To stop a stream
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Return Type	:	none (void)
+ * Note		:	EN reads 1 until the current item is transferred (bounded by DMA_TIMEOUT). NDTR then
+ *			holds the items not transferred. A TC flag may be set: cleared by DMA_StreamStart.
+ * ------------------------------------------------------------------------------------------------------ */
+void DMA_StreamStop(DMA_RegDef_t *pDMAx, uint8_t Stream)
+{
+	DMA_Stream_RegDef_t *pStream = &pDMAx->S[Stream];
+	uint32_t timeout = DMA_TIMEOUT;
+
+	pStream->CR &= ~(1U << DMA_SxCR_EN);
+	while ((pStream->CR & (1U << DMA_SxCR_EN)) && --timeout);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_GetRemaining
+ * Description	:	To get the number of items left
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Return Type	:	NDTR (uint16_t)
+ * Note		:	Circular mode: reloaded with the buffer size after the last item.
+ * ------------------------------------------------------------------------------------------------------ */
+uint16_t DMA_GetRemaining(DMA_RegDef_t *pDMAx, uint8_t Stream)
+{
+	return (uint16_t)pDMAx->S[Stream].NDTR;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DMA_GetFlags / DMA_ClearFlags
+ * Description	:	To get or clear the flags of a stream
+ * Parameter 1	:	Base address of the DMA controller (DMA1, DMA2)
+ * Parameter 2	:	Stream [0 to 7]
+ * Parameter 3	:	@DMA_FLAG to clear (OR-ed, DMA_ClearFlags only)
+ * Return Type	:	@DMA_FLAG (OR-ed, DMA_GetFlags)
+ * Note		:	IFCR is write-1-to-clear: written directly, never read-modify-write.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t DMA_GetFlags(DMA_RegDef_t *pDMAx, uint8_t Stream)
+{
+	return (uint8_t)((pDMAx->ISR[Stream >> 2] >> dmaFlagShift[Stream & 3]) & DMA_FLAG_ALL);
+}
+
+void DMA_ClearFlags(DMA_RegDef_t *pDMAx, uint8_t Stream, uint8_t Flags)
+{
+	pDMAx->IFCR[Stream >> 2] = ((uint32_t)(Flags & DMA_FLAG_ALL) << dmaFlagShift[Stream & 3]);
+}
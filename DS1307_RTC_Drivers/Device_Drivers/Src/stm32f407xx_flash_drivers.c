@@ -0,0 +1,93 @@
+/*
+ * 									stm32f407xx_flash_drivers.c
+ *
+ *  This file contains Flash interface driver API implementations.
+ *
+ *  No global/static variables: the APIs are safe to call from SystemInit (before .data/.bss are initialized).
+ *
+ */
+
+#include <stm32f407xx_flash_drivers.h>
+
+// HCLK per wait state [Hz], indexed by @FLASH_VRANGE (Reference Manual: Number of wait states according to CPU clock)
+static const uint32_t hz_per_ws[4] = {20000000U, 22000000U, 24000000U, 30000000U};
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	FLASH_Latency_Value
+ * Description	:	To get the number of wait states needed for a given HCLK and voltage range
+ * Parameters	:	HCLK [Hz], @FLASH_VRANGE
+ * Return Type	:	(uint8_t) wait states [0 to FLASH_LATENCY_MAX]
+ * Note		:	One wait state per 'hz_per_ws' of HCLK:
+ *			2.7 V to 3.6 V : 0 WS up to 30 MHz, 1 WS up to 60 MHz ... 5 WS up to 168 MHz
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t FLASH_Latency_Value(uint32_t Hclk, uint8_t VoltageRange)
+{
+	uint32_t latency;
+
+	if (Hclk == 0)
+	{
+		return 0;
+	}
+
+	latency = (Hclk - 1) / hz_per_ws[VoltageRange & 0x03];
+
+	return (latency > FLASH_LATENCY_MAX) ? FLASH_LATENCY_MAX : (uint8_t)latency;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	FLASH_SetLatency
+ * Description	:	To program the wait states for a given HCLK and voltage range
+ * Parameters	:	HCLK [Hz], @FLASH_VRANGE
+ * Return Type	:	none (void)
+ * Note		:	When HCLK goes up, call it BEFORE the clock change; when HCLK goes down, AFTER.
+ *			FLASH_ACR is read back until the new value is active (Reference Manual).
+ * ------------------------------------------------------------------------------------------------------ */
+void FLASH_SetLatency(uint32_t Hclk, uint8_t VoltageRange)
+{
+	uint32_t latency = FLASH_Latency_Value(Hclk, VoltageRange);
+
+	FLASH->ACR = (FLASH->ACR & ~(0x07U << FLASH_ACR_LATENCY)) | (latency << FLASH_ACR_LATENCY);
+
+	while (((FLASH->ACR >> FLASH_ACR_LATENCY) & 0x07U) != latency);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	FLASH_GetLatency
+ * Description	:	To get the wait states currently programmed
+ * Parameters	:	none
+ * Return Type	:	(uint8_t) wait states
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t FLASH_GetLatency(void)
+{
+	return (uint8_t)((FLASH->ACR >> FLASH_ACR_LATENCY) & 0x07U);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	FLASH_ARTControl
+ * Description	:	To enable or disable the ART accelerator (instruction cache, data cache and prefetch)
+ * Parameters	:	ENABLE or DISABLE
+ * Return Type	:	none (void)
+ * Note		:	The caches can only be reset while disabled, so on ENABLE they are first disabled,
+ *			reset (stale lines after a Flash program/erase) and then enabled together with prefetch.
+ *			With VDD below 2.1 V (FLASH_VRANGE_1V8_2V1) prefetch MUST NOT be enabled.
+ * ------------------------------------------------------------------------------------------------------ */
+void FLASH_ARTControl(uint8_t EnOrDi)
+{
+	// Disable caches and prefetch
+	FLASH->ACR &= ~((1 << FLASH_ACR_PRFTEN) | (1 << FLASH_ACR_ICEN) | (1 << FLASH_ACR_DCEN));
+
+	if (EnOrDi == ENABLE)
+	{
+		// Reset caches (bits are not self-clearing)
+		FLASH->ACR |= ((1 << FLASH_ACR_ICRST) | (1 << FLASH_ACR_DCRST));
+		FLASH->ACR &= ~((1 << FLASH_ACR_ICRST) | (1 << FLASH_ACR_DCRST));
+
+		// Enable caches and prefetch
+		FLASH->ACR |= ((1 << FLASH_ACR_PRFTEN) | (1 << FLASH_ACR_ICEN) | (1 << FLASH_ACR_DCEN));
+	}
+}
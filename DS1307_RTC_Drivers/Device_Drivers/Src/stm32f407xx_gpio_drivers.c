@@ -6,6 +6,12 @@
  */
 
 #include <stm32f407xx_gpio_drivers.h>
+#include <stm32f407xx_nvic_drivers.h>
+
+#include <stddef.h>
+
+// EXTI Dispatch Table: one callback per EXTI Line (index = pin number, any port)
+static GPIO_Callback_t GPIO_CallbackTable[16];
 
 
 /* -- APIs (Definitions) Supported by this GPIO driver -- */
@@ -123,32 +129,69 @@ void GPIO_PeriClockControl(GPIO_RegDef_t *pGPIOx, uint8_t EnorDi)
  * Parameter 1	:	Pointer to GPIO Handle
  * Return Type	:	none (void)
  * Note		:	Peripheral Clock is enabled at starting of the function, so users need not do it explicitly.
+ *			Same as GPIO_InitMask with a single pin (GPIO_PinNumber).
  * ------------------------------------------------------------------------------------------------------ */
 void GPIO_Init(GPIO_Handle_t *pGPIOHandle)
+{
+	GPIO_InitMask(pGPIOHandle->pGPIOx, GPIO_PIN_MASK(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber), &pGPIOHandle->GPIO_PinConfig);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	GPIO_InitMask
+ * Description	:	Peripheral Initialize API:
+ *			To initialize several pins of the given GPIO port with the same configuration.
+ * Parameter 1	:	Base address of the GPIO peripheral
+ * Parameter 2	:	Pins to configure, one bit per pin (GPIO_PIN_MASK(x) | GPIO_PIN_MASK(y) ...)
+ * Parameter 3	:	Pointer to the Pin Configuration (GPIO_PinNumber is ignored)
+ * Return Type	:	none (void)
+ * Note		:	Peripheral Clock is enabled at starting of the function, so users need not do it explicitly.
+ *			Each register value is computed once for all the pins and written with a single store
+ *			(one read-modify-write per register instead of one per pin and register).
+ * ------------------------------------------------------------------------------------------------------ */
+void GPIO_InitMask(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, GPIO_PinConfig_t *pPinConfig)
 {
 	// Enable Peripheral Clock
-	GPIO_PeriClockControl(pGPIOHandle->pGPIOx, ENABLE);
+	GPIO_PeriClockControl(pGPIOx, ENABLE);
+
+	// As defined in x_gpio_drivers.h, Pin Modes greater than 3 are interrupt modes (pin must be INPUT)
+	uint32_t mode = (pPinConfig->GPIO_PinMode <= GPIO_MODE_ANALOG) ? pPinConfig->GPIO_PinMode : GPIO_MODE_IN;
+
+	// Field masks: 2 bit fields (MODER, OSPEEDR, PUPDR), 1 bit field (OTYPER), 4 bit fields (AFR[0], AFR[1], EXTICR[x])
+	uint32_t mask2 = 0, mask4[2] = {0, 0}, exticrMask[4] = {0, 0, 0, 0};
 
-	uint32_t temp = 0;
+	// Field values
+	uint32_t modeVal = 0, speedVal = 0, pupdVal = 0, afVal[2] = {0, 0}, exticrVal[4] = {0, 0, 0, 0};
 
-	// ->  1. Configure the GPIO pin Mode
+	uint8_t portcode = GPIO_BASEADDR_TO_CODE(pGPIOx);
 
-	// As defined in x_gpio_drivers.h, Pin Modes greater than 3 are interrupt modes
-	if (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode <= GPIO_MODE_ANALOG)
+	/* -Step 1. Compute all the field masks and values (no register access)- */
+	for (uint8_t pin = 0; pin < 16; pin++)
 	{
-		// In Pin Mode Register, each pin takes 2 bit fields [Shift value according to pin number]
-		// Logic: Mode value left shifted by (2 * pin number)
-		temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode << (2 * pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
+		if (!(PinMask & GPIO_PIN_MASK(pin)))
+		{
+			continue;
+		}
 
-		// Store 'temp' i.e. Mode Value in MODE Register [Set/touch only required bit leave rest untouched '|']
-		pGPIOHandle->pGPIOx->MODER &= ~(0x3 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber); 	// Clear required bits
-		pGPIOHandle->pGPIOx->MODER |= temp;							// Update required bits
+		// In MODER, OSPEEDR and PUPDR, each pin takes 2 bit fields [Shift value: 2 * pin number]
+		mask2    |= (0x3U << (2 * pin));
+		modeVal  |= (mode << (2 * pin));
+		speedVal |= ((uint32_t) pPinConfig->GPIO_PinSpeed << (2 * pin));
+		pupdVal  |= ((uint32_t) pPinConfig->GPIO_PinPuPdControl << (2 * pin));
 
-		// Reset 'temp'
-		temp = 0;
+		// AF[0]: Low (Pin 0 - 7), AF[1]: High (Pin 8 - 15), each pin takes 4 bit fields
+		mask4[pin / 8] |= (0xFU << (4 * (pin % 8)));
+		afVal[pin / 8] |= ((uint32_t) (pPinConfig->GPIO_PinAltFuncMode & 0xF) << (4 * (pin % 8)));
 
+		// EXTICR[x]: 4 pins per register, 4 bit fields (Port Code)
+		exticrMask[pin / 4] |= (0xFU << (4 * (pin % 4)));
+		exticrVal[pin / 4]  |= ((uint32_t) portcode << (4 * (pin % 4)));
 	}
-	else
+
+	/* -Step 2. Configure the GPIO pin Mode- */
+	pGPIOx->MODER = (pGPIOx->MODER & ~mask2) | modeVal;
+
+	if (pPinConfig->GPIO_PinMode > GPIO_MODE_ANALOG)
 	{
 		// Interrupt Modes
 		/*
@@ -161,94 +204,75 @@ void GPIO_Init(GPIO_Handle_t *pGPIOHandle)
 		 * 7. Implement the IRQ handler.
 		 * */
 
-		// -> Configure the edge trigger
-		if (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_FT)
+		// -> Configure the edge trigger (Falling: FTSR, Rising: RTSR, the other one is cleared)
+		if (pPinConfig->GPIO_PinMode == GPIO_MODE_IT_FT)
 		{
-			// Configure the Falling Trigger Selection Register (FTSR)
-			EXTI->FTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-
-			// As a safe side, Clear same bit in RTSR so just FTSR is configured
-			EXTI->RTSR &= ~(1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+			EXTI->FTSR |= PinMask;
+			EXTI->RTSR &= ~((uint32_t) PinMask);
 		}
-		else if (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RT)
+		else if (pPinConfig->GPIO_PinMode == GPIO_MODE_IT_RT)
 		{
-			// Configure the Rising Trigger Selection Register (RTSR)
-			EXTI->RTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-
-			// As a safe side, Clear same bit in FTSR so just RTSR is configured
-			EXTI->FTSR &= ~(1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+			EXTI->RTSR |= PinMask;
+			EXTI->FTSR &= ~((uint32_t) PinMask);
 		}
-		else if (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_IT_RFT)
+		else if (pPinConfig->GPIO_PinMode == GPIO_MODE_IT_RFT)
 		{
-			// Configure the both FTSR and RTSR
-			EXTI->FTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
-			EXTI->RTSR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+			EXTI->FTSR |= PinMask;
+			EXTI->RTSR |= PinMask;
 		}
 
-		// -> Configure the GPIO Port Selection in SYSCFG_EXTICR
-		// GPIO_Pin_x of WHICH port is delivering interrupt? decided by GPIO Port selection [By default, PORTA]
-
-		uint8_t SYSArrayIndex, SYSBitField;
-
-		SYSArrayIndex = (pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber) / 4;
-		SYSBitField	  = (pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber) % 4;
+		// -> Configure the GPIO Port Selection in SYSCFG_EXTICR (only the fields of the given pins)
+		SYSCFG_EN();		// before configuring, enable clock
 
-		// Now store the Port Code
-		uint8_t portcode = GPIO_BASEADDR_TO_CODE(pGPIOHandle->pGPIOx);
-		SYSCFG_EN();												   // Clock Enable
-		SYSCFG->EXTICR[SYSArrayIndex] = portcode << (SYSBitField * 4); // before configuring, enable clock
+		for (uint8_t i = 0; i < 4; i++)
+		{
+			if (exticrMask[i])
+			{
+				SYSCFG->EXTICR[i] = (SYSCFG->EXTICR[i] & ~exticrMask[i]) | exticrVal[i];
+			}
+		}
 
+		// -> Register the callback of every pin (before the line is unmasked)
+		for (uint8_t pin = 0; pin < 16; pin++)
+		{
+			if (PinMask & GPIO_PIN_MASK(pin))
+			{
+				GPIO_CallbackTable[pin] = pPinConfig->GPIO_PinCallback;
+			}
+		}
 
 		// -> Enable EXTI Interrupt delivery using Interrupt Mask Register
-		EXTI->IMR |= (1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+		EXTI->IMR |= PinMask;
 	}
 
-	// -> 2. Configure the GPIO Speed
-
-	// Logic: Speed value left shifted by 2 * pin number
-	temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinSpeed << (2 * pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
-	pGPIOHandle->pGPIOx->OSPEEDR &= ~(0x3 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber); 				// Clear required bits
-	pGPIOHandle->pGPIOx->OSPEEDR |= temp;										// Update required bits
-
-	// Reset 'temp'
-	temp = 0;
-
-	// -> 3. Configure the Pull-up and Pull-down setting
-
-	temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinPuPdControl << (2 * pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
-	pGPIOHandle->pGPIOx->PUPDR &= ~(0x3 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber); // Clear required bits
-	pGPIOHandle->pGPIOx->PUPDR |= temp;
+	/* -Step 3. Configure the GPIO Speed- */
+	pGPIOx->OSPEEDR = (pGPIOx->OSPEEDR & ~mask2) | speedVal;
 
-	temp = 0;
+	/* -Step 4. Configure the Pull-up and Pull-down setting- */
+	pGPIOx->PUPDR = (pGPIOx->PUPDR & ~mask2) | pupdVal;
 
-	// -> 4. Configure the GPIO Output type
-
-	// Each Pin takes only 1 bit field thats why (1 * pin number)
-	temp = (pGPIOHandle->GPIO_PinConfig.GPIO_PinOPType << (1 * pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
-	pGPIOHandle->pGPIOx->OTYPER &= ~(0x1 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber); // Clear required bits
-	pGPIOHandle->pGPIOx->OTYPER |= temp;
-
-	temp = 0;
-
-	// -> 5. Configure the Alternate Functionality
-
-	// If mode is selected as Alternate Function then only configure for Alternate Functionality
-	if (pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_ALTFUNC)
+	/* -Step 5. Configure the GPIO Output type (each pin takes only 1 bit field)- */
+	if (pPinConfig->GPIO_PinOPType == GPIO_OP_TYPE_OD)
 	{
-		// In AFR, each pin takes 4 bit fields and there are two AF registers
-		// AF Low and AF High, in this project AF is defined as an array (stm2f407xx.h)
-		// AF[0]: Low (Pin 0 - 7), AF[1]: High (Pin 8 - 15)
-		// Logic: (x = (Pin_number / 8) ) if 1 then AF[1] and if 0 then AF[0]
-		//      : then, to get Bit position (y = (pin_number % 8))
-		//		AF[x] = alt_fnc_value  << (4 * y)
-
-		uint8_t AFarrayIndex, AFbitField;
+		pGPIOx->OTYPER |= PinMask;
+	}
+	else
+	{
+		pGPIOx->OTYPER &= ~((uint32_t) PinMask);
+	}
 
-		AFarrayIndex = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber / 8;
-		AFbitField	 = pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber % 8;
-		pGPIOHandle->pGPIOx->AFR[AFarrayIndex] &= ~(0xF << (4 * AFbitField));					// Clear required Bits
-		pGPIOHandle->pGPIOx->AFR[AFarrayIndex] |= pGPIOHandle->GPIO_PinConfig.GPIO_PinAltFuncMode << (4 * AFbitField);
+	/* -Step 6. Configure the Alternate Functionality (only if mode is Alternate Function)- */
+	if (pPinConfig->GPIO_PinMode == GPIO_MODE_ALTFUNC)
+	{
+		if (mask4[0])
+		{
+			pGPIOx->AFR[0] = (pGPIOx->AFR[0] & ~mask4[0]) | afVal[0];
+		}
 
+		if (mask4[1])
+		{
+			pGPIOx->AFR[1] = (pGPIOx->AFR[1] & ~mask4[1]) | afVal[1];
+		}
 	}
 
 }
@@ -363,19 +387,19 @@ uint16_t GPIO_ReadFromInputPort(GPIO_RegDef_t *pGPIOx)
  * Parameter 2	:	Pin number to be written
  * Parameter 3	:	Value to be written
  * Return Type	:	none (void)
- * Note		:
+ * Note		:	Uses BSRR: safe against ISRs writing other pins of the same port.
  * ------------------------------------------------------------------------------------------------------ */
 void GPIO_WriteToOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Value)
 {
 	if (Value == GPIO_PIN_SET)
 	{
-		// write 1 to the OUTPUT DATA Register at the bit position corresponds to given pin number
-		pGPIOx->ODR |= (1 << PinNumber);
+		// write 1 to the lower half of BSRR (BSx): sets the pin, atomic (no read-modify-write of ODR)
+		pGPIOx->BSRR = GPIO_PIN_MASK(PinNumber);
 	}
 	else
 	{
-		// clear or write 0 to the OUTPUT DATA Register at bit position corresponds to given pin number
-		pGPIOx->ODR &= ~(1 << PinNumber);
+		// write 1 to the upper half of BSRR (BRx): resets the pin, atomic (no read-modify-write of ODR)
+		pGPIOx->BSRR = (uint32_t) GPIO_PIN_MASK(PinNumber) << 16;
 	}
 }
 
@@ -403,11 +427,45 @@ void GPIO_WriteToOutputPort(GPIO_RegDef_t *pGPIOx, uint16_t Value)
  * Parameter 1	:	Base address of the GPIO peripheral
  * Parameter 2	: 	Pin Number to toggle
  * Return Type	:	none (void)
- * Note		:
+ * Note		:	Uses BSRR: only the given pin is written, other pins of the port are never touched.
  * ------------------------------------------------------------------------------------------------------ */
 void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber)
 {
-	pGPIOx->ODR ^= (1 << PinNumber);
+	uint32_t pin = GPIO_PIN_MASK(PinNumber);
+	uint32_t odr = pGPIOx->ODR;
+
+	// Pin HIGH -> reset (BRx, upper half), Pin LOW -> set (BSx, lower half)
+	pGPIOx->BSRR = ((odr & pin) << 16) | (~odr & pin);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	GPIO_SetPins
+ * Description	:	To set (HIGH) several pins of the given port at once
+ *
+ * Parameter 1	:	Base address of the GPIO peripheral
+ * Parameter 2	:	Pins to set, one bit per pin (GPIO_PIN_MASK(x) | ...)
+ * Return Type	:	none (void)
+ * Note		:	Single write to BSRR, atomic (no interrupt-disable section required).
+ * ------------------------------------------------------------------------------------------------------ */
+void GPIO_SetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+	pGPIOx->BSRR = PinMask;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	GPIO_ResetPins
+ * Description	:	To reset (LOW) several pins of the given port at once
+ *
+ * Parameter 1	:	Base address of the GPIO peripheral
+ * Parameter 2	:	Pins to reset, one bit per pin (GPIO_PIN_MASK(x) | ...)
+ * Return Type	:	none (void)
+ * Note		:	Single write to BSRR, atomic (no interrupt-disable section required).
+ * ------------------------------------------------------------------------------------------------------ */
+void GPIO_ResetPins(GPIO_RegDef_t *pGPIOx, uint16_t PinMask)
+{
+	pGPIOx->BSRR = (uint32_t) PinMask << 16;
 }
 
 
@@ -420,48 +478,19 @@ void GPIO_ToggleOutputPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber)
  * Parameter 1	:	IRQ number
  * Parameter 2	:	Enable or Disable the IRQ (ENABLE or DISABLE Macro)
  * Return Type	:	none (void)
- * Note		:
+ * Note		:	Any IRQ number (0 to 81), see stm32f407xx_nvic_drivers.h
  * ------------------------------------------------------------------------------------------------------ */
 void GPIO_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
 {
 	if (EnorDi == ENABLE)
 	{
 		// Interrupt Set Enable Registers NVIC_ISERx
-		if (IRQNumber <= 31)
-		{
-			// Configure ISER0 Register
-			*NVIC_ISER0 |= (1 << IRQNumber);
-		}
-		else if (IRQNumber > 31 && IRQNumber < 64)
-		{
-			// Configure ISER1 Register
-			*NVIC_ISER1 |= (1 << IRQNumber % 32);  // x % 32 to get to second register set and from its 0th bit
-
-		}
-		else if (IRQNumber >= 64 && IRQNumber < 96)
-		{
-			// COnfigure ISER2 Register : Sufficient, no need to configure more ISERx Registers
-			*NVIC_ISER2 |= (1 << IRQNumber % 64);  // x % 64 to get to third register set and from its 0th bit
-		}
+		NVIC_EnableIRQ(IRQNumber);
 	}
 	else	// Have to write 1 also to clear, writing 0 in ISER makes no effect
 	{
-		// Interrupt Clear Enable Registers NVIC_ISCRx
-		if (IRQNumber <= 31)
-		{
-			// Configure ICER0 Register
-			*NVIC_ICER0 |= (1 << IRQNumber);
-		}
-		else if (IRQNumber > 31 && IRQNumber < 64)
-		{
-			// Configure ICER1 Register
-			*NVIC_ICER1 |= (1 << IRQNumber % 32);  // x % 32 to get to second register set and from its 0th bit
-		}
-		else if (IRQNumber >= 64 && IRQNumber < 96)
-		{
-			// COnfigure ICER2 Register : Sufficient, no need to configure more ICERx Registers
-			*NVIC_ICER2 |= (1 << IRQNumber % 64);  // x % 64 to get to third register set and from its 0th bit
-		}
+		// Interrupt Clear Enable Registers NVIC_ICERx
+		NVIC_DisableIRQ(IRQNumber);
 	}
 
 }
@@ -478,18 +507,8 @@ void GPIO_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
  * ------------------------------------------------------------------------------------------------------ */
 void GPIO_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
 {
-	// There are 60 IPR (Interrupt Priority) registers
-	// Each register is of 32 bits and divided into 4 sections to accommodate 4 Priority values
-
-	// Now to get the right section and right bit field
-	uint8_t iprx		 = IRQNumber / 4;
-	uint8_t iprx_section = IRQNumber % 4;
-
-	// NVIC_PRI_BASEADDR + iprx to jump to the required address
-	// shift value is calculated because lower 4 bits of each section are not implemented
-	uint8_t shiftValue	 = (8 * iprx_section) + (8 - PRI_BITS_IMPLEMENTED);
-	*(NVIC_PRI_BASEADDR + iprx) |= (IRQPriority << shiftValue);
-
+	// Replaces the previous priority (byte access to NVIC_IPRx, see stm32f407xx_nvic_drivers.h)
+	NVIC_SetPriority(IRQNumber, IRQPriority);
 }
 
 
@@ -506,7 +525,101 @@ void GPIO_IRQHandling(uint8_t PinNumber)
 	// Clear the EXTI PR Register corresponds to the pin number
 	if (EXTI->PR & (1 << PinNumber))	// if PR is set means interrupt is pended
 	{
-		// Clear it by writing 1
-		EXTI->PR |= (1 << PinNumber);
+		// Clear it by writing 1 (writing 0 has no effect: no read-modify-write, other pending lines are kept)
+		EXTI->PR = (1 << PinNumber);
 	}
 }
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	GPIO_RegisterCallback
+ * Description	:	To register (or replace) the callback of an EXTI Line
+ *
+ * Parameter 1	:	Pin Number (EXTI Line 0 to 15)
+ * Parameter 2	:	Callback (NULL: the line is only cleared)
+ * Return Type	:	none (void)
+ * Note		:	GPIO_Init registers GPIO_PinCallback automatically for Interrupt Modes.
+ * ------------------------------------------------------------------------------------------------------ */
+void GPIO_RegisterCallback(uint8_t PinNumber, GPIO_Callback_t Callback)
+{
+	if (PinNumber < 16)
+	{
+		GPIO_CallbackTable[PinNumber] = Callback;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	GPIO_IRQDispatch
+ * Description	:	To process all pending EXTI Lines of an IRQ:
+ *
+ * Parameter 1	:	EXTI Lines served by the IRQ (GPIO_PIN_MASK(x), GPIO_EXTI_LINES_9_5, GPIO_EXTI_LINES_15_10)
+ * Return Type	:	none (void)
+ * Note		:	EXTI->PR is read once, the pending lines are cleared with a single write (before the
+ *			callbacks, so an edge during a callback pends again) and each line is found with CLZ
+ *			(count leading zeros, one instruction) instead of scanning pin by pin.
+ * ------------------------------------------------------------------------------------------------------ */
+void GPIO_IRQDispatch(uint16_t LineMask)
+{
+	uint32_t pending = EXTI->PR & LineMask;
+
+	// Clear by writing 1 (only the lines being dispatched)
+	EXTI->PR = pending;
+
+	while (pending)
+	{
+		// Highest pending line first: 31 - CLZ
+		uint8_t pin = (uint8_t) (31 - __builtin_clz(pending));
+
+		pending &= ~(1U << pin);
+
+		if (GPIO_CallbackTable[pin] != NULL)
+		{
+			GPIO_CallbackTable[pin](pin);
+		}
+	}
+}
+
+
+/* -- EXTI IRQ Handlers (replace the Default_Handler aliases of the startup file) --
+ * An application implementing its own EXTI handlers defines GPIO_NO_EXTI_IRQ_HANDLERS (-D) and
+ * calls GPIO_IRQDispatch() or GPIO_IRQHandling() from them.
+ */
+#ifndef GPIO_NO_EXTI_IRQ_HANDLERS
+
+void EXTI0_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_PIN_MASK(0));
+}
+
+void EXTI1_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_PIN_MASK(1));
+}
+
+void EXTI2_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_PIN_MASK(2));
+}
+
+void EXTI3_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_PIN_MASK(3));
+}
+
+void EXTI4_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_PIN_MASK(4));
+}
+
+void EXTI9_5_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_EXTI_LINES_9_5);
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+	GPIO_IRQDispatch(GPIO_EXTI_LINES_15_10);
+}
+
+#endif /* GPIO_NO_EXTI_IRQ_HANDLERS */
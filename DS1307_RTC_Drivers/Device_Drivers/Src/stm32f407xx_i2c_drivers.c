@@ -6,13 +6,13 @@
  */
 
 #include <stm32f407xx_i2c_drivers.h>
+#include <stm32f407xx_nvic_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+#include <stm32f407xx_systick_drivers.h>
 
 
 /* -- Helper Functions prototypes  -- */
 
-// To get the value of Pclk1 (defined in stm32f407xx_rcc_driver.c)
-uint32_t RCC_Pclk1_Value(void);
-
 // To Execute Address Phase : for Writing (Master Tx -> Slave Rx)
 static void I2C_ExecuteAddressPhase_Write(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddress);
 
@@ -20,7 +20,19 @@ static void I2C_ExecuteAddressPhase_Write(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddr
 static void I2C_ExecuteAddressPhase_Read(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddress);
 
 // To clear ADDR Flag
-static void I2C_ClearADDRFlag(I2C_Handle_t *pI2CHandle);
+__RAMFUNC static void I2C_ClearADDRFlag(I2C_Handle_t *pI2CHandle);
+
+// To configure FREQ, CCR and TRISE from the current Pclk1
+static uint8_t I2C_ConfigTiming(I2C_Handle_t *pI2CHandle);
+
+// To apply a deferred timing update before a new transaction
+static void I2C_ApplyPendingTiming(I2C_Handle_t *pI2CHandle);
+
+// To wait for a SR1 flag with a deadline (polled transfers)
+static uint8_t I2C_WaitFlag(I2C_RegDef_t *pI2Cx, uint32_t FlagName);
+
+// To end a failed polled transfer (STOP, ACKing restored)
+static uint8_t I2C_MasterAbort(I2C_Handle_t *pI2CHandle, uint8_t Status);
 
 
 
@@ -96,7 +108,8 @@ void I2C_PeriClockControl(I2C_RegDef_t *pI2Cx, uint8_t EnorDi)
  * 			3. Configure the device address (only when device is Slave)
  * 			4. Enable ACking
  * 			5. Configure the rise time for I2C pins (TRISE)
- *			For FREQ configuration, it is known that HSI is 16 MHz, but still it is required to calculate
+ *			FREQ, CCR and TRISE are computed from the cached Pclk1 (I2C_ConfigTiming), and
+ *			recomputed by I2C_UpdateTiming after a clock change.
  *
  *			Also, Peripheral Clock is enabled at starting of the function, so users need not do it explicitly.
  * ------------------------------------------------------------------------------------------------------ */
@@ -114,14 +127,8 @@ void I2C_Init(I2C_Handle_t *pI2CHandle)
 	// Configure CR1 Register
 	pI2CHandle->pI2Cx->CR1 = tempReg;
 
-	/* - Configure the FREQ fields (CR2 Register) - */
-
-	tempReg = 0;
-	// Get Pclk value [Returns 16HMz (STM32F407)]
-	tempReg |= RCC_Pclk1_Value() / 1000000U;		// divide by 1000000 to get value 16
-
-	// Configure CR2 with FREQ value
-	pI2CHandle->pI2Cx->CR2 = (tempReg & 0x3F);		// Masking: Only need first 6 bits (FREQ[5:0])
+	// Interrupt enable bits cleared, FREQ is configured below
+	pI2CHandle->pI2Cx->CR2 = 0;
 
 	/* - Configure the Slave Address - */
 
@@ -143,126 +150,8 @@ void I2C_Init(I2C_Handle_t *pI2CHandle)
 	tempReg |= (1 << 14);
 	pI2CHandle->pI2Cx->OAR1 = tempReg;
 
-	/* - Configure the Serial Clock Speed - */
-
-	// Configure the CCR fields (CCR Register)
-	// Bits[11:0]	: CCR field
-
-	// CCR calculations
-	uint16_t ccr_value = 0;
-	tempReg = 0;
-
-	if (pI2CHandle->I2C_Config.I2C_SCL_Speed <= I2C_SCL_SPEED_SM)
-	{
-		//STEP a:  Mode is Standard Mode (Configure the 15th bit in CCR register)
-		// Bit 15: 0 for Standard Mode (by default (reset value))
-
-		// STEP b: Calculate value of CCR for Standard Mode frequency
-		/* Formula to calculate CCR
-		 *	T(high scl) = CCR * T(pclk)
-		 *	T(low scl) = CCR * T(pclk)
-		 *   Assuming, T(high) = T(low) of SCL
-		 *   => T(scl) = 2 * CCR * T(pclk1)
-		 *   => CCR = T(scl) / 2 * T(pclk1)
-		 *
-		 *   In terms of frequency
-		 *   => CCR = f(pclk1) / 2 * f(scl)
-		 */
-
-		// CCR = Pclk1 / I2C_SCL_Speed
-		ccr_value = (RCC_Pclk1_Value() / (2 * pI2CHandle->I2C_Config.I2C_SCL_Speed));
-
-		// Save CCR value in tempReg register and Mask out unnecessary bits (CCR Bits[11:0])
-		tempReg |= (ccr_value & 0xFFF);
-	}
-	else
-	{
-		// STEP a:  Mode is Fast Mode
-		// Set Bit 15: 1 for Fast Mode
-		tempReg |= (1 << 15);
-
-		// STEP b: Configure Duty Cycle
-		// Bit 14 (user configured)
-		tempReg |= (pI2CHandle->I2C_Config.I2C_FM_DutyCycle << 14);
-
-		// STEP c: Calculate value of CCR for Fast Mode
-		/* Formula to calculate CCR in FM
-		 *
-		 * if DUTY (I2C_FM_DutyCycle) = 0 then, T(low) = 2 * T(high)
-		 *
-		 * 	T(high) = CCR * T(pclk1)
-		 * 	T(low)  = 2 * CCR * T(pclk1)
-		 *
-		 * 	CCR = f(pclk1) / (3 * f(scl))
-		 *
-		 * if DUTY (I2C_FM_DutyCycle) = 1 then, T(low) = ~ 1.7 * T(high)   [to reach 400kHz]
-		 *
-		 *  	T(high) = 9 * CCR * T(pclk1)
-		 *	T(low)  = 16 * CCR * T(pclk1)
-		 *
-		 *	CCR = f(pclk1) / (25 * f(scl))
-		 * */
-
-		// Check for DUTY CYCLE (user configured)
-		if(pI2CHandle->I2C_Config.I2C_FM_DutyCycle == I2C_FM_DutyCycle_2)
-		{
-			// CCR = f(pclk1) / (3 * f(scl))
-			ccr_value = (RCC_Pclk1_Value() / (3 * pI2CHandle->I2C_Config.I2C_SCL_Speed));
-
-		}
-		else if (pI2CHandle->I2C_Config.I2C_FM_DutyCycle == I2C_FM_DutyCycle_16_9)
-		{
-			// CCR = f(pclk1) / (25 * f(scl))
-			ccr_value = (RCC_Pclk1_Value() / (25 * pI2CHandle->I2C_Config.I2C_SCL_Speed));
-
-		}
-		else
-		{
-			// Meh
-		}
-
-		// Save CCR value in tempReg register and Mask out unnecessary bits (CCR Bits[11:0])
-		tempReg |= (ccr_value & 0xFFF);
-
-	}
-
-
-	// Configure the CCR Register with value in tempReg
-	pI2CHandle->pI2Cx->CCR = tempReg;
-
-	/* - Configure the rise time for I2C pins - */
-
-	// Configure the TRISE Register
-	// TRISE[5:0] Maximum rise time in Fast Mode or Standard Mode
-	// Get values from I2C specification
-	/* Configure with value => (Max_SCL_rise_time / T(pclk1) + 1 [Reference Manual]
-	 *			=> [Trise(max) / T(pclk1)] + 1
-	 *			=> [Trise(max) * f(pclk1)] + 1
-	 *
-	 */
-
-	// Check if Mode is FM or SM
-	if (pI2CHandle->I2C_Config.I2C_SCL_Speed <= I2C_SCL_SPEED_SM)
-	{
-		// Mode: SM
-
-		// [Trise(max) * f(pclk1)] + 1
-		// Trise (max) for standard mode is 1000ns (I2C specification)
-		tempReg = (RCC_Pclk1_Value() / 1000000U) + 1;
-
-	}
-	else
-	{
-		// Mode: FM
-
-		// [Trise(max) * f(pclk1)] + 1
-		// Trise (max) for fast mode is 300ns (I2C specification)
-		tempReg = (((RCC_Pclk1_Value() * 300 ) / 1000000000U) + 1);
-
-	}
-
-	// Configure the TRISE Register with value in tempReg
-	pI2CHandle->pI2Cx->TRISE = tempReg & 0x3F;		// TRISE[5:0] Mask others
+	/* - Configure FREQ, Serial Clock Speed (CCR) and rise time (TRISE) from Pclk1 - */
+	I2C_ConfigTiming(pI2CHandle);
 
 }
 
@@ -300,6 +189,49 @@ void I2C_DeInit(I2C_RegDef_t *pI2Cx)
 }
 
 
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_UpdateTiming
+ * Description	:	To recompute and reprogram FREQ, CCR and TRISE after a Pclk1 change
+ *
+ * Parameter 1	:	Handle pointer variable
+ * Return Type	:	@I2C_TIMING
+ * Note		:	Meant to be called from an RCC clock-change listener (RCC_RegisterClockListener).
+ *			CCR and TRISE can only be written with PE = 0, which would abort a transfer, so:
+ *			- bus idle		: applied now (PE cleared, timing written, PE and ACK restored)
+ *			- transfer running	: deferred (I2C_TIMING_DEFERRED), applied at the start of the
+ *						  next Master Send/Receive, once the bus is free
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t I2C_UpdateTiming(I2C_Handle_t *pI2CHandle)
+{
+	uint8_t status;
+	uint32_t peState;
+
+	/* -Step 1. Defer while a transaction is in progress (IT state or bus BUSY)- */
+	if ((pI2CHandle->TxRxState != I2C_READY) || (pI2CHandle->pI2Cx->SR2 & (1 << I2C_SR2_BUSY)))
+	{
+		pI2CHandle->TimingUpdatePending = SET;
+		return I2C_TIMING_DEFERRED;
+	}
+
+	/* -Step 2. Disable the peripheral (CCR and TRISE are writable with PE = 0 only)- */
+	peState = pI2CHandle->pI2Cx->CR1 & (1 << I2C_CR1_PE);
+	pI2CHandle->pI2Cx->CR1 &= ~(1 << I2C_CR1_PE);
+
+	/* -Step 3. Program FREQ, CCR and TRISE from the new Pclk1- */
+	status = I2C_ConfigTiming(pI2CHandle);
+	pI2CHandle->TimingUpdatePending = RESET;
+
+	/* -Step 4. Restore PE, and ACK (cleared by hardware when PE = 0)- */
+	pI2CHandle->pI2Cx->CR1 |= peState;
+	if (peState && (pI2CHandle->I2C_Config.I2C_ACK_Control == I2C_ACK_ENABLE))
+	{
+		I2C_ManageACK(pI2CHandle->pI2Cx, ENABLE);
+	}
+
+	return status;
+}
+
+
 /* -- > SPI Send and Receive Data < -- */
 
 /* ------------------------------------------------------------------------------------------------------
@@ -311,18 +243,29 @@ void I2C_DeInit(I2C_RegDef_t *pI2Cx)
  * Parameter 3	:   	Length of the Data to send
  * Parameter 4	: 	Slave Address
  * Parameter 5	:	RepeatedStart (MACRO I2C_REPEATED_START_EN/_DI), to enable or disable repeated start
- * Return Type	:	none (void)
+ * Return Type	:	uint8_t @I2C_STATUS
  * Note		:	Blocking API (Polling), function call will wait until all the bytes are transmitted.
+ *			Every flag wait is bounded (I2C_TIMEOUT_MS): on a stuck bus or a NACK the transfer is
+ *			ended with a STOP and the error returned.
  * ------------------------------------------------------------------------------------------------------ */
-void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
+uint8_t I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
 {
+	uint8_t status;
+
+	// Safe point between transactions: apply a deferred clock change (I2C_UpdateTiming)
+	I2C_ApplyPendingTiming(pI2CHandle);
+
 	/* - Step 1: Generate the START condition - */
 	I2C_GenerateStartCondition(pI2CHandle->pI2Cx);
 
 	/* - Step 2: Confirm generation of START condition - */
 	// By checking SB Flag in SR1
 	// Until SB is cleared, SCL will be stretched (SCL will be pulled to LOW)
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_SB)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_SB);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 	// Clearing is done (by reading)
 
 	/* - Step 3: Send the address of the Slave with R/~W bit as 0 - */
@@ -332,7 +275,11 @@ void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t L
 
 	/* - Step 4: Confirm completetion of Address Phase - */
 	// By checking the ADDR Flag in SR1
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_ADDR)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_ADDR);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 
 
 	/* - Step 5: Clear the ADDR Flag (according to its software sequence) - */
@@ -347,7 +294,11 @@ void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t L
 	while (LenOfData > 0)
 	{
 		// Wait till TxE is Set
-		while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_TXE)));
+		status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_TXE);
+		if (status != I2C_OK)
+		{
+			return I2C_MasterAbort(pI2CHandle, status);
+		}
 
 		// Send data (Copy to DR)
 		pI2CHandle->pI2Cx->DR = *pTxBuffer;
@@ -365,10 +316,18 @@ void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t L
 	// TxE = 1 and BTF = 1 means, both Shoft register and DR are empty
 
 	// Wait till TxE is Set
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_TXE)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_TXE);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 
 	// Wait till BTF is Set
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_BTF)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_BTF);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 
 
 	/* - Step 8: Generate the STOP condition - */
@@ -380,6 +339,7 @@ void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t L
 		I2C_GenerateStopCondition(pI2CHandle->pI2Cx);
 	}
 
+	return I2C_OK;
 }
 
 
@@ -392,18 +352,29 @@ void I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t L
  * Parameter 3	:   	Length of the Data to send
  * Parameter 4	: 	Slave Address
  * Parameter 5	:	RepeatedStart (MACRO I2C_REPEATED_START_EN/_DI), to enable or disable repeated start
- * Return Type	:	none (void)
+ * Return Type	:	uint8_t @I2C_STATUS
  * Note		:	Blocking API (Polling), function call will wait until all the bytes are received.
+ *			Every flag wait is bounded (I2C_TIMEOUT_MS): on a stuck bus or a NACK the transfer is
+ *			ended with a STOP and the error returned (buffer partly written).
  * ------------------------------------------------------------------------------------------------------ */
-void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
+uint8_t I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
 {
+	uint8_t status;
+
+	// Safe point between transactions: apply a deferred clock change (I2C_UpdateTiming)
+	I2C_ApplyPendingTiming(pI2CHandle);
+
 	/* - Step 1: Generate the START condition - */
 	I2C_GenerateStartCondition(pI2CHandle->pI2Cx);
 
 	/* - Step 2: Confirm generation of START condition - */
 	// By checking SB Flag in SR1
 	// Until SB is cleared, SCL will be stretched (SCL will be pulled to LOW)
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_SB)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_SB);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 	// Clearing is done (by reading)
 
 	/* - Step 3: Send the address of the Slave with R/~W bit as 1 - */
@@ -412,7 +383,11 @@ void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_
 
 	/* - Step 4: Confirm completetion of Address Phase - */
 	// By checking the ADDR Flag in SR1
-	while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_ADDR)));
+	status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_ADDR);
+	if (status != I2C_OK)
+	{
+		return I2C_MasterAbort(pI2CHandle, status);
+	}
 
 
 	/* - Step 5: CHECK for length of data from the slave and follow procedures - */
@@ -431,7 +406,11 @@ void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_
 
 
 		// c. Wait until RxNE becomes 1
-		while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_RXNE)));
+		status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_RXNE);
+		if (status != I2C_OK)
+		{
+			return I2C_MasterAbort(pI2CHandle, status);
+		}
 
 		// d. Set STOP bit to 1 [STOP condition (in CR)]
 		if (repeatedStart == I2C_REPEATED_START_DI)
@@ -458,7 +437,11 @@ void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_
 		for (uint32_t i = LenOfData; i > 0; i--)
 		{
 			// c. Wait until RxNE becomes 1
-			while (!(I2C_getFlagStatus(pI2CHandle->pI2Cx, I2C_FLAG_RXNE)));
+			status = I2C_WaitFlag(pI2CHandle->pI2Cx, I2C_FLAG_RXNE);
+			if (status != I2C_OK)
+			{
+				return I2C_MasterAbort(pI2CHandle, status);
+			}
 
 			// d. Check: if only last 2 bytes are remaining
 			if (i == 2)
@@ -491,6 +474,7 @@ void I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_
 		I2C_ManageACK(pI2CHandle->pI2Cx, I2C_ACK_ENABLE);
 	}
 
+	return I2C_OK;
 }
 
 
@@ -514,6 +498,9 @@ uint8_t I2C_MasterSendData_IT(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint
 	// Only when Peripheral is NOT busy
 	if( (state != I2C_BUSY_IN_TX) && (state != I2C_BUSY_IN_RX))
 	{
+		// Safe point between transactions: apply a deferred clock change (I2C_UpdateTiming)
+		I2C_ApplyPendingTiming(pI2CHandle);
+
 		// a. Save the Tx buffer address and length information in a global variable
 		pI2CHandle->pTxBuffer = pTxBuffer;		// Saving Tx Buffer Address
 		pI2CHandle->TxDataLength = LenOfData;		// Saving Length Information
@@ -569,6 +556,9 @@ uint8_t I2C_MasterReceiveData_IT(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, u
 	// Only when Peripheral is NOT busy
 	if( (state != I2C_BUSY_IN_TX) && (state != I2C_BUSY_IN_RX))
 	{
+		// Safe point between transactions: apply a deferred clock change (I2C_UpdateTiming)
+		I2C_ApplyPendingTiming(pI2CHandle);
+
 		// a. Save the Tx buffer address and length information in a global variable
 		pI2CHandle->pRxBuffer = pRxBuffer;		// Saving Rx Buffer Address
 		pI2CHandle->RxDataLength = LenOfData;		// Saving Length Information
@@ -767,49 +757,21 @@ void I2C_GenerateStopCondition(I2C_RegDef_t *pI2Cx)
  * Parameter 1	:	IRQ number
  * Parameter 2	:	Enable or Disable the IRQ (ENABLE or DISABLE Macro)
  * Return Type	:	none (void)
- * Note		:
+ * Note		:	Any IRQ number (0 to 81), see stm32f407xx_nvic_drivers.h
  * ------------------------------------------------------------------------------------------------------ */
 void I2C_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
 {
 	if (EnorDi == ENABLE)
 	{
 		// Interrupt Set Enable Registers NVIC_ISERx
-		if (IRQNumber <= 31)
-		{
-			// Configure ISER0 Register
-			*NVIC_ISER0 |= (1 << IRQNumber);
-		}
-		else if (IRQNumber > 31 && IRQNumber < 64)
-		{
-			// Configure ISER1 Register
-			*NVIC_ISER1 |= (1 << IRQNumber % 32);  // x % 32 to get to second register set and from its 0th bit
-
-		}
-		else if (IRQNumber >= 64 && IRQNumber < 96)
-		{
-			// COnfigure ISER2 Register : Sufficient, no need to configure more ISERx Registers
-			*NVIC_ISER2 |= (1 << IRQNumber % 64);  // x % 64 to get to third register set and from its 0th bit
-		}
+		NVIC_EnableIRQ(IRQNumber);
 	}
 	else	// Have to write 1 also to clear, writing 0 in ISER makes no effect
 	{
-		// Interrupt Clear Enable Registers NVIC_ISCRx
-		if (IRQNumber <= 31)
-		{
-			// Configure ICER0 Register
-			*NVIC_ICER0 |= (1 << IRQNumber);
-		}
-		else if (IRQNumber > 31 && IRQNumber < 64)
-		{
-			// Configure ICER1 Register
-			*NVIC_ICER1 |= (1 << IRQNumber % 32);  // x % 32 to get to second register set and from its 0th bit
-		}
-		else if (IRQNumber >= 64 && IRQNumber < 96)
-		{
-			// COnfigure ICER2 Register : Sufficient, no need to configure more ICERx Registers
-			*NVIC_ICER2 |= (1 << IRQNumber % 64);  // x % 64 to get to third register set and from its 0th bit
-		}
+		// Interrupt Clear Enable Registers NVIC_ICERx
+		NVIC_DisableIRQ(IRQNumber);
 	}
+
 }
 
 
@@ -824,18 +786,8 @@ void I2C_IRQInterruptConfig(uint8_t IRQNumber, uint8_t EnorDi)
  * ------------------------------------------------------------------------------------------------------ */
 void I2C_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
 {
-	// There are 60 IPR (Interrupt Priority) registers
-	// Each register is of 32 bits and divided into 4 sections to accommodate 4 Priority values
-
-	// Now to get the right section and right bit field
-	uint8_t iprx		 = IRQNumber / 4;
-	uint8_t iprx_section = IRQNumber % 4;
-
-	// NVIC_PRI_BASEADDR + iprx to jump to the required address
-	// shift value is calculated because lower 4 bits of each section are not implemented
-	uint8_t shiftValue	 = (8 * iprx_section) + (8 - PRI_BITS_IMPLEMENTED);
-	*(NVIC_PRI_BASEADDR + iprx) |= (IRQPriority << shiftValue);
-
+	// Replaces the previous priority (byte access to NVIC_IPRx, see stm32f407xx_nvic_drivers.h)
+	NVIC_SetPriority(IRQNumber, IRQPriority);
 }
 
 
@@ -848,8 +800,9 @@ void I2C_IRQPriorityConfig(uint8_t IRQNumber, uint32_t IRQPriority)
  * Note		:	Event Interrupt can be generated by:
  * 				-> SB, ADDR, ADD10, STOPF, BTF, TxE, ITBUFEN, RxNE
  * 				ADDR10 is not implemented (NOT using 10 bit Address Mode)
+ *			Runs from SRAM (__RAMFUNC): one interrupt per byte, no Flash wait states.
  * ------------------------------------------------------------------------------------------------------ */
-void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
+__RAMFUNC void I2C_EV_IRQHandling(I2C_Handle_t *pI2CHandle)
 {
 	/* - Interrupt handling for both Master and Slave Mode - */
 
@@ -1432,7 +1385,7 @@ static void I2C_ExecuteAddressPhase_Read(I2C_RegDef_t *pI2Cx, uint8_t SlaveAddre
  * Note		:	Private helper function
  *
  * ------------------------------------------------------------------------------------------------------ */
-static void I2C_ClearADDRFlag(I2C_Handle_t *pI2CHandle)
+__RAMFUNC static void I2C_ClearADDRFlag(I2C_Handle_t *pI2CHandle)
 {
 	// Clearing: Cleared by software by reading SR1 Register followed reading SR2 or by hardware when PE = 0
 	// Simply read SR1 and SR2
@@ -1488,3 +1441,244 @@ static void I2C_ClearADDRFlag(I2C_Handle_t *pI2CHandle)
 
 
 }
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_ConfigTiming
+ * Description	:	To configure FREQ (CR2), CCR and TRISE from the current Pclk1
+ *
+ * Parameter 1	:	Handle pointer variable
+ * Return Type	:	@I2C_TIMING (I2C_TIMING_OK, I2C_TIMING_ERR_PCLK or I2C_TIMING_ERR_DUTY)
+ * Note		:	Private helper function. The peripheral MUST be disabled (PE = 0).
+ *			On an error nothing is written (a FM CCR of 0 is not allowed).
+ *			FREQ and CCR are rounded up, so SCL never exceeds I2C_SCL_Speed at any Pclk1
+ *			(e.g. Pclk1 5.25 MHz, SM: CCR 27 -> 97.2 kHz, truncated CCR 26 would give 101 kHz).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t I2C_ConfigTiming(I2C_Handle_t *pI2CHandle)
+{
+	uint32_t tempReg;
+
+	// APB1 clock (cached by the RCC driver), used by FREQ, CCR and TRISE
+	uint32_t pclk1 = RCC_Pclk1_Value();
+	uint32_t freqMHz = (pclk1 + 999999U) / 1000000U;
+
+	/* - Check Pclk1 range (Reference Manual: min 2 MHz in SM, 4 MHz in FM, max 50 MHz) - */
+	if ((pclk1 < ((pI2CHandle->I2C_Config.I2C_SCL_Speed <= I2C_SCL_SPEED_SM) ? 2000000U : 4000000U)) || (freqMHz > 50))
+	{
+		return I2C_TIMING_ERR_PCLK;
+	}
+
+	/* - Check the Duty Cycle in Fast Mode (only two values, see CCR calculations) - */
+	if ((pI2CHandle->I2C_Config.I2C_SCL_Speed > I2C_SCL_SPEED_SM) &&
+	    (pI2CHandle->I2C_Config.I2C_FM_DutyCycle != I2C_FM_DutyCycle_2) &&
+	    (pI2CHandle->I2C_Config.I2C_FM_DutyCycle != I2C_FM_DutyCycle_16_9))
+	{
+		return I2C_TIMING_ERR_DUTY;
+	}
+
+	/* - Configure the FREQ fields (CR2 Register) - */
+
+	// Pclk1 in MHz [16 MHz on HSI, 42 MHz on PLL 168 MHz (STM32F407)], interrupt enable bits kept
+	pI2CHandle->pI2Cx->CR2 = (pI2CHandle->pI2Cx->CR2 & ~0x3FU) | (freqMHz & 0x3F);	// FREQ[5:0]
+
+	/* - Configure the Serial Clock Speed - */
+
+	// Configure the CCR fields (CCR Register)
+	// Bits[11:0]	: CCR field
+
+	// CCR calculations
+	uint32_t ccr_value = 0;
+	tempReg = 0;
+
+	if (pI2CHandle->I2C_Config.I2C_SCL_Speed <= I2C_SCL_SPEED_SM)
+	{
+		//STEP a:  Mode is Standard Mode (Configure the 15th bit in CCR register)
+		// Bit 15: 0 for Standard Mode (by default (reset value))
+
+		// STEP b: Calculate value of CCR for Standard Mode frequency
+		/* Formula to calculate CCR
+		 *	T(high scl) = CCR * T(pclk)
+		 *	T(low scl) = CCR * T(pclk)
+		 *   Assuming, T(high) = T(low) of SCL
+		 *   => T(scl) = 2 * CCR * T(pclk1)
+		 *   => CCR = T(scl) / 2 * T(pclk1)
+		 *
+		 *   In terms of frequency
+		 *   => CCR = f(pclk1) / 2 * f(scl)
+		 */
+
+		// CCR = Pclk1 / (2 * I2C_SCL_Speed), rounded up (SCL never above I2C_SCL_Speed)
+		ccr_value = (pclk1 + (2 * pI2CHandle->I2C_Config.I2C_SCL_Speed) - 1) / (2 * pI2CHandle->I2C_Config.I2C_SCL_Speed);
+
+		// Minimum allowed CCR in Standard Mode is 4
+		if (ccr_value < 4)
+		{
+			ccr_value = 4;
+		}
+
+		// Save CCR value in tempReg register and Mask out unnecessary bits (CCR Bits[11:0])
+		tempReg |= (ccr_value & 0xFFF);
+	}
+	else
+	{
+		// STEP a:  Mode is Fast Mode
+		// Set Bit 15: 1 for Fast Mode
+		tempReg |= (1 << 15);
+
+		// STEP b: Configure Duty Cycle
+		// Bit 14 (user configured)
+		tempReg |= (pI2CHandle->I2C_Config.I2C_FM_DutyCycle << 14);
+
+		// STEP c: Calculate value of CCR for Fast Mode
+		/* Formula to calculate CCR in FM
+		 *
+		 * if DUTY (I2C_FM_DutyCycle) = 0 then, T(low) = 2 * T(high)
+		 *
+		 * 	T(high) = CCR * T(pclk1)
+		 * 	T(low)  = 2 * CCR * T(pclk1)
+		 *
+		 * 	CCR = f(pclk1) / (3 * f(scl))
+		 *
+		 * if DUTY (I2C_FM_DutyCycle) = 1 then, T(low) = ~ 1.7 * T(high)   [to reach 400kHz]
+		 *
+		 *  	T(high) = 9 * CCR * T(pclk1)
+		 *	T(low)  = 16 * CCR * T(pclk1)
+		 *
+		 *	CCR = f(pclk1) / (25 * f(scl))
+		 * */
+
+		// Check for DUTY CYCLE (user configured, checked above)
+		if(pI2CHandle->I2C_Config.I2C_FM_DutyCycle == I2C_FM_DutyCycle_2)
+		{
+			// CCR = f(pclk1) / (3 * f(scl))
+			ccr_value = (pclk1 + (3 * pI2CHandle->I2C_Config.I2C_SCL_Speed) - 1) / (3 * pI2CHandle->I2C_Config.I2C_SCL_Speed);
+
+		}
+		else
+		{
+			// I2C_FM_DutyCycle_16_9: CCR = f(pclk1) / (25 * f(scl))
+			ccr_value = (pclk1 + (25 * pI2CHandle->I2C_Config.I2C_SCL_Speed) - 1) / (25 * pI2CHandle->I2C_Config.I2C_SCL_Speed);
+
+		}
+
+		// Save CCR value in tempReg register and Mask out unnecessary bits (CCR Bits[11:0])
+		tempReg |= (ccr_value & 0xFFF);
+
+	}
+
+
+	// Configure the CCR Register with value in tempReg
+	pI2CHandle->pI2Cx->CCR = tempReg;
+
+	/* - Configure the rise time for I2C pins - */
+
+	// Configure the TRISE Register
+	// TRISE[5:0] Maximum rise time in Fast Mode or Standard Mode
+	// Get values from I2C specification
+	/* Configure with value => (Max_SCL_rise_time / T(pclk1) + 1 [Reference Manual]
+	 *			=> [Trise(max) / T(pclk1)] + 1
+	 *			=> [Trise(max) * f(pclk1)] + 1
+	 *
+	 */
+
+	// Check if Mode is FM or SM
+	if (pI2CHandle->I2C_Config.I2C_SCL_Speed <= I2C_SCL_SPEED_SM)
+	{
+		// Mode: SM
+
+		// [Trise(max) * f(pclk1)] + 1
+		// Trise (max) for standard mode is 1000ns (I2C specification)
+		tempReg = (pclk1 / 1000000U) + 1;
+
+	}
+	else
+	{
+		// Mode: FM
+
+		// [Trise(max) * f(pclk1)] + 1
+		// Trise (max) for fast mode is 300ns (I2C specification)
+		// (pclk1 in MHz first: pclk1 * 300 overflows 32 bits above 14.3 MHz)
+		tempReg = (((pclk1 / 1000000U) * 300U) / 1000U) + 1;
+
+	}
+
+	// Configure the TRISE Register with value in tempReg
+	pI2CHandle->pI2Cx->TRISE = tempReg & 0x3F;		// TRISE[5:0] Mask others
+
+	return I2C_TIMING_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_ApplyPendingTiming
+ * Description	:	To apply a deferred timing update (see I2C_UpdateTiming) before a new transaction
+ *
+ * Parameter 1	:	Handle pointer variable
+ * Return Type	:	none (void)
+ * Note		:	Private helper function. Stays deferred while the bus is BUSY (e.g. repeated START).
+ * ------------------------------------------------------------------------------------------------------ */
+static void I2C_ApplyPendingTiming(I2C_Handle_t *pI2CHandle)
+{
+	if (pI2CHandle->TimingUpdatePending)
+	{
+		(void)I2C_UpdateTiming(pI2CHandle);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_WaitFlag
+ * Description	:	To wait for a SR1 flag with a deadline
+ *
+ * Parameter 1	:	Base address of the I2C peripheral
+ * Parameter 2	:	Flag Name (I2C_FLAG_SB, _ADDR, _TXE, _RXNE, _BTF)
+ * Return Type	:	uint8_t @I2C_STATUS
+ * Note		:	Private helper function. Deadline of I2C_TIMEOUT_MS on the SysTick time base, with a
+ *			poll count backstop (I2C_TIMEOUT_POLLS) for callers the tick cannot interrupt. AF ends
+ *			the wait at once: ADDR or TXE never come after a NACK.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t I2C_WaitFlag(I2C_RegDef_t *pI2Cx, uint32_t FlagName)
+{
+	uint32_t start = SysTick_GetTicks();
+	uint32_t ticks = SysTick_MsToTicks(I2C_TIMEOUT_MS) + 1;		// + 1: first tick may be partial
+	uint32_t polls = I2C_TIMEOUT_POLLS;
+
+	while (!(pI2Cx->SR1 & FlagName))
+	{
+		if (pI2Cx->SR1 & I2C_FLAG_AF)
+		{
+			return I2C_ERR_NACK;
+		}
+
+		if ((SysTick_Elapsed(start) >= ticks) || (--polls == 0))
+		{
+			return I2C_ERR_TIMEOUT;
+		}
+	}
+
+	return I2C_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_MasterAbort
+ * Description	:	To end a failed polled transfer
+ *
+ * Parameter 1	:	Handle pointer variable
+ * Parameter 2	:	Error (@I2C_STATUS)
+ * Return Type	:	uint8_t @I2C_STATUS (Parameter 2, for 'return I2C_MasterAbort(...)')
+ * Note		:	Private helper function. AF cleared (rc_w0), STOP requested (releases the bus when the
+ *			peripheral is master), ACKing restored. A slave holding SDA low is NOT recovered here.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t I2C_MasterAbort(I2C_Handle_t *pI2CHandle, uint8_t Status)
+{
+	pI2CHandle->pI2Cx->SR1 &= ~I2C_FLAG_AF;
+	I2C_GenerateStopCondition(pI2CHandle->pI2Cx);
+
+	if (pI2CHandle->I2C_Config.I2C_ACK_Control == I2C_ACK_ENABLE)
+	{
+		I2C_ManageACK(pI2CHandle->pI2Cx, I2C_ACK_ENABLE);
+	}
+
+	return Status;
+}
@@ -0,0 +1,216 @@
+/*
+ * 									stm32f407xx_itm_drivers.c
+ *
+ *  This file contains ITM (SWO trace output) driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_itm_drivers.h>
+#include <stm32f407xx_nvic_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+
+#include <string.h>
+
+// Selected SWO bit rate [Hz] (0: not set up by ITM_Init)
+static uint32_t itmSwoHz = 0;
+
+// Bytes dropped per stimulus port (FIFO full)
+static uint32_t itmDrops[ITM_PORTS];
+
+/* --Helper Functions-- */
+static uint8_t ITM_ConfigPrescaler(void);
+static void ITM_ClockChanged(void);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_Init
+ * Description	:	To set up the SWO trace output
+ * Parameter 1	:	SWO bit rate [Hz] (ITM_SWO_HZ)
+ * Return Type	:	uint8_t @ITM_STATUS
+ * Note		:	Asynchronous NRZ, formatter bypassed, ports 0 to ITM_PORTS - 1 enabled. The probe
+ *			MUST decode at the same rate with the same core clock (the prescaler follows HCLK
+ *			through a clock listener). PB3 MUST stay in AF0 (reset state: TRACESWO).
+ *			Works without a probe: the output is simply lost (not counted as dropped).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t ITM_Init(uint32_t SwoHz)
+{
+	itmSwoHz = SwoHz;
+	memset(itmDrops, 0, sizeof(itmDrops));
+
+	/* -Step 1. Trace enabled (DWT/ITM), SWO pin in asynchronous mode- */
+	*SCB_DEMCR |= (1U << SCB_DEMCR_TRCENA);
+	*DBGMCU_CR = (*DBGMCU_CR & ~(3U << DBGMCU_CR_TRACE_MODE)) | (1U << DBGMCU_CR_TRACE_IOEN);
+
+	/* -Step 2. TPIU: NRZ, SWO prescaler for the current HCLK, no formatter (ITM packets only)- */
+	*TPIU_SPPR = TPIU_SPPR_NRZ;
+	if (ITM_ConfigPrescaler() != ITM_OK)
+	{
+		itmSwoHz = 0;
+		return ITM_ERR_RATE;
+	}
+	*TPIU_FFCR = (1U << TPIU_FFCR_TRIGIN);
+
+	/* -Step 3. ITM: unlocked, disabled while reconfigured, then enabled with sync packets- */
+	*ITM_LAR = ITM_LAR_KEY;
+	*ITM_TCR = 0;
+	while (*ITM_TCR & (1U << ITM_TCR_BUSY));
+
+	*ITM_TCR = (1U << ITM_TCR_TRACEBUSID) | (1U << ITM_TCR_SYNCENA) | (1U << ITM_TCR_ITMENA);
+	*ITM_TPR = 0;
+	*ITM_TER = (ITM_PORTS >= 32) ? 0xFFFFFFFFU : ((1U << ITM_PORTS) - 1);
+
+	/* -Step 4. Re-time on clock changes (registering twice is a no-op)- */
+	RCC_RegisterClockListener(ITM_ClockChanged);
+
+	return ITM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_Write
+ * Description	:	To write bytes on a stimulus port without blocking
+ * Parameter 1	:	@ITM_PORT (0 to ITM_PORTS - 1)
+ * Parameter 2	:	Pointer to data
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	Bytes written (uint32_t)
+ * Note		:	32-bit stimulus writes (4 bytes per packet), bytes for the tail. Each FIFO check and
+ *			write is atomic (PRIMASK): callable from thread and ISR, packets from different
+ *			contexts interleave but are never lost unnoticed. When the FIFO is still full after
+ *			ITM_FIFO_RETRIES polls the rest of the write is dropped and added to the drop count.
+ *			Port not traced: nothing written, 0 returned (not counted).
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t ITM_Write(uint8_t Port, const char *pData, uint32_t Len)
+{
+	volatile uint32_t *pStim;
+	uint32_t sent = 0;
+	uint32_t word;
+	uint32_t chunk;
+	uint32_t primask;
+	uint8_t written;
+
+	if ((Port >= ITM_PORTS) || !ITM_IsEnabled(Port))
+	{
+		return 0;
+	}
+
+	pStim = ITM_STIM(Port);
+
+	while (sent < Len)
+	{
+		chunk = ((Len - sent) >= 4) ? 4 : 1;
+		if (chunk == 4)
+		{
+			memcpy(&word, &pData[sent], 4);
+		}
+
+		/* -Step 1. Wait (bounded) for a free FIFO slot, check and write in one critical section- */
+		written = 0;
+		for (uint32_t retry = 0; (retry < ITM_FIFO_RETRIES) && !written; retry++)
+		{
+			primask = NVIC_EnterCriticalAll();
+			if (*pStim & (1U << ITM_STIM_FIFOREADY))
+			{
+				if (chunk == 4)
+				{
+					*pStim = word;
+				}
+				else
+				{
+					*(volatile uint8_t *)pStim = (uint8_t)pData[sent];
+				}
+				written = 1;
+			}
+			NVIC_ExitCriticalAll(primask);
+		}
+
+		/* -Step 2. Still full: drop the rest (bounded time per call)- */
+		if (!written)
+		{
+			primask = NVIC_EnterCriticalAll();
+			itmDrops[Port] += Len - sent;
+			NVIC_ExitCriticalAll(primask);
+			break;
+		}
+
+		sent += chunk;
+	}
+
+	return sent;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_IsEnabled
+ * Description	:	To know if a stimulus port is traced
+ * Parameter 1	:	@ITM_PORT
+ * Return Type	:	uint8_t (1: traced, 0: not traced)
+ * Note		:	ITM enabled (ITM_Init or the debugger) and the port enabled in ITM_TER.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t ITM_IsEnabled(uint8_t Port)
+{
+	if ((Port >= 32) || !(*SCB_DEMCR & (1U << SCB_DEMCR_TRCENA)) || !(*ITM_TCR & (1U << ITM_TCR_ITMENA)))
+	{
+		return 0;
+	}
+
+	return (*ITM_TER >> Port) & 1U;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_GetDropCount
+ * Description	:	To get the bytes dropped on a stimulus port
+ * Parameter 1	:	@ITM_PORT
+ * Return Type	:	Dropped bytes since ITM_Init (uint32_t, 0 for ports not counted)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t ITM_GetDropCount(uint8_t Port)
+{
+	return (Port < ITM_PORTS) ? itmDrops[Port] : 0;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_ConfigPrescaler
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	uint8_t @ITM_STATUS
+ * Note		:	SWO rate = HCLK / (ACPR + 1), ACPR rounded to the nearest (13 bits)
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t ITM_ConfigPrescaler(void)
+{
+	uint32_t hclk = RCC_Hclk_Value();
+	uint32_t prescaler;
+
+	if ((itmSwoHz == 0) || (itmSwoHz > hclk))
+	{
+		return ITM_ERR_RATE;
+	}
+
+	prescaler = ((hclk + (itmSwoHz / 2)) / itmSwoHz) - 1;
+	if (prescaler > 0x1FFFU)
+	{
+		return ITM_ERR_RATE;
+	}
+
+	*TPIU_ACPR = prescaler;
+
+	return ITM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	ITM_ClockChanged
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	RCC clock-change listener: SWO prescaler for the new HCLK (kept if out of range)
+ * ------------------------------------------------------------------------------------------------------ */
+static void ITM_ClockChanged(void)
+{
+	if (itmSwoHz != 0)
+	{
+		(void)ITM_ConfigPrescaler();
+	}
+}
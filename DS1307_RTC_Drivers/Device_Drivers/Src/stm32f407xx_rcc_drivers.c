@@ -6,281 +6,518 @@
  */
 
 #include <stm32f407xx_rcc_drivers.h>
+#include <stm32f407xx_flash_drivers.h>
 
-// array to store AHB prescaler values
-uint16_t ahb_prescaler[8] = {2,4,8,16,64,128,256,512};
+// AHB prescaler as right shift, indexed by HPRE[3:0] (0xxx: /1, 1000: /2 ... 1111: /512; no /32)
+static const uint8_t ahb_shift[16] = {0,0,0,0,0,0,0,0,1,2,3,4,6,7,8,9};
 
-// array to store APB1 prescaler values
-uint8_t apb1_prescaler[4] = {2,4,8,16};
+// APB1/APB2 prescaler as right shift, indexed by PPREx[2:0] (0xx: /1, 100: /2 ... 111: /16)
+static const uint8_t apb_shift[8] = {0,0,0,0,1,2,3,4};
 
-// array to store APB2 prescaler values
-uint8_t apb2_prescaler[4] = {2,4,8,16};
+// Cached clock values [Hz], reset state: HSI for everything
+static uint32_t sysClk = RCC_HSI_VALUE;
+static uint32_t hClk = RCC_HSI_VALUE;
+static uint32_t pClk1 = RCC_HSI_VALUE;
+static uint32_t pClk2 = RCC_HSI_VALUE;
 
+// Registered clock-change listeners
+static RCC_ClockListener_t clockListeners[RCC_MAX_CLOCK_LISTENERS];
+static uint8_t clockListenerCount = 0;
+
+// Reset flags of this boot (@RCC_RESET_FLAG), read once from RCC_CSR
+static uint8_t resetFlags = 0;
+static uint8_t resetFlagsRead = 0;
+
+
+const RCC_ClockConfig_t RCC_Config_HSI_16MHz =
+{
+	.RCC_SysClkSource = RCC_SYSCLK_HSI,
+	.RCC_PLLSource = RCC_PLLSRC_HSI,
+	.RCC_PLLM = 16,
+	.RCC_PLLN = 192,
+	.RCC_PLLP = 2,
+	.RCC_PLLQ = 4,
+	.RCC_AHBPrescaler = RCC_AHB_DIV1,
+	.RCC_APB1Prescaler = RCC_APB_DIV1,
+	.RCC_APB2Prescaler = RCC_APB_DIV1
+};
+
+const RCC_ClockConfig_t RCC_Config_PLL_168MHz =
+{
+	.RCC_SysClkSource = RCC_SYSCLK_PLL,
+	.RCC_PLLSource = RCC_PLLSRC_HSE,
+	.RCC_PLLM = 8,					// 8 MHz / 8   = 1 MHz
+	.RCC_PLLN = 336,				// 1 MHz * 336 = 336 MHz
+	.RCC_PLLP = 2,					// 336 MHz / 2 = 168 MHz
+	.RCC_PLLQ = 7,					// 336 MHz / 7 = 48 MHz
+	.RCC_AHBPrescaler = RCC_AHB_DIV1,		// 168 MHz
+	.RCC_APB1Prescaler = RCC_APB_DIV4,		// 42 MHz
+	.RCC_APB2Prescaler = RCC_APB_DIV2		// 84 MHz
+};
+
+const RCC_ClockConfig_t RCC_Config_PLL_HSI_168MHz =
+{
+	.RCC_SysClkSource = RCC_SYSCLK_PLL,
+	.RCC_PLLSource = RCC_PLLSRC_HSI,
+	.RCC_PLLM = 16,					// 16 MHz / 16 = 1 MHz
+	.RCC_PLLN = 336,				// 1 MHz * 336 = 336 MHz
+	.RCC_PLLP = 2,					// 336 MHz / 2 = 168 MHz
+	.RCC_PLLQ = 7,					// 336 MHz / 7 = 48 MHz
+	.RCC_AHBPrescaler = RCC_AHB_DIV1,		// 168 MHz
+	.RCC_APB1Prescaler = RCC_APB_DIV4,		// 42 MHz
+	.RCC_APB2Prescaler = RCC_APB_DIV2		// 84 MHz
+};
+
+
+/* -- Helper Functions prototypes  -- */
+
+// To poll a register until (register & mask) == expected, or until RCC_TIMEOUT
+static uint8_t RCC_WaitFlag(volatile uint32_t *pReg, uint32_t Mask, uint32_t Expected);
+
+// To select the system clock and wait for the switch to complete
+static uint8_t RCC_SwitchSysClk(uint8_t Source);
+
+// To call every registered clock-change listener
+static void RCC_NotifyClockListeners(void);
+
+
+
+/* -- > Clock Configuration < -- */
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	RCC_Pclk1_Value
- * Description	:	To get the value of Pclk1
- * Parameters	:	none
- * Return Type	:	(uint32_t) clock frequency
- * Note		:	For STM32F407G-DISC1 board,
- *			(From Clock Tree)
- *			[HSE or HSI(used) or PLLCLK or PLLR]
- *			 -> [AHB_PRESC] -> [APB1_PRESC] -> [APB1 peripheral clock]
+ * Name		:	RCC_ClockConfig
+ * Description	:	To switch the System Clock (oscillator, PLL, bus prescalers and Flash latency)
+ * Parameters	:	Pointer to clock configuration (@RCC_ClockConfig_t)
+ * Return Type	:	@RCC_STATUS (RCC_OK on success)
+ * Note		:	Steps:
+ *			1. Validate the configuration (nothing is touched when it is out of range)
+ *			2. Start the required oscillator (HSE) and wait until it is ready
+ *			3. If PLL is requested: move SYSCLK to HSI, reprogram and lock the PLL
+ *			4. Raise Flash latency (if needed), select AHB prescaler, APB prescalers at /16
+ *			5. Switch SYSCLK, then program the final APB prescalers
+ *			6. Lower Flash latency (if possible), refresh the cached clock values and notify
+ *			   the clock-change listeners
  *
- *			Steps:
- *			1. Find source [HSE or HSI(used) or PLLCLK or PLLR]  (from RCC)
- *			2. Calculate AHB Prescaler
- *			3. Calculate APB1 Prescaler
- *			4. Then, derive clock frequency for APB1 peripheral
- *
- *			USART2, USART3, UART4, UART5 are connected to APB1 Bus
- *			I2Cx is connected to APB1 Bus
+ *			HSI is left ON (fall-back clock). Peripherals clocked from APB1/APB2 (I2C, USART,..)
+ *			are re-timed by their drivers' listeners (see RCC_RegisterClockListener).
  * ------------------------------------------------------------------------------------------------------ */
-uint32_t RCC_Pclk1_Value(void)
+uint8_t RCC_ClockConfig(const RCC_ClockConfig_t *pClockConfig)
 {
-	uint32_t pClk1;
-
-	/* - Step 1: Find Source - */
-
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 2 and 3 (SWS bits: System Clock Switch status)
-	/*
-	 * 00:	HSI oscillator used as the system clock
-	 * 01:	HSE oscillator used as the system clock
-	 * 10:  PLL used as the system clock
-	 * 11:  Not applicable
-	 *
-	 * */
-	uint8_t sysClkSource;
-	uint32_t sysClockFreq;
-	// Read 3rd and 2nd bit from CFGR register
-	// To read, right shift CFGR by 2 (this will bring bit 3 and 2 to 0th and 1st bit position and then, Mask them)
-	sysClkSource = ((RCC->CFGR >> 2) & 0x03);
-
-	// Now check for System Clock Source
-	if (sysClkSource == 0)
+	uint32_t newSysClk;
+	uint32_t newHclk;
+	uint32_t tempReg;
+
+	/* - Step 1: Validate Configuration - */
+
+	if (pClockConfig->RCC_SysClkSource == RCC_SYSCLK_HSI)
 	{
-		// HSI oscillator used as the system clock (16HMz)
-		sysClockFreq = 16000000;
+		newSysClk = RCC_HSI_VALUE;
 	}
-	else if (sysClkSource == 1)
+	else if (pClockConfig->RCC_SysClkSource == RCC_SYSCLK_HSE)
 	{
-		// HSE oscillator used as the system clock (8HMz)
-		sysClockFreq = 8000000;
+		newSysClk = RCC_HSE_VALUE;
 	}
-	else if (sysClkSource == 2)
+	else if (pClockConfig->RCC_SysClkSource == RCC_SYSCLK_PLL)
 	{
-		// PLL used as the system clock
+		uint32_t vcoIn;
+		uint32_t vcoOut;
+
+		if ((pClockConfig->RCC_PLLM < 2) || (pClockConfig->RCC_PLLM > 63) ||
+		    (pClockConfig->RCC_PLLN < 50) || (pClockConfig->RCC_PLLN > 432) ||
+		    (pClockConfig->RCC_PLLP < 2) || (pClockConfig->RCC_PLLP > 8) || (pClockConfig->RCC_PLLP & 1) ||
+		    (pClockConfig->RCC_PLLQ < 2) || (pClockConfig->RCC_PLLQ > 15))
+		{
+			return RCC_ERR_CONFIG;
+		}
+
+		vcoIn = ((pClockConfig->RCC_PLLSource == RCC_PLLSRC_HSE) ? RCC_HSE_VALUE : RCC_HSI_VALUE) / pClockConfig->RCC_PLLM;
+		vcoOut = vcoIn * pClockConfig->RCC_PLLN;
+
+		if ((vcoIn < 1000000U) || (vcoIn > 2000000U) || (vcoOut < 100000000U) || (vcoOut > 432000000U))
+		{
+			return RCC_ERR_CONFIG;
+		}
+
+		newSysClk = vcoOut / pClockConfig->RCC_PLLP;
 	}
 	else
 	{
-		// Not Applicable
+		return RCC_ERR_CONFIG;
 	}
 
-	/* - Step 2: Calculate AHB Prescalar - */
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 4 to 7 (HPRE: AHB Prescaler)
-	/*
-	 * 0xxx: (if value is < 8) System Clock is not divided
-	 * 1000: system clock divided by 2
-	 * 1001: system clock divided by 4
-	 * 1010: system clock divided by 8
-	 * 1011: system clock divided by 16
-	 * 1100: system clock divided by 64
-	 * 1101: system clock divided by 128
-	 * 1110: system clock divided by 256
-	 * 1111: system clock divided by 512
-	 *
-	 * */
-
-	uint8_t temp;
-	uint8_t ahb_pres;
-
-	// Read the value of HPRE and shift the value to right and then, Mask them
-	temp = ((RCC->CFGR >> 4) & 0xF);
-
-	if (temp < 8)
+	newHclk = newSysClk >> ahb_shift[pClockConfig->RCC_AHBPrescaler & 0x0F];
+
+	if ((newSysClk > RCC_SYSCLK_MAX) ||
+	    ((newHclk >> apb_shift[pClockConfig->RCC_APB1Prescaler & 0x07]) > RCC_PCLK1_MAX) ||
+	    ((newHclk >> apb_shift[pClockConfig->RCC_APB2Prescaler & 0x07]) > RCC_PCLK2_MAX))
 	{
-		// System Clock is not divided, AHB Prescaler is 1
-		ahb_pres = 1;
+		return RCC_ERR_CONFIG;
 	}
-	else
-	{
-		// AHB prescaler value depends upon temp variable
-		ahb_pres = ahb_prescaler[temp - 8];		// if temp is 8 then, fetch 1st array value (0th element), and so on.
 
+	/* - Step 2: Start Oscillators - */
+
+	// HSI is the intermediate clock while the PLL is reprogrammed
+	RCC->CR |= (1 << RCC_CR_HSION);
+	if (RCC_WaitFlag(&RCC->CR, (1 << RCC_CR_HSIRDY), (1 << RCC_CR_HSIRDY)))
+	{
+		return RCC_ERR_SWITCH;
 	}
 
-	/* - Step 3: Calculate APB1 Prescalar - */
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 10 to 12 (PPRE1: APB1 Prescaler)
+	if ((pClockConfig->RCC_SysClkSource == RCC_SYSCLK_HSE) ||
+	    ((pClockConfig->RCC_SysClkSource == RCC_SYSCLK_PLL) && (pClockConfig->RCC_PLLSource == RCC_PLLSRC_HSE)))
+	{
+		RCC->CR |= (1 << RCC_CR_HSEON);
+		if (RCC_WaitFlag(&RCC->CR, (1 << RCC_CR_HSERDY), (1 << RCC_CR_HSERDY)))
+		{
+			return RCC_ERR_HSE;
+		}
+	}
 
-	/*
-	 * 0xx: (if value < 4) AHB clock not divided
-	 * 100: AHB clock divided by 2
-	 * 101: AHB clock divided by 4
-	 * 110: AHB clock divided by 8
-	 * 111: AHB clock divided by 16
-	 *
-	 * */
+	/* - Step 3: Configure PLL - */
 
-	uint8_t apb1_pres;
+	if (pClockConfig->RCC_SysClkSource == RCC_SYSCLK_PLL)
+	{
+		// PLL can not be reprogrammed while it clocks the core
+		if (((RCC->CFGR >> RCC_CFGR_SWS) & 0x03) == RCC_SYSCLK_PLL)
+		{
+			if (RCC_SwitchSysClk(RCC_SYSCLK_HSI))
+			{
+				return RCC_ERR_SWITCH;
+			}
+			FLASH_SetLatency(RCC_HSI_VALUE >> ahb_shift[(RCC->CFGR >> RCC_CFGR_HPRE) & 0x0F], FLASH_VRANGE_BOARD);
+			RCC_UpdateClockCache();
+		}
+
+		RCC->CR &= ~(1 << RCC_CR_PLLON);
+		if (RCC_WaitFlag(&RCC->CR, (1 << RCC_CR_PLLRDY), 0))
+		{
+			return RCC_ERR_PLL;
+		}
+
+		// Keep reserved bits, replace M, N, P, SRC and Q
+		tempReg = RCC->PLLCFGR;
+		tempReg &= ~((0x3F << RCC_PLLCFGR_PLLM) | (0x1FF << RCC_PLLCFGR_PLLN) | (0x03 << RCC_PLLCFGR_PLLP) |
+			     (1 << RCC_PLLCFGR_PLLSRC) | (0x0F << RCC_PLLCFGR_PLLQ));
+		tempReg |= ((uint32_t)pClockConfig->RCC_PLLM << RCC_PLLCFGR_PLLM);
+		tempReg |= ((uint32_t)pClockConfig->RCC_PLLN << RCC_PLLCFGR_PLLN);
+		tempReg |= ((uint32_t)((pClockConfig->RCC_PLLP >> 1) - 1) << RCC_PLLCFGR_PLLP);	// 2: 00, 4: 01, 6: 10, 8: 11
+		tempReg |= ((uint32_t)pClockConfig->RCC_PLLSource << RCC_PLLCFGR_PLLSRC);
+		tempReg |= ((uint32_t)pClockConfig->RCC_PLLQ << RCC_PLLCFGR_PLLQ);
+		RCC->PLLCFGR = tempReg;
+
+		RCC->CR |= (1 << RCC_CR_PLLON);
+		if (RCC_WaitFlag(&RCC->CR, (1 << RCC_CR_PLLRDY), (1 << RCC_CR_PLLRDY)))
+		{
+			return RCC_ERR_PLL;
+		}
+	}
 
-	// Read the value of PPRE1 and shift the value to right and then, Mask them
-	temp = ((RCC->CFGR >> 10) & 0x7);
+	/* - Step 4: Flash Latency and Prescalers - */
 
-	if (temp < 4)
+	// More wait states MUST be in place before HCLK goes up
+	if (newHclk > hClk)
 	{
-		// AHB clock is not divided, APB1 Prescaler is 1
-		apb1_pres = 1;
+		FLASH_SetLatency(newHclk, FLASH_VRANGE_BOARD);
 	}
-	else
-	{
-		// APB1 prescaler value depends upon temp variable
-		apb1_pres = apb1_prescaler[temp - 4];		// if temp is 4 then, fetch 1st array value (0th element), and so on.
 
+	// APB buses at /16 during the switch: never above their limits in between
+	tempReg = RCC->CFGR;
+	tempReg &= ~((0x0F << RCC_CFGR_HPRE) | (0x07 << RCC_CFGR_PPRE1) | (0x07 << RCC_CFGR_PPRE2));
+	tempReg |= ((uint32_t)(pClockConfig->RCC_AHBPrescaler & 0x0F) << RCC_CFGR_HPRE);
+	tempReg |= (RCC_APB_DIV16 << RCC_CFGR_PPRE1) | (RCC_APB_DIV16 << RCC_CFGR_PPRE2);
+	RCC->CFGR = tempReg;
+
+	/* - Step 5: Switch System Clock - */
+
+	if (RCC_SwitchSysClk(pClockConfig->RCC_SysClkSource))
+	{
+		return RCC_ERR_SWITCH;
 	}
 
-	/* - Step 4: Derive Clock (Pclk1) - */
-	pClk1 = (sysClockFreq / ahb_pres ) / apb1_pres;
+	tempReg = RCC->CFGR;
+	tempReg &= ~((0x07 << RCC_CFGR_PPRE1) | (0x07 << RCC_CFGR_PPRE2));
+	tempReg |= ((uint32_t)(pClockConfig->RCC_APB1Prescaler & 0x07) << RCC_CFGR_PPRE1);
+	tempReg |= ((uint32_t)(pClockConfig->RCC_APB2Prescaler & 0x07) << RCC_CFGR_PPRE2);
+	RCC->CFGR = tempReg;
 
+	/* - Step 6: Flash Latency and Clock Cache - */
 
-	return pClk1;
+	// Fewer wait states only once HCLK went down
+	FLASH_SetLatency(newHclk, FLASH_VRANGE_BOARD);
 
-}
+	RCC_UpdateClockCache();
+	RCC_NotifyClockListeners();
 
+	return RCC_OK;
+}
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	RCC_Pclk2_Value
- * Description	:	To get the value of Pclk2
- * Parameters	:	none
- * Return Type	:	(uint32_t) clock frequency
- * Note		:	For STM32F407G-DISC1 board,
- *			(From Clock Tree)
- *			[HSE or HSI(used) or PLLCLK or PLLR]
- *			-> [AHB_PRESC] -> [APB2_PRESC] -> [APB2 peripheral clock]
- *
- *			Steps:
- *			1. Find source [HSE or HSI(used) or PLLCLK or PLLR]  (from RCC)
- *			2. Calculate AHB Prescaler
- *			3. Calculate APB2 Prescaler
- *			4. Then, derive clock frequency for APB2 peripheral
- *
- *			USART1, USART6 are connected to APB2 Bus
+ * Name		:	RCC_SetHclkPrescaler
+ * Description	:	To change only the AHB prescaler (dynamic clock scaling)
+ * Parameters	:	@RCC_AHB_DIV
+ * Return Type	:	@RCC_STATUS (RCC_OK on success)
+ * Note		:	SYSCLK and the PLL keep running (no lock time): HCLK, PCLK1 and PCLK2 are divided
+ *			together, e.g. from 168/42/84 MHz to 21/5.25/10.5 MHz with RCC_AHB_DIV8 while idle.
+ *			Flash latency is raised before / lowered after the change. Listeners are notified.
  *
+ *			Call it between transfers (thread mode): a transfer already on the bus finishes with
+ *			the timing it started with.
  * ------------------------------------------------------------------------------------------------------ */
-uint32_t RCC_Pclk2_Value(void)
+uint8_t RCC_SetHclkPrescaler(uint8_t AHBPrescaler)
 {
-	uint32_t pClk2;
-
-	/* - Step 1: Find Source - */
-
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 2 and 3 (SWS bits: System Clock Switch status)
-	/*
-	 * 00:	HSI oscillator used as the system clock
-	 * 01:	HSE oscillator used as the system clock
-	 * 10:  PLL used as the system clock
-	 * 11:  Not applicable
-	 *
-	 * */
-	uint8_t sysClkSource;
-	uint32_t sysClockFreq;
-	// Read 3rd and 2nd bit from CFGR register
-	// To read, right shift CFGR by 2 (this will bring bit 3 and 2 to 0th and 1st bit position and then, Mask them)
-	sysClkSource = ((RCC->CFGR >> 2) & 0x03);
-
-	// Now check for System Clock Source
-	if (sysClkSource == 0)
+	uint32_t cfgr = RCC->CFGR;
+	uint32_t newHclk = sysClk >> ahb_shift[AHBPrescaler & 0x0F];
+
+	/* - Step 1: Validate against the APB limits with the current APB prescalers - */
+	if (((newHclk >> apb_shift[(cfgr >> RCC_CFGR_PPRE1) & 0x07]) > RCC_PCLK1_MAX) ||
+	    ((newHclk >> apb_shift[(cfgr >> RCC_CFGR_PPRE2) & 0x07]) > RCC_PCLK2_MAX))
 	{
-		// HSI oscillator used as the system clock (16HMz)
-		sysClockFreq = 16000000;
+		return RCC_ERR_CONFIG;
 	}
-	else if (sysClkSource == 1)
+
+	/* - Step 2: Flash latency up (if needed), new HPRE, Flash latency down (if possible) - */
+	if (newHclk > hClk)
 	{
-		// HSE oscillator used as the system clock (8HMz)
-		sysClockFreq = 8000000;
+		FLASH_SetLatency(newHclk, FLASH_VRANGE_BOARD);
 	}
-	else if (sysClkSource == 2)
+
+	RCC->CFGR = (cfgr & ~(0x0F << RCC_CFGR_HPRE)) | ((uint32_t)(AHBPrescaler & 0x0F) << RCC_CFGR_HPRE);
+
+	FLASH_SetLatency(newHclk, FLASH_VRANGE_BOARD);
+
+	/* - Step 3: Clock Cache and Listeners - */
+	RCC_UpdateClockCache();
+	RCC_NotifyClockListeners();
+
+	return RCC_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_UpdateClockCache
+ * Description	:	To refresh the cached clock values from the RCC registers
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	Called by RCC_ClockConfig. Call it explicitly only if RCC_CFGR/RCC_PLLCFGR were changed
+ *			outside this driver (e.g. by a bootloader).
+ *
+ *			[HSI or HSE or PLLCLK] -> SYSCLK -> [AHB_PRESC] -> HCLK -> [APBx_PRESC] -> PCLKx
+ * ------------------------------------------------------------------------------------------------------ */
+void RCC_UpdateClockCache(void)
+{
+	uint32_t cfgr = RCC->CFGR;
+
+	/* - Step 1: Find Source (SWS bits) - */
+	switch ((cfgr >> RCC_CFGR_SWS) & 0x03)
 	{
-		// PLL used as the system clock
+		case RCC_SYSCLK_HSE:
+			sysClk = RCC_HSE_VALUE;
+			break;
+
+		case RCC_SYSCLK_PLL:
+			sysClk = RCC_PLLClk_Value();
+			break;
+
+		default:
+			sysClk = RCC_HSI_VALUE;
+			break;
 	}
-	else
+
+	/* - Step 2: Apply AHB and APBx Prescalers (all powers of two) - */
+	hClk = sysClk >> ahb_shift[(cfgr >> RCC_CFGR_HPRE) & 0x0F];
+	pClk1 = hClk >> apb_shift[(cfgr >> RCC_CFGR_PPRE1) & 0x07];
+	pClk2 = hClk >> apb_shift[(cfgr >> RCC_CFGR_PPRE2) & 0x07];
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_RegisterClockListener
+ * Description	:	To register a function called after every clock change
+ * Parameters	:	Listener (@RCC_ClockListener_t)
+ * Return Type	:	RCC_OK, or RCC_ERR_CONFIG when the table is full (RCC_MAX_CLOCK_LISTENERS)
+ * Note		:	Registering the same listener twice has no effect (drivers may be re-initialized).
+ *			Listeners run in the context of RCC_ClockConfig/RCC_SetHclkPrescaler, after the
+ *			clock cache is updated, and MUST NOT change the clocks.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t RCC_RegisterClockListener(RCC_ClockListener_t Listener)
+{
+	for (uint8_t i = 0; i < clockListenerCount; i++)
 	{
-		// Not Applicable
+		if (clockListeners[i] == Listener)
+		{
+			return RCC_OK;
+		}
 	}
 
-	/* - Step 2: Calculate AHB Prescalar - */
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 4 to 7 (HPRE: AHB Prescaler)
-	/*
-	 * 0xxx: (if value is < 8) System Clock is not divided
-	 * 1000: system clock divided by 2
-	 * 1001: system clock divided by 4
-	 * 1010: system clock divided by 8
-	 * 1011: system clock divided by 16
-	 * 1100: system clock divided by 64
-	 * 1101: system clock divided by 128
-	 * 1110: system clock divided by 256
-	 * 1111: system clock divided by 512
-	 *
-	 * */
-
-	uint8_t temp;
-	uint8_t ahb_pres;
-
-	// Read the value of HPRE and shift the value to right and then, Mask them
-	temp = ((RCC->CFGR >> 4) & 0xF);
-
-	if (temp < 8)
+	if ((Listener == NULL) || (clockListenerCount >= RCC_MAX_CLOCK_LISTENERS))
 	{
-		// System Clock is not divided, AHB Prescaler is 1
-		ahb_pres = 1;
+		return RCC_ERR_CONFIG;
 	}
-	else
-	{
-		// AHB prescaler value depends upon temp variable
-		ahb_pres = ahb_prescaler[temp - 8];		// if temp is 8 then, fetch 1st array value (0th element), and so on.
 
-	}
+	clockListeners[clockListenerCount++] = Listener;
 
-	/* - Step 3: Calculate APB1 Prescalar - */
-	// In RCC Cloak Configuration Register (RCC_CFGR)
-	// Check bits 10 to 12 (PPRE1: APB1 Prescaler)
+	return RCC_OK;
+}
 
-	/*
-	 * 0xx: (if value < 4) AHB clock not divided
-	 * 100: AHB clock divided by 2
-	 * 101: AHB clock divided by 4
-	 * 110: AHB clock divided by 8
-	 * 111: AHB clock divided by 16
-	 *
-	 * */
 
-	uint8_t apb2_pres;
+/* -- > Reset Cause < -- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_GetResetFlags
+ * Description	:	To get the cause(s) of the last reset
+ * Parameters	:	none
+ * Return Type	:	uint8_t (@RCC_RESET_FLAG, OR-ed)
+ * Note		:	RCC_CSR flags are sticky until cleared (RMVF): the first call reads and clears them,
+ *			so the next reset reports its own cause only. Later calls return the same value.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t RCC_GetResetFlags(void)
+{
+	if (!resetFlagsRead)
+	{
+		resetFlags = (uint8_t)((RCC->CSR >> 24) & 0xFE);
+		RCC->CSR |= (1U << RCC_CSR_RMVF);
+		resetFlagsRead = 1;
+	}
+
+	return resetFlags;
+}
+
 
-	// Read the value of PPRE2[15:13] and shift the value to right and then, Mask them
-	temp = ((RCC->CFGR >> 13) & 0x7);
+/* -- > Clock Values < -- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_PLLClk_Value
+ * Description	:	To get the value of PLLCLK (main PLL P output)
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) clock frequency
+ * Note		:	PLLCLK = ((PLL source / M) * N) / P, all read from RCC_PLLCFGR.
+ *			Computed from the registers (not cached), the PLL may be configured but not selected.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t RCC_PLLClk_Value(void)
+{
+	uint32_t pllcfgr = RCC->PLLCFGR;
+	uint32_t pllm = (pllcfgr >> RCC_PLLCFGR_PLLM) & 0x3F;
+	uint32_t plln = (pllcfgr >> RCC_PLLCFGR_PLLN) & 0x1FF;
+	uint32_t pllp = (((pllcfgr >> RCC_PLLCFGR_PLLP) & 0x03) + 1) << 1;	// 00: 2, 01: 4, 10: 6, 11: 8
+	uint32_t pllSource = (pllcfgr & (1 << RCC_PLLCFGR_PLLSRC)) ? RCC_HSE_VALUE : RCC_HSI_VALUE;
 
-	if (temp < 4)
+	if (pllm == 0)
 	{
-		// AHB clock is not divided, APB2 Prescaler is 1
-		apb2_pres = 1;
+		// Invalid M (0 and 1 are not allowed)
+		return 0;
 	}
-	else
-	{
-		// APB2 prescaler value depends upon temp variable
-		apb2_pres = apb2_prescaler[temp - 4];		// if temp is 4 then, fetch 1st array value (0th element), and so on.
 
-	}
+	// Divide first: source * N overflows 32 bits
+	return ((pllSource / pllm) * plln) / pllp;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_SysClk_Value
+ * Description	:	To get the value of SYSCLK
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) clock frequency
+ * Note		:	Cached value (see RCC_UpdateClockCache)
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t RCC_SysClk_Value(void)
+{
+	return sysClk;
+}
+
 
-	/* - Step 4: Derive Clock (Pclk1) - */
-	pClk2 = (sysClockFreq / ahb_pres ) / apb2_pres;
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_Hclk_Value
+ * Description	:	To get the value of HCLK (AHB bus, core, DMA, memories)
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) clock frequency
+ * Note		:	Cached value (see RCC_UpdateClockCache)
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t RCC_Hclk_Value(void)
+{
+	return hClk;
+}
 
 
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_Pclk1_Value
+ * Description	:	To get the value of Pclk1
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) clock frequency
+ * Note		:	Cached value (see RCC_UpdateClockCache)
+ *
+ *			USART2, USART3, UART4, UART5 are connected to APB1 Bus
+ *			I2Cx is connected to APB1 Bus
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t RCC_Pclk1_Value(void)
+{
+	return pClk1;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_Pclk2_Value
+ * Description	:	To get the value of Pclk2
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) clock frequency
+ * Note		:	Cached value (see RCC_UpdateClockCache)
+ *
+ *			USART1, USART6 are connected to APB2 Bus
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t RCC_Pclk2_Value(void)
+{
 	return pClk2;
+}
+
 
+
+/* -- > Helper Functions < -- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_WaitFlag
+ * Description	:	To poll a register until (register & Mask) == Expected
+ * Parameters	:	Register, Mask, Expected value
+ * Return Type	:	0 when reached, 1 on timeout (RCC_TIMEOUT polls)
+ * Note		:	Private helper function
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t RCC_WaitFlag(volatile uint32_t *pReg, uint32_t Mask, uint32_t Expected)
+{
+	uint32_t timeout = RCC_TIMEOUT;
+
+	while ((*pReg & Mask) != Expected)
+	{
+		if (--timeout == 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
 }
 
 
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_SwitchSysClk
+ * Description	:	To select the system clock (SW bits) and wait for the switch (SWS bits)
+ * Parameters	:	@RCC_SYSCLK
+ * Return Type	:	0 on success, 1 on timeout
+ * Note		:	Private helper function. The selected source MUST be ready.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t RCC_SwitchSysClk(uint8_t Source)
+{
+	RCC->CFGR = (RCC->CFGR & ~(0x03 << RCC_CFGR_SW)) | ((uint32_t)Source << RCC_CFGR_SW);
 
+	return RCC_WaitFlag(&RCC->CFGR, (0x03 << RCC_CFGR_SWS), ((uint32_t)Source << RCC_CFGR_SWS));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	RCC_NotifyClockListeners
+ * Description	:	To call every registered clock-change listener (registration order)
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	Private helper function
+ * ------------------------------------------------------------------------------------------------------ */
+static void RCC_NotifyClockListeners(void)
+{
+	for (uint8_t i = 0; i < clockListenerCount; i++)
+	{
+		clockListeners[i]();
+	}
+}
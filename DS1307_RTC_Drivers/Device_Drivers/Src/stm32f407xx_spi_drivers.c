@@ -0,0 +1,630 @@
+/*
+ * 									stm32f407xx_spi_drivers.c
+ *
+ *  This file contains SPI driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_spi_drivers.h>
+#include <stm32f407xx_dma_drivers.h>
+#include <stm32f407xx_gpio_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+
+// DMA request mapping (reference manual, DMA1/DMA2 request mapping tables) and IRQ numbers.
+// Streams chosen clear of the USART streams used by the application (USART2: DMA1 Streams 5/6)
+typedef struct
+{
+	SPI_RegDef_t	*pSPIx;
+	DMA_RegDef_t	*pDMAx;
+	uint8_t		TxStream;
+	uint8_t		RxStream;
+	uint8_t		Channel;
+	uint8_t		TxIRQ;
+	uint8_t		RxIRQ;
+
+}SPI_DMAMap_t;
+
+static const SPI_DMAMap_t spiDmaMap[] =
+{
+	{SPI1, DMA2, 3, 0, 3, IRQ_NO_DMA2_STREAM3, IRQ_NO_DMA2_STREAM0},
+	{SPI2, DMA1, 4, 3, 0, IRQ_NO_DMA1_STREAM4, IRQ_NO_DMA1_STREAM3},
+	{SPI3, DMA1, 7, 2, 0, IRQ_NO_DMA1_STREAM7, IRQ_NO_DMA1_STREAM2},
+	{SPI4, DMA2, 4, 3, 5, IRQ_NO_DMA2_STREAM4, IRQ_NO_DMA2_STREAM3},
+};
+
+#define SPI_DMA_MAP_SIZE		(sizeof(spiDmaMap) / sizeof(spiDmaMap[0]))
+
+// Fixed-address DMA sources/sinks for read-only or write-only transfers (SRAM)
+static uint8_t spiDummyTx = SPI_DUMMY_BYTE;
+static uint8_t spiDummyRx;
+
+// Handles re-timed by the clock listener
+static SPI_Handle_t *spiHandles[SPI_MAX_HANDLES];
+
+/* --Helper Functions-- */
+static const SPI_DMAMap_t *SPI_GetDMAMap(SPI_RegDef_t *pSPIx);
+static uint8_t SPI_IsDMAMemory(const void *pBuffer, uint32_t Size);
+static uint8_t SPI_WaitFlag(SPI_RegDef_t *pSPIx, uint8_t FlagBit, uint8_t Level);
+static void SPI_ClockChanged(void);
+static void SPI_ApplyPendingClock(SPI_Handle_t *pSPIHandle);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_PeriClockControl
+ * Description	:	To enable or disable the peripheral clock of a SPI
+ * Parameter 1	:	Base address of the SPI peripheral
+ * Parameter 2	:	ENABLE or DISABLE Macro
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_PeriClockControl(SPI_RegDef_t *pSPIx, uint8_t EnorDi)
+{
+	if (EnorDi == ENABLE)
+	{
+		if (pSPIx == SPI1)
+		{
+			SPI1_PCLK_EN();
+		}
+		else if (pSPIx == SPI2)
+		{
+			SPI2_PCLK_EN();
+		}
+		else if (pSPIx == SPI3)
+		{
+			SPI3_PCLK_EN();
+		}
+		else if (pSPIx == SPI4)
+		{
+			SPI4_PCLK_EN();
+		}
+	}
+	else
+	{
+		if (pSPIx == SPI1)
+		{
+			SPI1_PCLK_DI();
+		}
+		else if (pSPIx == SPI2)
+		{
+			SPI2_PCLK_DI();
+		}
+		else if (pSPIx == SPI3)
+		{
+			SPI3_PCLK_DI();
+		}
+		else if (pSPIx == SPI4)
+		{
+			SPI4_PCLK_DI();
+		}
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_Init
+ * Description	:	To initialize the SPI peripheral (master) and its DMA streams
+ * Parameter 1	:	Pointer to SPI Handle
+ * Return Type	:	uint8_t @SPI_STATUS
+ * Note		:	Full duplex, 8-bit frames, MSB first, software NSS (SSM/SSI: no mode fault).
+ *			Enables the SPI (and DMA) clocks, releases the chip select. The GPIO pins and the
+ *			DMA stream IRQs are left to the application.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SPI_Init(SPI_Handle_t *pSPIHandle)
+{
+	const SPI_DMAMap_t *pMap = SPI_GetDMAMap(pSPIHandle->pSPIx);
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+	DMA_Config_t dmaConfig;
+	uint8_t status;
+
+	if (pMap == NULL)
+	{
+		return SPI_ERR_CONFIG;
+	}
+
+	pSPIHandle->State = SPI_READY;
+	pSPIHandle->LastError = SPI_OK;
+	pSPIHandle->pDMAx = NULL;
+	SPI_ChipSelect(pSPIHandle, DISABLE);
+
+	/* -Step 1. Clock enabled, SPI disabled while configured- */
+	SPI_PeriClockControl(pSPIx, ENABLE);
+	pSPIx->CR1 = 0;
+	pSPIx->CR2 = 0;
+
+	/* -Step 2. Master, software NSS held high, clock polarity/phase- */
+	pSPIx->CR1 = (1U << SPI_CR1_MSTR) | (1U << SPI_CR1_SSM) | (1U << SPI_CR1_SSI)
+		| ((uint32_t)(pSPIHandle->SPI_Config.SPI_CPOL & 1) << SPI_CR1_COPL)
+		| ((uint32_t)(pSPIHandle->SPI_Config.SPI_CPHA & 1) << SPI_CR1_CPHA);
+
+	/* -Step 3. SCLK prescaler for the current PCLK, SPI enabled- */
+	status = SPI_UpdateClock(pSPIHandle);
+	if (status != SPI_OK)
+	{
+		return status;
+	}
+
+	/* -Step 4. DMA streams: TX errors only, RX signals the end of the transfer- */
+	if (pSPIHandle->SPI_Config.SPI_DMA == ENABLE)
+	{
+		pSPIHandle->pDMAx = pMap->pDMAx;
+		pSPIHandle->TxStream = pMap->TxStream;
+		pSPIHandle->RxStream = pMap->RxStream;
+		DMA_PeriClockControl(pMap->pDMAx, ENABLE);
+
+		dmaConfig.DMA_Channel = pMap->Channel;
+		dmaConfig.DMA_Direction = DMA_DIR_MEM_TO_PERIPH;
+		dmaConfig.DMA_Mode = DMA_MODE_NORMAL;
+		dmaConfig.DMA_Priority = DMA_PRIORITY_HIGH;
+		dmaConfig.DMA_Interrupts = DMA_IT_TE;
+		DMA_StreamInit(pMap->pDMAx, pMap->TxStream, &dmaConfig, &pSPIx->DR);
+
+		dmaConfig.DMA_Direction = DMA_DIR_PERIPH_TO_MEM;
+		dmaConfig.DMA_Priority = DMA_PRIORITY_VERY_HIGH;		// RX first: no overrun
+		dmaConfig.DMA_Interrupts = DMA_IT_TC | DMA_IT_TE;
+		DMA_StreamInit(pMap->pDMAx, pMap->RxStream, &dmaConfig, &pSPIx->DR);
+	}
+
+	/* -Step 5. Re-timed on clock changes (one slot per handle, one listener for all)- */
+	for (uint8_t i = 0; i < SPI_MAX_HANDLES; i++)
+	{
+		if ((spiHandles[i] == NULL) || (spiHandles[i] == pSPIHandle))
+		{
+			spiHandles[i] = pSPIHandle;
+			break;
+		}
+	}
+	RCC_RegisterClockListener(SPI_ClockChanged);
+
+	return SPI_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_DeInit
+ * Description	:	To stop the DMA streams and reset the SPI peripheral
+ * Parameter 1	:	Pointer to SPI Handle
+ * Return Type	:	none (void)
+ * Note		:	A running DMA transfer is aborted. The DMA clock is left enabled (streams may be
+ *			shared with other peripherals).
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_DeInit(SPI_Handle_t *pSPIHandle)
+{
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+
+	SPI_AbortDMA(pSPIHandle);
+	pSPIHandle->State = SPI_READY;
+	SPI_ChipSelect(pSPIHandle, DISABLE);
+
+	for (uint8_t i = 0; i < SPI_MAX_HANDLES; i++)
+	{
+		if (spiHandles[i] == pSPIHandle)
+		{
+			spiHandles[i] = NULL;
+		}
+	}
+
+	if (pSPIx == SPI1)
+	{
+		SPI1_REG_RESET();
+	}
+	else if (pSPIx == SPI2)
+	{
+		SPI2_REG_RESET();
+	}
+	else if (pSPIx == SPI3)
+	{
+		SPI3_REG_RESET();
+	}
+	else if (pSPIx == SPI4)
+	{
+		SPI4_REG_RESET();
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_UpdateClock
+ * Description	:	To program the SCLK prescaler for the current PCLK
+ * Parameter 1	:	Pointer to SPI Handle
+ * Return Type	:	uint8_t @SPI_STATUS
+ * Note		:	SCLK = PCLK / 2^(BR + 1), the highest not above SPI_MaxHz. SPI1/SPI4 on APB2, SPI2/SPI3
+ *			on APB1. BR is only writable with the SPI disabled: waits for the bus to be idle
+ *			(NOT during a DMA transfer: SPI_ERR_BUSY, ClockPending set, re-timed when the transfer
+ *			ends or before the next one starts). Prescaler kept when out of range.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SPI_UpdateClock(SPI_Handle_t *pSPIHandle)
+{
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+	uint32_t pclk;
+	uint8_t br = 0;
+
+	if (pSPIHandle->State != SPI_READY)
+	{
+		pSPIHandle->ClockPending = 1;
+		return SPI_ERR_BUSY;
+	}
+
+	pSPIHandle->ClockPending = 0;
+	pclk = ((pSPIx == SPI1) || (pSPIx == SPI4)) ? RCC_Pclk2_Value() : RCC_Pclk1_Value();
+
+	/* -Step 1. Smallest divider meeting the device limit- */
+	while ((br < 8) && ((pclk >> (br + 1)) > pSPIHandle->SPI_Config.SPI_MaxHz))
+	{
+		br++;
+	}
+	if (br == 8)
+	{
+		return SPI_ERR_CONFIG;
+	}
+
+	/* -Step 2. SPI disabled after the last frame, prescaler written, SPI enabled- */
+	if (pSPIx->CR1 & (1U << SPI_CR1_SPE))
+	{
+		(void)SPI_WaitFlag(pSPIx, SPI_SR_BSY, 0);
+		pSPIx->CR1 &= ~(1U << SPI_CR1_SPE);
+	}
+	pSPIx->CR1 = (pSPIx->CR1 & ~(7U << SPI_CR1_BR)) | ((uint32_t)br << SPI_CR1_BR);
+	pSPIx->CR1 |= (1U << SPI_CR1_SPE);
+
+	pSPIHandle->SclkHz = pclk >> (br + 1);
+
+	return SPI_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_ChipSelect
+ * Description	:	To assert or release the chip select
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	ENABLE (assert) or DISABLE (release) Macro
+ * Return Type	:	none (void)
+ * Note		:	Atomic pin write (BSRR). No pin (pCSPort NULL): nothing done.
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_ChipSelect(SPI_Handle_t *pSPIHandle, uint8_t EnorDi)
+{
+	if (pSPIHandle->pCSPort == NULL)
+	{
+		return;
+	}
+
+	if ((EnorDi == ENABLE) == (pSPIHandle->CSActiveHigh != 0))
+	{
+		GPIO_SetPins(pSPIHandle->pCSPort, (uint16_t)(1U << pSPIHandle->CSPin));
+	}
+	else
+	{
+		GPIO_ResetPins(pSPIHandle->pCSPort, (uint16_t)(1U << pSPIHandle->CSPin));
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_Transfer
+ * Description	:	To send and receive bytes (polled)
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	Bytes to send (NULL: SPI_DUMMY_BYTE)
+ * Parameter 3	:	Received bytes (NULL: discarded)
+ * Parameter 4	:	Number of bytes
+ * Return Type	:	uint8_t @SPI_STATUS
+ * Note		:	One byte in flight (write DR, wait RXNE, read DR): no overrun whatever the interrupt
+ *			load. Returns with the bus idle (BSY cleared): the chip select can be released.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SPI_Transfer(SPI_Handle_t *pSPIHandle, const uint8_t *pTx, uint8_t *pRx, uint32_t Len)
+{
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+	uint8_t data;
+
+	if (pSPIHandle->State != SPI_READY)
+	{
+		return SPI_ERR_BUSY;
+	}
+	SPI_ApplyPendingClock(pSPIHandle);
+
+	for (uint32_t i = 0; i < Len; i++)
+	{
+		if (SPI_WaitFlag(pSPIx, SPI_SR_TXE, 1) != SPI_OK)
+		{
+			return SPI_ERR_TIMEOUT;
+		}
+		pSPIx->DR = (pTx != NULL) ? pTx[i] : SPI_DUMMY_BYTE;
+
+		if (SPI_WaitFlag(pSPIx, SPI_SR_RXNE, 1) != SPI_OK)
+		{
+			return SPI_ERR_TIMEOUT;
+		}
+		data = (uint8_t)pSPIx->DR;
+		if (pRx != NULL)
+		{
+			pRx[i] = data;
+		}
+	}
+
+	return SPI_WaitFlag(pSPIx, SPI_SR_BSY, 0);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_TransferDMA
+ * Description	:	To start a full-duplex DMA transfer
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	Bytes to send (NULL: SPI_DUMMY_BYTE)
+ * Parameter 3	:	Received bytes (NULL: discarded)
+ * Parameter 4	:	Number of bytes [1 to 65535]
+ * Return Type	:	uint8_t @SPI_STATUS
+ * Note		:	Buffers MUST stay valid until SPI_EVENT_DMA_DONE (or SPI_WaitDone) and be DMA
+ *			accessible (SRAM, not CCMRAM). A missing buffer is replaced by one fixed byte (memory
+ *			address not incremented). RX stream started first: ready before the first byte.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SPI_TransferDMA(SPI_Handle_t *pSPIHandle, const uint8_t *pTx, uint8_t *pRx, uint16_t Len)
+{
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+	DMA_RegDef_t *pDMAx = pSPIHandle->pDMAx;
+
+	if (pSPIHandle->State != SPI_READY)
+	{
+		return SPI_ERR_BUSY;
+	}
+	if ((pDMAx == NULL) || ((pTx != NULL) && !SPI_IsDMAMemory(pTx, Len))
+		|| ((pRx != NULL) && !SPI_IsDMAMemory(pRx, Len)))
+	{
+		return SPI_ERR_CONFIG;
+	}
+	if (Len == 0)
+	{
+		return SPI_OK;
+	}
+	SPI_ApplyPendingClock(pSPIHandle);
+
+	pSPIHandle->State = SPI_BUSY_DMA;
+	pSPIHandle->LastError = SPI_OK;
+
+	/* -Step 1. Stale received byte and overrun flag cleared (DR then SR read)- */
+	(void)pSPIx->DR;
+	(void)pSPIx->SR;
+
+	/* -Step 2. Memory increment only for real buffers- */
+	DMA_SetMemoryIncrement(pDMAx, pSPIHandle->RxStream, (pRx != NULL) ? ENABLE : DISABLE);
+	DMA_SetMemoryIncrement(pDMAx, pSPIHandle->TxStream, (pTx != NULL) ? ENABLE : DISABLE);
+
+	/* -Step 3. RX stream, TX stream, then the SPI DMA requests- */
+	DMA_StreamStart(pDMAx, pSPIHandle->RxStream, (pRx != NULL) ? pRx : &spiDummyRx, Len);
+	DMA_StreamStart(pDMAx, pSPIHandle->TxStream, (pTx != NULL) ? pTx : &spiDummyTx, Len);
+	pSPIx->CR2 |= (1U << SPI_CR2_RXDMAEN) | (1U << SPI_CR2_TXDMAEN);
+
+	return SPI_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_WaitDone
+ * Description	:	To wait for the end of a DMA transfer
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	Timeout (polling iterations)
+ * Return Type	:	uint8_t @SPI_STATUS (SPI_ERR_BUSY: still running, SPI_ERR_DMA: ended by a transfer error)
+ * Note		:	Needs the RX DMA stream interrupt enabled. No transfer running: returns at once with
+ *			the outcome of the last one. On SPI_ERR_BUSY the DMA still owns the buffers: wait
+ *			again or call SPI_AbortDMA before they go out of scope.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SPI_WaitDone(SPI_Handle_t *pSPIHandle, uint32_t Timeout)
+{
+	while (pSPIHandle->State != SPI_READY)
+	{
+		if (Timeout-- == 0)
+		{
+			return SPI_ERR_BUSY;
+		}
+	}
+
+	if (pSPIHandle->LastError != SPI_OK)
+	{
+		return pSPIHandle->LastError;
+	}
+
+	return SPI_WaitFlag(pSPIHandle->pSPIx, SPI_SR_BSY, 0);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_AbortDMA
+ * Description	:	To stop a DMA transfer
+ * Parameter 1	:	Pointer to SPI Handle
+ * Return Type	:	none (void)
+ * Note		:	SPI DMA requests cleared first (no new request), then both streams stopped: no
+ *			DMA access to the buffers after return. The byte in flight is drained (BSY, DR, SR:
+ *			no stale data or overrun for the next transfer). The chip select is left to the caller.
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_AbortDMA(SPI_Handle_t *pSPIHandle)
+{
+	SPI_RegDef_t *pSPIx = pSPIHandle->pSPIx;
+	DMA_RegDef_t *pDMAx = pSPIHandle->pDMAx;
+
+	if (pDMAx == NULL)
+	{
+		return;
+	}
+
+	/* -Step 1. No more requests, streams stopped, their flags cleared (no late interrupt)- */
+	pSPIx->CR2 &= ~((1U << SPI_CR2_RXDMAEN) | (1U << SPI_CR2_TXDMAEN));
+	DMA_StreamStop(pDMAx, pSPIHandle->TxStream);
+	DMA_StreamStop(pDMAx, pSPIHandle->RxStream);
+	DMA_ClearFlags(pDMAx, pSPIHandle->TxStream, DMA_FLAG_ALL);
+	DMA_ClearFlags(pDMAx, pSPIHandle->RxStream, DMA_FLAG_ALL);
+
+	/* -Step 2. Last frame finished, received byte and overrun flag cleared (DR then SR read)- */
+	(void)SPI_WaitFlag(pSPIx, SPI_SR_BSY, 0);
+	(void)pSPIx->DR;
+	(void)pSPIx->SR;
+
+	pSPIHandle->State = SPI_READY;
+	SPI_ApplyPendingClock(pSPIHandle);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_GetIRQNumbers
+ * Description	:	To get the IRQ numbers of the DMA streams used by a SPI
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	TX DMA stream IRQ number (output)
+ * Parameter 3	:	RX DMA stream IRQ number (output)
+ * Return Type	:	none (void)
+ * Note		:	Outputs left unchanged for an unknown peripheral.
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_GetIRQNumbers(SPI_Handle_t *pSPIHandle, uint8_t *pTxIRQ, uint8_t *pRxIRQ)
+{
+	const SPI_DMAMap_t *pMap = SPI_GetDMAMap(pSPIHandle->pSPIx);
+
+	if (pMap != NULL)
+	{
+		*pTxIRQ = pMap->TxIRQ;
+		*pRxIRQ = pMap->RxIRQ;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_DMA_IRQHandling
+ * Description	:	DMA stream interrupt (TX or RX stream of the SPI)
+ * Parameter 1	:	Pointer to SPI Handle
+ * Return Type	:	none (void)
+ * Note		:	RX transfer complete: every byte sent and received. Transfer error on either
+ *			stream: both stopped, transfer aborted, LastError = SPI_ERR_DMA (SPI_WaitDone).
+ * ------------------------------------------------------------------------------------------------------ */
+void SPI_DMA_IRQHandling(SPI_Handle_t *pSPIHandle)
+{
+	DMA_RegDef_t *pDMAx = pSPIHandle->pDMAx;
+	uint8_t txFlags = DMA_GetFlags(pDMAx, pSPIHandle->TxStream);
+	uint8_t rxFlags = DMA_GetFlags(pDMAx, pSPIHandle->RxStream);
+
+	DMA_ClearFlags(pDMAx, pSPIHandle->TxStream, txFlags);
+	DMA_ClearFlags(pDMAx, pSPIHandle->RxStream, rxFlags);
+
+	if ((txFlags | rxFlags) & DMA_FLAG_TE)
+	{
+		pSPIHandle->LastError = SPI_ERR_DMA;
+		SPI_AbortDMA(pSPIHandle);
+		SPI_ApplicationEventCallback(pSPIHandle, SPI_ERROR_DMA);
+	}
+	else if ((rxFlags & DMA_FLAG_TC) && (pSPIHandle->State == SPI_BUSY_DMA))
+	{
+		pSPIHandle->pSPIx->CR2 &= ~((1U << SPI_CR2_RXDMAEN) | (1U << SPI_CR2_TXDMAEN));
+		pSPIHandle->State = SPI_READY;
+		SPI_ApplyPendingClock(pSPIHandle);
+		SPI_ApplicationEventCallback(pSPIHandle, SPI_EVENT_DMA_DONE);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_ApplicationEventCallback
+ * Description	:	Callback implementation
+ *
+ * Parameter 1	:	Pointer to SPI Handle
+ * Parameter 2	:	Application Event
+ * Return Type	:	none (void)
+ * Note		:	This function must be implemented in the application. Since the driver does not know
+ * 			in which application this function will be implemented, therefore,
+ * 			weak implementation is done here. If application does not implement this function
+ * 			then this implementation will be called. __attribute__((weak))
+ * ------------------------------------------------------------------------------------------------------ */
+__attribute__((weak))void SPI_ApplicationEventCallback(SPI_Handle_t *pSPIHandle, uint8_t ApplicationEvent)
+{
+	// May or may not be implemented in the application file as per the requirements
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_GetDMAMap
+ * Description	:	Helper Functions
+ * Parameters	:	Base address of the SPI peripheral
+ * Return Type	:	DMA mapping of the peripheral (NULL: unknown)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+static const SPI_DMAMap_t *SPI_GetDMAMap(SPI_RegDef_t *pSPIx)
+{
+	for (uint32_t i = 0; i < SPI_DMA_MAP_SIZE; i++)
+	{
+		if (spiDmaMap[i].pSPIx == pSPIx)
+		{
+			return &spiDmaMap[i];
+		}
+	}
+
+	return NULL;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_IsDMAMemory
+ * Description	:	Helper Functions
+ * Parameters	:	Buffer and size
+ * Return Type	:	uint8_t (1: DMA accessible, 0: in CCMRAM)
+ * Note		:	CCMRAM is on the CPU D-bus only: a DMA transfer from/to it fails (TE)
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t SPI_IsDMAMemory(const void *pBuffer, uint32_t Size)
+{
+	uint32_t start = (uint32_t)(uintptr_t)pBuffer;
+
+	return ((start + Size) <= CCMRAM_BASEADDR) || (start >= (CCMRAM_BASEADDR + 0x10000U));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_WaitFlag
+ * Description	:	Helper Functions
+ * Parameters	:	SPI, SR bit position, level waited for (1: set, 0: cleared)
+ * Return Type	:	uint8_t @SPI_STATUS (SPI_ERR_TIMEOUT after SPI_TIMEOUT polls)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t SPI_WaitFlag(SPI_RegDef_t *pSPIx, uint8_t FlagBit, uint8_t Level)
+{
+	uint32_t timeout = SPI_TIMEOUT;
+
+	while (((pSPIx->SR >> FlagBit) & 1U) != Level)
+	{
+		if (--timeout == 0)
+		{
+			return SPI_ERR_TIMEOUT;
+		}
+	}
+
+	return SPI_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_ClockChanged
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	RCC clock-change listener: SCLK prescaler of every initialized SPI for the new PCLK
+ *			(only lower or equal to SPI_MaxHz: a faster PCLK never over-clocks the device). A SPI
+ *			in a DMA transfer is left pending (ClockPending), re-timed by SPI_ApplyPendingClock.
+ * ------------------------------------------------------------------------------------------------------ */
+static void SPI_ClockChanged(void)
+{
+	for (uint8_t i = 0; i < SPI_MAX_HANDLES; i++)
+	{
+		if (spiHandles[i] != NULL)
+		{
+			(void)SPI_UpdateClock(spiHandles[i]);
+		}
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SPI_ApplyPendingClock
+ * Description	:	Helper Functions
+ * Parameters	:	Pointer to SPI Handle
+ * Return Type	:	none (void)
+ * Note		:	Deferred SPI_UpdateClock: called with the handle ready (end of a DMA transfer, abort,
+ *			start of the next transfer), the first SCLK after a clock change is never above SPI_MaxHz
+ * ------------------------------------------------------------------------------------------------------ */
+static void SPI_ApplyPendingClock(SPI_Handle_t *pSPIHandle)
+{
+	if (pSPIHandle->ClockPending)
+	{
+		(void)SPI_UpdateClock(pSPIHandle);
+	}
+}
@@ -0,0 +1,214 @@
+/*
+ * 									stm32f407xx_systick_drivers.c
+ *
+ *  This file contains SysTick driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_systick_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+
+// Tick counter (incremented by SysTick_Handler)
+static volatile uint32_t sysTicks = 0;
+
+// Selected tick rate [Hz] (0: not started)
+static uint32_t tickHz = 0;
+
+// Tick hook (called from SysTick_Handler)
+static volatile SysTick_Hook_t tickHook = NULL;
+
+/* --Helper Functions-- */
+static uint8_t SysTick_ConfigReload(void);
+static void SysTick_ClockChanged(void);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_Init
+ * Description	:	To start the tick counter
+ * Parameter 1	:	Tick rate [Hz] (SYSTICK_TICK_HZ: 1 ms)
+ * Parameter 2	:	SysTick exception priority [0 (highest) to NVIC_PRIORITY_LOWEST]
+ * Return Type	:	uint8_t @SYSTICK_STATUS
+ * Note		:	Counter clocked from HCLK: reload = HCLK / rate - 1 (24 bits, 1 kHz works from
+ *			1 MHz to 168 MHz). After a clock change the reload is re-computed by a clock listener.
+ *			The tick counter is NOT reset (time stays monotonic when called again).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t SysTick_Init(uint32_t TickHz, uint8_t Priority)
+{
+	if (TickHz == 0)
+	{
+		return SYSTICK_ERR_RATE;
+	}
+
+	tickHz = TickHz;
+
+	/* -Step 1. Counter stopped, reload for the current HCLK- */
+	*SYST_CSR = 0;
+	if (SysTick_ConfigReload() != SYSTICK_OK)
+	{
+		tickHz = 0;
+		return SYSTICK_ERR_RATE;
+	}
+
+	/* -Step 2. Exception priority (byte store in SHPR3)- */
+	SCB_SHPR[SYSTICK_EXCEPTION_NO - 4] = (uint8_t)((Priority << (8 - PRI_BITS_IMPLEMENTED)) & 0xFF);
+
+	/* -Step 3. Re-time on clock changes (registering twice is a no-op)- */
+	RCC_RegisterClockListener(SysTick_ClockChanged);
+
+	/* -Step 4. Start: processor clock, exception enabled- */
+	*SYST_CVR = 0;
+	*SYST_CSR = (1U << SYST_CSR_CLKSOURCE) | (1U << SYST_CSR_TICKINT) | (1U << SYST_CSR_ENABLE);
+
+	return SYSTICK_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_DeInit
+ * Description	:	To stop the tick counter (SysTick exception disabled)
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	The tick count is kept.
+ * ------------------------------------------------------------------------------------------------------ */
+void SysTick_DeInit(void)
+{
+	*SYST_CSR = 0;
+	tickHz = 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_GetTicks
+ * Description	:	To get the number of ticks since SysTick_Init
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) ticks (wraps around after 2^32 ticks: 49.7 days at 1 kHz)
+ * Note		:	Single 32-bit load: atomic.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t SysTick_GetTicks(void)
+{
+	return sysTicks;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_Elapsed
+ * Description	:	To get the number of ticks elapsed since a SysTick_GetTicks value
+ * Parameters	:	Start value (SysTick_GetTicks)
+ * Return Type	:	(uint32_t) ticks
+ * Note		:	Unsigned difference: correct across the wrap-around. Typical deadline loop:
+ *			start = SysTick_GetTicks(); while (!flag && (SysTick_Elapsed(start) < timeout));
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t SysTick_Elapsed(uint32_t StartTicks)
+{
+	return sysTicks - StartTicks;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_MsToTicks
+ * Description	:	To convert milliseconds into ticks (rounded up)
+ * Parameters	:	Milliseconds
+ * Return Type	:	(uint32_t) ticks (1:1 at SYSTICK_TICK_HZ)
+ * Note		:	Before SysTick_Init the default rate (SYSTICK_TICK_HZ) is assumed.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t SysTick_MsToTicks(uint32_t Ms)
+{
+	uint32_t rate = (tickHz != 0) ? tickHz : SYSTICK_TICK_HZ;
+
+	if (rate == 1000U)
+	{
+		return Ms;
+	}
+
+	return (uint32_t)((((uint64_t)Ms * rate) + 999U) / 1000U);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_Delay
+ * Description	:	To wait (blocking) for at least 'Ms' milliseconds
+ * Parameters	:	Milliseconds
+ * Return Type	:	none (void)
+ * Note		:	One extra tick is waited: the first one may be partial. SysTick MUST be running
+ *			and NOT masked (do not call from an interrupt of higher or equal priority).
+ * ------------------------------------------------------------------------------------------------------ */
+void SysTick_Delay(uint32_t Ms)
+{
+	uint32_t start = sysTicks;
+	uint32_t ticks = SysTick_MsToTicks(Ms) + 1;
+
+	while ((sysTicks - start) < ticks);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_SetTickHook
+ * Description	:	To install the tick hook
+ * Parameters	:	Function called on every tick (interrupt context), NULL to remove
+ * Return Type	:	none (void)
+ * Note		:	The hook MUST be short: it delays every interrupt of lower priority.
+ * ------------------------------------------------------------------------------------------------------ */
+void SysTick_SetTickHook(SysTick_Hook_t Hook)
+{
+	tickHook = Hook;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_Handler
+ * Description	:	SysTick exception handler (overrides the weak one of the startup file)
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	Runs from SRAM (__RAMFUNC)
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC void SysTick_Handler(void)
+{
+	SysTick_Hook_t hook = tickHook;
+
+	sysTicks++;
+
+	if (hook != NULL)
+	{
+		hook();
+	}
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_ConfigReload
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	uint8_t @SYSTICK_STATUS
+ * Note		:	Reload from the cached HCLK, rounded to the nearest count (1 kHz at 168 MHz: exact)
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t SysTick_ConfigReload(void)
+{
+	uint32_t reload = (RCC_Hclk_Value() + (tickHz / 2)) / tickHz;
+
+	if ((reload < 2) || ((reload - 1) > SYST_RVR_MAX))
+	{
+		return SYSTICK_ERR_RATE;
+	}
+
+	*SYST_RVR = reload - 1;
+
+	return SYSTICK_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SysTick_ClockChanged
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	RCC clock-change listener: new reload, the current period finishes with the old one.
+ *			If the rate cannot be reached with the new HCLK the reload is left unchanged.
+ * ------------------------------------------------------------------------------------------------------ */
+static void SysTick_ClockChanged(void)
+{
+	if (tickHz != 0)
+	{
+		SysTick_ConfigReload();
+	}
+}
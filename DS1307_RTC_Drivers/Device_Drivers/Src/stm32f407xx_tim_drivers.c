@@ -0,0 +1,171 @@
+/*
+ * 									stm32f407xx_tim_drivers.c
+ *
+ *  This file contains General-purpose Timer (TIM2 to TIM5) driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_tim_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:  	TIM_PeriClockControl
+ * Description	:	Peripheral Clock Setup API:
+ 			This function Enables or Disables peripheral clock for the given TIM peripheral
+ * Parameter 1	:	Base address of the TIM peripheral
+ * Parameter 2	:	ENABLE or DISABLE Macro
+ * Return Type	:	none (void)
+ * Note		:
+ * ------------------------------------------------------------------------------------------------------ */
+void TIM_PeriClockControl(TIM_RegDef_t *pTIMx, uint8_t EnorDi)
+{
+	if (EnorDi == ENABLE)
+	{
+		if (pTIMx == TIM2)
+		{
+			TIM2_PCLK_EN();
+		}
+		else if (pTIMx == TIM3)
+		{
+			TIM3_PCLK_EN();
+		}
+		else if (pTIMx == TIM4)
+		{
+			TIM4_PCLK_EN();
+		}
+		else if (pTIMx == TIM5)
+		{
+			TIM5_PCLK_EN();
+		}
+	}
+	else
+	{
+		if (pTIMx == TIM2)
+		{
+			TIM2_PCLK_DI();
+		}
+		else if (pTIMx == TIM3)
+		{
+			TIM3_PCLK_DI();
+		}
+		else if (pTIMx == TIM4)
+		{
+			TIM4_PCLK_DI();
+		}
+		else if (pTIMx == TIM5)
+		{
+			TIM5_PCLK_DI();
+		}
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TIM_Clock_Value
+ * Description	:	To get the counter clock of a TIM2 to TIM5 timer (prescaler 0)
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) Timer clock [Hz]
+ * Note		:	APB1 timers run at PCLK1 when the APB1 prescaler is 1, otherwise at 2 x PCLK1.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t TIM_Clock_Value(void)
+{
+	uint32_t pclk1 = RCC_Pclk1_Value();
+
+	return (pclk1 == RCC_Hclk_Value()) ? pclk1 : (2 * pclk1);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TIM_IC_Init
+ * Description	:	To start the free-running counter with input capture on one channel
+ * Parameter 1	:	Base address of the TIM peripheral
+ * Parameter 2	:	@TIM_CHANNEL
+ * Parameter 3	:	@TIM_ICEDGE
+ * Parameter 4	:	@TIM_ICPSC
+ * Parameter 5	:	Input filter [0 to 15] (0: none)
+ * Return Type	:	none (void)
+ * Note		:	Counter clock = TIM_Clock_Value() (PSC 0), wraps every 65536 ticks (ARR 0xFFFF).
+ *			On TIM2/TIM5 only the lower 16 bits of the capture are used, so the same
+ *			modulo-65536 delta works on every timer.
+ *			The pin MUST already be configured in the timer's alternate function.
+ * ------------------------------------------------------------------------------------------------------ */
+void TIM_IC_Init(TIM_RegDef_t *pTIMx, uint8_t Channel, uint8_t Edge, uint8_t ICPrescaler, uint8_t ICFilter)
+{
+	uint8_t ccmr = (Channel - 1) / 2;
+	uint8_t shift = ((Channel - 1) % 2) * 8;
+	uint8_t ccer = (Channel - 1) * 4;
+
+	TIM_PeriClockControl(pTIMx, ENABLE);
+
+	/* -Step 1. Counter stopped, channel disabled while it is configured- */
+	pTIMx->CR1 &= ~(1 << TIM_CR1_CEN);
+	pTIMx->CCER &= ~(0x0FU << ccer);
+
+	/* -Step 2. Free-running counter at the timer clock- */
+	pTIMx->PSC = 0;
+	pTIMx->ARR = 0xFFFF;
+
+	/* -Step 3. Channel as input, mapped on its own pin (TIx), prescaler and filter- */
+	pTIMx->CCMR[ccmr] &= ~(0xFFU << shift);
+	pTIMx->CCMR[ccmr] |= ((1U << TIM_CCMR_CCS) | ((ICPrescaler & 0x03U) << TIM_CCMR_ICPSC) | ((ICFilter & 0x0FU) << TIM_CCMR_ICF)) << shift;
+
+	/* -Step 4. Edge and capture enable- */
+	pTIMx->CCER |= (((Edge & 0x01U) << TIM_CCER_CC1P) | (1U << TIM_CCER_CC1E)) << ccer;
+
+	/* -Step 5. Load PSC/ARR, clear the flags and start- */
+	pTIMx->EGR = (1 << TIM_EGR_UG);
+	pTIMx->SR = 0;
+	pTIMx->CR1 |= (1 << TIM_CR1_CEN);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TIM_IC_WaitCapture
+ * Description	:	To wait for the next capture on a channel
+ * Parameter 1	:	Base address of the TIM peripheral
+ * Parameter 2	:	@TIM_CHANNEL
+ * Parameter 3	:	Pointer to the captured counter value
+ * Return Type	:	uint8_t @TIM_STATUS
+ * Note		:	Reading CCRx clears CCxIF. An over-capture (CCxOF) is reported once and cleared.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t TIM_IC_WaitCapture(TIM_RegDef_t *pTIMx, uint8_t Channel, uint16_t *pCapture)
+{
+	uint32_t timeout = TIM_TIMEOUT;
+	uint32_t ccif = 1U << (TIM_SR_CC1IF + Channel - 1);
+	uint32_t ccof = 1U << (TIM_SR_CC1OF + Channel - 1);
+
+	while (!(pTIMx->SR & ccif))
+	{
+		if (--timeout == 0)
+		{
+			return TIM_ERR_TIMEOUT;
+		}
+	}
+
+	*pCapture = (uint16_t)pTIMx->CCR[Channel - 1];
+
+	if (pTIMx->SR & ccof)
+	{
+		pTIMx->SR = ~ccof;
+		return TIM_ERR_OVERCAPTURE;
+	}
+
+	return TIM_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TIM_IC_DeInit
+ * Description	:	To stop the counter and disable the capture channel
+ * Parameter 1	:	Base address of the TIM peripheral
+ * Parameter 2	:	@TIM_CHANNEL
+ * Return Type	:	none (void)
+ * Note		:	The peripheral clock is left enabled.
+ * ------------------------------------------------------------------------------------------------------ */
+void TIM_IC_DeInit(TIM_RegDef_t *pTIMx, uint8_t Channel)
+{
+	pTIMx->CR1 &= ~(1 << TIM_CR1_CEN);
+	pTIMx->CCER &= ~(0x0FU << ((Channel - 1) * 4));
+	pTIMx->SR = 0;
+}
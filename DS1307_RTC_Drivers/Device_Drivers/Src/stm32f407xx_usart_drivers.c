@@ -0,0 +1,693 @@
+/*
+ * 									stm32f407xx_usart_drivers.c
+ *
+ *  This file contains USART driver API implementations.
+ *
+ */
+
+#include <stm32f407xx_usart_drivers.h>
+#include <stm32f407xx_nvic_drivers.h>
+#include <stm32f407xx_dma_drivers.h>
+#include <stm32f407xx_rcc_drivers.h>
+
+#include <string.h>
+
+// DMA request mapping (reference manual, DMA1/DMA2 request mapping tables) and IRQ numbers
+typedef struct
+{
+	USART_RegDef_t	*pUSARTx;
+	DMA_RegDef_t	*pDMAx;
+	uint8_t		TxStream;
+	uint8_t		RxStream;
+	uint8_t		Channel;
+	uint8_t		USARTIRQ;
+	uint8_t		TxIRQ;
+	uint8_t		RxIRQ;
+
+}USART_DMAMap_t;
+
+static const USART_DMAMap_t usartDmaMap[] =
+{
+	{USART1, DMA2, 7, 2, 4, IRQ_NO_USART1, IRQ_NO_DMA2_STREAM7, IRQ_NO_DMA2_STREAM2},
+	{USART2, DMA1, 6, 5, 4, IRQ_NO_USART2, IRQ_NO_DMA1_STREAM6, IRQ_NO_DMA1_STREAM5},
+	{USART3, DMA1, 3, 1, 4, IRQ_NO_USART3, IRQ_NO_DMA1_STREAM3, IRQ_NO_DMA1_STREAM1},
+	{UART4,  DMA1, 4, 2, 4, IRQ_NO_UART4,  IRQ_NO_DMA1_STREAM4, IRQ_NO_DMA1_STREAM2},
+	{UART5,  DMA1, 7, 0, 4, IRQ_NO_UART5,  IRQ_NO_DMA1_STREAM7, IRQ_NO_DMA1_STREAM0},
+	{USART6, DMA2, 6, 1, 5, IRQ_NO_USART6, IRQ_NO_DMA2_STREAM6, IRQ_NO_DMA2_STREAM1},
+};
+
+#define USART_DMA_MAP_SIZE		(sizeof(usartDmaMap) / sizeof(usartDmaMap[0]))
+
+// Largest TX buffer: one DMA segment (at most the buffer size) MUST fit in NDTR (16 bits)
+#define USART_TX_MAX_SIZE		32768U
+
+// Handles re-timed by the clock listener
+static USART_Handle_t *usartHandles[USART_MAX_HANDLES];
+
+/* --Helper Functions-- */
+static const USART_DMAMap_t *USART_GetDMAMap(USART_RegDef_t *pUSARTx);
+static uint8_t USART_IsDMAMemory(const void *pBuffer, uint32_t Size);
+static void USART_StartTx(USART_Handle_t *pUSARTHandle);
+static void USART_ClockChanged(void);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_PeriClockControl
+ * Description	:	To enable or disable the peripheral clock of a USART
+ * Parameter 1	:	Base address of the USART peripheral
+ * Parameter 2	:	ENABLE or DISABLE Macro
+ * Return Type	:	none (void)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_PeriClockControl(USART_RegDef_t *pUSARTx, uint8_t EnorDi)
+{
+	if (EnorDi == ENABLE)
+	{
+		if (pUSARTx == USART1)
+		{
+			USART1_PCLK_EN();
+		}
+		else if (pUSARTx == USART2)
+		{
+			USART2_PCLK_EN();
+		}
+		else if (pUSARTx == USART3)
+		{
+			USART3_PCLK_EN();
+		}
+		else if (pUSARTx == UART4)
+		{
+			UART4_PCLK_EN();
+		}
+		else if (pUSARTx == UART5)
+		{
+			UART5_PCLK_EN();
+		}
+		else if (pUSARTx == USART6)
+		{
+			USART6_PCLK_EN();
+		}
+	}
+	else
+	{
+		if (pUSARTx == USART1)
+		{
+			USART1_PCLK_DI();
+		}
+		else if (pUSARTx == USART2)
+		{
+			USART2_PCLK_DI();
+		}
+		else if (pUSARTx == USART3)
+		{
+			USART3_PCLK_DI();
+		}
+		else if (pUSARTx == UART4)
+		{
+			UART4_PCLK_DI();
+		}
+		else if (pUSARTx == UART5)
+		{
+			UART5_PCLK_DI();
+		}
+		else if (pUSARTx == USART6)
+		{
+			USART6_PCLK_DI();
+		}
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_Init
+ * Description	:	To initialize the USART peripheral and its DMA streams
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	uint8_t @USART_STATUS
+ * Note		:	8 data bits (9 bits on the line with parity), oversampling by 16. TX buffer size: power
+ *			of 2, at most 32 KB. RX buffer NULL: TX only. Both buffers MUST be DMA accessible
+ *			(SRAM, not CCMRAM). The GPIO pins (alternate function) are set up by the application.
+ *			Enables the USART and DMA clocks; the IRQs (USART_GetIRQNumbers) are left to the
+ *			application.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t USART_Init(USART_Handle_t *pUSARTHandle)
+{
+	const USART_DMAMap_t *pMap = USART_GetDMAMap(pUSARTHandle->pUSARTx);
+	USART_RegDef_t *pUSARTx = pUSARTHandle->pUSARTx;
+	DMA_Config_t dmaConfig;
+	uint32_t tempReg = 0;
+	uint8_t status;
+
+	/* -Step 1. Peripheral and buffers checked- */
+	if ((pMap == NULL) || (pUSARTHandle->pTxBuffer == NULL) || (pUSARTHandle->TxSize == 0)
+		|| (pUSARTHandle->TxSize > USART_TX_MAX_SIZE)
+		|| (pUSARTHandle->TxSize & (pUSARTHandle->TxSize - 1))
+		|| !USART_IsDMAMemory(pUSARTHandle->pTxBuffer, pUSARTHandle->TxSize)
+		|| (pUSARTHandle->USART_Config.USART_Parity > USART_PARITY_ODD))
+	{
+		return USART_ERR_CONFIG;
+	}
+	if ((pUSARTHandle->pRxBuffer != NULL)
+		&& ((pUSARTHandle->RxSize == 0) || !USART_IsDMAMemory(pUSARTHandle->pRxBuffer, pUSARTHandle->RxSize)))
+	{
+		return USART_ERR_CONFIG;
+	}
+
+	pUSARTHandle->pDMAx = pMap->pDMAx;
+	pUSARTHandle->TxStream = pMap->TxStream;
+	pUSARTHandle->RxStream = pMap->RxStream;
+	pUSARTHandle->TxHead = 0;
+	pUSARTHandle->TxTail = 0;
+	pUSARTHandle->TxDMALength = 0;
+	pUSARTHandle->RxRead = 0;
+	pUSARTHandle->TxDropped = 0;
+	pUSARTHandle->RxErrors = 0;
+
+	/* -Step 2. Clocks enabled, USART disabled while configured- */
+	USART_PeriClockControl(pUSARTx, ENABLE);
+	DMA_PeriClockControl(pMap->pDMAx, ENABLE);
+	pUSARTx->CR1 = 0;
+
+	/* -Step 3. Baud rate for the current PCLK- */
+	status = USART_UpdateBaud(pUSARTHandle);
+	if (status != USART_OK)
+	{
+		return status;
+	}
+
+	/* -Step 4. Frame: parity (9-bit word to keep 8 data bits), stop bits, DMA requests- */
+	pUSARTx->CR2 = ((uint32_t)(pUSARTHandle->USART_Config.USART_StopBits & 0x3) << USART_CR2_STOP);
+	tempReg = (1U << USART_CR3_DMAT);
+	if (pUSARTHandle->pRxBuffer != NULL)
+	{
+		tempReg |= (1U << USART_CR3_DMAR) | (1U << USART_CR3_EIE);
+	}
+	pUSARTx->CR3 = tempReg;
+
+	/* -Step 5. TX stream: memory to peripheral, normal mode, started per segment- */
+	dmaConfig.DMA_Channel = pMap->Channel;
+	dmaConfig.DMA_Direction = DMA_DIR_MEM_TO_PERIPH;
+	dmaConfig.DMA_Mode = DMA_MODE_NORMAL;
+	dmaConfig.DMA_Priority = DMA_PRIORITY_MEDIUM;
+	dmaConfig.DMA_Interrupts = DMA_IT_TC | DMA_IT_TE;
+	DMA_StreamInit(pMap->pDMAx, pMap->TxStream, &dmaConfig, &pUSARTx->DR);
+
+	/* -Step 6. RX stream: peripheral to memory, circular over the whole RX buffer (never stopped)- */
+	if (pUSARTHandle->pRxBuffer != NULL)
+	{
+		dmaConfig.DMA_Direction = DMA_DIR_PERIPH_TO_MEM;
+		dmaConfig.DMA_Mode = DMA_MODE_CIRCULAR;
+		dmaConfig.DMA_Priority = DMA_PRIORITY_HIGH;
+		dmaConfig.DMA_Interrupts = DMA_IT_HT | DMA_IT_TC | DMA_IT_TE;
+		DMA_StreamInit(pMap->pDMAx, pMap->RxStream, &dmaConfig, &pUSARTx->DR);
+		DMA_StreamStart(pMap->pDMAx, pMap->RxStream, pUSARTHandle->pRxBuffer, pUSARTHandle->RxSize);
+	}
+
+	/* -Step 7. USART enabled (TC cleared before the first DMA transfer, reference manual)- */
+	tempReg = (1U << USART_CR1_UE) | (1U << USART_CR1_TE);
+	if (pUSARTHandle->pRxBuffer != NULL)
+	{
+		tempReg |= (1U << USART_CR1_RE) | (1U << USART_CR1_IDLEIE);
+	}
+	if (pUSARTHandle->USART_Config.USART_Parity != USART_PARITY_NONE)
+	{
+		tempReg |= (1U << USART_CR1_M) | (1U << USART_CR1_PCE);
+		if (pUSARTHandle->USART_Config.USART_Parity == USART_PARITY_ODD)
+		{
+			tempReg |= (1U << USART_CR1_PS);
+		}
+	}
+	pUSARTx->CR1 = tempReg;
+	pUSARTx->SR &= ~(1U << USART_SR_TC);
+
+	/* -Step 8. Re-timed on clock changes (one slot per handle, one listener for all)- */
+	for (uint8_t i = 0; i < USART_MAX_HANDLES; i++)
+	{
+		if ((usartHandles[i] == NULL) || (usartHandles[i] == pUSARTHandle))
+		{
+			usartHandles[i] = pUSARTHandle;
+			break;
+		}
+	}
+	RCC_RegisterClockListener(USART_ClockChanged);
+
+	return USART_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_DeInit
+ * Description	:	To stop the DMA streams and reset the USART peripheral
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	none (void)
+ * Note		:	Bytes still queued are lost (USART_Flush first). The DMA clock is left enabled
+ *			(streams may be shared with other peripherals).
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_DeInit(USART_Handle_t *pUSARTHandle)
+{
+	USART_RegDef_t *pUSARTx = pUSARTHandle->pUSARTx;
+
+	if (pUSARTHandle->pDMAx != NULL)
+	{
+		DMA_StreamStop(pUSARTHandle->pDMAx, pUSARTHandle->TxStream);
+		if (pUSARTHandle->pRxBuffer != NULL)
+		{
+			DMA_StreamStop(pUSARTHandle->pDMAx, pUSARTHandle->RxStream);
+		}
+	}
+	pUSARTHandle->TxDMALength = 0;
+
+	for (uint8_t i = 0; i < USART_MAX_HANDLES; i++)
+	{
+		if (usartHandles[i] == pUSARTHandle)
+		{
+			usartHandles[i] = NULL;
+		}
+	}
+
+	if (pUSARTx == USART1)
+	{
+		USART1_REG_RESET();
+	}
+	else if (pUSARTx == USART2)
+	{
+		USART2_REG_RESET();
+	}
+	else if (pUSARTx == USART3)
+	{
+		USART3_REG_RESET();
+	}
+	else if (pUSARTx == UART4)
+	{
+		UART4_REG_RESET();
+	}
+	else if (pUSARTx == UART5)
+	{
+		UART5_REG_RESET();
+	}
+	else if (pUSARTx == USART6)
+	{
+		USART6_REG_RESET();
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_UpdateBaud
+ * Description	:	To program the baud rate register for the current PCLK
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	uint8_t @USART_STATUS
+ * Note		:	Oversampling by 16: BRR (12.4 fixed point USARTDIV) = PCLK / baud, rounded to the
+ *			nearest. USART1/USART6 on APB2, others on APB1. BRR kept when out of range.
+ *			A byte on the line while BRR changes may be corrupted (clock switch is rare).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t USART_UpdateBaud(USART_Handle_t *pUSARTHandle)
+{
+	USART_RegDef_t *pUSARTx = pUSARTHandle->pUSARTx;
+	uint32_t baud = pUSARTHandle->USART_Config.USART_Baud;
+	uint32_t pclk;
+	uint32_t brr;
+
+	if ((pUSARTx == USART1) || (pUSARTx == USART6))
+	{
+		pclk = RCC_Pclk2_Value();
+	}
+	else
+	{
+		pclk = RCC_Pclk1_Value();
+	}
+
+	if (baud == 0)
+	{
+		return USART_ERR_BAUD;
+	}
+
+	brr = (pclk + (baud / 2)) / baud;
+	if ((brr < 16) || (brr > 0xFFFFU))
+	{
+		return USART_ERR_BAUD;
+	}
+
+	pUSARTx->BRR = brr;
+
+	return USART_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_Write
+ * Description	:	To queue bytes for transmission without waiting
+ * Parameter 1	:	Pointer to USART Handle
+ * Parameter 2	:	Pointer to data
+ * Parameter 3	:	Number of bytes
+ * Return Type	:	Bytes queued (uint32_t)
+ * Note		:	One bulk copy into the TX buffer, then the DMA sends it (no CPU work per byte). What
+ *			does not fit is dropped and counted in TxDropped: the caller never waits for the line.
+ *			One producer context (e.g. thread): writes from several contexts MUST be serialized
+ *			by the caller. The DMA is kicked here only when idle, otherwise by the TC interrupt.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t USART_Write(USART_Handle_t *pUSARTHandle, const void *pData, uint32_t Len)
+{
+	const uint8_t *pSrc = (const uint8_t *)pData;
+	uint32_t mask = pUSARTHandle->TxSize - 1;
+	uint32_t head = pUSARTHandle->TxHead;
+	uint32_t space = pUSARTHandle->TxSize - (head - pUSARTHandle->TxTail);
+	uint32_t first;
+	uint32_t primask;
+
+	/* -Step 1. What does not fit is dropped (the DMA only frees space)- */
+	if (Len > space)
+	{
+		pUSARTHandle->TxDropped += Len - space;
+		Len = space;
+	}
+	if (Len == 0)
+	{
+		return 0;
+	}
+
+	/* -Step 2. Copied in at most two pieces (buffer end wrap)- */
+	first = pUSARTHandle->TxSize - (head & mask);
+	if (first > Len)
+	{
+		first = Len;
+	}
+	memcpy(&pUSARTHandle->pTxBuffer[head & mask], pSrc, first);
+	memcpy(pUSARTHandle->pTxBuffer, &pSrc[first], Len - first);
+
+	/* -Step 3. Published, DMA started if idle (same critical section as the TC interrupt)- */
+	primask = NVIC_EnterCriticalAll();
+	pUSARTHandle->TxHead = head + Len;
+	if (pUSARTHandle->TxDMALength == 0)
+	{
+		USART_StartTx(pUSARTHandle);
+	}
+	NVIC_ExitCriticalAll(primask);
+
+	return Len;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_TxPending
+ * Description	:	To get the bytes queued and not sent yet
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	Bytes (uint32_t)
+ * Note		:	Bytes of the running DMA transfer are counted until its TC interrupt.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t USART_TxPending(USART_Handle_t *pUSARTHandle)
+{
+	return pUSARTHandle->TxHead - pUSARTHandle->TxTail;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_Flush
+ * Description	:	To wait until everything queued is on the line
+ * Parameter 1	:	Pointer to USART Handle
+ * Parameter 2	:	Timeout (polling iterations)
+ * Return Type	:	uint8_t (0: done, 1: timeout)
+ * Note		:	Needs the TX DMA interrupt enabled. Ends on USART TC: the last stop bit is sent
+ *			(safe to stop the clocks).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t USART_Flush(USART_Handle_t *pUSARTHandle, uint32_t Timeout)
+{
+	while (USART_TxPending(pUSARTHandle) != 0)
+	{
+		if (Timeout-- == 0)
+		{
+			return 1;
+		}
+	}
+
+	while (!(pUSARTHandle->pUSARTx->SR & (1U << USART_SR_TC)))
+	{
+		if (Timeout-- == 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_Read
+ * Description	:	To read the bytes received since the last call
+ * Parameter 1	:	Pointer to USART Handle
+ * Parameter 2	:	Pointer to the application buffer
+ * Parameter 3	:	Size of the application buffer
+ * Return Type	:	Bytes copied (uint32_t)
+ * Note		:	DMA write position = RxSize - NDTR. The reader MUST keep up (called on
+ *			USART_EVENT_RX_DATA/RX_IDLE): data older than one buffer is overwritten unnoticed.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t USART_Read(USART_Handle_t *pUSARTHandle, uint8_t *pBuffer, uint32_t MaxLen)
+{
+	uint32_t write;
+	uint32_t read = pUSARTHandle->RxRead;
+	uint32_t count = 0;
+
+	if (pUSARTHandle->pRxBuffer == NULL)
+	{
+		return 0;
+	}
+
+	write = pUSARTHandle->RxSize - DMA_GetRemaining(pUSARTHandle->pDMAx, pUSARTHandle->RxStream);
+	if (write >= pUSARTHandle->RxSize)
+	{
+		write = 0;
+	}
+
+	while ((read != write) && (count < MaxLen))
+	{
+		pBuffer[count++] = pUSARTHandle->pRxBuffer[read];
+		if (++read == pUSARTHandle->RxSize)
+		{
+			read = 0;
+		}
+	}
+	pUSARTHandle->RxRead = read;
+
+	return count;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_GetIRQNumbers
+ * Description	:	To get the IRQ numbers used by a USART and its DMA streams
+ * Parameter 1	:	Pointer to USART Handle
+ * Parameter 2	:	USART IRQ number (output)
+ * Parameter 3	:	TX DMA stream IRQ number (output)
+ * Parameter 4	:	RX DMA stream IRQ number (output)
+ * Return Type	:	none (void)
+ * Note		:	Outputs left unchanged for an unknown peripheral.
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_GetIRQNumbers(USART_Handle_t *pUSARTHandle, uint8_t *pUSARTIRQ, uint8_t *pTxIRQ, uint8_t *pRxIRQ)
+{
+	const USART_DMAMap_t *pMap = USART_GetDMAMap(pUSARTHandle->pUSARTx);
+
+	if (pMap != NULL)
+	{
+		*pUSARTIRQ = pMap->USARTIRQ;
+		*pTxIRQ = pMap->TxIRQ;
+		*pRxIRQ = pMap->RxIRQ;
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_IRQHandling
+ * Description	:	USART interrupt: IDLE line and RX errors
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	none (void)
+ * Note		:	IDLE, ORE, NF and FE are cleared by reading SR then DR. The DMA has already moved
+ *			the received bytes, so the DR read loses nothing.
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_IRQHandling(USART_Handle_t *pUSARTHandle)
+{
+	USART_RegDef_t *pUSARTx = pUSARTHandle->pUSARTx;
+	uint32_t sr = pUSARTx->SR;
+	uint32_t errors = sr & ((1U << USART_SR_ORE) | (1U << USART_SR_NF) | (1U << USART_SR_FE));
+
+	if (sr & ((1U << USART_SR_IDLE) | errors))
+	{
+		(void)pUSARTx->DR;
+	}
+
+	if (errors)
+	{
+		pUSARTHandle->RxErrors++;
+		USART_ApplicationEventCallback(pUSARTHandle, USART_ERROR_RX);
+	}
+
+	if (sr & (1U << USART_SR_IDLE))
+	{
+		USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_RX_IDLE);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_DMA_TX_IRQHandling
+ * Description	:	TX DMA stream interrupt: segment sent, next one started
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	none (void)
+ * Note		:	Transfer error: the queued bytes are discarded (stream stopped by hardware).
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_DMA_TX_IRQHandling(USART_Handle_t *pUSARTHandle)
+{
+	uint8_t flags = DMA_GetFlags(pUSARTHandle->pDMAx, pUSARTHandle->TxStream);
+	uint32_t primask;
+
+	DMA_ClearFlags(pUSARTHandle->pDMAx, pUSARTHandle->TxStream, flags);
+
+	primask = NVIC_EnterCriticalAll();
+	if (flags & DMA_FLAG_TE)
+	{
+		pUSARTHandle->TxDropped += pUSARTHandle->TxHead - pUSARTHandle->TxTail;
+		pUSARTHandle->TxTail = pUSARTHandle->TxHead;
+		pUSARTHandle->TxDMALength = 0;
+		NVIC_ExitCriticalAll(primask);
+		USART_ApplicationEventCallback(pUSARTHandle, USART_ERROR_DMA);
+		return;
+	}
+
+	if ((flags & DMA_FLAG_TC) && (pUSARTHandle->TxDMALength != 0))
+	{
+		pUSARTHandle->TxTail += pUSARTHandle->TxDMALength;
+		USART_StartTx(pUSARTHandle);
+		NVIC_ExitCriticalAll(primask);
+
+		if (pUSARTHandle->TxDMALength == 0)
+		{
+			USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_TX_DONE);
+		}
+		return;
+	}
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_DMA_RX_IRQHandling
+ * Description	:	RX DMA stream interrupt: half or whole buffer written
+ * Parameter 1	:	Pointer to USART Handle
+ * Return Type	:	none (void)
+ * Note		:	The application reads with USART_Read from the callback (or later, in time).
+ * ------------------------------------------------------------------------------------------------------ */
+void USART_DMA_RX_IRQHandling(USART_Handle_t *pUSARTHandle)
+{
+	uint8_t flags = DMA_GetFlags(pUSARTHandle->pDMAx, pUSARTHandle->RxStream);
+
+	DMA_ClearFlags(pUSARTHandle->pDMAx, pUSARTHandle->RxStream, flags);
+
+	if (flags & DMA_FLAG_TE)
+	{
+		USART_ApplicationEventCallback(pUSARTHandle, USART_ERROR_DMA);
+	}
+	else if (flags & (DMA_FLAG_HT | DMA_FLAG_TC))
+	{
+		USART_ApplicationEventCallback(pUSARTHandle, USART_EVENT_RX_DATA);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_ApplicationEventCallback
+ * Description	:	Callback implementation
+ *
+ * Parameter 1	:	Pointer to USART Handle
+ * Parameter 2	:	Application Event
+ * Return Type	:	none (void)
+ * Note		:	This function must be implemented in the application. Since the driver does not know
+ * 			in which application this function will be implemented, therefore,
+ * 			weak implementation is done here. If application does not implement this function
+ * 			then this implementation will be called. __attribute__((weak))
+ * ------------------------------------------------------------------------------------------------------ */
+__attribute__((weak))void USART_ApplicationEventCallback(USART_Handle_t *pUSARTHandle, uint8_t ApplicationEvent)
+{
+	// May or may not be implemented in the application file as per the requirements
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_GetDMAMap
+ * Description	:	Helper Functions
+ * Parameters	:	Base address of the USART peripheral
+ * Return Type	:	DMA mapping of the peripheral (NULL: unknown)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+static const USART_DMAMap_t *USART_GetDMAMap(USART_RegDef_t *pUSARTx)
+{
+	for (uint32_t i = 0; i < USART_DMA_MAP_SIZE; i++)
+	{
+		if (usartDmaMap[i].pUSARTx == pUSARTx)
+		{
+			return &usartDmaMap[i];
+		}
+	}
+
+	return NULL;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_IsDMAMemory
+ * Description	:	Helper Functions
+ * Parameters	:	Buffer and size
+ * Return Type	:	uint8_t (1: DMA accessible, 0: in CCMRAM)
+ * Note		:	CCMRAM is on the CPU D-bus only: a DMA transfer from/to it fails (TE)
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t USART_IsDMAMemory(const void *pBuffer, uint32_t Size)
+{
+	uint32_t start = (uint32_t)(uintptr_t)pBuffer;
+
+	return ((start + Size) <= CCMRAM_BASEADDR) || (start >= (CCMRAM_BASEADDR + 0x10000U));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_StartTx
+ * Description	:	Helper Functions
+ * Parameters	:	Pointer to USART Handle
+ * Return Type	:	none (void)
+ * Note		:	Called with interrupts masked. Starts the longest contiguous segment from the tail
+ *			(up to the buffer end), TxDMALength 0 when nothing is queued.
+ * ------------------------------------------------------------------------------------------------------ */
+static void USART_StartTx(USART_Handle_t *pUSARTHandle)
+{
+	uint32_t mask = pUSARTHandle->TxSize - 1;
+	uint32_t tail = pUSARTHandle->TxTail;
+	uint32_t length = pUSARTHandle->TxHead - tail;
+
+	if (length > (pUSARTHandle->TxSize - (tail & mask)))
+	{
+		length = pUSARTHandle->TxSize - (tail & mask);
+	}
+
+	pUSARTHandle->TxDMALength = length;
+	if (length != 0)
+	{
+		DMA_StreamStart(pUSARTHandle->pDMAx, pUSARTHandle->TxStream, &pUSARTHandle->pTxBuffer[tail & mask], (uint16_t)length);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	USART_ClockChanged
+ * Description	:	Helper Functions
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	RCC clock-change listener: baud rate of every initialized USART for the new PCLK
+ * ------------------------------------------------------------------------------------------------------ */
+static void USART_ClockChanged(void)
+{
+	for (uint8_t i = 0; i < USART_MAX_HANDLES; i++)
+	{
+		if (usartHandles[i] != NULL)
+		{
+			(void)USART_UpdateBaud(usartHandles[i]);
+		}
+	}
+}
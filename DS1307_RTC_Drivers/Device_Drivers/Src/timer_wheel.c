@@ -0,0 +1,393 @@
+/*
+ * 									timer_wheel.c
+ *
+ *  This file contains the software timer (hierarchical timer wheel) implementations (see timer_wheel.h).
+ *
+ *  Level L slot of an expiry time E: (E >> (6 * L)) & 63. A timer goes to the lowest level whose range
+ *  covers its remaining time; when level 0 wraps (every 64 ticks) the current slot of level 1 is moved
+ *  down, and so on up the levels (cascade). Every timer is therefore moved at most once per level.
+ *
+ */
+
+#include <timer_wheel.h>
+#include <stm32f407xx_nvic_drivers.h>
+#include <stm32f407xx_systick_drivers.h>
+
+#include <string.h>
+
+#define TIMER_WHEEL_SLOT_MASK		(TIMER_WHEEL_SLOTS - 1)
+
+// Slot lists (singly linked, each timer keeps the address of the pointer to it: O(1) removal)
+// Walked on every tick: kept in CCMRAM with the pool (zero wait state, CPU only)
+__CCMRAM_BSS static TimerWheel_Timer_t *wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+
+// Timer pool and its free list
+__CCMRAM_BSS static TimerWheel_Timer_t timerPool[TIMER_WHEEL_POOL_SIZE];
+static TimerWheel_Timer_t *freeList = NULL;
+
+// Next tick to process
+static volatile uint32_t wheelTime = 0;
+
+/* --Helper Functions-- */
+__RAMFUNC static void TimerWheel_Link(TimerWheel_Timer_t *pTimer);
+__RAMFUNC static void TimerWheel_Unlink(TimerWheel_Timer_t *pTimer);
+__RAMFUNC static void TimerWheel_Cascade(uint8_t Level, uint32_t Index);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Init
+ * Description	:	To empty the wheel and the pool, and install the tick on the SysTick hook
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	SysTick_Init sets the tick rate (1 tick = 1 ms at SYSTICK_TICK_HZ).
+ *			All the timers previously created are lost.
+ * ------------------------------------------------------------------------------------------------------ */
+void TimerWheel_Init(void)
+{
+	uint32_t primask = NVIC_EnterCriticalAll();
+
+	memset(wheel, 0, sizeof(wheel));
+	memset(timerPool, 0, sizeof(timerPool));
+
+	freeList = NULL;
+	for (uint8_t i = TIMER_WHEEL_POOL_SIZE; i > 0; i--)
+	{
+		timerPool[i - 1].pNext = freeList;
+		freeList = &timerPool[i - 1];
+	}
+
+	wheelTime = 0;
+
+	NVIC_ExitCriticalAll(primask);
+
+	SysTick_SetTickHook(TimerWheel_Tick);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Create
+ * Description	:	To take a timer from the pool
+ * Parameter 1	:	Callback (called on expiry, SysTick interrupt context)
+ * Parameter 2	:	Callback argument
+ * Return Type	:	Pointer to the timer (TIMER_WHEEL_IDLE), NULL if the pool is empty
+ * Note		:	O(1): free list.
+ * ------------------------------------------------------------------------------------------------------ */
+TimerWheel_Timer_t* TimerWheel_Create(TimerWheel_Callback_t Callback, void *pArg)
+{
+	TimerWheel_Timer_t *pTimer;
+	uint32_t primask = NVIC_EnterCriticalAll();
+
+	pTimer = freeList;
+	if (pTimer != NULL)
+	{
+		freeList = pTimer->pNext;
+
+		pTimer->pNext = NULL;
+		pTimer->pPrevNext = NULL;
+		pTimer->Period = 0;
+		pTimer->Callback = Callback;
+		pTimer->pArg = pArg;
+		pTimer->State = TIMER_WHEEL_IDLE;
+	}
+
+	NVIC_ExitCriticalAll(primask);
+
+	return pTimer;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Delete
+ * Description	:	To give a timer back to the pool
+ * Parameter 1	:	Pointer to the timer
+ * Return Type	:	none (void)
+ * Note		:	The timer is stopped first. The pointer MUST NOT be used afterwards.
+ * ------------------------------------------------------------------------------------------------------ */
+void TimerWheel_Delete(TimerWheel_Timer_t *pTimer)
+{
+	uint32_t primask;
+
+	if ((pTimer == NULL) || (pTimer->State == TIMER_WHEEL_FREE))
+	{
+		return;
+	}
+
+	primask = NVIC_EnterCriticalAll();
+
+	if (pTimer->State == TIMER_WHEEL_ARMED)
+	{
+		TimerWheel_Unlink(pTimer);
+	}
+
+	pTimer->State = TIMER_WHEEL_FREE;
+	pTimer->pNext = freeList;
+	freeList = pTimer;
+
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Start
+ * Description	:	To arm a timer
+ * Parameter 1	:	Pointer to the timer
+ * Parameter 2	:	First expiry [1 to TIMER_WHEEL_MAX_DELAY ticks] (0 is taken as 1)
+ * Parameter 3	:	Period [ticks] (0: one-shot)
+ * Return Type	:	uint8_t @TIMER_WHEEL_STATUS
+ * Note		:	O(1). An armed timer is re-armed. The tick in progress counts as the first one:
+ *			the callback runs after (DelayTicks - 1) to DelayTicks tick periods.
+ *			Periodic timers are re-armed from their previous expiry (no cumulative drift).
+ *			Periods above TIMER_WHEEL_MAX_DELAY work (the timer is cascaded again).
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t TimerWheel_Start(TimerWheel_Timer_t *pTimer, uint32_t DelayTicks, uint32_t PeriodTicks)
+{
+	uint32_t primask;
+
+	if ((pTimer == NULL) || (pTimer->State == TIMER_WHEEL_FREE) || (DelayTicks > TIMER_WHEEL_MAX_DELAY))
+	{
+		return TIMER_WHEEL_ERR_PARAM;
+	}
+
+	if (DelayTicks == 0)
+	{
+		DelayTicks = 1;
+	}
+
+	primask = NVIC_EnterCriticalAll();
+
+	if (pTimer->State == TIMER_WHEEL_ARMED)
+	{
+		TimerWheel_Unlink(pTimer);
+	}
+
+	pTimer->Expires = wheelTime + DelayTicks - 1;
+	pTimer->Period = PeriodTicks;
+	pTimer->State = TIMER_WHEEL_ARMED;
+	TimerWheel_Link(pTimer);
+
+	NVIC_ExitCriticalAll(primask);
+
+	return TIMER_WHEEL_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Stop
+ * Description	:	To disarm a timer
+ * Parameter 1	:	Pointer to the timer
+ * Return Type	:	none (void)
+ * Note		:	O(1). Can be called from any callback, also for a timer expiring in the same tick.
+ * ------------------------------------------------------------------------------------------------------ */
+void TimerWheel_Stop(TimerWheel_Timer_t *pTimer)
+{
+	uint32_t primask;
+
+	if (pTimer == NULL)
+	{
+		return;
+	}
+
+	primask = NVIC_EnterCriticalAll();
+
+	if (pTimer->State == TIMER_WHEEL_ARMED)
+	{
+		TimerWheel_Unlink(pTimer);
+		pTimer->State = TIMER_WHEEL_IDLE;
+	}
+
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_IsArmed
+ * Description	:	To know if a timer is armed
+ * Parameter 1	:	Pointer to the timer
+ * Return Type	:	uint8_t (1: armed, 0: idle or free)
+ * Note		:	A one-shot timer is disarmed before its callback runs: it can be re-armed from it.
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t TimerWheel_IsArmed(const TimerWheel_Timer_t *pTimer)
+{
+	return (pTimer != NULL) && (pTimer->State == TIMER_WHEEL_ARMED);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Tick
+ * Description	:	To advance the wheel by one tick
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	Installed on the SysTick hook by TimerWheel_Init.
+ *			Steps: cascade (every 64 ticks), then run the timers of the current level 0 slot.
+ *			The slot is moved to a local list first: callbacks may start, stop or delete any
+ *			timer (also one of this list). Interrupts are unmasked while a callback runs.
+ *			Runs from SRAM (__RAMFUNC) with its helpers: no Flash wait states in the tick path.
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC void TimerWheel_Tick(void)
+{
+	TimerWheel_Timer_t *expired;
+	TimerWheel_Timer_t *pTimer;
+	TimerWheel_Callback_t callback;
+	void *pArg;
+	uint32_t index;
+	uint32_t primask = NVIC_EnterCriticalAll();
+
+	/* -Step 1. Level 0 wraps: move the current slot of the next level(s) down- */
+	index = wheelTime & TIMER_WHEEL_SLOT_MASK;
+
+	if (index == 0)
+	{
+		for (uint8_t level = 1; level < TIMER_WHEEL_LEVELS; level++)
+		{
+			uint32_t levelIndex = (wheelTime >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+
+			TimerWheel_Cascade(level, levelIndex);
+
+			if (levelIndex != 0)
+			{
+				break;
+			}
+		}
+	}
+
+	wheelTime++;
+
+	/* -Step 2. Expired timers: this slot, moved to a local list- */
+	expired = wheel[0][index];
+	wheel[0][index] = NULL;
+	if (expired != NULL)
+	{
+		expired->pPrevNext = &expired;
+	}
+
+	/* -Step 3. Re-arm (periodic) or disarm (one-shot), then call back- */
+	while (expired != NULL)
+	{
+		pTimer = expired;
+		TimerWheel_Unlink(pTimer);
+		pTimer->State = TIMER_WHEEL_IDLE;
+
+		if (pTimer->Period != 0)
+		{
+			pTimer->Expires += pTimer->Period;
+			pTimer->State = TIMER_WHEEL_ARMED;
+			TimerWheel_Link(pTimer);
+		}
+
+		callback = pTimer->Callback;
+		pArg = pTimer->pArg;
+
+		if (callback != NULL)
+		{
+			NVIC_ExitCriticalAll(primask);
+			callback(pArg);
+			primask = NVIC_EnterCriticalAll();
+		}
+	}
+
+	NVIC_ExitCriticalAll(primask);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Now
+ * Description	:	To get the wheel time
+ * Parameters	:	none
+ * Return Type	:	(uint32_t) ticks processed since TimerWheel_Init
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t TimerWheel_Now(void)
+{
+	return wheelTime;
+}
+
+
+/* --Helper Functions-- */
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Link
+ * Description	:	Helper Functions
+ * Parameters	:	Pointer to the timer (Expires set)
+ * Return Type	:	none (void)
+ * Note		:	To insert a timer at the lowest level covering its remaining time (O(1)).
+ *			Already expired: current level 0 slot (next tick). Beyond the wheel: farthest slot
+ *			of the last level, cascaded again later.
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC static void TimerWheel_Link(TimerWheel_Timer_t *pTimer)
+{
+	TimerWheel_Timer_t **pHead;
+	uint32_t expires = pTimer->Expires;
+	uint32_t delta = expires - wheelTime;
+	uint8_t level = 0;
+
+	if ((int32_t)delta < 0)
+	{
+		expires = wheelTime;
+	}
+	else if (delta > TIMER_WHEEL_MAX_DELAY)
+	{
+		expires = wheelTime + TIMER_WHEEL_MAX_DELAY;
+		level = TIMER_WHEEL_LEVELS - 1;
+	}
+	else
+	{
+		while (delta >= (1UL << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+		{
+			level++;
+		}
+	}
+
+	pHead = &wheel[level][(expires >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK];
+
+	pTimer->pNext = *pHead;
+	if (*pHead != NULL)
+	{
+		(*pHead)->pPrevNext = &pTimer->pNext;
+	}
+	*pHead = pTimer;
+	pTimer->pPrevNext = pHead;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Unlink
+ * Description	:	Helper Functions
+ * Parameters	:	Pointer to the timer (linked)
+ * Return Type	:	none (void)
+ * Note		:	To remove a timer from its list (O(1), no list head needed)
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC static void TimerWheel_Unlink(TimerWheel_Timer_t *pTimer)
+{
+	*pTimer->pPrevNext = pTimer->pNext;
+	if (pTimer->pNext != NULL)
+	{
+		pTimer->pNext->pPrevNext = pTimer->pPrevNext;
+	}
+
+	pTimer->pNext = NULL;
+	pTimer->pPrevNext = NULL;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	TimerWheel_Cascade
+ * Description	:	Helper Functions
+ * Parameters	:	Level [1 to TIMER_WHEEL_LEVELS - 1], slot index
+ * Return Type	:	none (void)
+ * Note		:	To re-insert all the timers of a slot (they move to lower levels)
+ * ------------------------------------------------------------------------------------------------------ */
+__RAMFUNC static void TimerWheel_Cascade(uint8_t Level, uint32_t Index)
+{
+	TimerWheel_Timer_t *pTimer = wheel[Level][Index];
+
+	wheel[Level][Index] = NULL;
+
+	while (pTimer != NULL)
+	{
+		TimerWheel_Timer_t *pNext = pTimer->pNext;
+
+		TimerWheel_Link(pTimer);
+		pTimer = pNext;
+	}
+}
@@ -5,182 +5,378 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "DS1307_RTC.h"
+#include "DS1307_Format.h"
+#include "DS1307_LowPower.h"
+#include "DS1307_Drift.h"
+#include "DS1307_Trim.h"
+#include "DS1307_Boot.h"
+#include "stm32f407xx_rcc_drivers.h"
+#include "stm32f407xx_flash_drivers.h"
+#include "stm32f407xx_dwt_drivers.h"
+#include "stm32f407xx_nvic_drivers.h"
+#include "stm32f407xx_systick_drivers.h"
+#include "timer_wheel.h"
+#include "mem_pool.h"
+#include "sysmem.h"
+#include "stm32f407xx_itm_drivers.h"
+#include "dlog.h"
+#include "DS1307_Stream.h"
+#include "RTC_Device.h"
 
 /* -- To initialize the semi-hosting features -- */
 extern void initialise_monitor_handles(void);
 
-/* -- Helper Functions -- */
-char* get_DayofWeek(uint8_t day);			// To get current day of the week
-char* Time_to_String(RTC_Time_h *pRTCTime); 		// To convert time information into a string [hh:mm:ss]
-char* Date_to_String(RTC_Date_h *pRTCDate); 		// To convert date information into a string [dd-mm-yy]
+/* -- To compare DS1307/I2C code paths with the Flash ART accelerator OFF and ON -- */
+static void Benchmark_FlashART(void);
+
+#ifdef USE_ITM_TRACE
+/* -- Deferred log transport: records sent as they are on their own stimulus port -- */
+static void DLog_ITMSink(const uint8_t *pRecord, uint32_t Len);
+#endif
+
+/* -- Software timer callback (SysTick interrupt context): counts the heartbeats -- */
+static void Heartbeat_Callback(void *pArg);
 
 
 int main(void)
 {
+	// Reset to main() in HCLK cycles: DWT cycle counter started by Reset_Handler, core on HSI until here
+	uint32_t bootCycles = DWT_GetCycles();
 
-	/* -- To enable Semi-Hosting [before using any printfs] -- */
+	/* -- To enable Semi-Hosting [before using any printfs] (no-op when built with USE_ITM_TRACE) -- */
 	initialise_monitor_handles();
 
+#ifdef USE_ITM_TRACE
+	/* -- printf through the ITM/SWO instead (syscalls.c): no CPU halt per call, drops counted -- */
+	ITM_Init(ITM_SWO_HZ);
+#endif
+
 	printf("DS1307 RTC: Basic Functionality. \n");
+	printf("Reset to main: %lu cycles (%lu us)\n", (unsigned long)bootCycles,
+			(unsigned long)(bootCycles / (RCC_HSI_VALUE / 1000000U)));
+
+	// Run the core from HSE + PLL at 168 MHz (before any peripheral is initialized)
+	if (RCC_ClockConfig(&RCC_Config_PLL_168MHz) != RCC_OK)
+	{
+		printf("PLL Configuration Failed. [Running on HSI 16 MHz]\n");
+	}
+	printf("SYSCLK = %lu Hz, PCLK1 = %lu Hz\n", (unsigned long)RCC_SysClk_Value(), (unsigned long)RCC_Pclk1_Value());
+
+	// 1 ms time base and software timers (lowest priority: peripheral interrupts are never delayed)
+	SysTick_Init(SYSTICK_TICK_HZ, NVIC_PRIORITY_LOWEST);
+	TimerWheel_Init();
+
+	// Deferred log: records only on the target, formatted on the host (Tools/dlog_decode.py)
+	DLog_Init();
 
-	uint8_t initORfail;
+	// Fixed-size block pool (O(1), ISR safe) for driver buffers, e.g. the serial stream: malloc stays for newlib only
+	MemPool_Init();
+
+	// Stack overflow into the heap/.bss: MemManage fault instead of silent corruption
+	if (SysMem_StackGuardEnable() != SYSMEM_OK)
+	{
+		printf("MPU stack guard not enabled\n");
+	}
+
+	uint8_t bootType;
+	DS1307_Boot_Info_t bootInfo;
+	uint8_t timeFormat;
+	uint32_t epoch;
+	uint32_t firstStampCycles;
 
 	RTC_Date_h currentDate;
 	RTC_Time_h currentTime;
 
-	char *AMorPM;
+	// Caller provided buffers (DS1307_Format.h)
+	char timeBuff[DS1307_TIME_STR_LEN];
+	char dateBuff[DS1307_DATE_STR_LEN];
+	char isoBuff[DS1307_ISO8601_STR_LEN];
 
-	// Initialize DS1307
-	initORfail = DS1307_Init();
+	// Initialize DS1307: full init after power-on, I2C only after a software/watchdog reset (clock untouched)
+	bootType = DS1307_Boot_Init();
 
-	if (initORfail)
+	if (bootType == DS1307_BOOT_FAIL)
 	{
 		printf("DS1307 Initialization Failed. [Exit Manually]\n ");
 		while(1);
 	}
 
-	// Program current time and date
-	currentDate.date = 27;
-	currentDate.day = TUESDAY;
-	currentDate.month = 12;
-	currentDate.year = 22;		// JUST last 2 digits
-
-	currentTime.hours = 10;
-	currentTime.minutes = 25;
-	currentTime.seconds = 1;
-	currentTime.timeFormat = TIME_FORMAT_12H_PM;
+	// First timestamp (one burst read), cycles counted from reset by the DWT
+	epoch = DS1307_Get_Epoch(&timeFormat);
+	firstStampCycles = DWT_GetCycles();
+	DS1307_Boot_Save(epoch, timeFormat);
+	printf("%s boot: first timestamp %lu, %lu cycles after reset\n", (bootType == DS1307_BOOT_WARM) ? "Warm" : "Cold",
+		(unsigned long)epoch, (unsigned long)firstStampCycles);
 
-	/* -- Program Current Time and Date -- */
-	DS1307_Set_Current_Date(&currentDate);
-	DS1307_Set_Current_Time(&currentTime);
+	// Time lost (oscillator was stopped, or registers out of range): program it, a running clock is kept
+	DS1307_Boot_GetInfo(&bootInfo);
+	if (bootInfo.InitStatus != DS1307_INIT_OK)
+	{
+		printf("DS1307 time not valid (status %u): setting it\n", bootInfo.InitStatus);
+
+		// Program current time and date
+		currentDate.date = 27;
+		currentDate.day = TUESDAY;
+		currentDate.month = 12;
+		currentDate.year = 22;		// JUST last 2 digits
+
+		currentTime.hours = 10;
+		currentTime.minutes = 25;
+		currentTime.seconds = 1;
+		currentTime.timeFormat = TIME_FORMAT_12H_PM;
+
+		/* -- Program Current Time and Date -- */
+		DS1307_Set_Current_Date(&currentDate);
+		DS1307_Set_Current_Time(&currentTime);
+	}
 
 
 	/* -- Get Current Time and Date -- */
-	DS1307_Get_Current_Date(&currentDate);
-	DS1307_Get_Current_Time(&currentTime);
+	if (DS1307_Get_Current_DateTime(&currentDate, &currentTime) == 2)
+	{
+		printf("DS1307 not answering\n");
+	}
 
-	if (currentTime.timeFormat != TIME_FORMAT_24H)
+	// Print Time (with AM or PM details in 12 Hours Format)
+	DS1307_Format_Time(&currentTime, DS1307_FORMAT_AS_IS, timeBuff);
+	printf("Current time = %s\n", timeBuff);
+
+	// Print Date
+	DS1307_Format_Date(&currentDate, dateBuff);
+	printf("Current Date = %s <%s> \n", dateBuff, DS1307_DayName(currentDate.day));
+
+	// Print ISO-8601 Timestamp
+	DS1307_Format_ISO8601(&currentDate, &currentTime, isoBuff);
+	printf("ISO-8601     = %s\n", isoBuff);
+
+	// Idle operating point: HCLK / 8 (21 MHz, PCLK1 5.25 MHz), DS1307 I2C re-timed by its clock listener
+	if (RCC_SetHclkPrescaler(RCC_AHB_DIV8) == RCC_OK)
 	{
-		// Print Time with AM or PM details
-		if (currentTime.timeFormat == TIME_FORMAT_12H_PM)
-		{
-			// PM
-			AMorPM = "PM";
-		}
-		else
-		{
-			// AM
-			AMorPM = "AM";
-		}
+		DS1307_Get_Current_Time(&currentTime);
+		DS1307_Format_Time(&currentTime, DS1307_FORMAT_AS_IS, timeBuff);
+		printf("HCLK = %lu Hz: Current time = %s\n", (unsigned long)RCC_Hclk_Value(), timeBuff);
 
-		printf("Current time = %s %s\n", Time_to_String(&currentTime), AMorPM);
+		// Back to full speed
+		RCC_SetHclkPrescaler(RCC_AHB_DIV1);
 	}
-	else
+
+	Benchmark_FlashART();
+
+	/* -- Software timers: 100 ms periodic heartbeat over a 1 s delay (expected: 10) -- */
+	volatile uint32_t heartbeats = 0;
+	TimerWheel_Timer_t *pHeartbeat = TimerWheel_Create(Heartbeat_Callback, (void *)&heartbeats);
+
+	TimerWheel_Start(pHeartbeat, SysTick_MsToTicks(100), SysTick_MsToTicks(100));
+	SysTick_Delay(1000);
+	TimerWheel_Delete(pHeartbeat);
+	printf("Heartbeats in 1 s: %lu\n", (unsigned long)heartbeats);
+
+	/* -- MCU clock drift against the DS1307 crystal (32.768 kHz SQW, TIM4 input capture, 2 s window) -- */
+	DS1307_Drift_t drift;
+
+	if (DS1307_Drift_Measure(2, &drift) == DS1307_DRIFT_OK)
 	{
-		// 24 Hours Format
-		printf("Current time = %s\n", Time_to_String(&currentTime));
+		printf("TIM clock: nominal %lu Hz, measured %lu Hz (%ld ppm)\n", (unsigned long)drift.NominalHz,
+			(unsigned long)drift.MeasuredHz, (long)drift.ErrorPPM);
 	}
 
-	// Print Date
-	printf("Current Date = %s <%s> \n",Date_to_String(&currentDate), get_DayofWeek(currentDate.day));
+	/* -- DS1307 crystal drift tracking (state in the DS1307 NVRAM, DS1307_Trim_Sync on every external sync) -- */
+	DS1307_Trim_Info_t trimInfo;
+	uint16_t nowMs;
 
-	return 0;
-}
+	if (DS1307_Trim_Init() == DS1307_TRIM_NEW)
+	{
+		printf("Drift tracking: no state in NVRAM, waiting for two syncs\n");
+	}
 
+	DS1307_Trim_Service();
+	DS1307_Trim_GetInfo(&trimInfo);
+	printf("Drift %ld ppb, pending %ld ms, corrected epoch %lu", (long)trimInfo.DriftPPB, (long)trimInfo.PendingMs,
+		(unsigned long)DS1307_Trim_Now(&nowMs));
+	printf(".%03u s\n", nowMs);
 
-/* ------------------------------------------------------------------------------------------------------
- * Name		:	Number_to_String
- * Description	:	To convert number into string
- *
- * Parameter 1	:	number to convert (uint8_t)
- * Parameter 2	:	Buffer (char *)
- * Return Type	:	none (void)
- * Note		:
- * ------------------------------------------------------------------------------------------------------ */
-void Number_to_String(uint8_t number, char* buff)
-{
-	if (number < 10)
+#ifdef USE_ITM_TRACE
+	/* -- Time readings at full speed on their own stimulus port (ITM_PORT_TIME): I2C bound, not log bound -- */
+	uint32_t streamStart = DWT_GetCycles();
+
+	for (uint8_t reading = 0; reading < 100; reading++)
 	{
-		buff[0] = '0';
-		buff[1] = number + 48;	// ASCII
+		DS1307_Get_Current_DateTime(&currentDate, &currentTime);
+		DS1307_Format_ISO8601(&currentDate, &currentTime, isoBuff);
+		ITM_Write(ITM_PORT_TIME, isoBuff, strlen(isoBuff));
+		ITM_Write(ITM_PORT_TIME, "\n", 1);
 	}
-	else if (number >= 10 && number < 99)
+	printf("100 timestamps traced in %lu cycles, dropped bytes: stdout %lu, time %lu\n",
+		(unsigned long)(DWT_GetCycles() - streamStart), (unsigned long)ITM_GetDropCount(ITM_PORT_STDOUT),
+		(unsigned long)ITM_GetDropCount(ITM_PORT_TIME));
+#endif
+
+	/* -- Deferred log: 100 raw readings (7 registers, DWT timestamp), no formatting on the target -- */
+	uint8_t regs[7];
+	uint32_t logStart;
+	uint32_t logCycles = 0;
+	DLog_Stats_t logStats;
+
+	for (uint8_t reading = 0; reading < 100; reading++)
 	{
-		buff[0] = (number / 10) + 48;	// Split and add 48
-		buff[1] = (number % 10) + 48;
+		DS1307_Read_Burst(DS1307_SECONDS_ADDR, regs, sizeof(regs));
+
+		logStart = DWT_GetCycles();
+		DLOG_BYTES("DS1307 %02hhx:%02hhx:%02hhx day %hhx date %02hhx/%02hhx/%02hhx", regs, sizeof(regs));
+		logCycles += DWT_GetCycles() - logStart;
 
+#ifdef USE_ITM_TRACE
+		DLog_Drain(DLog_ITMSink);
+#endif
 	}
+	DLog_GetStats(&logStats);
+	printf("Deferred log: %lu cycles per record, %lu records, %lu dropped\n", (unsigned long)(logCycles / 100),
+		(unsigned long)logStats.Records, (unsigned long)logStats.Dropped);
 
-}
+	/* -- Serial time stream (USART2, DMA): timestamps queued, the RTC polling never waits for the line -- */
+	DS1307_Stream_Stats_t streamStats;
+	MemPool_Stats_t poolStats;
+	uint32_t streamCycles;
 
+	if (DS1307_Stream_Init(DS1307_STREAM_TEXT) == DS1307_STREAM_OK)
+	{
+		streamCycles = DWT_GetCycles();
+		for (uint8_t reading = 0; reading < 10; reading++)
+		{
+			DS1307_Stream_Timestamp();
+		}
+		streamCycles = DWT_GetCycles() - streamCycles;
 
-/* ------------------------------------------------------------------------------------------------------
- * Name		:	Time_to_String
- * Description	:	To convert time information from DS1307 into string
- *
- * Parameter 1	:	Handle pointer variable (RTC_Time_h)
- * Return Type	:	none (void)
- * Note		:	Also, converts string in hh:mm:ss format
- * ------------------------------------------------------------------------------------------------------ */
-char* Time_to_String(RTC_Time_h *pRTCTime)
-{
-	// Format -> hh:mm:ss [9 characters]
+		// On the line before STOP (USART clock halted while sleeping)
+		DS1307_Stream_Flush(0x00FFFFFFU);
+		DS1307_Stream_GetStats(&streamStats);
+		printf("Serial stream: %lu cycles per timestamp (I2C read included), %lu sent, %lu dropped\n",
+			(unsigned long)(streamCycles / 10), (unsigned long)streamStats.Timestamps, (unsigned long)streamStats.Dropped);
 
-	static char timeBuff[9];
+		// Not needed any more: TX/RX buffers back to the pool (guard words checked)
+		if (DS1307_Stream_DeInit() == DS1307_STREAM_ERR_OVERFLOW)
+		{
+			printf("Serial stream: buffer overrun detected\n");
+		}
+		MemPool_GetStats(MEMPOOL_CLASSES - 1, &poolStats);
+		printf("Memory pool: %u/%u large blocks in use (max %u)\n", (unsigned)poolStats.Used,
+			(unsigned)poolStats.BlockCount, (unsigned)poolStats.MaxUsed);
+	}
 
-	timeBuff[2] = ':';
-	timeBuff[5] = ':';
+	/* -- Common RTC interface: same calls on the DS1307 (I2C) or, built with USE_DS3234_RTC, the DS3234 (SPI) -- */
+	const RTC_Ops_t *pRTC = RTC_DEFAULT_OPS;
+	RTC_Date_h rtcDate;
+	RTC_Time_h rtcTime;
+	uint8_t nvram[16];
+	uint32_t rtcCycles;
+	uint8_t rtcStatus = RTC_Init(pRTC);
 
-	Number_to_String(pRTCTime->hours, timeBuff);
-	Number_to_String(pRTCTime->minutes, &timeBuff[3]);
-	Number_to_String(pRTCTime->seconds, &timeBuff[6]);
+	if (rtcStatus != RTC_ERR_DEVICE)
+	{
+		rtcCycles = DWT_GetCycles();
+		RTC_GetDateTime(pRTC, &rtcDate, &rtcTime);
+		rtcCycles = DWT_GetCycles() - rtcCycles;
+
+		// NVRAM left to the application only (DS1307: after the drift tracking record)
+		RTC_ReadNVRAM(pRTC, 0, nvram, (pRTC->NVRAMSize < sizeof(nvram)) ? pRTC->NVRAMSize : sizeof(nvram));
+		printf("%s: %lu cycles per date/time read, %u bytes NVRAM%s\n", pRTC->pName, (unsigned long)rtcCycles,
+			(unsigned int)pRTC->NVRAMSize, (rtcStatus == RTC_ERR_TIME_INVALID) ? " (time not set)" : "");
+	}
 
-	timeBuff[8] = '\0';
+	/* -- Sleep (STOP) until the next second: DS1307 1 Hz SQW wakes the MCU, no busy polling -- */
+	// Run clock restored on wake-up from HSI (no HSE start-up: lower wake latency)
+	DS1307_LP_Stats_t lpStats;
 
-	return timeBuff;
+	if (DS1307_LowPower_Init(DS1307_LP_STOP, &RCC_Config_PLL_HSI_168MHz) == 0)
+	{
+		for (uint8_t tick = 0; tick < 5; tick++)
+		{
+			DS1307_LowPower_WaitForTick();
+
+			DS1307_Get_Current_Time(&currentTime);
+			DS1307_Format_Time(&currentTime, DS1307_FORMAT_AS_IS, timeBuff);
+			DS1307_LowPower_GetStats(&lpStats);
+			printf("Tick %lu: %s (wake-to-ready %lu us, max %lu us, clock errors %lu)\n", (unsigned long)lpStats.TickCount,
+				timeBuff, (unsigned long)lpStats.LastWakeUs, (unsigned long)lpStats.MaxWakeUs,
+				(unsigned long)lpStats.ClockErrors);
+		}
+	}
+
+	// Stack/heap high-water marks of the whole run: margin left in _Min_Stack_Size/_Min_Heap_Size
+	SysMem_Info_t memInfo;
 
+	SysMem_GetInfo(&memInfo);
+	printf("Stack: %lu/%lu bytes used, heap: %lu bytes used (%lu free), never used: %lu bytes\n",
+		(unsigned long)memInfo.StackUsed, (unsigned long)memInfo.StackSize, (unsigned long)memInfo.HeapUsed,
+		(unsigned long)memInfo.HeapFree, (unsigned long)memInfo.MinFree);
+
+	return 0;
 }
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	Date_to_String
- * Description	:	To convert date information from DS1307 into string
- *
- * Parameter 1	:	Handle pointer variable (RTC_Date_h)
+ * Name		:	Benchmark_FlashART
+ * Description	:	To measure (DWT cycle counter) a DS1307 read over I2C and a timestamp formatting,
+ *			with the Flash ART accelerator disabled and enabled
+ * Parameters	:	none
  * Return Type	:	none (void)
- * Note		:	Also, converts string in dd-mm-yy format
+ * Note		:	At 168 MHz (5 wait states) every Flash fetch that misses the ART costs 6 cycles.
+ *			The I2C read is mostly spent waiting on the bus (100 kHz), formatting is CPU bound.
  * ------------------------------------------------------------------------------------------------------ */
-char* Date_to_String(RTC_Date_h *pRTCDate)
+static void Benchmark_FlashART(void)
 {
-	// Format -> dd-mm-yy
-	static char dateBuff[9];
+	RTC_Date_h date;
+	RTC_Time_h time;
+	char buff[DS1307_TIMESTAMP_STR_LEN];
+	uint32_t start;
+	uint32_t i2cCycles;
+	uint32_t formatCycles;
 
-	dateBuff[2] = '-';
-	dateBuff[5] = '-';
+	DWT_CycleCounterInit();
 
-	Number_to_String(pRTCDate->date,dateBuff);
-	Number_to_String(pRTCDate->month,&dateBuff[3]);
-	Number_to_String(pRTCDate->year,&dateBuff[6]);
+	for (uint8_t art = DISABLE; art <= ENABLE; art++)
+	{
+		FLASH_ARTControl(art);
 
-	dateBuff[8] = '\0';
+		start = DWT_GetCycles();
+		DS1307_Get_Current_DateTime(&date, &time);
+		i2cCycles = DWT_GetCycles() - start;
 
-	return dateBuff;
+		start = DWT_GetCycles();
+		DS1307_Format_Timestamp(&date, &time, DS1307_FORMAT_24H, buff);
+		formatCycles = DWT_GetCycles() - start;
 
+		printf("ART %-3s (%u WS): DS1307 read = %lu cycles, format = %lu cycles\n", (art == ENABLE) ? "ON" : "OFF",
+			FLASH_GetLatency(), (unsigned long)i2cCycles, (unsigned long)formatCycles);
+	}
 }
 
 
 /* ------------------------------------------------------------------------------------------------------
- * Name		:	get_DayofWeek
- * Description	:	To get days of week
- *
- * Parameter 1	:	day (place) (uint8_t)
- * Return Type	:	day of week (char *)
- * Note		:
+ * Name		:	Heartbeat_Callback
+ * Description	:	Software timer callback: to count the heartbeats
+ * Parameters	:	Pointer to the counter (volatile uint32_t)
+ * Return Type	:	none (void)
+ * Note		:	SysTick interrupt context.
  * ------------------------------------------------------------------------------------------------------ */
-char* get_DayofWeek(uint8_t day)
+static void Heartbeat_Callback(void *pArg)
 {
-	char* Days[] = {"Sunday","Monday","Tuesday","Wednesday","Thursday","Friday","Saturday"};
+	(*(volatile uint32_t *)pArg)++;
+}
+
 
-	return Days[day - 1];
+#ifdef USE_ITM_TRACE
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	DLog_ITMSink
+ * Description	:	Deferred log sink: to send one record on ITM_PORT_DLOG
+ * Parameters	:	Pointer to the record, length in bytes
+ * Return Type	:	none (void)
+ * Note		:	Bytes dropped by the ITM are skipped by dlog_decode.py (resync on the next header).
+ * ------------------------------------------------------------------------------------------------------ */
+static void DLog_ITMSink(const uint8_t *pRecord, uint32_t Len)
+{
+	ITM_Write(ITM_PORT_DLOG, (const char *)pRecord, Len);
 }
+#endif
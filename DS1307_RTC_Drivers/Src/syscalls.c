@@ -7,6 +7,13 @@
  *            For more information about which c-functions
  *            need which of these lowlevel functions
  *            please consult the Newlib libc-manual
+ *
+ *            Built with USE_ITM_TRACE: stdout/stderr go to the ITM stimulus
+ *            ports (SWO) instead of semihosting. The project then compiles
+ *            this file and links with nosys.specs only (no rdimon.specs,
+ *            no -lrdimon): initialise_monitor_handles() below is a no-op.
+ *            Build configuration Debug_ITM does all three; Debug keeps
+ *            semihosting (this file excluded, rdimon linked)
  ******************************************************************************
  * @attention
  *
@@ -29,6 +36,9 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#ifdef USE_ITM_TRACE
+#include "stm32f407xx_itm_drivers.h"
+#endif
 
 
 /* Variables */
@@ -77,6 +87,24 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
   return len;
 }
 
+#ifdef USE_ITM_TRACE
+/**
+ * @brief Writes stdout (port ITM_PORT_STDOUT) and stderr (ITM_PORT_STDERR)
+ *        to the ITM without blocking
+ *
+ * Bytes that do not fit in the stimulus FIFO are dropped and counted
+ * (ITM_GetDropCount): 'len' is always returned so newlib never retries.
+ * ITM_Init() MUST be called first (or the debugger must enable the ITM).
+ */
+int _write(int file, char *ptr, int len)
+{
+  if (len > 0)
+  {
+    (void)ITM_Write((file == 2) ? ITM_PORT_STDERR : ITM_PORT_STDOUT, ptr, (uint32_t)len);
+  }
+  return len;
+}
+#else
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
   (void)file;
@@ -88,6 +116,7 @@ __attribute__((weak)) int _write(int file, char *ptr, int len)
   }
   return len;
 }
+#endif /* USE_ITM_TRACE */
 
 int _close(int file)
 {
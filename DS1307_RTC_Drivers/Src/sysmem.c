@@ -23,6 +23,8 @@
 /* Includes */
 #include <errno.h>
 #include <stdint.h>
+#include "stm32f407xx.h"
+#include "sysmem.h"
 
 /**
  * Pointer to the current high watermark of the heap usage
@@ -38,12 +40,14 @@ static uint8_t *__sbrk_heap_end = NULL;
  * #  .data  #  .bss  #       newlib heap       #          MSP stack          #
  * #         #        #                         # Reserved by _Min_Stack_Size #
  * ############################################################################
- * ^-- RAM start      ^-- _end                             _estack, RAM end --^
+ * ^-- RAM start      ^-- _end                  ^-- _sstack  _estack, RAM end --^
  * @endverbatim
  *
  * This implementation starts allocating at the '_end' linker symbol
  * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
  * The implementation considers '_estack' linker symbol to be RAM end
+ * The '_heap_limit' linker symbol is '_estack' - '_Min_Stack_Size', or RAM end
+ * when the MSP stack is linked into CCMRAM (_STACK_IN_CCMRAM)
  * NOTE: If the MSP stack, at any point during execution, grows larger than the
  * reserved size, please increase the '_Min_Stack_Size'.
  *
@@ -53,10 +57,8 @@ static uint8_t *__sbrk_heap_end = NULL;
 void *_sbrk(ptrdiff_t incr)
 {
   extern uint8_t _end; /* Symbol defined in the linker script */
-  extern uint8_t _estack; /* Symbol defined in the linker script */
-  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
-  const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
-  const uint8_t *max_heap = (uint8_t *)stack_limit;
+  extern uint8_t _heap_limit; /* Symbol defined in the linker script */
+  const uint8_t *max_heap = &_heap_limit;
   uint8_t *prev_heap_end;
 
   /* Initialize heap end at first call */
@@ -77,3 +79,146 @@ void *_sbrk(ptrdiff_t incr)
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * MPU stack guard state (see SysMem_StackGuardEnable)
+ */
+static uint8_t sysmemGuardEnabled = 0;
+
+/**
+ * @brief Returns the stack high-water mark
+ *
+ * Scans the reserved stack from '_sstack' (from the end of the guard when
+ * the MPU stack guard is enabled: no access) up to the first word that no
+ * longer holds SYSMEM_STACK_PAINT, painted by Reset_Handler.
+ * A word pushed with the paint value itself reads as unused: the result may
+ * be up to a few words low, keep a margin when shrinking '_Min_Stack_Size'.
+ *
+ * @return Bytes of the reserved stack used since reset
+ */
+uint32_t SysMem_StackUsed(void)
+{
+  extern uint8_t _sstack; /* Symbol defined in the linker script */
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  const uint32_t *p = (const uint32_t *)&_sstack;
+  const uint32_t *end = (const uint32_t *)&_estack;
+
+  if (sysmemGuardEnabled)
+  {
+    p += SYSMEM_GUARD_SIZE / sizeof(uint32_t);
+  }
+
+  while ((p < end) && (*p == SYSMEM_STACK_PAINT))
+  {
+    p++;
+  }
+
+  return (uint32_t)(end - p) * sizeof(uint32_t);
+}
+
+/**
+ * @brief Returns the current heap end (next address _sbrk hands out)
+ *
+ * @return '__sbrk_heap_end', '_end' before the first _sbrk
+ */
+uint32_t SysMem_HeapEnd(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+
+  return (uint32_t)((NULL == __sbrk_heap_end) ? &_end : __sbrk_heap_end);
+}
+
+/**
+ * @brief Fills the stack and heap usage
+ *
+ * Stack and heap never shrink in their free space since reset (high-water
+ * mark, newlib does not give memory back through _sbrk): the free values are
+ * the minimum free memory since reset. With the guard enabled, its
+ * SYSMEM_GUARD_SIZE bytes count as neither used nor free.
+ *
+ * @param pInfo Pointer to memory usage (filled)
+ */
+void SysMem_GetInfo(SysMem_Info_t *pInfo)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  extern uint8_t _heap_limit; /* Symbol defined in the linker script */
+  extern uint8_t _sstack; /* Symbol defined in the linker script */
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  uint32_t guard = sysmemGuardEnabled ? SYSMEM_GUARD_SIZE : 0;
+
+  pInfo->StackSize = (uint32_t)(&_estack - &_sstack);
+  pInfo->StackUsed = SysMem_StackUsed();
+  pInfo->StackFree = pInfo->StackSize - guard - pInfo->StackUsed;
+
+  pInfo->HeapEnd = SysMem_HeapEnd();
+  pInfo->HeapUsed = pInfo->HeapEnd - (uint32_t)&_end;
+  pInfo->HeapFree = (uint32_t)&_heap_limit - pInfo->HeapEnd;
+
+  pInfo->MinFree = pInfo->StackFree + pInfo->HeapFree;
+}
+
+/**
+ * @brief Protects the bottom SYSMEM_GUARD_SIZE bytes of the stack with the
+ *        MPU (no access, execute never): an overflow raises a MemManage
+ *        fault instead of overwriting the heap/.bss below
+ *
+ * Region SYSMEM_GUARD_REGION, default memory map everywhere else
+ * (PRIVDEFENA). The guard bytes MUST still be painted (never used).
+ * NOTE: the fault is taken on the overflowed stack: the MemManage/HardFault
+ * handlers must not push anything (Default_Handler loops in place).
+ *
+ * @return SYSMEM_OK, SYSMEM_ERR_NO_MPU, SYSMEM_ERR_ALIGN or SYSMEM_ERR_USED
+ */
+uint8_t SysMem_StackGuardEnable(void)
+{
+  extern uint8_t _sstack; /* Symbol defined in the linker script */
+  const uint32_t *p = (const uint32_t *)&_sstack;
+
+  if (((*MPU_TYPE >> 8) & 0xFF) == 0)
+  {
+    return SYSMEM_ERR_NO_MPU;
+  }
+
+  if ((uint32_t)p & (SYSMEM_GUARD_SIZE - 1))
+  {
+    return SYSMEM_ERR_ALIGN;
+  }
+
+  for (uint32_t i = 0; i < (SYSMEM_GUARD_SIZE / sizeof(uint32_t)); i++)
+  {
+    if (p[i] != SYSMEM_STACK_PAINT)
+    {
+      return SYSMEM_ERR_USED;
+    }
+  }
+
+  __asm volatile ("dmb" ::: "memory");
+  *MPU_CTRL = 0;
+
+  *MPU_RNR = SYSMEM_GUARD_REGION;
+  *MPU_RBAR = (uint32_t)p;
+  *MPU_RASR = (1U << MPU_RASR_XN) | (0U << MPU_RASR_AP) |
+              ((uint32_t)(__builtin_ctz(SYSMEM_GUARD_SIZE) - 1) << MPU_RASR_SIZE) | (1U << MPU_RASR_ENABLE);
+
+  *SCB_SHCSR |= (1U << SCB_SHCSR_MEMFAULTENA);
+  *MPU_CTRL = (1U << MPU_CTRL_PRIVDEFENA) | (1U << MPU_CTRL_ENABLE);
+  __asm volatile ("dsb\n\tisb" ::: "memory");
+
+  sysmemGuardEnabled = 1;
+
+  return SYSMEM_OK;
+}
+
+/**
+ * @brief Removes the MPU stack guard (the MPU is turned off: no other user)
+ */
+void SysMem_StackGuardDisable(void)
+{
+  __asm volatile ("dmb" ::: "memory");
+  *MPU_CTRL = 0;
+  *MPU_RNR = SYSMEM_GUARD_REGION;
+  *MPU_RASR = 0;
+  __asm volatile ("dsb\n\tisb" ::: "memory");
+
+  sysmemGuardEnabled = 0;
+}
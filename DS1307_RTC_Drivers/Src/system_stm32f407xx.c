@@ -0,0 +1,39 @@
+/*
+ *
+ *									 system_stm32f407xx.c
+ *
+ *  SystemInit: called by Reset_Handler (startup_stm32f407vgtx.s) before .data/.bss are initialized
+ *  and before main. It MUST NOT use global/static variables.
+ *
+ */
+
+#include <stm32f407xx.h>
+#include <stm32f407xx_rcc_drivers.h>
+#include <stm32f407xx_flash_drivers.h>
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SystemInit
+ * Description	:	Early core and Flash interface setup
+ * Parameters	:	none
+ * Return Type	:	none (void)
+ * Note		:	Steps:
+ *			1. FPU full access (CP10, CP11): the project is built with -mfloat-abi=hard
+ *			2. Flash wait states for the reset clock (HSI 16 MHz)
+ *			3. ART accelerator ON (instruction cache, data cache, prefetch)
+ *
+ *			The PLL is started later by the application (RCC_ClockConfig), which raises the
+ *			wait states before the switch.
+ * ------------------------------------------------------------------------------------------------------ */
+void SystemInit(void)
+{
+	/* - Step 1: FPU - */
+	*SCB_CPACR |= (0x0FU << SCB_CPACR_CP10);
+	__asm volatile ("dsb\n\tisb" ::: "memory");
+
+	/* - Step 2: Flash Latency - */
+	FLASH_SetLatency(RCC_HSI_VALUE, FLASH_VRANGE_BOARD);
+
+	/* - Step 3: ART Accelerator - */
+	FLASH_ARTControl(ENABLE);
+}
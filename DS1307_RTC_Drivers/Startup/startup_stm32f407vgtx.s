@@ -41,6 +41,24 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* start address for the initialization values of the .ramfunc section.
+defined in linker script */
+.word _siramfunc
+/* start address for the .ramfunc section. defined in linker script */
+.word _sramfunc
+/* end address for the .ramfunc section. defined in linker script */
+.word _eramfunc
+/* start address for the initialization values of the .ccmram section.
+defined in linker script */
+.word _siccmram
+/* start address for the .ccmram section. defined in linker script */
+.word _sccmram
+/* end address for the .ccmram section. defined in linker script */
+.word _eccmram
+/* start address for the .ccmbss section. defined in linker script */
+.word _sccmbss
+/* end address for the .ccmbss section. defined in linker script */
+.word _eccmbss
 
 /**
  * @brief  This is the code that gets called when the processor first
@@ -57,6 +75,22 @@ defined in linker script */
 Reset_Handler:
   ldr   r0, =_estack
   mov   sp, r0          /* set stack pointer */
+/* Start the DWT cycle counter: main() reads the reset-to-main cycles from DWT_CYCCNT */
+  ldr r0, =0xE000EDFC   /* DEMCR */
+  ldr r1, [r0]
+  orr r1, r1, #0x01000000 /* TRCENA */
+  str r1, [r0]
+  ldr r0, =0xE0001000   /* DWT_CTRL */
+  movs r1, #0
+  str r1, [r0, #4]      /* DWT_CYCCNT = 0 */
+  ldr r1, [r0]
+  orr r1, r1, #1        /* CYCCNTENA */
+  str r1, [r0]
+/* Paint the reserved stack (nothing pushed yet): high-water mark, see SysMem_GetInfo */
+  ldr r0, =_sstack
+  ldr r1, =_estack
+  ldr r2, =0xA5A5A5A5   /* SYSMEM_STACK_PAINT */
+  bl FillWords
 /* Call the clock system initialization function.*/
   bl  SystemInit
 
@@ -64,32 +98,29 @@ Reset_Handler:
   ldr r0, =_sdata
   ldr r1, =_edata
   ldr r2, =_sidata
-  movs r3, #0
-  b LoopCopyDataInit
+  bl CopyWordsInit
 
-CopyDataInit:
-  ldr r4, [r2, r3]
-  str r4, [r0, r3]
-  adds r3, r3, #4
+/* Copy the RAM functions from flash to SRAM (nothing before this point may call a __RAMFUNC) */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  bl CopyWordsInit
 
-LoopCopyDataInit:
-  adds r4, r0, r3
-  cmp r4, r1
-  bcc CopyDataInit
+/* Copy the CCM-RAM data initializers from flash (CCM data RAM is clocked out of reset) */
+  ldr r0, =_sccmram
+  ldr r1, =_eccmram
+  ldr r2, =_siccmram
+  bl CopyWordsInit
 
 /* Zero fill the bss segment. */
-  ldr r2, =_sbss
-  ldr r4, =_ebss
-  movs r3, #0
-  b LoopFillZerobss
+  ldr r0, =_sbss
+  ldr r1, =_ebss
+  bl FillZeroWords
 
-FillZerobss:
-  str  r3, [r2]
-  adds r2, r2, #4
-
-LoopFillZerobss:
-  cmp r2, r4
-  bcc FillZerobss
+/* Zero fill the CCM-RAM bss segment. (.noinit is left untouched: kept across resets, no zeroing cost) */
+  ldr r0, =_sccmbss
+  ldr r1, =_eccmbss
+  bl FillZeroWords
 
 /* Call static constructors */
   bl __libc_init_array
@@ -101,6 +132,81 @@ LoopForever:
 
   .size Reset_Handler, .-Reset_Handler
 
+/**
+ * @brief  Copies words from flash to RAM, 8 words per LDM/STM burst then
+ *          one word at a time for the rest (sections are 4-byte aligned).
+ * @param  r0: destination start, r1: destination end, r2: source start
+ * @retval : None (clobbers r0, r2 to r10)
+*/
+  .section .text.CopyWordsInit,"ax",%progbits
+  .type CopyWordsInit, %function
+CopyWordsInit:
+  b LoopCopyBurst
+
+CopyBurst:
+  ldmia r2!, {r3-r10}
+  stmia r0!, {r3-r10}
+
+LoopCopyBurst:
+  add r3, r0, #32
+  cmp r3, r1
+  bls CopyBurst
+  b LoopCopyWord
+
+CopyWord:
+  ldr r3, [r2], #4
+  str r3, [r0], #4
+
+LoopCopyWord:
+  cmp r0, r1
+  bcc CopyWord
+  bx lr
+
+  .size CopyWordsInit, .-CopyWordsInit
+
+/**
+ * @brief  Fills words with zero (FillZeroWords) or a pattern (FillWords),
+ *          8 words per STM burst then one word at a time for the rest
+ *          (regions are 4-byte aligned). Uses no stack.
+ * @param  r0: start, r1: end, r2: pattern (FillWords only)
+ * @retval : None (clobbers r0, r2 to r10)
+*/
+  .section .text.FillZeroWords,"ax",%progbits
+  .type FillZeroWords, %function
+  .type FillWords, %function
+FillZeroWords:
+  movs r2, #0
+
+FillWords:
+  mov r3, r2
+  mov r4, r2
+  mov r5, r2
+  mov r6, r2
+  mov r7, r2
+  mov r8, r2
+  mov r9, r2
+  mov r10, r2
+  b LoopFillBurst
+
+FillBurst:
+  stmia r0!, {r3-r10}
+
+LoopFillBurst:
+  add r2, r0, #32
+  cmp r2, r1
+  bls FillBurst
+  b LoopFillWord
+
+FillWord:
+  str r3, [r0], #4
+
+LoopFillWord:
+  cmp r0, r1
+  bcc FillWord
+  bx lr
+
+  .size FillZeroWords, .-FillZeroWords
+
 /**
  * @brief  This is the code that gets called when the processor receives an
  *         unexpected interrupt.  This simply enters an infinite loop, preserving
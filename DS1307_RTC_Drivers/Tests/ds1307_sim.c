@@ -0,0 +1,190 @@
+/*
+ * 									ds1307_sim.c
+ *
+ *  This file contains the simulated DS1307 (see ds1307_sim.h) and the stubs of the other
+ *  driver calls made by DS1307_RTC.c (pins, peripheral set-up, clock listener).
+ *
+ */
+
+#include "ds1307_sim.h"
+#include "DS1307_RTC.h"
+#include "stm32f407xx_rcc_drivers.h"
+
+#include<string.h>
+
+static uint8_t simRegs[SIM_DS1307_REG_SIZE];
+static uint8_t simPointer;
+static uint32_t simTransfers;
+static uint32_t simFailFrom = SIM_DS1307_NO_FAIL;
+
+/* --Helper Functions-- */
+static uint8_t SimDS1307_Transfer(uint8_t SlaveAddress);
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SimDS1307_Reset
+ * Description	:	To clear the registers, the pointer, the transfer count and the bus error
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	All registers 0x00: clock running (CH cleared), 2000-01-00 (date 0 is out of range).
+ * ------------------------------------------------------------------------------------------------------ */
+void SimDS1307_Reset(void)
+{
+	memset(simRegs, 0, sizeof(simRegs));
+	simPointer = 0;
+	simTransfers = 0;
+	simFailFrom = SIM_DS1307_NO_FAIL;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SimDS1307_Registers
+ * Description	:	To access the register file directly
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint8_t * (SIM_DS1307_REG_SIZE registers, index = register address)
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t *SimDS1307_Registers(void)
+{
+	return simRegs;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SimDS1307_FailFrom
+ * Description	:	To make every transfer fail from the given transfer index on
+ *
+ * Parameter 1	:	Transfer index (counted from SimDS1307_Reset), SIM_DS1307_NO_FAIL: never
+ * Return Type	:	none (void)
+ * Note		:	A failed transfer returns I2C_ERR_NACK and does not touch the registers or the pointer.
+ * ------------------------------------------------------------------------------------------------------ */
+void SimDS1307_FailFrom(uint32_t Transfer)
+{
+	simFailFrom = Transfer;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SimDS1307_Transfers
+ * Description	:	To get the number of transfers since SimDS1307_Reset
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint32_t
+ * Note		:	Failed transfers included.
+ * ------------------------------------------------------------------------------------------------------ */
+uint32_t SimDS1307_Transfers(void)
+{
+	return simTransfers;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_MasterSendData
+ * Description	:	Simulated write transfer: register pointer, then data
+ *
+ * Parameter 1	:	Handle pointer variable (not used)
+ * Parameter 2	:	Bytes sent (pointer first)
+ * Parameter 3	:	Number of bytes
+ * Parameter 4	:	Slave address (DS1307_I2C_ADDR, others are not acknowledged)
+ * Parameter 5	:	Repeated start (not used)
+ * Return Type	:	uint8_t @I2C_STATUS
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t I2C_MasterSendData(I2C_Handle_t *pI2CHandle, uint8_t *pTxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
+{
+	uint8_t status = SimDS1307_Transfer(SlaveAddress);
+
+	if ((status != I2C_OK) || (LenOfData == 0))
+	{
+		return status;
+	}
+
+	simPointer = pTxBuffer[0] % SIM_DS1307_REG_SIZE;
+
+	for (uint32_t i = 1; i < LenOfData; i++)
+	{
+		simRegs[simPointer] = pTxBuffer[i];
+		simPointer = (simPointer + 1) % SIM_DS1307_REG_SIZE;
+	}
+
+	return I2C_OK;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	I2C_MasterReceiveData
+ * Description	:	Simulated read transfer from the register pointer
+ *
+ * Parameter 1	:	Handle pointer variable (not used)
+ * Parameter 2	:	Destination buffer
+ * Parameter 3	:	Number of bytes
+ * Parameter 4	:	Slave address (DS1307_I2C_ADDR, others are not acknowledged)
+ * Parameter 5	:	Repeated start (not used)
+ * Return Type	:	uint8_t @I2C_STATUS
+ * Note		:	none
+ * ------------------------------------------------------------------------------------------------------ */
+uint8_t I2C_MasterReceiveData(I2C_Handle_t *pI2CHandle, uint8_t *pRxBuffer, uint32_t LenOfData, uint8_t SlaveAddress, uint8_t repeatedStart)
+{
+	uint8_t status = SimDS1307_Transfer(SlaveAddress);
+
+	if (status != I2C_OK)
+	{
+		return status;
+	}
+
+	for (uint32_t i = 0; i < LenOfData; i++)
+	{
+		pRxBuffer[i] = simRegs[simPointer];
+		simPointer = (simPointer + 1) % SIM_DS1307_REG_SIZE;
+	}
+
+	return I2C_OK;
+}
+
+
+/* -- Stubs: no peripheral on the host -- */
+void I2C_Init(I2C_Handle_t *pI2CHandle)
+{
+}
+
+void I2C_PeripheralControl(I2C_RegDef_t *pI2Cx, uint8_t EnorDi)
+{
+}
+
+uint8_t I2C_UpdateTiming(I2C_Handle_t *pI2CHandle)
+{
+	return I2C_TIMING_OK;
+}
+
+void GPIO_InitMask(GPIO_RegDef_t *pGPIOx, uint16_t PinMask, GPIO_PinConfig_t *pPinConfig)
+{
+}
+
+uint8_t RCC_RegisterClockListener(RCC_ClockListener_t Listener)
+{
+	return RCC_OK;
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	SimDS1307_Transfer
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Slave address
+ * Return Type	:	uint8_t @I2C_STATUS
+ * Note		: Counts the transfer, NACK for another address or from the SimDS1307_FailFrom index on.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t SimDS1307_Transfer(uint8_t SlaveAddress)
+{
+	uint32_t transfer = simTransfers++;
+
+	if ((SlaveAddress != DS1307_I2C_ADDR) || (transfer >= simFailFrom))
+	{
+		return I2C_ERR_NACK;
+	}
+
+	return I2C_OK;
+}
@@ -0,0 +1,43 @@
+/*
+ * 									ds1307_sim.h
+ *
+ * Simulated DS1307 for the host tests: the I2C driver calls made by DS1307_RTC.c are answered
+ * from a 64-byte register file instead of the bus.
+ *
+ * 	> Write transfer	: first byte is the register pointer, the next bytes are written
+ * 	> Read transfer		: bytes read from the register pointer
+ * 	> Register pointer	: auto-increments, 0x3F wraps to 0x00 (data sheet)
+ * 	> Bus errors		: every transfer from a given index on fails (I2C_ERR_NACK)
+ *
+ * The clock does not advance: the registers only change when the driver writes them.
+ *
+ */
+
+#ifndef TESTS_DS1307_SIM_H_
+#define TESTS_DS1307_SIM_H_
+
+#include <stdint.h>
+
+/* -- Size of the DS1307 register file (time-keeper, control and NVRAM) -- */
+#define SIM_DS1307_REG_SIZE		64
+
+/* -- No bus error (SimDS1307_FailFrom) -- */
+#define SIM_DS1307_NO_FAIL		0xFFFFFFFFU
+
+
+/* -- APIs Supported by the simulated DS1307 -- */
+
+// To clear the registers, the pointer, the transfer count and the bus error
+void SimDS1307_Reset(void);
+
+// To access the register file directly (raw values, no I2C transfer)
+uint8_t *SimDS1307_Registers(void);
+
+// To make every transfer fail from the given transfer index on (0: the next one, SIM_DS1307_NO_FAIL: never)
+void SimDS1307_FailFrom(uint32_t Transfer);
+
+// To get the number of transfers since SimDS1307_Reset (failed ones included)
+uint32_t SimDS1307_Transfers(void);
+
+
+#endif /* TESTS_DS1307_SIM_H_ */
@@ -0,0 +1,775 @@
+/*
+ * 									test_ds1307_properties.c
+ *
+ * Host-run property tests of the BCD codec and of the DS1307 date/time encoding.
+ *
+ * 	> BCD codec	: every value 0-99 and every byte, against the original Binary_to_BCD and
+ * 			  BCD_to_Binary (kept below as the reference), packed and time-keeper variants
+ * 	> Hours		: every 12h/24h encoding through set/get, every raw hours register value
+ * 	> Dates		: every date of 2000-2099 through set/get and through the epoch APIs
+ * 	> Fuzzing	: random raw time-keeper registers (fixed seed: failures are reproducible)
+ * 	> Bus errors	: status of the getters and of DS1307_Init when the DS1307 does not answer
+ *
+ * The driver is the firmware source, unchanged. The I2C bus is replaced by the simulated DS1307
+ * (ds1307_sim.c). Build and run: "make -C Tests" (exit status 1 on any failure).
+ *
+ */
+
+#include "DS1307_RTC.h"
+#include "bcd_codec.h"
+#include "ds1307_sim.h"
+
+#include<stdarg.h>
+#include<stdint.h>
+#include<stdio.h>
+#include<string.h>
+
+/* -- Fuzzing: number of random register sets and seed -- */
+#define FUZZ_ITERATIONS			1000000U
+#define FUZZ_SEED			0x1307C0DEU
+
+/* -- Failures printed before the rest are only counted -- */
+#define MAX_PRINTED_FAILURES		20
+
+/* -- To check a property, the message is printf-like -- */
+#define CHECK(cond, ...)		do { checks++; if (!(cond)) { Test_Fail(__LINE__, __VA_ARGS__); } } while (0)
+
+static uint32_t checks;
+static uint32_t failures;
+static uint32_t fuzzState = FUZZ_SEED;
+
+/* --Helper Functions-- */
+static void Test_Fail(int line, const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+static uint8_t Ref_Binary_to_BCD(uint8_t value);
+static uint8_t Ref_BCD_to_Binary(uint8_t value);
+static uint8_t Ref_Days_In_Month(uint8_t month, uint8_t year);
+static uint8_t Ref_Day_Of_Week(uint8_t date, uint8_t month, uint8_t year);
+static uint8_t Ref_Decode_Hours(uint8_t value, uint8_t *pTimeFormat);
+static uint8_t Ref_Timekeeper_Valid(const uint8_t *pRegs);
+static uint32_t Fuzz_Next(void);
+static void Sim_Set_Valid_Date(void);
+static void Sim_Set_Valid_Time(void);
+
+/* -- Tests -- */
+static void Test_BCD_Codec(void);
+static void Test_BCD_Packed(void);
+static void Test_Hours(void);
+static void Test_Dates(void);
+static void Test_Fuzz_Registers(void);
+static void Test_Bus_Errors(void);
+
+
+int main(void)
+{
+	static const struct
+	{
+		const char *pName;
+		void (*pTest)(void);
+
+	}tests[] =
+	{
+		{"bcd_codec",		Test_BCD_Codec},
+		{"bcd_packed",		Test_BCD_Packed},
+		{"hours",		Test_Hours},
+		{"dates",		Test_Dates},
+		{"fuzz_registers",	Test_Fuzz_Registers},
+		{"bus_errors",		Test_Bus_Errors},
+	};
+	uint32_t totalFailures = 0;
+
+	for (uint32_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+	{
+		checks = 0;
+		failures = 0;
+		SimDS1307_Reset();
+
+		tests[i].pTest();
+
+		printf("%-16s %9lu checks, %lu failed\n", tests[i].pName, (unsigned long)checks, (unsigned long)failures);
+		totalFailures += failures;
+	}
+
+	printf("%s\n", totalFailures ? "FAILED" : "PASSED");
+
+	return totalFailures ? 1 : 0;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_BCD_Codec
+ * Description	:	BCD_Encode/BCD_Decode against the original conversions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	Encode: 0-99 round trip, 100-255 clamped to 0x99 (table never read past its end).
+ *			Decode: every byte, invalid digits included (same arithmetic as BCD_to_Binary).
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_BCD_Codec(void)
+{
+	for (uint32_t value = 0; value < 100; value++)
+	{
+		uint8_t bcd = BCD_Encode((uint8_t)value);
+
+		CHECK(bcd == Ref_Binary_to_BCD((uint8_t)value), "BCD_Encode(%lu) = 0x%02X", (unsigned long)value, bcd);
+		CHECK(BCD_Decode(bcd) == value, "BCD_Decode(BCD_Encode(%lu)) = %u", (unsigned long)value, BCD_Decode(bcd));
+		CHECK(Ref_BCD_to_Binary(bcd) == value, "BCD_to_Binary(BCD_Encode(%lu))", (unsigned long)value);
+	}
+
+	for (uint32_t value = 100; value < 256; value++)
+	{
+		CHECK(BCD_Encode((uint8_t)value) == 0x99, "BCD_Encode(%lu) not clamped", (unsigned long)value);
+	}
+
+	for (uint32_t bcd = 0; bcd < 256; bcd++)
+	{
+		CHECK(BCD_Decode((uint8_t)bcd) == Ref_BCD_to_Binary((uint8_t)bcd), "BCD_Decode(0x%02lX) = %u, expected %u",
+			(unsigned long)bcd, BCD_Decode((uint8_t)bcd), Ref_BCD_to_Binary((uint8_t)bcd));
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_BCD_Packed
+ * Description	:	SWAR variants against the byte conversions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	Every value in every lane (other lanes random), then random time-keeper sets.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_BCD_Packed(void)
+{
+	uint8_t bytes[4];
+	uint8_t regs[BCD_TIMEKEEPER_LEN];
+	uint8_t expected[BCD_TIMEKEEPER_LEN];
+	uint32_t word;
+
+	/* -Step 1. Every value in every lane of a word- */
+	for (uint32_t lane = 0; lane < 4; lane++)
+	{
+		for (uint32_t value = 0; value < 256; value++)
+		{
+			word = Fuzz_Next();
+			memcpy(bytes, &word, sizeof(bytes));
+			bytes[lane] = (uint8_t)value;
+			memcpy(&word, bytes, sizeof(word));
+
+			// a. Decode: any byte
+			uint32_t decoded = BCD_DecodePacked(word);
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				CHECK(((decoded >> (8 * i)) & 0xFF) == BCD_Decode(bytes[i]), "BCD_DecodePacked(0x%08lX) lane %lu",
+					(unsigned long)word, (unsigned long)i);
+			}
+
+			// b. Encode: 0 to 99 in every lane
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				bytes[i] = (i == lane) ? (uint8_t)(value % 100) : (uint8_t)(bytes[i] % 100);
+			}
+			memcpy(&word, bytes, sizeof(word));
+
+			uint32_t encoded = BCD_EncodePacked(word);
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				CHECK(((encoded >> (8 * i)) & 0xFF) == Ref_Binary_to_BCD(bytes[i]), "BCD_EncodePacked(0x%08lX) lane %lu",
+					(unsigned long)word, (unsigned long)i);
+			}
+		}
+	}
+
+	/* -Step 2. Seven time-keeper bytes at once (random)- */
+	for (uint32_t n = 0; n < 100000U; n++)
+	{
+		for (uint32_t i = 0; i < BCD_TIMEKEEPER_LEN; i++)
+		{
+			regs[i] = (uint8_t)Fuzz_Next();
+			expected[i] = Ref_BCD_to_Binary(regs[i]);
+		}
+		BCD_DecodeTimekeeper(regs);
+		CHECK(memcmp(regs, expected, sizeof(regs)) == 0, "BCD_DecodeTimekeeper (set %lu)", (unsigned long)n);
+
+		for (uint32_t i = 0; i < BCD_TIMEKEEPER_LEN; i++)
+		{
+			regs[i] = (uint8_t)(Fuzz_Next() % 100);
+			expected[i] = Ref_Binary_to_BCD(regs[i]);
+		}
+		BCD_EncodeTimekeeper(regs);
+		CHECK(memcmp(regs, expected, sizeof(regs)) == 0, "BCD_EncodeTimekeeper (set %lu)", (unsigned long)n);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_Hours
+ * Description	:	Every 12h/24h time through DS1307_Set_Current_Time/DS1307_Get_Current_Time
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	Hours register checked against the data sheet encoding (Bit[6] 12/24, Bit[5] AM/PM or
+ *			20-23 h). Then every raw hours register value decoded by the getter.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_Hours(void)
+{
+	static const uint8_t formats[] = {TIME_FORMAT_24H, TIME_FORMAT_12H_AM, TIME_FORMAT_12H_PM};
+	uint8_t *pRegs = SimDS1307_Registers();
+	RTC_Time_h set;
+	RTC_Time_h get;
+	uint8_t expected;
+	uint8_t status;
+
+	Sim_Set_Valid_Date();
+
+	/* -Step 1. Every hour of every format, with every minute and second value- */
+	for (uint32_t f = 0; f < sizeof(formats); f++)
+	{
+		uint8_t first = (formats[f] == TIME_FORMAT_24H) ? 0 : 1;
+		uint8_t last = (formats[f] == TIME_FORMAT_24H) ? 23 : 12;
+
+		for (uint8_t hours = first; hours <= last; hours++)
+		{
+			for (uint8_t sixty = 0; sixty < 60; sixty++)
+			{
+				set.hours = hours;
+				set.minutes = sixty;
+				set.seconds = (uint8_t)(59 - sixty);
+				set.timeFormat = formats[f];
+				DS1307_Set_Current_Time(&set);
+
+				expected = Ref_Binary_to_BCD(hours);
+				if (formats[f] != TIME_FORMAT_24H)
+				{
+					expected |= (1 << 6) | ((formats[f] == TIME_FORMAT_12H_PM) ? (1 << 5) : 0);
+				}
+				CHECK(pRegs[DS1307_HOURS_ADDR] == expected, "hours %u format %u: register 0x%02X, expected 0x%02X",
+					hours, formats[f], pRegs[DS1307_HOURS_ADDR], expected);
+				CHECK(pRegs[DS1307_MINUTES_ADDR] == Ref_Binary_to_BCD(sixty), "minutes %u: register 0x%02X",
+					sixty, pRegs[DS1307_MINUTES_ADDR]);
+				CHECK(pRegs[DS1307_SECONDS_ADDR] == Ref_Binary_to_BCD(59 - sixty), "seconds %u: register 0x%02X",
+					59 - sixty, pRegs[DS1307_SECONDS_ADDR]);
+
+				memset(&get, 0xFF, sizeof(get));
+				status = DS1307_Get_Current_Time(&get);
+				CHECK(status == 0, "%02u:%02u:%02u format %u: status %u", hours, sixty, 59 - sixty, formats[f], status);
+				CHECK(memcmp(&set, &get, sizeof(set)) == 0, "%02u:%02u:%02u format %u read back as %02u:%02u:%02u format %u",
+					hours, sixty, 59 - sixty, formats[f], get.hours, get.minutes, get.seconds, get.timeFormat);
+			}
+		}
+	}
+
+	/* -Step 2. Every raw hours register value (Bit[7] unused, invalid BCD included)- */
+	for (uint32_t raw = 0; raw < 256; raw++)
+	{
+		uint8_t refFormat;
+		uint8_t refHours = Ref_Decode_Hours((uint8_t)raw, &refFormat);
+
+		Sim_Set_Valid_Time();
+		pRegs[DS1307_HOURS_ADDR] = (uint8_t)raw;
+
+		status = DS1307_Get_Current_Time(&get);
+		CHECK((get.hours == refHours) && (get.timeFormat == refFormat), "hours register 0x%02lX: %u format %u, expected %u format %u",
+			(unsigned long)raw, get.hours, get.timeFormat, refHours, refFormat);
+		CHECK(status == (Ref_Timekeeper_Valid(pRegs) ? 0 : 3), "hours register 0x%02lX: status %u", (unsigned long)raw, status);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_Dates
+ * Description	:	Every date of 2000-2099 through set/get and through the epoch APIs
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	The epoch of each day is the previous one + 86400 (a different time of the day is set
+ *			each day). Also: DS1307_Days_In_Month, day of the week, first impossible date of each
+ *			month reported invalid (status 3).
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_Dates(void)
+{
+	uint8_t *pRegs = SimDS1307_Registers();
+	RTC_Date_h set;
+	RTC_Date_h get;
+	RTC_Time_h time;
+	uint32_t dayIndex = 0;
+	uint32_t epoch;
+	uint32_t readEpoch;
+	uint8_t timeFormat;
+	uint8_t status;
+
+	CHECK(DS1307_Days_In_Month(0, 0) == 0, "DS1307_Days_In_Month(0) not 0");
+	CHECK(DS1307_Days_In_Month(13, 0) == 0, "DS1307_Days_In_Month(13) not 0");
+
+	for (uint8_t year = 0; year < 100; year++)
+	{
+		for (uint8_t month = 1; month <= 12; month++)
+		{
+			uint8_t days = Ref_Days_In_Month(month, year);
+
+			CHECK(DS1307_Days_In_Month(month, year) == days, "DS1307_Days_In_Month(%u, %u) = %u, expected %u",
+				month, year, DS1307_Days_In_Month(month, year), days);
+
+			for (uint8_t date = 1; date <= days; date++, dayIndex++)
+			{
+				/* -Step 1. Set/get: registers and read back- */
+				Sim_Set_Valid_Time();
+				set.date = date;
+				set.month = month;
+				set.year = year;
+				set.day = Ref_Day_Of_Week(date, month, year);
+				DS1307_Set_Current_Date(&set);
+
+				CHECK((pRegs[DS1307_DATE_ADDR] == Ref_Binary_to_BCD(date)) && (pRegs[DS1307_MONTH_ADDR] == Ref_Binary_to_BCD(month)) &&
+					(pRegs[DS1307_YEAR_ADDR] == Ref_Binary_to_BCD(year)) && (pRegs[DS1307_DAY_ADDR] == set.day),
+					"20%02u-%02u-%02u: registers %02X %02X %02X %02X", year, month, date, pRegs[DS1307_DAY_ADDR],
+					pRegs[DS1307_DATE_ADDR], pRegs[DS1307_MONTH_ADDR], pRegs[DS1307_YEAR_ADDR]);
+
+				memset(&get, 0xFF, sizeof(get));
+				status = DS1307_Get_Current_Date(&get);
+				CHECK(status == 0, "20%02u-%02u-%02u: status %u", year, month, date, status);
+				CHECK(memcmp(&set, &get, sizeof(set)) == 0, "20%02u-%02u-%02u read back as 20%02u-%02u-%02u day %u",
+					year, month, date, get.year, get.month, get.date, get.day);
+
+				/* -Step 2. Epoch: set, read back, decoded date and day of the week- */
+				epoch = (dayIndex * 86400U) + ((dayIndex * 7919U) % 86400U);
+				timeFormat = (dayIndex & 1) ? TIME_FORMAT_12H_AM : TIME_FORMAT_24H;
+
+				CHECK(DS1307_Set_Epoch(epoch, timeFormat) == 0, "DS1307_Set_Epoch(%lu) failed", (unsigned long)epoch);
+				status = DS1307_Read_Epoch(&readEpoch, NULL);
+				CHECK((status == 0) && (readEpoch == epoch), "epoch %lu read back as %lu (status %u)",
+					(unsigned long)epoch, (unsigned long)readEpoch, status);
+
+				status = DS1307_Get_Current_DateTime(&get, &time);
+				CHECK((status == 0) && (memcmp(&set, &get, sizeof(set)) == 0), "epoch %lu: 20%02u-%02u-%02u day %u, expected 20%02u-%02u-%02u day %u",
+					(unsigned long)epoch, get.year, get.month, get.date, get.day, year, month, date, set.day);
+				CHECK(DS1307_DateTime_To_Epoch(&get, &time) == epoch, "epoch %lu: DS1307_DateTime_To_Epoch", (unsigned long)epoch);
+			}
+
+			/* -Step 3. First impossible date of the month (e.g. 29 February 2023, 31 April): invalid- */
+			if (days < 31)
+			{
+				Sim_Set_Valid_Time();
+				pRegs[DS1307_DAY_ADDR] = 1;
+				pRegs[DS1307_DATE_ADDR] = Ref_Binary_to_BCD(days + 1);
+				pRegs[DS1307_MONTH_ADDR] = Ref_Binary_to_BCD(month);
+				pRegs[DS1307_YEAR_ADDR] = Ref_Binary_to_BCD(year);
+				CHECK(DS1307_Get_Current_Date(&get) == 3, "20%02u-%02u-%02u not reported invalid", year, month, days + 1);
+			}
+		}
+	}
+
+	CHECK(dayIndex == 36525U, "%lu days in 2000-2099", (unsigned long)dayIndex);
+	CHECK((dayIndex * 86400U) - 1U == DS1307_EPOCH_MAX, "DS1307_EPOCH_MAX is not 2099-12-31 23:59:59");
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_Fuzz_Registers
+ * Description	:	Random raw time-keeper registers through the getters
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	Every field decoded as the reference does, status 3 exactly when the reference finds
+ *			the registers invalid. Valid sets: written back unchanged by the setters (Bit[7] of the
+ *			hours register is not kept) and the epoch converts back to the same date and time.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_Fuzz_Registers(void)
+{
+	uint8_t *pRegs = SimDS1307_Registers();
+	uint8_t raw[BCD_TIMEKEEPER_LEN];
+	RTC_Date_h date;
+	RTC_Date_h epochDate;
+	RTC_Time_h time;
+	RTC_Time_h epochTime;
+	uint32_t epoch;
+	uint8_t refFormat;
+	uint8_t valid;
+	uint8_t status;
+
+	for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++)
+	{
+		for (uint32_t i = 0; i < BCD_TIMEKEEPER_LEN; i++)
+		{
+			raw[i] = (uint8_t)Fuzz_Next();
+		}
+
+		// One set in two built in range (otherwise almost every set is invalid), then one byte in 16
+		// replaced by a random one and CH set one time in 16
+		if (n & 1)
+		{
+			uint8_t hours = (uint8_t)(Fuzz_Next() % 36);
+
+			raw[DS1307_SECONDS_ADDR] = Ref_Binary_to_BCD((uint8_t)(Fuzz_Next() % 60));
+			raw[DS1307_MINUTES_ADDR] = Ref_Binary_to_BCD((uint8_t)(Fuzz_Next() % 60));
+			raw[DS1307_HOURS_ADDR] = (hours < 24) ? Ref_Binary_to_BCD(hours) :
+				(uint8_t)(0x40 | ((hours & 1) ? 0x20 : 0) | Ref_Binary_to_BCD((uint8_t)(((hours - 24) % 12) + 1)));
+			raw[DS1307_DAY_ADDR] = (uint8_t)((Fuzz_Next() % 7) + 1);
+			raw[DS1307_DATE_ADDR] = Ref_Binary_to_BCD((uint8_t)((Fuzz_Next() % 31) + 1));
+			raw[DS1307_MONTH_ADDR] = Ref_Binary_to_BCD((uint8_t)((Fuzz_Next() % 12) + 1));
+			raw[DS1307_YEAR_ADDR] = Ref_Binary_to_BCD((uint8_t)(Fuzz_Next() % 100));
+
+			if ((Fuzz_Next() & 0x0F) == 0)
+			{
+				raw[Fuzz_Next() % BCD_TIMEKEEPER_LEN] = (uint8_t)Fuzz_Next();
+			}
+			if ((Fuzz_Next() & 0x0F) == 0)
+			{
+				raw[DS1307_SECONDS_ADDR] |= (1 << DS1307_SECONDS_CH);
+			}
+		}
+
+		memcpy(pRegs, raw, sizeof(raw));
+		valid = Ref_Timekeeper_Valid(raw);
+
+		/* -Step 1. Decoded fields and status- */
+		status = DS1307_Get_Current_DateTime(&date, &time);
+		CHECK(status == (valid ? 0 : 3), "registers %02X %02X %02X %02X %02X %02X %02X: status %u, expected %u",
+			raw[0], raw[1], raw[2], raw[3], raw[4], raw[5], raw[6], status, valid ? 0 : 3);
+		CHECK((time.seconds == Ref_BCD_to_Binary(raw[DS1307_SECONDS_ADDR] & 0x7F)) &&
+			(time.minutes == Ref_BCD_to_Binary(raw[DS1307_MINUTES_ADDR])) &&
+			(time.hours == Ref_Decode_Hours(raw[DS1307_HOURS_ADDR], &refFormat)) && (time.timeFormat == refFormat) &&
+			(date.day == Ref_BCD_to_Binary(raw[DS1307_DAY_ADDR])) && (date.date == Ref_BCD_to_Binary(raw[DS1307_DATE_ADDR])) &&
+			(date.month == Ref_BCD_to_Binary(raw[DS1307_MONTH_ADDR])) && (date.year == Ref_BCD_to_Binary(raw[DS1307_YEAR_ADDR])),
+			"registers %02X %02X %02X %02X %02X %02X %02X: decoded %u:%u:%u fmt %u %u %u-%u-%u", raw[0], raw[1], raw[2],
+			raw[3], raw[4], raw[5], raw[6], time.hours, time.minutes, time.seconds, time.timeFormat, date.day,
+			date.year, date.month, date.date);
+		CHECK(memcmp(pRegs, raw, sizeof(raw)) == 0, "registers changed by a read");
+
+		if (!valid)
+		{
+			continue;
+		}
+
+		/* -Step 2. Valid set: written back unchanged- */
+		memset(pRegs, 0, BCD_TIMEKEEPER_LEN);
+		DS1307_Set_Current_Date(&date);
+		DS1307_Set_Current_Time(&time);
+		raw[DS1307_HOURS_ADDR] &= 0x7F;
+		CHECK(memcmp(pRegs, raw, sizeof(raw)) == 0, "registers %02X %02X %02X %02X %02X %02X %02X written back as %02X %02X %02X %02X %02X %02X %02X",
+			raw[0], raw[1], raw[2], raw[3], raw[4], raw[5], raw[6], pRegs[0], pRegs[1], pRegs[2], pRegs[3], pRegs[4],
+			pRegs[5], pRegs[6]);
+
+		/* -Step 3. Epoch converts back to the same date and time (same format)- */
+		status = DS1307_Read_Epoch(&epoch, &refFormat);
+		CHECK((status == 0) && (epoch <= DS1307_EPOCH_MAX), "registers %02X %02X %02X: epoch %lu status %u",
+			raw[0], raw[1], raw[2], (unsigned long)epoch, status);
+
+		DS1307_Epoch_To_DateTime(epoch, &epochDate, &epochTime, refFormat);
+		CHECK((epochDate.date == date.date) && (epochDate.month == date.month) && (epochDate.year == date.year) &&
+			(memcmp(&epochTime, &time, sizeof(time)) == 0), "epoch %lu: %u-%u-%u %u:%u:%u fmt %u, expected %u-%u-%u %u:%u:%u fmt %u",
+			(unsigned long)epoch, epochDate.year, epochDate.month, epochDate.date, epochTime.hours, epochTime.minutes,
+			epochTime.seconds, epochTime.timeFormat, date.year, date.month, date.date, time.hours, time.minutes,
+			time.seconds, time.timeFormat);
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_Bus_Errors
+ * Description	:	Status of the getters and of DS1307_Init when the DS1307 does not answer
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		:	DS1307_Init with CH set: the burst read (2 transfers), the restart write (1) and the
+ *			check read (2) each made to fail.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_Bus_Errors(void)
+{
+	uint8_t *pRegs = SimDS1307_Registers();
+	RTC_Date_h date;
+	RTC_Time_h time;
+	uint32_t epoch = 1;
+	uint8_t timeFormat = TIME_FORMAT_12H_AM;
+
+	/* -Step 1. Getters- */
+	SimDS1307_Reset();
+	Sim_Set_Valid_Date();
+	Sim_Set_Valid_Time();
+	SimDS1307_FailFrom(0);
+
+	CHECK(DS1307_Get_Current_Time(&time) == 2, "DS1307_Get_Current_Time: no bus error");
+	CHECK(DS1307_Get_Current_Date(&date) == 2, "DS1307_Get_Current_Date: no bus error");
+	CHECK(DS1307_Get_Current_DateTime(&date, &time) == 2, "DS1307_Get_Current_DateTime: no bus error");
+	CHECK((DS1307_Read_Epoch(&epoch, &timeFormat) == 2) && (epoch == 0) && (timeFormat == TIME_FORMAT_24H),
+		"DS1307_Read_Epoch: epoch %lu format %u", (unsigned long)epoch, timeFormat);
+	CHECK(DS1307_Set_Epoch(0, TIME_FORMAT_24H) == 2, "DS1307_Set_Epoch: no bus error");
+
+	/* -Step 2. DS1307_Init, clock running and valid: one burst read, nothing written- */
+	SimDS1307_Reset();
+	Sim_Set_Valid_Date();
+	Sim_Set_Valid_Time();
+	CHECK(DS1307_Init() == DS1307_INIT_OK, "DS1307_Init: running clock not OK");
+	CHECK(SimDS1307_Transfers() == 2, "DS1307_Init: %lu transfers on a running clock", (unsigned long)SimDS1307_Transfers());
+
+	/* -Step 3. DS1307_Init, CH set: restarted, seconds kept- */
+	pRegs[DS1307_SECONDS_ADDR] = (1 << DS1307_SECONDS_CH) | 0x42;
+	CHECK(DS1307_Init() == DS1307_INIT_RESTARTED, "DS1307_Init: halted clock not restarted");
+	CHECK(pRegs[DS1307_SECONDS_ADDR] == 0x42, "DS1307_Init: seconds register 0x%02X after restart", pRegs[DS1307_SECONDS_ADDR]);
+
+	/* -Step 4. DS1307_Init, CH set, each transfer made to fail in turn- */
+	for (uint32_t fail = 0; fail < 5; fail++)
+	{
+		SimDS1307_Reset();
+		Sim_Set_Valid_Date();
+		Sim_Set_Valid_Time();
+		pRegs[DS1307_SECONDS_ADDR] |= (1 << DS1307_SECONDS_CH);
+		SimDS1307_FailFrom(fail);
+
+		uint8_t status = DS1307_Init();
+		CHECK(status == DS1307_INIT_ERR_BUS, "DS1307_Init: transfer %lu failed, status %u", (unsigned long)fail, status);
+	}
+}
+
+
+/* --Helper Functions-- */
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Test_Fail
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Line of the check
+ * Parameter 2	:	printf-like message
+ * Return Type	:	none (void)
+ * Note		: Counts the failure, prints the first MAX_PRINTED_FAILURES of each test.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Test_Fail(int line, const char *pFormat, ...)
+{
+	va_list args;
+
+	if (failures++ < MAX_PRINTED_FAILURES)
+	{
+		printf("  line %d: ", line);
+		va_start(args, pFormat);
+		vprintf(pFormat, args);
+		va_end(args);
+		printf("\n");
+	}
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_Binary_to_BCD
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	value (uint8_t)
+ * Return Type	:	BCD equivalent of provided binary value.(uint8_t)
+ * Note		: Reference: the original DS1307_RTC.c conversion (divide and modulo), kept verbatim.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_Binary_to_BCD(uint8_t value)
+{
+	uint8_t x;
+	uint8_t y;
+	uint8_t BCD;
+
+	if (value >= 10)
+	{
+		// a. Split the digits: example 10 -> [1][0]
+		x = value / 10;		// Integer division
+		y = value % 10;
+
+		// b.
+		BCD = (uint8_t) ((x << 4) | (y));
+	}
+	else
+	{
+		// BCD is equals to value
+		BCD = value;
+	}
+
+	return BCD;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_BCD_to_Binary
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	value (uint8_t)
+ * Return Type	:	Binary equivalent of provided BCD value.(uint8_t)
+ * Note		: Reference: the original DS1307_RTC.c conversion (multiply), kept verbatim.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_BCD_to_Binary(uint8_t value)
+{
+	uint8_t x;
+	uint8_t y;
+	uint8_t Binary;
+
+	x = (uint8_t) ((value >> 4) * 10);
+	y = (value & (uint8_t) 0x0F);			// Mask Bits[7:4] (they are x) and extract bits[3:0] -> y
+
+	Binary = x + y;
+
+	return Binary;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_Days_In_Month
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Month [1 to 12]
+ * Parameter 2	:	Year [0 to 99] (2000 to 2099)
+ * Return Type	:	uint8_t (28 to 31)
+ * Note		: Gregorian rule in full (2000 is a leap year, 2100 is out of range).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_Days_In_Month(uint8_t month, uint8_t year)
+{
+	uint32_t fullYear = 2000U + year;
+
+	if (month == 2)
+	{
+		return (((fullYear % 4) == 0) && (((fullYear % 100) != 0) || ((fullYear % 400) == 0))) ? 29 : 28;
+	}
+
+	return ((month == 4) || (month == 6) || (month == 9) || (month == 11)) ? 30 : 31;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_Day_Of_Week
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Date [1 to 31]
+ * Parameter 2	:	Month [1 to 12]
+ * Parameter 3	:	Year [0 to 99] (2000 to 2099)
+ * Return Type	:	uint8_t (SUNDAY to SATURDAY)
+ * Note		: Sakamoto's method, independent of the epoch arithmetic of the driver.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_Day_Of_Week(uint8_t date, uint8_t month, uint8_t year)
+{
+	static const uint8_t offset[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+	uint32_t y = 2000U + year - ((month < 3) ? 1U : 0U);
+
+	return (uint8_t)(((y + (y / 4) - (y / 100) + (y / 400) + offset[month - 1] + date) % 7) + SUNDAY);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_Decode_Hours
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Hours Register value (uint8_t)
+ * Parameter 2	:	Pointer to store Time Format (@TIME_FORMAT) (uint8_t *)
+ * Return Type	:	hours (binary) (uint8_t)
+ * Note		: Data sheet: Bit[6] HIGH -> 12-Hour, Bit[5] AM/PM. Bit[6] LOW -> 24-Hour, Bit[5] is the
+ *		  second 10-Hour bit. Bit[7] is always 0.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_Decode_Hours(uint8_t value, uint8_t *pTimeFormat)
+{
+	if (value & 0x40)
+	{
+		*pTimeFormat = (value & 0x20) ? TIME_FORMAT_12H_PM : TIME_FORMAT_12H_AM;
+		return Ref_BCD_to_Binary(value & 0x1F);
+	}
+
+	*pTimeFormat = TIME_FORMAT_24H;
+	return Ref_BCD_to_Binary(value & 0x3F);
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Ref_Timekeeper_Valid
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	Time-keeper registers, Seconds to Year (raw)
+ * Return Type	:	uint8_t (1: clock running and valid date and time, 0: otherwise)
+ * Note		: Written from the data sheet register map, not from DS1307_Check_Timekeeper.
+ * ------------------------------------------------------------------------------------------------------ */
+static uint8_t Ref_Timekeeper_Valid(const uint8_t *pRegs)
+{
+	uint8_t format;
+	uint8_t hoursBCD = pRegs[DS1307_HOURS_ADDR] & ((pRegs[DS1307_HOURS_ADDR] & 0x40) ? 0x1F : 0x3F);
+	uint8_t hours = Ref_Decode_Hours(pRegs[DS1307_HOURS_ADDR], &format);
+	uint8_t month = Ref_BCD_to_Binary(pRegs[DS1307_MONTH_ADDR]);
+	uint8_t bcd[BCD_TIMEKEEPER_LEN] =
+	{
+		pRegs[DS1307_SECONDS_ADDR], pRegs[DS1307_MINUTES_ADDR], hoursBCD, pRegs[DS1307_DAY_ADDR],
+		pRegs[DS1307_DATE_ADDR], pRegs[DS1307_MONTH_ADDR], pRegs[DS1307_YEAR_ADDR]
+	};
+
+	// a. Clock running (CH cleared)
+	if (pRegs[DS1307_SECONDS_ADDR] & 0x80)
+	{
+		return 0;
+	}
+
+	// b. BCD digits
+	for (uint32_t i = 0; i < BCD_TIMEKEEPER_LEN; i++)
+	{
+		if (((bcd[i] & 0x0F) > 9) || ((bcd[i] >> 4) > 9))
+		{
+			return 0;
+		}
+	}
+
+	// c. Ranges
+	if ((Ref_BCD_to_Binary(pRegs[DS1307_SECONDS_ADDR]) > 59) || (Ref_BCD_to_Binary(pRegs[DS1307_MINUTES_ADDR]) > 59))
+	{
+		return 0;
+	}
+	if ((format == TIME_FORMAT_24H) ? (hours > 23) : ((hours < 1) || (hours > 12)))
+	{
+		return 0;
+	}
+	if ((Ref_BCD_to_Binary(pRegs[DS1307_DAY_ADDR]) < 1) || (Ref_BCD_to_Binary(pRegs[DS1307_DAY_ADDR]) > 7) ||
+	    (month < 1) || (month > 12))
+	{
+		return 0;
+	}
+
+	// d. Date within the month
+	return (Ref_BCD_to_Binary(pRegs[DS1307_DATE_ADDR]) >= 1) &&
+		(Ref_BCD_to_Binary(pRegs[DS1307_DATE_ADDR]) <= Ref_Days_In_Month(month, Ref_BCD_to_Binary(pRegs[DS1307_YEAR_ADDR])));
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Fuzz_Next
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	uint32_t (pseudo-random)
+ * Note		: xorshift32, seeded with FUZZ_SEED (same sequence on every run).
+ * ------------------------------------------------------------------------------------------------------ */
+static uint32_t Fuzz_Next(void)
+{
+	fuzzState ^= fuzzState << 13;
+	fuzzState ^= fuzzState >> 17;
+	fuzzState ^= fuzzState << 5;
+
+	return fuzzState;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Sim_Set_Valid_Date
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: Raw registers of Tuesday 2022-12-27, written directly (no I2C transfer).
+ * ------------------------------------------------------------------------------------------------------ */
+static void Sim_Set_Valid_Date(void)
+{
+	uint8_t *pRegs = SimDS1307_Registers();
+
+	pRegs[DS1307_DAY_ADDR] = TUESDAY;
+	pRegs[DS1307_DATE_ADDR] = 0x27;
+	pRegs[DS1307_MONTH_ADDR] = 0x12;
+	pRegs[DS1307_YEAR_ADDR] = 0x22;
+}
+
+
+/* ------------------------------------------------------------------------------------------------------
+ * Name		:	Sim_Set_Valid_Time
+ * Description	:	Helper Functions
+ *
+ * Parameter 1	:	none (void)
+ * Return Type	:	none (void)
+ * Note		: Raw registers of 10:25:01 PM (12-Hour), clock running, written directly.
+ * ------------------------------------------------------------------------------------------------------ */
+static void Sim_Set_Valid_Time(void)
+{
+	uint8_t *pRegs = SimDS1307_Registers();
+
+	pRegs[DS1307_SECONDS_ADDR] = 0x01;
+	pRegs[DS1307_MINUTES_ADDR] = 0x25;
+	pRegs[DS1307_HOURS_ADDR] = 0x40 | 0x20 | 0x10;
+}
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+#
+#                                   dlog_decode.py
+#
+# Host side of the deferred log (Device_Drivers/Inc/dlog.h).
+#
+# The firmware never formats DLOG messages: every record carries the ID of its format string
+# (offset in the .dlog_fmt INFO section of the ELF), a DWT_CYCCNT timestamp and the raw
+# arguments. This tool reads the strings from the ELF and formats the records:
+#     header      ID [31:16], mark 0xA [15:12], type [11:8], payload bytes [7:0]
+#     timestamp   DWT_CYCCNT at the log site (HCLK cycles, wraps every 2^32 cycles)
+#     payload     type 0 (DLOG):       4 bytes per conversion
+#                 type 1 (DLOG_BYTES): %hh. 1 byte, %h. 2 bytes, others 4 bytes (little-endian)
+#
+# The input is the raw record stream, e.g. ITM stimulus port 3 (ITM_PORT_DLOG) saved by the
+# SWO viewer or probe software. Bytes that do not start a valid record are skipped (resync
+# after SWO drops) and counted.
+#
+# Usage (from the build configuration folder, e.g. Debug/):
+#     python3 ../Tools/dlog_decode.py --elf DS1307_RTC_Drivers.elf --input swo_port3.bin
+#     python3 ../Tools/dlog_decode.py --elf DS1307_RTC_Drivers.elf --list
+#
+# Only the Python 3 standard library is required.
+#
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION = '.dlog_fmt'
+
+DLOG_MARK = 0xA
+TYPE_WORDS, TYPE_BYTES = 0, 1
+HEADER_BYTES = 8
+
+# printf conversion: flags, width, precision, length modifier, conversion
+CONVERSION = re.compile(r'%(?P<spec>[-+ #0]*\d*(?:\.\d+)?)(?P<len>hh|h|ll|l|z|j|t)?(?P<conv>[diouxXc%])')
+
+LENGTH_BYTES = {'hh': 1, 'h': 2}
+
+
+def read_section(elf_path, name):
+    """ Returns the bytes of an ELF32 little-endian section (None if absent) """
+    with open(elf_path, 'rb') as elf_file:
+        elf = elf_file.read()
+    if elf[:4] != b'\x7fELF' or elf[4] != 1 or elf[5] != 1:
+        sys.exit('dlog_decode: {}: not an ELF32 little-endian file'.format(elf_path))
+
+    shoff, = struct.unpack_from('<I', elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+
+    def header(index):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from('<IIIIII', elf, shoff + index * shentsize)
+
+    names_offset = header(shstrndx)[4]
+    for index in range(shnum):
+        sh_name, _, _, _, offset, size = header(index)
+        end = elf.index(b'\0', names_offset + sh_name)
+        if elf[names_offset + sh_name:end].decode('ascii', 'replace') == name:
+            return elf[offset:offset + size]
+    return None
+
+
+def string_table(section):
+    """ Returns { ID (offset) : format string } """
+    table, offset = {}, 0
+    while offset < len(section):
+        end = section.find(b'\0', offset)
+        if end < 0:
+            end = len(section)
+        if end > offset:
+            table[offset] = section[offset:end].decode('utf-8', 'replace')
+        offset = end + 1
+    return table
+
+
+def format_record(fmt, rtype, payload):
+    """ printf-like formatting of the raw payload (values taken in order) """
+    position = 0
+
+    def convert(match):
+        nonlocal position
+        conv = match.group('conv')
+        if conv == '%':
+            return '%'
+        size = LENGTH_BYTES.get(match.group('len'), 4) if rtype == TYPE_BYTES else 4
+        if position + size > len(payload):
+            return '<missing>'
+        value = int.from_bytes(payload[position:position + size], 'little')
+        position += size
+        if conv in 'di' and value >= (1 << (8 * size - 1)):
+            value -= 1 << (8 * size)
+        if conv == 'c':
+            return ('%' + match.group('spec') + 'c') % chr(value & 0xFF)
+        return ('%' + match.group('spec') + ('d' if conv in 'diu' else conv)) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(stream, table):
+    """ Yields (cycles since the first record, message), then the number of bytes skipped """
+    offset, skipped = 0, 0
+    first, last, cycles = None, None, 0
+    while offset + HEADER_BYTES <= len(stream):
+        header, stamp = struct.unpack_from('<II', stream, offset)
+        fid, mark, rtype, length = header >> 16, (header >> 12) & 0xF, (header >> 8) & 0xF, header & 0xFF
+        size = HEADER_BYTES + ((length + 3) // 4) * 4
+        if mark != DLOG_MARK or rtype not in (TYPE_WORDS, TYPE_BYTES) or fid not in table or \
+                offset + size > len(stream):
+            offset += 1
+            skipped += 1
+            continue
+
+        # Signed modulo-2^32 step from the previous record: a forward step across 2^32 is a
+        # DWT_CYCCNT wrap, a small backward step is a record reserved before an interrupting one
+        # (DLog_Write reserves the slot, then reads DWT_CYCCNT)
+        if last is None:
+            cycles = stamp
+        else:
+            step = (stamp - last) & 0xFFFFFFFF
+            if step >= (1 << 31):
+                step -= 1 << 32
+            cycles += step
+        last = stamp
+        if first is None:
+            first = cycles
+
+        payload = stream[offset + HEADER_BYTES:offset + HEADER_BYTES + length]
+        yield cycles - first, format_record(table[fid], rtype, payload)
+        offset += size
+    yield None, skipped + (len(stream) - offset)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Formats deferred log (DLOG) records with the ELF strings.')
+    parser.add_argument('--elf', required=True, help='linked firmware image (.dlog_fmt section)')
+    parser.add_argument('--input', help="raw record stream ('-': stdin)")
+    parser.add_argument('--hz', type=int, default=168000000, help='HCLK of the timestamps (default 168 MHz)')
+    parser.add_argument('--list', action='store_true', help='print the string table and exit')
+    args = parser.parse_args()
+
+    section = read_section(args.elf, SECTION)
+    if section is None:
+        sys.exit('dlog_decode: {}: no {} section (linker script, DLOG sites)'.format(args.elf, SECTION))
+    table = string_table(section)
+
+    if args.list:
+        for fid in sorted(table):
+            print('{:5d}  {!r}'.format(fid, table[fid]))
+        return 0
+
+    if not args.input:
+        parser.error('--input is required (or --list)')
+    if args.input == '-':
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(args.input, 'rb') as input_file:
+            stream = input_file.read()
+
+    for cycles, message in decode(stream, table):
+        if cycles is None:
+            if message:
+                print('dlog_decode: {} byte(s) skipped (not a record)'.format(message), file=sys.stderr)
+            break
+        print('[{:12.6f}] {}'.format(cycles / args.hz, message))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+#
+#                                   footprint_report.py
+#
+# Flash and RAM footprint report for the DS1307_RTC_Drivers firmware.
+#
+# Parses the linker map file (-Wl,-Map) and attributes the bytes of every input section
+# to a module (DS1307 driver, I2C, GPIO, RCC, application, startup, newlib, ...) and to a
+# symbol (one input section per function/object thanks to -ffunction-sections and
+# -fdata-sections). Each entry is classified as:
+#     text     code                                    (FLASH)
+#     rodata   constants, vector table, init arrays    (FLASH)
+#     data     initialised variables                   (FLASH load image + RAM)
+#     bss      zero initialised / uninitialised data   (RAM)
+#
+# The result is compared with a committed baseline (footprint_baseline.txt). Growth in
+# the modules listed as 'hot' in footprint.cfg is flagged; see that file for the syntax.
+# A missing or empty baseline is reported (and fails the build with 'fail_on_growth'):
+# there is nothing to compare with until "make footprint-baseline" has been run.
+#
+# Usage (from the build configuration folder, e.g. Debug/):
+#     python3 ../Tools/footprint_report.py --map DS1307_RTC_Drivers.map \
+#             --config ../footprint.cfg --baseline ../footprint_baseline.txt
+#     python3 ../Tools/footprint_report.py --map DS1307_RTC_Drivers.map \
+#             --write-baseline ../footprint_baseline.txt
+#
+# Only the Python 3 standard library is required.
+#
+
+import argparse
+import os
+import re
+import sys
+
+# Start of the part of the map we are interested in
+MAP_START = 'Linker script and memory map'
+
+# Matches an output section header:   .text           0x080001b0     0x27d4
+# (long names put the address and size on the next line)
+OUTPUT_SECTION = re.compile(r'^(?P<name>\.\S+|/DISCARD/)(?:\s+0x(?P<addr>[0-9a-fA-F]+)\s+0x(?P<size>[0-9a-fA-F]+)(?P<load>\s+load address.*)?)?\s*$')
+
+# Matches an input section:   .text.DS1307_Init   0x08000290   0x2c ./DS1307_Drivers/DS1307_RTC.o
+# (long names put the address, size and file on the next line)
+INPUT_SECTION = re.compile(r'^ (?P<name>\.\S+|\*fill\*|COMMON)(?:\s+0x(?P<addr>[0-9a-fA-F]+)\s+0x(?P<size>[0-9a-fA-F]+)\s*(?P<file>.*))?$')
+
+# Matches the continuation line of a long section name:   0x08000290   0x2c ./DS1307_Drivers/DS1307_RTC.o
+CONTINUATION = re.compile(r'^\s+0x(?P<addr>[0-9a-fA-F]+)\s+0x(?P<size>[0-9a-fA-F]+)\s*(?P<file>.*)$')
+
+CLASSES = ('text', 'rodata', 'data', 'bss')
+
+# Output section -> class (anything else is classified from its address, see section_class())
+SECTION_CLASSES = {
+    '.isr_vector': 'rodata', '.text': 'text', '.rodata': 'rodata',
+    '.ARM.extab': 'rodata', '.ARM': 'rodata', '.preinit_array': 'rodata',
+    '.init_array': 'rodata', '.fini_array': 'rodata',
+    '.data': 'data', '.ramfunc': 'data', '.ccmram': 'data', '.bss': 'bss', '.ccmbss': 'bss',
+    '.noinit': 'bss',
+}
+
+# Output sections that only reserve memory (heap and stack): reported, not attributed
+RESERVED_SECTIONS = ('._user_heap_stack', '._ccm_stack')
+
+# Input file -> module, first match wins (paths are normalised to '/')
+MODULE_RULES = [
+    (re.compile(r'DS1307_Drivers/'), 'DS1307'),
+    (re.compile(r'Device_Drivers/Src/stm32f407xx_(\w+?)_drivers\.o$'), lambda m: m.group(1).upper()),
+    (re.compile(r'Device_Drivers/Src/(\w+)\.o$'), lambda m: m.group(1)),
+    (re.compile(r'Startup/'), 'startup'),
+    (re.compile(r'Src/(sysmem|syscalls)\.o$'), 'syscalls'),
+    (re.compile(r'Src/'), 'app'),
+    (re.compile(r'(librdimon\w*\.a|rdimon-crt0\.o)'), 'rdimon'),
+    (re.compile(r'(libc\w*\.a|libm\.a|libnosys\.a)'), 'newlib'),
+    (re.compile(r'(libgcc\.a|crt\w+\.o)'), 'libgcc'),
+    (re.compile(r'linker stubs'), 'libgcc'),
+]
+
+PADDING = '(padding)'
+
+
+def module_of(path):
+    path = path.replace('\\', '/')
+    for pattern, module in MODULE_RULES:
+        match = pattern.search(path)
+        if match:
+            return module(match) if callable(module) else module
+    return 'other'
+
+
+def object_of(path):
+    """ Short name of the object: 'DS1307_RTC.o' or 'lib_a-memset.o' for archive members """
+    path = path.replace('\\', '/')
+    member = re.search(r'\(([^)]+)\)$', path)
+    return member.group(1) if member else os.path.basename(path)
+
+
+def symbol_of(section, path):
+    """ '.text.DS1307_Init' -> 'DS1307_Init', '.rodata' of Src/app.o -> '.rodata(app.o)' """
+    for prefix in ('.text.', '.rodata.', '.data.', '.bss.'):
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return '{}({})'.format(section, object_of(path))
+
+
+def section_class(name, addr, loaded):
+    if name in SECTION_CLASSES:
+        return SECTION_CLASSES[name]
+    if addr is None:
+        return None
+    if 0x08000000 <= addr < 0x10000000:
+        return 'rodata'
+    if 0x10000000 <= addr < 0x30000000:
+        return 'data' if loaded else 'bss'
+    # Debug information and other sections that are not allocated in the target
+    return None
+
+
+def parse_map(path):
+    """ Returns ({ (module, class, symbol) : bytes }, reserved bytes of heap/stack) """
+    entries, reserved = {}, 0
+    with open(path, encoding='utf-8', errors='replace') as map_file:
+        lines = map_file.read().splitlines()
+    try:
+        lines = lines[lines.index(MAP_START) + 1:]
+    except ValueError:
+        sys.exit('footprint_report: {}: not a GNU ld map file'.format(path))
+
+    out_name, out_class, last_module = None, None, PADDING
+    index = 0
+    while index < len(lines):
+        line = lines[index]
+        index += 1
+        if line.startswith('OUTPUT('):
+            break
+
+        header = OUTPUT_SECTION.match(line)
+        if header:
+            out_name, addr, size, loaded = header.group('name'), header.group('addr'), header.group('size'), header.group('load')
+            if addr is None and index < len(lines):
+                cont = CONTINUATION.match(lines[index])
+                if cont:
+                    addr, size = cont.group('addr'), cont.group('size')
+                    loaded = 'load address' in cont.group('file')
+                    index += 1
+            if out_name in RESERVED_SECTIONS and size is not None:
+                reserved += int(size, 16)
+            if out_name == '/DISCARD/' or out_name in RESERVED_SECTIONS:
+                out_class = None
+            else:
+                out_class = section_class(out_name, None if addr is None else int(addr, 16), loaded)
+            continue
+
+        if out_class is None:
+            continue
+
+        section = INPUT_SECTION.match(line)
+        if section:
+            name, size, source = section.group('name'), section.group('size'), section.group('file')
+            if size is None and index < len(lines):
+                cont = CONTINUATION.match(lines[index])
+                if cont:
+                    size, source = cont.group('size'), cont.group('file')
+                    index += 1
+            if size is None or int(size, 16) == 0:
+                continue
+            if name == '*fill*':
+                # Alignment padding is charged to the module whose section caused it
+                key = (last_module, out_class, PADDING)
+            else:
+                last_module = module_of(source)
+                key = (last_module, out_class, symbol_of(name, source))
+            entries[key] = entries.get(key, 0) + int(size, 16)
+    return entries, reserved
+
+
+def parse_baseline(path):
+    entries = {}
+    with open(path, encoding='utf-8') as baseline:
+        for number, raw in enumerate(baseline, 1):
+            line = raw.split('#', 1)[0].split()
+            if not line:
+                continue
+            if len(line) != 4 or line[1] not in CLASSES:
+                sys.exit('footprint_report: {}:{}: cannot parse "{}"'.format(path, number, raw.strip()))
+            entries[(line[0], line[1], line[3])] = int(line[2])
+    return entries
+
+
+def parse_config(path):
+    """ Returns (hot modules {module : allowed growth}, limits {FLASH/RAM : bytes}, settings) """
+    hot, limits, settings = {}, {}, {}
+    with open(path, encoding='utf-8') as cfg:
+        for number, raw in enumerate(cfg, 1):
+            line = raw.split('#', 1)[0].split()
+            if not line:
+                continue
+            if len(line) != 3 or line[0] not in ('hot', 'limit', 'set'):
+                sys.exit('footprint_report: {}:{}: cannot parse "{}"'.format(path, number, raw.strip()))
+            keyword, name, value = line[0], line[1], int(line[2], 0)
+            if keyword == 'hot':
+                hot[name] = value
+            elif keyword == 'limit':
+                limits[name.upper()] = value
+            else:
+                settings[name] = value
+    return hot, limits, settings
+
+
+def write_baseline(path, entries):
+    with open(path, 'w', encoding='utf-8') as out:
+        out.write('#\n')
+        out.write('#                                   footprint_baseline.txt\n')
+        out.write('#\n')
+        out.write('# Footprint baseline compared by Tools/footprint_report.py. Do not edit by hand,\n')
+        out.write('# regenerate with "make footprint-baseline" when a size change is intended.\n')
+        out.write('#\n')
+        out.write('# <module> <class> <bytes> <symbol>\n')
+        out.write('#\n')
+        for (module, klass, symbol) in sorted(entries, key=lambda k: (k[0].lower(), CLASSES.index(k[1]), k[2])):
+            out.write('{:<12} {:<7} {:>6} {}\n'.format(module, klass, entries[(module, klass, symbol)], symbol))
+
+
+def module_totals(entries):
+    """ Returns { module : { class : bytes } } """
+    totals = {}
+    for (module, klass, _), size in entries.items():
+        totals.setdefault(module, dict.fromkeys(CLASSES, 0))[klass] += size
+    return totals
+
+
+def flash_of(sizes):
+    return sizes['text'] + sizes['rodata'] + sizes['data']
+
+
+def ram_of(sizes):
+    return sizes['data'] + sizes['bss']
+
+
+def signed(value):
+    return '{:+d}'.format(value) if value else '.'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Flash/RAM footprint per module and symbol.')
+    parser.add_argument('--map', required=True, help='linker map file')
+    parser.add_argument('--config', help='hot modules and limits (footprint.cfg)')
+    parser.add_argument('--baseline', help='baseline to compare with (footprint_baseline.txt)')
+    parser.add_argument('--write-baseline', metavar='FILE', help='write the current footprint as the new baseline')
+    parser.add_argument('--output', help='also write the report to this file')
+    args = parser.parse_args()
+
+    entries, reserved = parse_map(args.map)
+    if args.write_baseline:
+        write_baseline(args.write_baseline, entries)
+        print('footprint_report: baseline written to {}'.format(args.write_baseline))
+        return 0
+
+    hot, limits, settings = parse_config(args.config) if args.config else ({}, {}, {})
+    baseline = parse_baseline(args.baseline) if args.baseline and os.path.exists(args.baseline) else None
+    # A baseline without entries (never generated) compares like no baseline at all
+    if not baseline:
+        baseline = None
+    current, previous = module_totals(entries), module_totals(baseline or {})
+    empty = dict.fromkeys(CLASSES, 0)
+    report, warnings, failures = [], [], []
+
+    # -- Per module --
+    report.append('{:<12} {:>7} {:>7} {:>7} {:>7} {:>8} {:>7} {:>8} {:>7}'.format(
+        'Module', 'text', 'rodata', 'data', 'bss', 'FLASH', 'delta', 'RAM', 'delta'))
+    report.append('-' * 80)
+    total, total_before = dict.fromkeys(CLASSES, 0), dict.fromkeys(CLASSES, 0)
+    for module in sorted(set(current) | set(previous), key=str.lower):
+        now, before = current.get(module, empty), previous.get(module, empty)
+        for klass in CLASSES:
+            total[klass] += now[klass]
+            total_before[klass] += before[klass]
+        flash_delta = flash_of(now) - flash_of(before) if baseline is not None else 0
+        ram_delta = ram_of(now) - ram_of(before) if baseline is not None else 0
+
+        status = ''
+        if module in hot and max(flash_delta, ram_delta) > hot[module]:
+            status = '  <-- GROWTH'
+            warnings.append('hot module {} grew by {} bytes FLASH, {} bytes RAM'.format(
+                module, flash_delta, ram_delta))
+        report.append('{:<12} {:>7} {:>7} {:>7} {:>7} {:>8} {:>7} {:>8} {:>7}{}'.format(
+            module + ('*' if module in hot else ''), now['text'], now['rodata'], now['data'], now['bss'],
+            flash_of(now), signed(flash_delta), ram_of(now), signed(ram_delta), status))
+
+    report.append('-' * 80)
+    flash_delta = flash_of(total) - flash_of(total_before) if baseline is not None else 0
+    ram_delta = ram_of(total) - ram_of(total_before) if baseline is not None else 0
+    report.append('{:<12} {:>7} {:>7} {:>7} {:>7} {:>8} {:>7} {:>8} {:>7}'.format(
+        'TOTAL', total['text'], total['rodata'], total['data'], total['bss'],
+        flash_of(total), signed(flash_delta), ram_of(total), signed(ram_delta)))
+    report.append('{:<12} {:>7} {:>7} {:>7} {:>7} {:>8} {:>7} {:>8} {:>7}'.format(
+        'heap+stack', '', '', '', '', '', '', reserved, ''))
+    report.append('(* hot module)')
+
+    # -- Limits of the smallest part we ship on --
+    used = {'FLASH': flash_of(total), 'RAM': ram_of(total) + reserved}
+    for region in sorted(limits):
+        if region in used and used[region] > limits[region]:
+            failures.append('{} uses {} bytes (limit {})'.format(region, used[region], limits[region]))
+
+    # -- Per symbol --
+    if baseline is None:
+        report.append('')
+        report.append('No baseline to compare with (run "make footprint-baseline").')
+        warnings.append('no baseline to compare with: run "make footprint-baseline" and commit {}'.format(
+            args.baseline or 'footprint_baseline.txt'))
+    else:
+        changes = []
+        for key in set(entries) | set(baseline):
+            delta = entries.get(key, 0) - baseline.get(key, 0)
+            if delta:
+                kind = 'added' if key not in baseline else 'removed' if key not in entries else ''
+                changes.append((key, baseline.get(key, 0), entries.get(key, 0), delta, kind))
+        report.append('')
+        report.append('{:<12} {:<7} {:<40} {:>7} {:>7} {:>7}'.format('Module', 'Class', 'Symbol', 'Before', 'After', 'Delta'))
+        report.append('-' * 80)
+        if not changes:
+            report.append('(no change against the baseline)')
+        for (module, klass, symbol), before, after, delta, kind in sorted(changes, key=lambda c: (-abs(c[3]), c[0])):
+            report.append('{:<12} {:<7} {:<40} {:>7} {:>7} {:>7}  {}'.format(
+                module, klass, symbol, before, after, signed(delta), kind).rstrip())
+
+    text = '\n'.join(report) + '\n'
+    sys.stdout.write(text)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as out:
+            out.write(text)
+
+    for warning in warnings:
+        sys.stderr.write('footprint_report: warning: {}\n'.format(warning))
+    if warnings and settings.get('fail_on_growth', 0):
+        failures += warnings
+    if failures:
+        for failure in failures:
+            sys.stderr.write('footprint_report: error: {}\n'.format(failure))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+#
+#                                   stack_report.py
+#
+# Worst-case stack depth report for the DS1307_RTC_Drivers firmware.
+#
+# Combines the per-function frame sizes emitted by GCC (-fstack-usage, '.su' files)
+# with the static call graph recovered from the linked ELF (objdump -d) and computes
+# the deepest call chain starting at every entry point:
+#     - main
+#     - every interrupt/exception handler that is actually implemented
+#       (handlers still aliased to Default_Handler are skipped)
+#     - every public DS1307_* API
+#
+# Calls through function pointers (hooks, callbacks, ops tables) are followed through the
+# 'calls' entries of the configuration, which list the possible targets of every indirect
+# call site. An indirect call that is not listed cannot be bounded and is reported.
+#
+# Budgets are read from 'stack_budget.cfg' (see that file for the syntax). The script
+# exits with a non-zero status when any budget is exceeded, so the build fails.
+#
+# Usage (from the build configuration folder, e.g. Debug/):
+#     python3 ../Tools/stack_report.py --elf DS1307_RTC_Drivers.elf --su-dir . \
+#             --budget ../stack_budget.cfg --objdump arm-none-eabi-objdump
+#
+# Only the Python 3 standard library is required.
+#
+
+import argparse
+import fnmatch
+import os
+import re
+import subprocess
+import sys
+
+# Matches one line of a '.su' file:   <file>:<line>:<col>:<function>\t<bytes>\t<qualifier>
+SU_LINE = re.compile(r'^(?P<loc>.*):(?P<line>\d+):(?P<col>\d+):(?P<func>[^\t]+)\t(?P<size>\d+)\t(?P<qual>[\w,]+)')
+
+# Matches the start of a function in 'objdump -d' output:   08000abc <DS1307_Init>:
+FUNC_START = re.compile(r'^[0-9a-fA-F]+ <(?P<func>[^>+]+)>:$')
+
+# Matches a direct call or tail call:   bl 8000abc <I2C_Init>   /   b.w 8000abc <memset>
+DIRECT_CALL = re.compile(r'\t(?P<op>bl|blx|b|b\.w|b\.n|call|callq|jmp|jmpq)\s+[0-9a-fA-F]+ <(?P<target>[^>+]+)(?P<offset>\+0x[0-9a-fA-F]+)?>')
+
+# Matches a linker long-branch veneer (Flash <-> SRAM calls of __RAMFUNC functions):   __I2C_EV_IRQHandling_veneer
+VENEER = re.compile(r'^__(?P<func>\w+)_veneer$')
+
+# Matches an indirect call or tail call through a register:   blx r3   /   bx r3 (but not 'bx lr')
+INDIRECT_CALL = re.compile(r'\t((blx|call|callq)\s+(r\d+|lr|ip|\*%\w+)|bx\s+(r\d+|ip))\s*$')
+
+# Matches a symbol table line of 'objdump -t':   08000abc  w    F .text  00000002 EXTI0_IRQHandler
+SYMBOL_LINE = re.compile(r'^(?P<addr>[0-9a-fA-F]+)\s+(?P<flags>.{7})\s+(?P<section>\S+)\s+(?P<size>[0-9a-fA-F]+)\s+(?P<name>\S+)$')
+
+
+def parse_su_files(su_dir):
+    """ Returns { function : (bytes, qualifier) } for every '.su' file below su_dir """
+    frames = {}
+    for root, _, files in os.walk(su_dir):
+        for name in files:
+            if not name.endswith('.su'):
+                continue
+            with open(os.path.join(root, name), encoding='utf-8', errors='replace') as su:
+                for line in su:
+                    match = SU_LINE.match(line.rstrip('\n'))
+                    if match:
+                        func = match.group('func')
+                        size = int(match.group('size'))
+                        # Static functions with the same name in different units: keep the larger frame
+                        if func not in frames or frames[func][0] < size:
+                            frames[func] = (size, match.group('qual'))
+    return frames
+
+
+def run_objdump(objdump, args, elf):
+    try:
+        return subprocess.run([objdump] + args + [elf], check=True, capture_output=True,
+                              text=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.exit('stack_report: failed to run {} {}: {}'.format(objdump, ' '.join(args), error))
+
+
+def parse_call_graph(disassembly):
+    """ Returns ({ caller : set(callees) }, set(functions with indirect calls)) """
+    graph = {}
+    indirect = set()
+    current = None
+    for line in disassembly.splitlines():
+        start = FUNC_START.match(line)
+        if start:
+            current = start.group('func')
+            graph.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        call = DIRECT_CALL.search(line)
+        if call:
+            # Calls through a PLT stub (host builds) are attributed to the real function
+            target = call.group('target').split('@')[0]
+            # Calls through a long-branch veneer are attributed to the real function
+            target = VENEER.sub(r'\g<func>', target)
+            # A branch inside the same function (loops, if/else) is not a call
+            if target != current and not call.group('offset'):
+                graph[current].add(target)
+            continue
+        if INDIRECT_CALL.search(line):
+            indirect.add(current)
+    return graph, indirect
+
+
+def parse_symbols(symbol_table):
+    """ Returns (handlers NOT aliased to Default_Handler, set of global functions) """
+    addresses, globals_ = {}, set()
+    for line in symbol_table.splitlines():
+        match = SYMBOL_LINE.match(line.strip())
+        if match and 'F' in match.group('flags'):
+            addresses[match.group('name')] = match.group('addr')
+            if match.group('flags')[0] == 'g':
+                globals_.add(match.group('name'))
+    default = addresses.get('Default_Handler')
+    handlers = sorted(name for name, addr in addresses.items()
+                      if name.endswith('_Handler') or name.endswith('_IRQHandler')
+                      if name not in ('Default_Handler', 'Reset_Handler') and addr != default)
+    return handlers, globals_
+
+
+def parse_budget(path):
+    """ Returns (budgets [(pattern, bytes)], extern costs {symbol : bytes}, settings {key : value},
+                 indirect call targets {caller : set(targets)}) """
+    budgets, externs, settings, targets = [], {}, {}, {}
+    with open(path, encoding='utf-8') as cfg:
+        for number, raw in enumerate(cfg, 1):
+            line = raw.split('#', 1)[0].split()
+            if not line:
+                continue
+            if len(line) != 3 or line[0] not in ('budget', 'extern', 'set', 'calls'):
+                sys.exit('stack_report: {}:{}: cannot parse "{}"'.format(path, number, raw.strip()))
+            if line[0] == 'calls':
+                targets.setdefault(line[1], set()).add(line[2])
+                continue
+            keyword, name, value = line[0], line[1], int(line[2], 0)
+            if keyword == 'budget':
+                budgets.append((name, value))
+            elif keyword == 'extern':
+                externs[name] = value
+            else:
+                settings[name] = value
+    return budgets, externs, settings, targets
+
+
+class StackAnalyzer:
+    def __init__(self, frames, graph, indirect, externs, targets):
+        self.frames = frames
+        self.graph = graph
+        self.indirect = indirect
+        self.externs = externs
+        self.targets = targets
+        self.memo = {}
+
+    def callees(self, func):
+        """ Direct callees plus the listed targets of the indirect calls that are linked in """
+        callees = set(self.graph.get(func, ()))
+        if func in self.indirect:
+            callees |= {target for target in self.targets.get(func, ())
+                        if target in self.graph or target in self.frames}
+        return sorted(callees)
+
+    def frame(self, func):
+        if func in self.frames:
+            return self.frames[func][0]
+        return self.externs.get(func)
+
+    def depth(self, func, path=()):
+        """ Returns (bytes, worst call chain, set of problems) for the deepest chain below func """
+        if func in self.memo:
+            return self.memo[func]
+        if func in path:
+            return 0, [func], {'recursion through ' + func}
+
+        problems = set()
+        own = self.frame(func)
+        if own is None:
+            own = 0
+            problems.add('no stack data for ' + func)
+        elif func in self.frames and 'dynamic' in self.frames[func][1]:
+            problems.add('dynamic stack in ' + func)
+        if func in self.indirect and func not in self.targets:
+            problems.add('unlisted indirect call in ' + func)
+
+        worst, chain = 0, []
+        # Functions with an 'extern' cost are leaves: the cost covers everything below them
+        callees = () if (func not in self.frames and func in self.externs) else self.callees(func)
+        for callee in callees:
+            sub_bytes, sub_chain, sub_problems = self.depth(callee, path + (func,))
+            problems |= sub_problems
+            if sub_bytes > worst:
+                worst, chain = sub_bytes, sub_chain
+
+        result = (own + worst, [func] + chain, problems)
+        # Results that depend on the current path (recursion cut-off) must not be reused
+        if not any(problem.startswith('recursion') for problem in problems):
+            self.memo[func] = result
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Worst-case stack depth per entry point.')
+    parser.add_argument('--elf', required=True, help='linked firmware image')
+    parser.add_argument('--su-dir', default='.', help='folder searched (recursively) for .su files')
+    parser.add_argument('--budget', required=True, help='budget configuration (stack_budget.cfg)')
+    parser.add_argument('--objdump', default='arm-none-eabi-objdump', help='objdump executable')
+    parser.add_argument('--output', help='also write the report to this file')
+    args = parser.parse_args()
+
+    budgets, externs, settings, targets = parse_budget(args.budget)
+    frames = parse_su_files(args.su_dir)
+    graph, indirect = parse_call_graph(run_objdump(args.objdump, ['-d', '--no-show-raw-insn'], args.elf))
+    handlers, public = parse_symbols(run_objdump(args.objdump, ['-t'], args.elf))
+
+    # Hardware exception frame pushed on entry to every handler (26 words with lazy FPU stacking)
+    exception_frame = settings.get('exception_frame', 104)
+    strict = settings.get('strict', 0)
+
+    entries = []
+    if 'main' in graph:
+        entries.append('main')
+    entries += handlers
+    entries += sorted(f for f in graph if f.startswith('DS1307_') and f in public
+                      and f not in entries)
+
+    analyzer = StackAnalyzer(frames, graph, indirect, externs, targets)
+    report, failures = [], []
+    results = {}
+
+    report.append('{:<36} {:>7} {:>7}  {}'.format('Entry point', 'Bytes', 'Budget', 'Worst call chain'))
+    report.append('-' * 100)
+    for entry in entries:
+        depth, chain, problems = analyzer.depth(entry)
+        if entry in handlers:
+            depth += exception_frame
+        results[entry] = depth
+
+        budget = next((value for pattern, value in budgets if fnmatch.fnmatchcase(entry, pattern)), None)
+        status = ''
+        if budget is not None and depth > budget:
+            status = '  <-- OVER BUDGET'
+            failures.append('{} uses {} bytes (budget {})'.format(entry, depth, budget))
+        if problems and strict:
+            failures.append('{}: {}'.format(entry, ', '.join(sorted(problems))))
+
+        report.append('{:<36} {:>7} {:>7}  {}{}'.format(entry, depth, '-' if budget is None else budget,
+                                                         ' > '.join(chain), status))
+        for problem in sorted(problems):
+            report.append('{:<36} {:>7} {:>7}    (lower bound: {})'.format('', '', '', problem))
+
+    # System figure: main plus the deepest handlers nested on top of it. Handlers of the same
+    # preemption priority cannot nest, so 'nested_handlers' is the number of priority levels in use
+    # (0: every implemented handler nested, the most conservative figure)
+    nested = settings.get('nested_handlers', 0)
+    deepest = sorted((results[h] for h in handlers), reverse=True)
+    if nested:
+        deepest = deepest[:nested]
+    total = results.get('main', 0) + sum(deepest)
+    total_budget = next((value for pattern, value in budgets if pattern == 'TOTAL'), None)
+    report.append('-' * 100)
+    report.append('{:<36} {:>7} {:>7}  main + {} deepest handlers nested'.format(
+        'TOTAL', total, '-' if total_budget is None else total_budget,
+        'all' if not nested else nested))
+    if total_budget is not None and total > total_budget:
+        failures.append('TOTAL uses {} bytes (budget {})'.format(total, total_budget))
+
+    text = '\n'.join(report) + '\n'
+    sys.stdout.write(text)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as out:
+            out.write(text)
+
+    if failures:
+        for failure in failures:
+            sys.stderr.write('stack_report: error: {}\n'.format(failure))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
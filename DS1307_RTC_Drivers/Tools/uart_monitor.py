@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+#                                   uart_monitor.py
+#
+# Host side of the serial time stream (DS1307_Drivers/DS1307_Stream.h).
+#
+# Reads a serial port (or a pty: simulator, socat loopback) in raw mode and checks the stream:
+#     text mode     one ISO-8601 line per timestamp ("20yy-mm-ddThh:mm:ss"), printed as received
+#     binary mode   DLOG records (timestamps are "DS1307 epoch %lu"), formatted with the strings of
+#                   the ELF (dlog_decode.py) once the capture ends
+# Timestamps MUST never go back; a jump of more than --max-gap seconds is reported as a gap
+# (stream stalled or records dropped). The exit status is 1 when a check failed.
+#
+# Usage (from the build configuration folder, e.g. Debug/):
+#     python3 ../Tools/uart_monitor.py --port /dev/ttyACM0 --seconds 10
+#     python3 ../Tools/uart_monitor.py --port /dev/pts/3 --mode binary --elf DS1307_RTC_Drivers.elf
+#     python3 ../Tools/uart_monitor.py --input capture.txt        (offline check of a saved stream)
+#
+# Only the Python 3 standard library is required (termios: Linux/macOS).
+#
+
+import argparse
+import datetime
+import os
+import re
+import select
+import sys
+import time
+
+import dlog_decode
+
+# DS1307 epoch (DS1307_Get_Epoch): seconds since 2000-01-01 00:00:00
+DS1307_EPOCH = datetime.datetime(2000, 1, 1)
+
+ISO_LINE = re.compile(r'^(\d{4})-(\d{2})-(\d{2})T(\d{2}):(\d{2}):(\d{2})$')
+EPOCH_RECORD = re.compile(r'^DS1307 epoch (\d+)$')
+
+
+class TimestampCheck:
+    """ Counts the timestamps, their order and the gaps between them """
+
+    def __init__(self, max_gap):
+        self.max_gap = max_gap
+        self.last = None
+        self.count = self.backwards = self.gaps = self.malformed = 0
+
+    def add(self, stamp, text):
+        if stamp is None:
+            self.malformed += 1
+            print('uart_monitor: malformed: {!r}'.format(text), file=sys.stderr)
+            return
+        self.count += 1
+        if self.last is not None:
+            delta = (stamp - self.last).total_seconds()
+            if delta < 0:
+                self.backwards += 1
+                print('uart_monitor: back in time: {} after {}'.format(stamp, self.last), file=sys.stderr)
+            elif delta > self.max_gap:
+                self.gaps += 1
+                print('uart_monitor: gap of {:.0f} s before {}'.format(delta, stamp), file=sys.stderr)
+        self.last = stamp
+
+    def report(self):
+        print('uart_monitor: {} timestamps, {} back in time, {} gaps, {} malformed'.format(
+            self.count, self.backwards, self.gaps, self.malformed), file=sys.stderr)
+        return 1 if (self.backwards or self.malformed) else 0
+
+
+def parse_iso(line):
+    match = ISO_LINE.match(line)
+    if not match:
+        return None
+    try:
+        return datetime.datetime(*(int(field) for field in match.groups()))
+    except ValueError:
+        return None
+
+
+def open_port(path, baud):
+    """ Opens a tty in raw mode (8N1, no echo, no line editing); a pty ignores the rate """
+    import termios
+    import tty
+
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY | os.O_NONBLOCK)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        speed = getattr(termios, 'B{}'.format(baud), None)
+        if speed is None:
+            sys.exit('uart_monitor: baud rate {} not supported by termios'.format(baud))
+        attrs[4] = attrs[5] = speed
+        attrs[2] = (attrs[2] & ~(termios.PARENB | termios.CSTOPB | termios.CSIZE)) | termios.CS8 | \
+            termios.CLOCAL | termios.CREAD
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+        termios.tcflush(fd, termios.TCIFLUSH)
+    return fd
+
+
+def read_chunks(fd, seconds):
+    """ Yields the bytes received until the time limit (0: none), EOF or Ctrl-C """
+    end = (time.monotonic() + seconds) if seconds else None
+    try:
+        while end is None or time.monotonic() < end:
+            timeout = 0.2 if end is None else max(0.0, min(0.2, end - time.monotonic()))
+            ready, _, _ = select.select([fd], [], [], timeout)
+            if not ready:
+                continue
+            try:
+                data = os.read(fd, 4096)
+            except BlockingIOError:
+                continue
+            except OSError:
+                # pty closed by the other side (EIO)
+                return
+            if not data:
+                return
+            yield data
+    except KeyboardInterrupt:
+        return
+
+
+def monitor_text(chunks, check, save):
+    pending = b''
+    for data in chunks:
+        if save:
+            save.write(data)
+        pending += data
+        *lines, pending = pending.split(b'\n')
+        for raw in lines:
+            line = raw.decode('ascii', 'replace').strip('\r')
+            print(line)
+            check.add(parse_iso(line), line)
+    if pending:
+        print('uart_monitor: {} byte(s) after the last line ignored'.format(len(pending)), file=sys.stderr)
+
+
+def monitor_binary(chunks, check, save, elf, hz):
+    section = dlog_decode.read_section(elf, dlog_decode.SECTION)
+    if section is None:
+        sys.exit('uart_monitor: {}: no {} section'.format(elf, dlog_decode.SECTION))
+    table = dlog_decode.string_table(section)
+
+    stream = b''.join(chunks)
+    if save:
+        save.write(stream)
+
+    for cycles, message in dlog_decode.decode(stream, table):
+        if cycles is None:
+            if message:
+                print('uart_monitor: {} byte(s) skipped (not a record)'.format(message), file=sys.stderr)
+            break
+        print('[{:12.6f}] {}'.format(cycles / hz, message))
+        match = EPOCH_RECORD.match(message)
+        if match:
+            check.add(DS1307_EPOCH + datetime.timedelta(seconds=int(match.group(1))), message)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Checks the DS1307 time stream of a serial port.')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--port', help='serial device or pty (e.g. /dev/ttyACM0, /dev/pts/3)')
+    source.add_argument('--input', help='saved stream to check offline')
+    parser.add_argument('--baud', type=int, default=115200, help='DS1307_STREAM_BAUD (default 115200)')
+    parser.add_argument('--mode', choices=('text', 'binary'), default='text', help='DS1307_STREAM_MODE')
+    parser.add_argument('--elf', help='linked firmware image (binary mode)')
+    parser.add_argument('--hz', type=int, default=168000000, help='HCLK of the DLOG timestamps (binary mode)')
+    parser.add_argument('--seconds', type=float, default=0, help='capture time (default: until Ctrl-C/EOF)')
+    parser.add_argument('--max-gap', type=float, default=2, help='largest step between timestamps [s]')
+    parser.add_argument('--save', help='file to save the raw stream to')
+    args = parser.parse_args()
+
+    if args.mode == 'binary' and not args.elf:
+        parser.error('--elf is required in binary mode')
+
+    if args.port:
+        fd = open_port(args.port, args.baud)
+        chunks = read_chunks(fd, args.seconds)
+    else:
+        with open(args.input, 'rb') as input_file:
+            chunks = iter([input_file.read()])
+
+    check = TimestampCheck(args.max_gap)
+    save = open(args.save, 'wb') if args.save else None
+    try:
+        if args.mode == 'text':
+            monitor_text(chunks, check, save)
+        else:
+            monitor_binary(chunks, check, save, args.elf, args.hz)
+    finally:
+        if save:
+            save.close()
+
+    return check.report()
+
+
+if __name__ == '__main__':
+    sys.exit(main())